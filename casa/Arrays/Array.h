@@ -524,6 +524,12 @@ public:
     // arrays handle all of the references for you.
     uInt nrefs() const;
 
+    // Is the Array the sole owner of its data? That is the case if no
+    // other Array references the data and if the data was not given using
+    // StorageInitPolicy SHARE. The data of such an Array can safely be
+    // handed over to another owner (e.g. a Python array) without a copy.
+    Bool ownsData() const;
+
     // Check to see if the Array is consistent. This is about the same thing
     // as checking for invariants. If AIPS_DEBUG is defined, this is invoked
     // after construction and on entry to most member functions.
@@ -813,6 +819,11 @@ protected:
     virtual void doNonDegenerate(const Array<T> &other,
                                  const IPosition &ignoreAxes);
 
+    // Create a storage block with the given number of elements.
+    // The storage is taken from the thread's MemoryPool if a
+    // MemoryPoolScope is active.
+    static Block<T>* newBlock (size_t nelements);
+
 
     // Reference counted block that contains the storage.
     CountedPtr<Block<T> > data_p;
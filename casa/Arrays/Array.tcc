@@ -54,7 +54,7 @@ template<class T> Array<T>::Array()
 template<class T> Array<T>::Array(const IPosition &Shape)
 : ArrayBase (Shape)
 {
-    data_p = new Block<T>(nelements());
+    data_p = newBlock (nelements());
     begin_p = data_p->storage();
     setEndIter();
     DebugAssert(ok(), ArrayError);
@@ -67,7 +67,7 @@ template<class T> Array<T>::Array(const IPosition &Shape,
 				  const T &initialValue)
 : ArrayBase (Shape)
 {
-    data_p = new Block<T>(nelements());
+    data_p = newBlock (nelements());
     begin_p = data_p->storage();
     setEndIter();
     DebugAssert(ok(), ArrayError);
@@ -797,6 +797,20 @@ template<class T> uInt Array<T>::nrefs() const
     return data_p.nrefs();
 }
 
+template<class T> Block<T>* Array<T>::newBlock (size_t nelements)
+{
+    if (nelements > 0  &&  MemoryPool::inScope()) {
+        return new Block<T> (nelements, AllocSpec<PoolAllocator<T> >::value);
+    }
+    return new Block<T> (nelements);
+}
+
+template<class T> Bool Array<T>::ownsData() const
+{
+    DebugAssert(ok(), ArrayError);
+    return data_p.nrefs() == 1  &&  data_p->ownsStorage();
+}
+
 // This is relatively expensive
 template<class T> Bool Array<T>::ok() const
 {
@@ -959,7 +973,7 @@ void Array<T>::takeStorage(const IPosition &shape, T *storage,
     case COPY:
 	if (data_p.null()  ||  data_p.nrefs() > 1
         ||  data_p->nelements() != new_nels) {
-	    data_p = new Block<T>(new_nels);
+	    data_p = newBlock (new_nels);
 	}
 	objcopy(data_p->storage(), storage, new_nels);
 	break;
@@ -0,0 +1,372 @@
+//# ArrayExpr.h: Lazy element-wise expressions of Arrays
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//# 
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//# 
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//# 
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//# 
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef CASA_ARRAYEXPR_H
+#define CASA_ARRAYEXPR_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <functional>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Lazy element-wise expressions of Arrays.
+// </summary>
+// <reviewed reviewer="" date="" tests="tArrayExpr">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+//   <li> <linkto group="ArrayMath.h#Array mathematical operations">ArrayMath</linkto>
+// </prerequisite>
+//
+// <etymology>
+// ArrayExpr is an expression of Arrays.
+// </etymology>
+//
+// <synopsis>
+// The mathematical operators in ArrayMath.h create a new Array for each
+// operation, so an expression like <src>a*b + c*d</src> creates three
+// Arrays, of which two are temporaries. Furthermore, the data of each
+// operand is traversed separately.
+// <br>The classes in this file make it possible to build such an
+// expression lazily (using expression templates). No Array is created
+// until the expression is evaluated, which is done in a single loop
+// over the elements creating the result Array only.
+// <p>
+// The lazy evaluation is opt-in; the normal Array operators are not
+// affected. An expression is started by wrapping an Array in the function
+// <src>lazy</src>, after which the operators +, -, *, / and unary - can be
+// used with other lazy expressions, Arrays and scalars. Arbitrary
+// functors (e.g. those in Functors.h) can be applied using
+// <src>lazyTransform</src>. The expression is evaluated by converting it
+// to an Array, or by function <src>evaluate</src> which stores the result
+// in an existing Array (resizing it if its shape differs).
+// <br>All Arrays in an expression must have the same shape; otherwise an
+// ArrayConformanceError exception is thrown when building the expression.
+// A non-contiguous Array (e.g. a section) is copied when it is wrapped
+// in an expression, because the evaluation indexes the data directly.
+// <p>
+// Note that an expression references the Arrays it is made of, so it
+// should be evaluated before the Arrays are changed or go out of scope.
+// Normally the expression is evaluated in the statement creating it.
+// It is fine to use the result Array as an operand.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Cube<Complex> a(shape), b(shape), c(shape), d(shape);
+//   ...
+//   // Evaluate with a single loop and without temporary arrays.
+//   Cube<Complex> res(lazy(a)*b + lazy(c)*d);
+//   // Store the result in an existing array.
+//   evaluate (res, lazy(a)*Complex(2,0) - res);
+//   // Apply a functor.
+//   Cube<Float> amp(lazyTransform (lazy(a)*b, Abs<Complex,Float>()));
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Expressions on large cubes (e.g. in calibration and flagging) are
+// dominated by the allocation of temporary arrays and by memory traffic.
+// </motivation>
+//
+// <group name="Lazy array expressions">
+
+
+// Leaf of an expression referencing the data of an Array.
+template<typename T> class ArrayExprLeaf
+{
+public:
+  typedef T value_type;
+  explicit ArrayExprLeaf (const Array<T>& arr)
+    : itsShape (&arr.shape())
+  {
+    if (arr.contiguousStorage()) {
+      itsData = arr.data();
+    } else {
+      itsCopy = new Array<T> (arr.copy());
+      itsData = itsCopy->data();
+    }
+  }
+  const IPosition& shape() const
+    { return *itsShape; }
+  value_type operator[] (size_t i) const
+    { return itsData[i]; }
+private:
+  const IPosition*      itsShape;
+  const T*              itsData;
+  CountedPtr<Array<T> > itsCopy;    //# only used for non-contiguous arrays
+};
+
+// Expression node applying a unary operator.
+template<typename E, typename OP, typename RES=typename E::value_type>
+class ArrayExprUnary
+{
+public:
+  typedef RES value_type;
+  ArrayExprUnary (const E& expr, OP op)
+    : itsExpr (expr), itsOp (op)
+    {}
+  const IPosition& shape() const
+    { return itsExpr.shape(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsExpr[i]); }
+private:
+  E  itsExpr;
+  OP itsOp;
+};
+
+// Expression node applying a binary operator to two expressions.
+template<typename L, typename R, typename OP,
+         typename RES=typename L::value_type>
+class ArrayExprBinary
+{
+public:
+  typedef RES value_type;
+  ArrayExprBinary (const L& left, const R& right, OP op)
+    : itsLeft (left), itsRight (right), itsOp (op)
+  {
+    if (! itsLeft.shape().isEqual (itsRight.shape())) {
+      throwArrayShapes ("ArrayExpr");
+    }
+  }
+  const IPosition& shape() const
+    { return itsLeft.shape(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsLeft[i], itsRight[i]); }
+private:
+  L  itsLeft;
+  R  itsRight;
+  OP itsOp;
+};
+
+// Expression node applying a binary operator to an expression
+// and a scalar (<src>expr OP scalar</src>).
+template<typename E, typename OP>
+class ArrayExprScalarRight
+{
+public:
+  typedef typename E::value_type value_type;
+  ArrayExprScalarRight (const E& left, const value_type& right, OP op)
+    : itsLeft (left), itsRight (right), itsOp (op)
+    {}
+  const IPosition& shape() const
+    { return itsLeft.shape(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsLeft[i], itsRight); }
+private:
+  E          itsLeft;
+  value_type itsRight;
+  OP         itsOp;
+};
+
+// Expression node applying a binary operator to a scalar
+// and an expression (<src>scalar OP expr</src>).
+template<typename E, typename OP>
+class ArrayExprScalarLeft
+{
+public:
+  typedef typename E::value_type value_type;
+  ArrayExprScalarLeft (const value_type& left, const E& right, OP op)
+    : itsLeft (left), itsRight (right), itsOp (op)
+    {}
+  const IPosition& shape() const
+    { return itsRight.shape(); }
+  value_type operator[] (size_t i) const
+    { return itsOp (itsLeft, itsRight[i]); }
+private:
+  value_type itsLeft;
+  E          itsRight;
+  OP         itsOp;
+};
+
+
+// The lazy expression as used by the user. It wraps an expression node.
+// The operators are only defined for this class, so they cannot interfere
+// with the normal Array operators.
+template<typename E> class ArrayExpr
+{
+public:
+  typedef typename E::value_type value_type;
+  explicit ArrayExpr (const E& expr)
+    : itsExpr (expr)
+    {}
+  const E& expr() const
+    { return itsExpr; }
+  const IPosition& shape() const
+    { return itsExpr.shape(); }
+  value_type operator[] (size_t i) const
+    { return itsExpr[i]; }
+  // Evaluate the expression into the given contiguous storage, which must
+  // have the size of the expression.
+  void evaluate (value_type* result) const
+  {
+    const size_t n = itsExpr.shape().product();
+    for (size_t i=0; i<n; ++i) {
+      result[i] = itsExpr[i];
+    }
+  }
+  // Evaluate the expression into a new Array.
+  // <group>
+  Array<value_type> array() const
+  {
+    Array<value_type> result(shape());
+    evaluate (result.data());
+    return result;
+  }
+  operator Array<value_type>() const
+    { return array(); }
+  // </group>
+private:
+  E itsExpr;
+};
+
+
+// Start a lazy expression.
+template<typename T>
+inline ArrayExpr<ArrayExprLeaf<T> > lazy (const Array<T>& arr)
+{
+  return ArrayExpr<ArrayExprLeaf<T> > (ArrayExprLeaf<T>(arr));
+}
+
+// Evaluate an expression into an Array. The Array is resized if its
+// shape differs from the expression shape (like Array assignment).
+template<typename T, typename E>
+void evaluate (Array<T>& result, const ArrayExpr<E>& expr)
+{
+  if (! result.shape().isEqual (expr.shape())) {
+    result.resize (expr.shape());
+  }
+  if (result.contiguousStorage()) {
+    expr.evaluate (result.data());
+  } else {
+    result = expr.array();
+  }
+}
+
+// Apply a unary functor to each element of an expression.
+// The result type is given by the functor's <src>result_type</src>.
+template<typename E, typename OP>
+inline ArrayExpr<ArrayExprUnary<E, OP, typename OP::result_type> >
+lazyTransform (const ArrayExpr<E>& expr, OP op)
+{
+  return ArrayExpr<ArrayExprUnary<E, OP, typename OP::result_type> >
+    (ArrayExprUnary<E, OP, typename OP::result_type> (expr.expr(), op));
+}
+
+// Apply a binary functor to the elements of two expressions.
+// The result type is given by the functor's <src>result_type</src>.
+template<typename L, typename R, typename OP>
+inline ArrayExpr<ArrayExprBinary<L, R, OP, typename OP::result_type> >
+lazyTransform (const ArrayExpr<L>& left, const ArrayExpr<R>& right, OP op)
+{
+  return ArrayExpr<ArrayExprBinary<L, R, OP, typename OP::result_type> >
+    (ArrayExprBinary<L, R, OP, typename OP::result_type>
+     (left.expr(), right.expr(), op));
+}
+
+// Unary minus.
+template<typename E>
+inline ArrayExpr<ArrayExprUnary<E, std::negate<typename E::value_type> > >
+operator- (const ArrayExpr<E>& expr)
+{
+  typedef std::negate<typename E::value_type> OP;
+  return ArrayExpr<ArrayExprUnary<E,OP> > (ArrayExprUnary<E,OP>
+                                           (expr.expr(), OP()));
+}
+
+//# Define the binary operators for the various operand combinations.
+#define ARRAYEXPR_BINARY_OPERATOR(OPER, FUNCTOR) \
+template<typename L, typename R> \
+inline ArrayExpr<ArrayExprBinary<L, R, FUNCTOR<typename L::value_type> > > \
+operator OPER (const ArrayExpr<L>& left, const ArrayExpr<R>& right) \
+{ \
+  typedef FUNCTOR<typename L::value_type> OP; \
+  return ArrayExpr<ArrayExprBinary<L,R,OP> > \
+    (ArrayExprBinary<L,R,OP> (left.expr(), right.expr(), OP())); \
+} \
+template<typename E> \
+inline ArrayExpr<ArrayExprBinary<E, ArrayExprLeaf<typename E::value_type>, \
+                                 FUNCTOR<typename E::value_type> > > \
+operator OPER (const ArrayExpr<E>& left, \
+               const Array<typename E::value_type>& right) \
+{ \
+  typedef ArrayExprLeaf<typename E::value_type> R; \
+  typedef FUNCTOR<typename E::value_type> OP; \
+  return ArrayExpr<ArrayExprBinary<E,R,OP> > \
+    (ArrayExprBinary<E,R,OP> (left.expr(), R(right), OP())); \
+} \
+template<typename E> \
+inline ArrayExpr<ArrayExprBinary<ArrayExprLeaf<typename E::value_type>, E, \
+                                 FUNCTOR<typename E::value_type> > > \
+operator OPER (const Array<typename E::value_type>& left, \
+               const ArrayExpr<E>& right) \
+{ \
+  typedef ArrayExprLeaf<typename E::value_type> L; \
+  typedef FUNCTOR<typename E::value_type> OP; \
+  return ArrayExpr<ArrayExprBinary<L,E,OP> > \
+    (ArrayExprBinary<L,E,OP> (L(left), right.expr(), OP())); \
+} \
+template<typename E> \
+inline ArrayExpr<ArrayExprScalarRight<E, FUNCTOR<typename E::value_type> > > \
+operator OPER (const ArrayExpr<E>& left, \
+               const typename E::value_type& right) \
+{ \
+  typedef FUNCTOR<typename E::value_type> OP; \
+  return ArrayExpr<ArrayExprScalarRight<E,OP> > \
+    (ArrayExprScalarRight<E,OP> (left.expr(), right, OP())); \
+} \
+template<typename E> \
+inline ArrayExpr<ArrayExprScalarLeft<E, FUNCTOR<typename E::value_type> > > \
+operator OPER (const typename E::value_type& left, \
+               const ArrayExpr<E>& right) \
+{ \
+  typedef FUNCTOR<typename E::value_type> OP; \
+  return ArrayExpr<ArrayExprScalarLeft<E,OP> > \
+    (ArrayExprScalarLeft<E,OP> (left, right.expr(), OP())); \
+}
+
+// The binary operators. Each can be used with a lazy expression and
+// another lazy expression, an Array, or a scalar.
+// <group>
+ARRAYEXPR_BINARY_OPERATOR(+, std::plus)
+ARRAYEXPR_BINARY_OPERATOR(-, std::minus)
+ARRAYEXPR_BINARY_OPERATOR(*, std::multiplies)
+ARRAYEXPR_BINARY_OPERATOR(/, std::divides)
+// </group>
+
+#undef ARRAYEXPR_BINARY_OPERATOR
+
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -271,6 +271,15 @@ template<class T> LogicalArray isInf    (const Array<T> &array);
 template<class T> LogicalArray isFinite (const Array<T> &array);
 // </group>
 
+// Test if any element in an array is NaN or infinite, or if all elements
+// are finite. Unlike the functions above, no temporary LogicalArray is
+// created and the test stops at the first mismatch.
+// <group>
+template<class T> Bool anyNaN    (const Array<T> &array);
+template<class T> Bool anyInf    (const Array<T> &array);
+template<class T> Bool allFinite (const Array<T> &array);
+// </group>
+
 // 
 // Element by element comparisons between an array and a scalar, which
 // behaves as if it were a conformant array filled with the value "val."
@@ -31,6 +31,7 @@
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
 #include <casacore/casa/Arrays/ArrayError.h>
+#include <casacore/casa/Arrays/ArrayReduceKernels.h>
 //# For scalar near() functions.
 #include <casacore/casa/BasicMath/Functors.h>
 
@@ -42,7 +43,8 @@ bool arrayCompareAll (const Array<T>& left, const Array<T>& right,
 {
   if (! left.conform(right)) return false;
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
-    return compareAll (left.cbegin(), left.cend(), right.cbegin(), op);
+    return arrayCompareAllChunk (left.data(), right.data(),
+                                 left.nelements(), op);
   } else {
     return compareAll (left.begin(),  left.end(),  right.begin(),  op);
   }
@@ -52,22 +54,20 @@ template<typename T, typename CompareOperator>
 bool arrayCompareAll (const Array<T>& left, T right,
                       CompareOperator op)
 {
-  if (left.contiguousStorage()) {
-    return compareAllRight (left.cbegin(), left.cend(), right, op);
-  } else {
-    return compareAllRight (left.begin(), left.end(), right, op);
-  }
+  typedef ArrayCompareRight<T,CompareOperator> Pred;
+  ArrayAllKernel<T,Pred> kernel(Pred(op, right));
+  arrayReduceChunks (left, kernel);
+  return kernel.result();
 }
 
 template<typename T, typename CompareOperator>
 bool arrayCompareAll (T left, const Array<T>& right,
                       CompareOperator op)
 {
-  if (right.contiguousStorage()) {
-    return compareAllLeft (right.cbegin(), right.cend(), left, op);
-  } else {
-    return compareAllLeft (right.begin(), right.end(), left, op);
-  }
+  typedef ArrayCompareLeft<T,CompareOperator> Pred;
+  ArrayAllKernel<T,Pred> kernel(Pred(op, left));
+  arrayReduceChunks (right, kernel);
+  return kernel.result();
 }
 
 template<typename T, typename CompareOperator>
@@ -76,7 +76,8 @@ bool arrayCompareAny (const Array<T>& left, const Array<T>& right,
 {
   if (! left.conform(right)) return false;
   if (left.contiguousStorage()  &&  right.contiguousStorage()) {
-    return compareAny (left.cbegin(), left.cend(), right.cbegin(), op);
+    return arrayCompareAnyChunk (left.data(), right.data(),
+                                 left.nelements(), op);
   } else {
     return compareAny (left.begin(),  left.end(),  right.begin(),  op);
   }
@@ -86,22 +87,20 @@ template<typename T, typename CompareOperator>
 bool arrayCompareAny (const Array<T>& left, T right,
                       CompareOperator op)
 {
-  if (left.contiguousStorage()) {
-    return compareAnyRight (left.cbegin(), left.cend(), right, op);
-  } else {
-    return compareAnyRight (left.begin(), left.end(), right, op);
-  }
+  typedef ArrayCompareRight<T,CompareOperator> Pred;
+  ArrayAnyKernel<T,Pred> kernel(Pred(op, right));
+  arrayReduceChunks (left, kernel);
+  return kernel.result();
 }
 
 template<typename T, typename CompareOperator>
 bool arrayCompareAny (T left, const Array<T>& right,
                       CompareOperator op)
 {
-  if (right.contiguousStorage()) {
-    return compareAnyLeft (right.cbegin(), right.cend(), left, op);
-  } else {
-    return compareAnyLeft (right.begin(), right.end(), left, op);
-  }
+  typedef ArrayCompareLeft<T,CompareOperator> Pred;
+  ArrayAnyKernel<T,Pred> kernel(Pred(op, left));
+  arrayReduceChunks (right, kernel);
+  return kernel.result();
 }
 
 
@@ -589,6 +588,30 @@ LogicalArray isFinite (const Array<T> &array)
   return result;
 }
 
+template<class T>
+Bool anyNaN (const Array<T> &array)
+{
+  ArrayAnyKernel<T,casacore::IsNaN<T> > kernel((casacore::IsNaN<T>()));
+  arrayReduceChunks (array, kernel);
+  return kernel.result();
+}
+
+template<class T>
+Bool anyInf (const Array<T> &array)
+{
+  ArrayAnyKernel<T,casacore::IsInf<T> > kernel((casacore::IsInf<T>()));
+  arrayReduceChunks (array, kernel);
+  return kernel.result();
+}
+
+template<class T>
+Bool allFinite (const Array<T> &array)
+{
+  ArrayAllKernel<T,casacore::IsFinite<T> > kernel((casacore::IsFinite<T>()));
+  arrayReduceChunks (array, kernel);
+  return kernel.result();
+}
+
 template<class T>
 LogicalArray near (const Array<T> &l, const Array<T>& r, Double tol)
 {
@@ -713,9 +736,10 @@ template<class T> Bool anyNearAbs (const T &val, const Array<T> &array,
 
 template<class T> size_t nfalse (const Array<T> &array)
 {
-  return (array.contiguousStorage() ?
-          std::count (array.cbegin(), array.cend(), T()) :
-          std::count (array.begin(),  array.end(),  T()));
+  typedef ArrayCompareRight<T,std::equal_to<T> > Pred;
+  ArrayCountKernel<T,Pred> kernel((Pred(std::equal_to<T>(), T())));
+  arrayReduceChunks (array, kernel);
+  return kernel.count();
 }
 
 template<class T> Array<uInt> partialNTrue (const Array<T>& array,
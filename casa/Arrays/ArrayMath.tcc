@@ -36,6 +36,7 @@
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/Arrays/VectorIter.h>
 #include <casacore/casa/Arrays/ArrayError.h>
+#include <casacore/casa/Arrays/ArrayReduceKernels.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/BasicMath/ConvertScalar.h>
 #include <casacore/casa/Utilities/GenSort.h>
@@ -756,31 +757,10 @@ template<class T> void minMax(T &minVal, T &maxVal, const Array<T> &array)
     throw(ArrayError("void minMax(T &min, T &max, const Array<T> &array) - "
                      "Array has no elements"));	
   }
-  T minv = array.data()[0];
-  T maxv = minv;
-  if (array.contiguousStorage()) {
-    typename Array<T>::const_contiter iterEnd = array.cend();
-    for (typename Array<T>::const_contiter iter = array.cbegin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
-  } else {
-    typename Array<T>::const_iterator iterEnd = array.end();
-    for (typename Array<T>::const_iterator iter = array.begin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      } else if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
-  }
-  maxVal = maxv;
-  minVal = minv;
+  ArrayMinMaxKernel<T> kernel(array.data()[0]);
+  arrayReduceChunks (array, kernel);
+  maxVal = kernel.maxVal();
+  minVal = kernel.minVal();
 }
 
 // <thrown>
@@ -1041,9 +1021,9 @@ template<class T> Array<T> fmod(const Array<T> &a, const T &b)
 // </thrown>
 template<class T> T sum(const Array<T> &a)
 {
-  return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
-    std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
+  ArraySumKernel<T> kernel;
+  arrayReduceChunks (a, kernel);
+  return kernel.sum();
 }
 
 // <thrown>
@@ -0,0 +1,374 @@
+//# ArrayReduceKernels.h: Kernels for fast reductions of Arrays
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//# 
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//# 
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//# 
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//# 
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef CASA_ARRAYREDUCEKERNELS_H
+#define CASA_ARRAYREDUCEKERNELS_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <algorithm>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Kernels for fast reductions of Arrays.
+// </summary>
+// <reviewed reviewer="" date="" tests="tArrayMath,tArrayLogical">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// Reductions like <src>sum</src>, <src>minMax</src>, <src>allEQ</src>
+// and <src>ntrue</src> used to iterate through an array using its STL
+// iterators. Those loops cannot be vectorized by the compiler, in
+// particular not for non-contiguous arrays.
+// <br>The function <src>arrayReduceChunks</src> passes the array data to
+// a kernel in chunks: the entire data for a contiguous array, otherwise
+// each line along the first axis (which is usually contiguous).
+// The kernels process a chunk using plain pointers in a way that the
+// compiler can vectorize:
+// <ul>
+//  <li> Sums and min/max use multiple independent accumulators, which
+//       the compiler maps onto the lanes of a vector register.
+//       Note that it changes the order in which floating point values are
+//       added, so the result can differ in the last bits.
+//  <li> Logical reductions evaluate blocks of elements without branching
+//       and test for early exit only after each block.
+// </ul>
+// The kernels have the signature
+// <src>Bool operator() (const T* data, size_t n, ssize_t incr)</src>,
+// where <src>incr</src> is the step between the elements in the chunk.
+// They return False if the traversal can stop early.
+// </synopsis>
+//
+// <group name="Array reduction kernels">
+
+
+// Apply the kernel to the array data in chunks as described above.
+template<typename T, typename Kernel>
+inline void arrayReduceChunks (const Array<T>& arr, Kernel& kernel)
+{
+  if (arr.empty()) {
+    return;
+  }
+  if (arr.contiguousStorage()) {
+    kernel (arr.data(), arr.nelements(), 1);
+    return;
+  }
+  const IPosition& shape = arr.shape();
+  const IPosition& steps = arr.steps();
+  const uInt ndim = shape.size();
+  const size_t nlines = arr.nelements() / shape[0];
+  IPosition pos(ndim, 0);
+  const T* ptr = arr.data();
+  for (size_t i=0; i<nlines; ++i) {
+    if (! kernel (ptr, shape[0], steps[0])) {
+      return;
+    }
+    // Step to the start of the next line.
+    for (uInt ax=1; ax<ndim; ++ax) {
+      if (++pos[ax] < shape[ax]) {
+        ptr += steps[ax];
+        break;
+      }
+      ptr -= (shape[ax]-1) * steps[ax];
+      pos[ax] = 0;
+    }
+  }
+}
+
+// Sum the data using 8 accumulators.
+template<typename T>
+inline T arraySumChunk (const T* data, size_t n)
+{
+  T s[8];
+  for (uInt j=0; j<8; ++j) {
+    s[j] = T();
+  }
+  size_t i = 0;
+  for (; i+8<=n; i+=8) {
+    for (uInt j=0; j<8; ++j) {
+      s[j] += data[i+j];
+    }
+  }
+  T sum = ((s[0]+s[1]) + (s[2]+s[3])) + ((s[4]+s[5]) + (s[6]+s[7]));
+  for (; i<n; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+// Kernel to sum the elements.
+template<typename T> class ArraySumKernel
+{
+public:
+  ArraySumKernel()
+    : itsSum (T())
+    {}
+  Bool operator() (const T* data, size_t n, ssize_t incr)
+  {
+    if (incr == 1) {
+      itsSum += arraySumChunk (data, n);
+    } else {
+      for (size_t i=0; i<n; ++i) {
+        itsSum += data[i*incr];
+      }
+    }
+    return True;
+  }
+  const T& sum() const
+    { return itsSum; }
+private:
+  T itsSum;
+};
+
+// Kernel to find the minimum and maximum, starting with the given value.
+// As in the original implementation, a NaN is ignored unless it is the
+// starting value, in which case the result is NaN.
+template<typename T> class ArrayMinMaxKernel
+{
+public:
+  explicit ArrayMinMaxKernel (const T& start)
+    : itsMin (start), itsMax (start)
+    {}
+  Bool operator() (const T* data, size_t n, ssize_t incr)
+  {
+    size_t i = 0;
+    if (incr == 1  &&  n >= 8) {
+      T mn[8], mx[8];
+      for (uInt j=0; j<8; ++j) {
+        mn[j] = itsMin;
+        mx[j] = itsMax;
+      }
+      for (; i+8<=n; i+=8) {
+        for (uInt j=0; j<8; ++j) {
+          const T v = data[i+j];
+          mn[j] = (v < mn[j] ? v : mn[j]);
+          mx[j] = (v > mx[j] ? v : mx[j]);
+        }
+      }
+      for (uInt j=0; j<8; ++j) {
+        if (mn[j] < itsMin) itsMin = mn[j];
+        if (mx[j] > itsMax) itsMax = mx[j];
+      }
+    }
+    for (; i<n; ++i) {
+      const T v = data[i*incr];
+      if (v < itsMin) {
+        itsMin = v;
+      } else if (v > itsMax) {
+        itsMax = v;
+      }
+    }
+    return True;
+  }
+  const T& minVal() const
+    { return itsMin; }
+  const T& maxVal() const
+    { return itsMax; }
+private:
+  T itsMin;
+  T itsMax;
+};
+
+// Kernel testing if a predicate holds for all elements.
+// The elements are tested in blocks of 64 without branching.
+template<typename T, typename Predicate> class ArrayAllKernel
+{
+public:
+  explicit ArrayAllKernel (Predicate pred)
+    : itsPred (pred), itsResult (True)
+    {}
+  Bool operator() (const T* data, size_t n, ssize_t incr)
+  {
+    size_t i = 0;
+    while (i < n) {
+      const size_t end = std::min (n, i+64);
+      Bool ok = True;
+      if (incr == 1) {
+        for (; i<end; ++i) {
+          ok &= Bool(itsPred(data[i]));
+        }
+      } else {
+        for (; i<end; ++i) {
+          ok &= Bool(itsPred(data[i*incr]));
+        }
+      }
+      if (!ok) {
+        itsResult = False;
+        return False;
+      }
+    }
+    return True;
+  }
+  Bool result() const
+    { return itsResult; }
+private:
+  Predicate itsPred;
+  Bool      itsResult;
+};
+
+// Kernel testing if a predicate holds for any element.
+// The elements are tested in blocks of 64 without branching.
+template<typename T, typename Predicate> class ArrayAnyKernel
+{
+public:
+  explicit ArrayAnyKernel (Predicate pred)
+    : itsPred (pred), itsResult (False)
+    {}
+  Bool operator() (const T* data, size_t n, ssize_t incr)
+  {
+    size_t i = 0;
+    while (i < n) {
+      const size_t end = std::min (n, i+64);
+      Bool any = False;
+      if (incr == 1) {
+        for (; i<end; ++i) {
+          any |= Bool(itsPred(data[i]));
+        }
+      } else {
+        for (; i<end; ++i) {
+          any |= Bool(itsPred(data[i*incr]));
+        }
+      }
+      if (any) {
+        itsResult = True;
+        return False;
+      }
+    }
+    return True;
+  }
+  Bool result() const
+    { return itsResult; }
+private:
+  Predicate itsPred;
+  Bool      itsResult;
+};
+
+// Kernel counting the elements for which a predicate holds.
+template<typename T, typename Predicate> class ArrayCountKernel
+{
+public:
+  explicit ArrayCountKernel (Predicate pred)
+    : itsPred (pred), itsCount (0)
+    {}
+  Bool operator() (const T* data, size_t n, ssize_t incr)
+  {
+    size_t count = 0;
+    if (incr == 1) {
+      for (size_t i=0; i<n; ++i) {
+        count += (itsPred(data[i]) ? 1 : 0);
+      }
+    } else {
+      for (size_t i=0; i<n; ++i) {
+        count += (itsPred(data[i*incr]) ? 1 : 0);
+      }
+    }
+    itsCount += count;
+    return True;
+  }
+  size_t count() const
+    { return itsCount; }
+private:
+  Predicate itsPred;
+  size_t    itsCount;
+};
+
+// Predicates comparing an element with a scalar using a binary
+// compare operator (<src>op(element,scalar)</src> and
+// <src>op(scalar,element)</src>).
+// <group>
+template<typename T, typename CompareOperator> class ArrayCompareRight
+{
+public:
+  ArrayCompareRight (CompareOperator op, const T& right)
+    : itsOp (op), itsRight (right)
+    {}
+  Bool operator() (const T& left) const
+    { return itsOp (left, itsRight); }
+private:
+  CompareOperator itsOp;
+  T               itsRight;
+};
+template<typename T, typename CompareOperator> class ArrayCompareLeft
+{
+public:
+  ArrayCompareLeft (CompareOperator op, const T& left)
+    : itsOp (op), itsLeft (left)
+    {}
+  Bool operator() (const T& right) const
+    { return itsOp (itsLeft, right); }
+private:
+  CompareOperator itsOp;
+  T               itsLeft;
+};
+// </group>
+
+// Test if the compare operator holds for all or any pair of elements in
+// two contiguous data blocks. The elements are tested in blocks of 64
+// without branching.
+// <group>
+template<typename T, typename CompareOperator>
+inline Bool arrayCompareAllChunk (const T* left, const T* right, size_t n,
+                                  CompareOperator op)
+{
+  size_t i = 0;
+  while (i < n) {
+    const size_t end = std::min (n, i+64);
+    Bool ok = True;
+    for (; i<end; ++i) {
+      ok &= Bool(op(left[i], right[i]));
+    }
+    if (!ok) return False;
+  }
+  return True;
+}
+template<typename T, typename CompareOperator>
+inline Bool arrayCompareAnyChunk (const T* left, const T* right, size_t n,
+                                  CompareOperator op)
+{
+  size_t i = 0;
+  while (i < n) {
+    const size_t end = std::min (n, i+64);
+    Bool any = False;
+    for (; i<end; ++i) {
+      any |= Bool(op(left[i], right[i]));
+    }
+    if (any) return True;
+  }
+  return False;
+}
+// </group>
+
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,357 @@
+//# FixedArray.h: Fixed-size vector and matrix with stack storage
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//# 
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//# 
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//# 
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//# 
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef CASA_FIXEDARRAY_H
+#define CASA_FIXEDARRAY_H
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayError.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Fixed-size vector with stack storage.
+// </summary>
+// <use visibility=export>
+// <reviewed reviewer="" date="" tests="tFixedArray">
+// </reviewed>
+//
+// <prerequisite>
+//   <li> <linkto class=Vector>Vector</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// A <linkto class=Vector>Vector</linkto> always keeps its data on the
+// heap, which makes it relatively expensive for tiny quantities like
+// 2-element directions, 3-element positions or 4-element correlations.
+// FixedVector has a length defined at compile time and keeps its data
+// inside the object, so creating one does not allocate memory.
+// <br>It offers element access, some simple arithmetic and conversions
+// to and from Arrays:
+// <ul>
+//  <li> It can be constructed from and assigned from an Array with the
+//       correct number of elements (of any shape and strides).
+//  <li> <src>vector()</src> returns a copy as a Vector.
+//  <li> <src>view()</src> returns a Vector referencing the data of the
+//       FixedVector, so it can be passed to functions taking a Vector
+//       without copying. The view must not be used after the FixedVector
+//       has been destructed.
+// </ul>
+// Unlike Vector, the default constructor initializes the elements with
+// their default value.
+// <br>The scimath module contains the similar class RigidVector, which
+// has more arithmetic, but cannot be used in the casa module.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   FixedVector<Double,3> pos(0.);
+//   pos[2] = 1;
+//   Vector<Double> v(pos.view());    // shares the data of pos
+//   v[0] = 2;                        // pos[0] is 2 now
+// </srcblock>
+// </example>
+
+template<typename T, uInt N> class FixedVector
+{
+public:
+  // Create with all elements set to their default value.
+  FixedVector()
+    { *this = T(); }
+
+  // Create with all elements set to the given value.
+  explicit FixedVector (const T& value)
+    { *this = value; }
+
+  // Create from a C-array containing N values.
+  explicit FixedVector (const T* values)
+    { for (uInt i=0; i<N; ++i) itsData[i] = values[i]; }
+
+  // Create from an Array, which must contain N elements.
+  // An ArrayConformanceError is thrown otherwise.
+  explicit FixedVector (const Array<T>& arr)
+    { *this = arr; }
+
+  // Set all elements to the given value.
+  FixedVector<T,N>& operator= (const T& value)
+  {
+    for (uInt i=0; i<N; ++i) itsData[i] = value;
+    return *this;
+  }
+
+  // Copy the values of an Array, which must contain N elements.
+  // An ArrayConformanceError is thrown otherwise.
+  FixedVector<T,N>& operator= (const Array<T>& arr)
+  {
+    if (arr.nelements() != N) {
+      throw ArrayConformanceError ("FixedVector: Array has an incorrect "
+                                   "number of elements");
+    }
+    uInt i = 0;
+    for (typename Array<T>::const_iterator iter=arr.begin();
+         iter!=arr.end(); ++iter) {
+      itsData[i++] = *iter;
+    }
+    return *this;
+  }
+
+  // Get the number of elements.
+  // <group>
+  static uInt size()
+    { return N; }
+  static uInt nelements()
+    { return N; }
+  // </group>
+
+  // Access an element. No bounds checking is done.
+  // <group>
+  T& operator[] (uInt i)
+    { return itsData[i]; }
+  const T& operator[] (uInt i) const
+    { return itsData[i]; }
+  T& operator() (uInt i)
+    { return itsData[i]; }
+  const T& operator() (uInt i) const
+    { return itsData[i]; }
+  // </group>
+
+  // Get a pointer to the data.
+  // <group>
+  T* data()
+    { return itsData; }
+  const T* data() const
+    { return itsData; }
+  // </group>
+
+  // Elementwise arithmetic.
+  // <group>
+  FixedVector<T,N>& operator+= (const FixedVector<T,N>& other)
+    { for (uInt i=0; i<N; ++i) itsData[i] += other.itsData[i]; return *this; }
+  FixedVector<T,N>& operator-= (const FixedVector<T,N>& other)
+    { for (uInt i=0; i<N; ++i) itsData[i] -= other.itsData[i]; return *this; }
+  FixedVector<T,N>& operator*= (const T& value)
+    { for (uInt i=0; i<N; ++i) itsData[i] *= value; return *this; }
+  FixedVector<T,N>& operator/= (const T& value)
+    { for (uInt i=0; i<N; ++i) itsData[i] /= value; return *this; }
+  // </group>
+
+  // Get the inner product.
+  T inner (const FixedVector<T,N>& other) const
+  {
+    T sum = T();
+    for (uInt i=0; i<N; ++i) sum += itsData[i] * other.itsData[i];
+    return sum;
+  }
+
+  // Get a copy as a Vector.
+  Vector<T> vector() const
+    { return Vector<T> (IPosition(1,N), itsData); }
+
+  // Get a Vector referencing the data.
+  // <group>
+  Vector<T> view()
+    { return Vector<T> (IPosition(1,N), itsData, SHARE); }
+  const Vector<T> view() const
+    { return Vector<T> (IPosition(1,N), const_cast<T*>(itsData), SHARE); }
+  // </group>
+
+private:
+  T itsData[N];
+};
+
+
+// <summary>
+// Fixed-size matrix with stack storage.
+// </summary>
+// <use visibility=export>
+// <reviewed reviewer="" date="" tests="tFixedArray">
+// </reviewed>
+//
+// <synopsis>
+// FixedMatrix is the matrix counterpart of
+// <linkto class=FixedVector>FixedVector</linkto>. Its shape is defined at
+// compile time and its data is kept in the object. Like
+// <linkto class=Matrix>Matrix</linkto> the data is stored in column-major
+// order, so <src>view()</src> can return a Matrix referencing the data.
+// <br>Matrix-vector and matrix-matrix products are defined for matching
+// shapes.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   FixedMatrix<Complex,2,2> jones(Complex(0.));
+//   jones(0,0) = jones(1,1) = Complex(1.);
+//   FixedVector<Complex,2> e(Complex(1.,1.));
+//   FixedVector<Complex,2> res = jones * e;
+// </srcblock>
+// </example>
+
+template<typename T, uInt NROW, uInt NCOL> class FixedMatrix
+{
+public:
+  // Create with all elements set to their default value.
+  FixedMatrix()
+    { *this = T(); }
+
+  // Create with all elements set to the given value.
+  explicit FixedMatrix (const T& value)
+    { *this = value; }
+
+  // Create from an Array, which must have shape [NROW,NCOL].
+  // An ArrayConformanceError is thrown otherwise.
+  explicit FixedMatrix (const Array<T>& arr)
+    { *this = arr; }
+
+  // Set all elements to the given value.
+  FixedMatrix<T,NROW,NCOL>& operator= (const T& value)
+  {
+    for (uInt i=0; i<NROW*NCOL; ++i) itsData[i] = value;
+    return *this;
+  }
+
+  // Copy the values of an Array, which must have shape [NROW,NCOL].
+  // An ArrayConformanceError is thrown otherwise.
+  FixedMatrix<T,NROW,NCOL>& operator= (const Array<T>& arr)
+  {
+    if (! arr.shape().isEqual (IPosition(2,NROW,NCOL))) {
+      throw ArrayConformanceError ("FixedMatrix: Array has an incorrect "
+                                   "shape");
+    }
+    uInt i = 0;
+    for (typename Array<T>::const_iterator iter=arr.begin();
+         iter!=arr.end(); ++iter) {
+      itsData[i++] = *iter;
+    }
+    return *this;
+  }
+
+  // Get the shape.
+  // <group>
+  static uInt nrow()
+    { return NROW; }
+  static uInt ncolumn()
+    { return NCOL; }
+  static uInt nelements()
+    { return NROW*NCOL; }
+  // </group>
+
+  // Access an element. No bounds checking is done.
+  // <group>
+  T& operator() (uInt i, uInt j)
+    { return itsData[i + j*NROW]; }
+  const T& operator() (uInt i, uInt j) const
+    { return itsData[i + j*NROW]; }
+  // </group>
+
+  // Get a pointer to the data.
+  // <group>
+  T* data()
+    { return itsData; }
+  const T* data() const
+    { return itsData; }
+  // </group>
+
+  // Set the matrix to the identity matrix (zero if not square).
+  void setIdentity()
+  {
+    *this = T();
+    for (uInt i=0; i<NROW  &&  i<NCOL; ++i) (*this)(i,i) = T(1);
+  }
+
+  // Elementwise arithmetic.
+  // <group>
+  FixedMatrix<T,NROW,NCOL>& operator+= (const FixedMatrix<T,NROW,NCOL>& other)
+    { for (uInt i=0; i<NROW*NCOL; ++i) itsData[i] += other.itsData[i];
+      return *this; }
+  FixedMatrix<T,NROW,NCOL>& operator-= (const FixedMatrix<T,NROW,NCOL>& other)
+    { for (uInt i=0; i<NROW*NCOL; ++i) itsData[i] -= other.itsData[i];
+      return *this; }
+  FixedMatrix<T,NROW,NCOL>& operator*= (const T& value)
+    { for (uInt i=0; i<NROW*NCOL; ++i) itsData[i] *= value; return *this; }
+  // </group>
+
+  // Get the transpose.
+  FixedMatrix<T,NCOL,NROW> transpose() const
+  {
+    FixedMatrix<T,NCOL,NROW> res;
+    for (uInt j=0; j<NCOL; ++j) {
+      for (uInt i=0; i<NROW; ++i) res(j,i) = (*this)(i,j);
+    }
+    return res;
+  }
+
+  // Get a copy as a Matrix.
+  Matrix<T> matrix() const
+    { return Matrix<T> (IPosition(2,NROW,NCOL), itsData); }
+
+  // Get a Matrix referencing the data.
+  // <group>
+  Matrix<T> view()
+    { return Matrix<T> (IPosition(2,NROW,NCOL), itsData, SHARE); }
+  const Matrix<T> view() const
+    { return Matrix<T> (IPosition(2,NROW,NCOL), const_cast<T*>(itsData),
+                        SHARE); }
+  // </group>
+
+private:
+  T itsData[NROW*NCOL];
+};
+
+
+// Matrix-vector and matrix-matrix product.
+// <group name=FixedArray product>
+template<typename T, uInt NROW, uInt NCOL>
+inline FixedVector<T,NROW> operator* (const FixedMatrix<T,NROW,NCOL>& left,
+                                      const FixedVector<T,NCOL>& right)
+{
+  FixedVector<T,NROW> res;
+  for (uInt j=0; j<NCOL; ++j) {
+    for (uInt i=0; i<NROW; ++i) res[i] += left(i,j) * right[j];
+  }
+  return res;
+}
+template<typename T, uInt NROW, uInt NK, uInt NCOL>
+inline FixedMatrix<T,NROW,NCOL> operator* (const FixedMatrix<T,NROW,NK>& left,
+                                           const FixedMatrix<T,NK,NCOL>& right)
+{
+  FixedMatrix<T,NROW,NCOL> res;
+  for (uInt j=0; j<NCOL; ++j) {
+    for (uInt k=0; k<NK; ++k) {
+      for (uInt i=0; i<NROW; ++i) res(i,j) += left(i,k) * right(k,j);
+    }
+  }
+  return res;
+}
+// </group>
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
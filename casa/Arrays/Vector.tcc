@@ -198,7 +198,7 @@ template<class T> Vector<T> &Vector<T>::operator=(const Vector<T> &other)
     if (this != &other) {
         if (! this->copyVectorHelper (other)) {
 	    // Block was empty, so allocate new block.
-	    this->data_p  = new Block<T> (this->length_p(0));
+	    this->data_p  = this->newBlock (this->length_p(0));
 	    this->begin_p = this->data_p->storage();
 	}
 	this->setEndIter();
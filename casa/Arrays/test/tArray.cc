@@ -218,6 +218,7 @@ void oldArrayTest()
 	    AlwaysAssertExit(x(i) == 5);
 	Vector<Int> y(x);
 	AlwaysAssertExit(x.nrefs() == y.nrefs() && x.nrefs() > 1);
+	AlwaysAssertExit(!x.ownsData() && !y.ownsData());
 	for (Int i=0; i < 10; i++)
 	    AlwaysAssertExit(y(i) == 5);
 	Vector<Int> z(x.copy());
@@ -1003,6 +1004,35 @@ void testRowColDiag()
 }
 
 
+void testPoolScope()
+{
+  MemoryPool::releaseFree();
+  Vector<String> outside;
+  {
+    MemoryPoolScope scope;
+    for (uInt i=0; i<100; ++i) {
+      Matrix<Complex> jones(2, 2, Complex(i, 1));
+      Vector<Double> corr(4);
+      indgen (corr);
+      corr.resize (6, True);
+      AlwaysAssertExit (corr[3] == 3);
+      AlwaysAssertExit (jones(1,1) == Complex(i,1));
+    }
+    // An array allocated in the scope can outlive it.
+    outside.resize (3);
+    outside = "abc";
+    MemoryPool::Statistics stats = scope.statistics();
+    AlwaysAssertExit (stats.nmisses <= 4);
+    AlwaysAssertExit (stats.nhits >= 3*100-4);
+  }
+  AlwaysAssertExit (MemoryPool::nfree() == 0);
+  AlwaysAssertExit (allEQ (outside, String("abc")));
+  // Outside a scope the pool is not used.
+  MemoryPool::resetStatistics();
+  Vector<Double> v(4);
+  AlwaysAssertExit (MemoryPool::statistics().nmisses == 0);
+}
+
 int main()
 {
     try {
@@ -1064,6 +1094,7 @@ int main()
 	  ai2 = 11;
 	  AlwaysAssertExit(ip[0] == 0 && ip[99] == 99 && 
 			   ai(IPosition(2,4,19)) == 99 && allEQ(ai2, 11));
+	  AlwaysAssertExit(!ai.ownsData() && ai2.ownsData());
 	  Vector<Int> vi(IPosition(1, 100), ip, SHARE);
 	  Matrix<Int> mi(IPosition(2, 10, 10), ip, SHARE);
 	  Cube<Int> ci(IPosition(3, 4, 5, 5), ip, SHARE);
@@ -1278,6 +1309,7 @@ int main()
         }
 
         testReformOrResize();
+        testPoolScope();
 
     } catch (const AipsError& x) {
 	cout << "\nCaught an exception: " << x.getMesg() << endl;
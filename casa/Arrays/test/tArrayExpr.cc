@@ -0,0 +1,169 @@
+//# tArrayExpr.cc: Test program for lazy array expressions
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+//# Includes
+#include <casacore/casa/Arrays/ArrayExpr.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayError.h>
+#include <casacore/casa/BasicMath/Functors.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+using namespace casacore;
+
+// Compare lazy expressions with the normal array operators.
+void testOperators()
+{
+  IPosition shape(3,4,5,6);
+  Cube<Double> a(shape), b(shape), c(shape), d(shape);
+  indgen (a, 1.);
+  indgen (b, 2., 0.5);
+  indgen (c, -3.);
+  indgen (d, 4., 2.);
+  Cube<Double> res(lazy(a)*b + lazy(c)*d);
+  AlwaysAssertExit (allNear (res, a*b + c*d, 1e-13));
+  res = lazy(a) - b/lazy(d);
+  AlwaysAssertExit (allNear (res, a - b/d, 1e-13));
+  res = 2. * (lazy(a) + 3.) / (-lazy(b)) - 1.;
+  AlwaysAssertExit (allNear (res, 2. * (a + 3.) / (-b) - 1., 1e-13));
+  res = 10. - lazy(a) * 0.5;
+  AlwaysAssertExit (allNear (res, 10. - a * 0.5, 1e-13));
+  // Evaluate into an existing array, which can also be an operand.
+  Cube<Double> res2(shape);
+  Double* ptr = res2.data();
+  evaluate (res2, lazy(a) + b);
+  AlwaysAssertExit (res2.data() == ptr);
+  AlwaysAssertExit (allNear (res2, a + b, 1e-13));
+  evaluate (res2, lazy(res2) * c - res2);
+  AlwaysAssertExit (allNear (res2, (a+b)*c - (a+b), 1e-13));
+  // An empty array gets resized.
+  Array<Double> res3;
+  evaluate (res3, lazy(a) * 2.);
+  AlwaysAssertExit (res3.shape() == shape);
+  AlwaysAssertExit (allNear (res3, a * 2., 1e-13));
+  // Functors.
+  Cube<Double> res4(lazyTransform (lazy(a) - 100., Abs<Double>()));
+  AlwaysAssertExit (allNear (res4, abs(a - 100.), 1e-13));
+  res4 = lazyTransform (lazy(a), lazy(b), Pow<Double>());
+  AlwaysAssertExit (allNear (res4, pow(a, b), 1e-13));
+}
+
+// Test non-contiguous arrays.
+void testSections()
+{
+  Matrix<Float> a(10,12), b(10,12);
+  indgen (a);
+  indgen (b, 5.f);
+  Matrix<Float> as = a(Slice(1,4,2), Slice(2,5));
+  Matrix<Float> bs = b(Slice(0,4,3), Slice(0,5,2));
+  Matrix<Float> res(lazy(as) * bs + 1.f);
+  AlwaysAssertExit (allEQ (res, as * bs + 1.f));
+  // Evaluate into a section.
+  Matrix<Float> exp = as + bs;
+  evaluate (as, lazy(as) + bs);
+  AlwaysAssertExit (allEQ (as, exp));
+  AlwaysAssertExit (allEQ (a(Slice(1,4,2), Slice(2,5)), exp));
+}
+
+// Test complex values and vectors.
+void testComplex()
+{
+  Vector<Complex> a(100), b(100);
+  for (uInt i=0; i<100; ++i) {
+    a[i] = Complex(i, -1.5*i);
+    b[i] = Complex(0.5, i);
+  }
+  Vector<Complex> res(lazy(a) * b - Complex(1,2));
+  AlwaysAssertExit (allNear (res, a * b - Complex(1,2), 1e-6));
+  Vector<Float> amp(lazyTransform (lazy(a) * b, Abs<Complex,Float>()));
+  AlwaysAssertExit (allNear (amp, amplitude(a * b), 1e-6));
+}
+
+// Check that non-conforming arrays are detected.
+void testErrors()
+{
+  Vector<Int> a(10), b(11);
+  Bool failed = False;
+  try {
+    Vector<Int> res(lazy(a) + b);
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // A vector cannot be resized to another dimensionality.
+  failed = False;
+  try {
+    Vector<Int> res;
+    evaluate (res, lazy(Matrix<Int>(2,3,0)) * 2);
+  } catch (ArrayError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+// Compare the timings of lazy and normal evaluation.
+void testPerf()
+{
+  IPosition shape(3,100,100,100);
+  Cube<Float> a(shape), b(shape), c(shape), d(shape), res(shape);
+  indgen(a);
+  b = 2.f;
+  c = 3.f;
+  d = 4.f;
+  Timer timer;
+  res = a*b + c*d;
+  timer.show ("normal");
+  timer.mark();
+  evaluate (res, lazy(a)*b + lazy(c)*d);
+  timer.show ("lazy  ");
+  AlwaysAssertExit (allEQ (res, a*b + c*d));
+}
+
+int main (int argc, char*[])
+{
+  try {
+    testOperators();
+    testSections();
+    testComplex();
+    testErrors();
+    if (argc > 1) {
+      testPerf();
+    }
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
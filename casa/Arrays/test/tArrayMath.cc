@@ -30,6 +30,7 @@
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
@@ -489,6 +490,121 @@ TestComplex(real, real, testDComplexReal, DComplex, Double)
 TestComplex(imag, imag, testDComplexImag, DComplex, Double)
 TestComplex(conj, conj, testDComplexConj, DComplex, DComplex)
 
+// Check the reductions against simple loops using the array iterators,
+// both for contiguous arrays and for strided sections.
+template<typename T>
+void checkReduce (const Array<T>& arr)
+{
+  T expSum = T();
+  T expMin = *arr.begin();
+  T expMax = expMin;
+  for (typename Array<T>::const_iterator iter=arr.begin();
+       iter!=arr.end(); ++iter) {
+    expSum += *iter;
+    if (*iter < expMin) expMin = *iter;
+    if (*iter > expMax) expMax = *iter;
+  }
+  AlwaysAssertExit (near (sum(arr), expSum, 1e-5));
+  T minv, maxv;
+  minMax (minv, maxv, arr);
+  AlwaysAssertExit (minv == expMin  &&  maxv == expMax);
+  AlwaysAssertExit (min(arr) == expMin  &&  max(arr) == expMax);
+  AlwaysAssertExit (allLE (arr, expMax)  &&  allGE (expMax, arr));
+  AlwaysAssertExit (!allLT (arr, expMax)  &&  !allGT (expMax, arr));
+  AlwaysAssertExit (anyEQ (arr, expMin)  &&  anyEQ (expMax, arr));
+  AlwaysAssertExit (!anyGT (arr, expMax)  &&  !anyLT (expMax, arr));
+  AlwaysAssertExit (allEQ (arr, arr.copy())  &&  !anyNE (arr.copy(), arr));
+}
+
+template<typename T>
+void testReduce()
+{
+  // Use odd lengths, so the remainders of the kernels are used as well.
+  Array<T> arr(IPosition(4,37,5,3,4));
+  indgen (arr, T(-100), T(0.5));
+  arr.data()[arr.size()-3] = T(1000);
+  arr.data()[57] = T(-1000);
+  checkReduce (arr);
+  Array<T> sect1 (arr(IPosition(4,1,1,0,1), IPosition(4,35,4,2,3)));
+  checkReduce (sect1);
+  Array<T> sect2 (arr(IPosition(4,2,0,0,0), IPosition(4,35,4,2,3),
+                      IPosition(4,3,2,1,2)));
+  checkReduce (sect2);
+  checkReduce (Array<T>(IPosition(1,1), T(2)));
+  // Sum of a large array.
+  Array<T> large(IPosition(2,1001,13), T(1));
+  AlwaysAssertExit (near (sum(large), T(1001*13), 1e-5));
+  AlwaysAssertExit (near (sum(large(IPosition(2,0,0), IPosition(2,1000,12),
+                                    IPosition(2,1,2))), T(1001*7), 1e-5));
+  // Empty array.
+  AlwaysAssertExit (sum(Array<T>()) == T());
+  AlwaysAssertExit (allEQ (Array<T>(), T(1))  &&  !anyEQ (Array<T>(), T(1)));
+}
+
+template<typename T>
+void testReduceNaN()
+{
+  Array<T> arr(IPosition(2,43,3));
+  indgen (arr);
+  Array<T> sect (arr(IPosition(2,0,0), IPosition(2,42,2), IPosition(2,1,2)));
+  AlwaysAssertExit (!anyNaN (arr)  &&  !anyInf (arr)  &&  allFinite (arr));
+  T nan;
+  setNaN (nan);
+  arr(IPosition(2,10,2)) = nan;
+  AlwaysAssertExit (anyNaN (arr)  &&  anyNaN (sect));
+  AlwaysAssertExit (!allFinite (arr)  &&  !anyInf (arr));
+  // A NaN is ignored by minMax unless it is the first element.
+  T minv, maxv;
+  minMax (minv, maxv, sect);
+  AlwaysAssertExit (minv == 0  &&  maxv == 3*43-1);
+  arr(IPosition(2,0,0)) = nan;
+  minMax (minv, maxv, sect);
+  AlwaysAssertExit (isNaN(minv)  &&  isNaN(maxv));
+  indgen (arr);
+  T inf;
+  setInf (inf);
+  arr(IPosition(2,42,0)) = -inf;
+  AlwaysAssertExit (anyInf (arr)  &&  anyInf (sect)  &&  !anyNaN (sect));
+  AlwaysAssertExit (min(sect) == -inf);
+}
+
+void testReduceBool()
+{
+  Array<Bool> arr(IPosition(3,67,3,5), True);
+  Array<Bool> sect (arr(IPosition(3,0,0,0), IPosition(3,66,2,4),
+                        IPosition(3,1,2,2)));
+  AlwaysAssertExit (allTrue (arr)  &&  allTrue (sect));
+  AlwaysAssertExit (ntrue (arr) == arr.size()  &&  nfalse (sect) == 0);
+  arr(IPosition(3,65,0,4)) = False;
+  arr(IPosition(3,3,1,4)) = False;
+  AlwaysAssertExit (!allTrue (arr)  &&  !allTrue (sect)  &&  anyTrue (sect));
+  AlwaysAssertExit (nfalse (arr) == 2  &&  nfalse (sect) == 1);
+  AlwaysAssertExit (ntrue (sect) == sect.size() - 1);
+  arr = False;
+  AlwaysAssertExit (!anyTrue (arr)  &&  !anyTrue (sect));
+  AlwaysAssertExit (ntrue (arr) == 0);
+}
+
+void testReduceComplex()
+{
+  Array<Complex> arr(IPosition(2,21,4));
+  for (uInt i=0; i<arr.size(); ++i) {
+    arr.data()[i] = Complex(i, -Float(i));
+  }
+  Array<Complex> sect (arr(IPosition(2,1,1), IPosition(2,19,3)));
+  Complex expSum;
+  for (Array<Complex>::const_iterator iter=sect.begin();
+       iter!=sect.end(); ++iter) {
+    expSum += *iter;
+  }
+  AlwaysAssertExit (near (sum(sect), expSum, 1e-5));
+  AlwaysAssertExit (near (mean(sect), expSum/Float(sect.size()), 1e-5));
+  AlwaysAssertExit (allEQ (sect, sect.copy())  &&  anyEQ (sect, Complex(22,-22)));
+  AlwaysAssertExit (!anyNaN (sect)  &&  allFinite (sect));
+  sect(IPosition(2,5,1)) = Complex(floatNaN(), 0);
+  AlwaysAssertExit (anyNaN (arr)  &&  anyNaN (sect));
+}
+
 int main()
 {
   try {
@@ -563,6 +679,13 @@ int main()
     testMakeComplex<Float,Complex>();
     testMakeComplex<Double,DComplex>();
     testMinMax1();
+    testReduce<Float>();
+    testReduce<Double>();
+    testReduce<Int>();
+    testReduceNaN<Float>();
+    testReduceNaN<Double>();
+    testReduceBool();
+    testReduceComplex();
   } catch (AipsError x) {
     cout << "Unexpected exception: " << x.getMesg() << endl;
     return 1;
@@ -0,0 +1,122 @@
+//# tFixedArray.cc: Test program for FixedVector and FixedMatrix
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casacore/casa/Arrays/FixedArray.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+void testVector()
+{
+  FixedVector<Double,3> v1;
+  AlwaysAssertExit (v1.size() == 3  &&  v1[0] == 0  &&  v1[2] == 0);
+  FixedVector<Double,3> v2(2.);
+  v2(1) = 3;
+  v1 += v2;
+  v1 *= 2.;
+  AlwaysAssertExit (v1[0] == 4  &&  v1[1] == 6  &&  v1[2] == 4);
+  AlwaysAssertExit (v1.inner(v2) == 4*2+6*3+4*2);
+  // Conversion to and from Vector.
+  Vector<Double> vec(v1.vector());
+  AlwaysAssertExit (vec[0] == 4  &&  vec[1] == 6  &&  vec[2] == 4);
+  vec[0] = 10;
+  AlwaysAssertExit (v1[0] == 4);
+  Vector<Double> view(v1.view());
+  view[0] = 10;
+  AlwaysAssertExit (v1[0] == 10);
+  AlwaysAssertExit (sum(view) == 20);
+  // From a strided section.
+  Vector<Double> arr(7);
+  indgen (arr);
+  FixedVector<Double,3> v3(arr(Slice(1,3,2)));
+  AlwaysAssertExit (v3[0] == 1  &&  v3[1] == 3  &&  v3[2] == 5);
+  Bool failed = False;
+  try {
+    v3 = arr;
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testMatrix()
+{
+  FixedMatrix<Complex,2,2> jones;
+  jones.setIdentity();
+  jones(0,1) = Complex(0,1);
+  FixedVector<Complex,2> e(Complex(1,1));
+  FixedVector<Complex,2> res = jones * e;
+  AlwaysAssertExit (res[0] == Complex(1,1) + Complex(0,1)*Complex(1,1));
+  AlwaysAssertExit (res[1] == Complex(1,1));
+  // Compare products with Matrix.
+  FixedMatrix<Double,2,3> a;
+  FixedMatrix<Double,3,4> b;
+  for (uInt j=0; j<3; ++j) {
+    for (uInt i=0; i<2; ++i) a(i,j) = i+2*j+1;
+    for (uInt i=0; i<4; ++i) b(j,i) = 3*i-j;
+  }
+  FixedMatrix<Double,2,4> c = a * b;
+  Matrix<Double> ma(a.view());
+  Matrix<Double> mb(b.matrix());
+  for (uInt j=0; j<4; ++j) {
+    for (uInt i=0; i<2; ++i) {
+      Double v = 0;
+      for (uInt k=0; k<3; ++k) v += ma(i,k) * mb(k,j);
+      AlwaysAssertExit (c(i,j) == v);
+    }
+  }
+  FixedMatrix<Double,4,2> ct = c.transpose();
+  AlwaysAssertExit (ct(3,1) == c(1,3));
+  AlwaysAssertExit (allEQ (FixedMatrix<Double,4,2>(ct.matrix()).view(),
+                           ct.view()));
+  Bool failed = False;
+  try {
+    FixedMatrix<Double,2,2> m(Matrix<Double>(2,3));
+  } catch (ArrayConformanceError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    testVector();
+    testMatrix();
+  } catch (AipsError& x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -27,10 +27,194 @@
 //# $Id$
 
 #include <casacore/casa/Containers/Allocator.h>
+#include <new>
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
 
 namespace casa {
 
 ArrayInitPolicy const ArrayInitPolicy::NO_INIT = ArrayInitPolicy(false);
 ArrayInitPolicy const ArrayInitPolicy::INIT = ArrayInitPolicy(true);
 
+namespace {
+  // The per-thread state of the MemoryPool.
+  struct MemoryPoolCache {
+    MemoryPoolCache()
+      : scopeDepth (0)
+    {
+      for (int i=0; i<MemoryPool::NSizeClass; ++i) {
+        freeList[i] = 0;
+        nfree[i]    = 0;
+      }
+    }
+    ~MemoryPoolCache()
+      { release(); }
+    void release()
+    {
+      for (int i=0; i<MemoryPool::NSizeClass; ++i) {
+        while (freeList[i]) {
+          void* next = *static_cast<void**>(freeList[i]);
+          free (freeList[i]);
+          freeList[i] = next;
+        }
+        nfree[i] = 0;
+      }
+    }
+    // The free blocks of a size class are linked through their first word.
+    void*  freeList[MemoryPool::NSizeClass];
+    uInt   nfree[MemoryPool::NSizeClass];
+    uInt   scopeDepth;
+    MemoryPool::Statistics stats;
+  };
+
+#ifdef USE_THREADS
+  pthread_key_t  theirCacheKey;
+  pthread_once_t theirCacheOnce = PTHREAD_ONCE_INIT;
+
+  extern "C" void deleteMemoryPoolCache (void* cache)
+    { delete static_cast<MemoryPoolCache*>(cache); }
+  extern "C" void makeMemoryPoolCacheKey()
+    { pthread_key_create (&theirCacheKey, deleteMemoryPoolCache); }
+
+  inline MemoryPoolCache& getCache()
+  {
+    pthread_once (&theirCacheOnce, makeMemoryPoolCacheKey);
+    MemoryPoolCache* cache =
+      static_cast<MemoryPoolCache*>(pthread_getspecific (theirCacheKey));
+    if (cache == 0) {
+      cache = new MemoryPoolCache();
+      pthread_setspecific (theirCacheKey, cache);
+    }
+    return *cache;
+  }
+#else
+  inline MemoryPoolCache& getCache()
+  {
+    static MemoryPoolCache cache;
+    return cache;
+  }
+#endif
+
+  // Get the size class of a block; -1 means not pooled.
+  inline int sizeClass (size_t nbytes)
+  {
+    if (nbytes > size_t(MemoryPool::MaxPooledSize)) {
+      return -1;
+    }
+    int cl = 0;
+    size_t size = MemoryPool::MinPooledSize;
+    while (size < nbytes) {
+      size += size;
+      ++cl;
+    }
+    return cl;
+  }
+}
+
+void* MemoryPool::allocate (size_t nbytes)
+{
+  MemoryPoolCache& cache = getCache();
+  int cl = sizeClass (nbytes);
+  void* ptr;
+  if (cl < 0) {
+    cache.stats.nlarge++;
+    ptr = malloc (nbytes);
+  } else if (cache.freeList[cl]) {
+    cache.stats.nhits++;
+    ptr = cache.freeList[cl];
+    cache.freeList[cl] = *static_cast<void**>(ptr);
+    cache.nfree[cl]--;
+  } else {
+    cache.stats.nmisses++;
+    ptr = malloc (size_t(MinPooledSize) << cl);
+  }
+  if (ptr == 0) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void MemoryPool::deallocate (void* ptr, size_t nbytes) throw()
+{
+  if (ptr == 0) {
+    return;
+  }
+  int cl = sizeClass (nbytes);
+  if (cl >= 0) {
+    MemoryPoolCache& cache = getCache();
+    if (cache.nfree[cl] < uInt(MaxFreePerClass)) {
+      *static_cast<void**>(ptr) = cache.freeList[cl];
+      cache.freeList[cl] = ptr;
+      cache.nfree[cl]++;
+      return;
+    }
+  }
+  free (ptr);
+}
+
+MemoryPool::Statistics MemoryPool::statistics()
+{
+  return getCache().stats;
+}
+
+void MemoryPool::resetStatistics()
+{
+  getCache().stats = Statistics();
+}
+
+size_t MemoryPool::nfree()
+{
+  MemoryPoolCache& cache = getCache();
+  size_t n = 0;
+  for (int i=0; i<NSizeClass; ++i) {
+    n += cache.nfree[i];
+  }
+  return n;
+}
+
+void MemoryPool::releaseFree()
+{
+  getCache().release();
+}
+
+Bool MemoryPool::inScope()
+{
+  return getCache().scopeDepth > 0;
+}
+
+void MemoryPool::enterScope()
+{
+  getCache().scopeDepth++;
+}
+
+void MemoryPool::leaveScope()
+{
+  MemoryPoolCache& cache = getCache();
+  if (--cache.scopeDepth == 0) {
+    cache.release();
+  }
+}
+
+
+MemoryPoolScope::MemoryPoolScope()
+  : itsStart (MemoryPool::statistics())
+{
+  MemoryPool::enterScope();
+}
+
+MemoryPoolScope::~MemoryPoolScope()
+{
+  MemoryPool::leaveScope();
+}
+
+MemoryPool::Statistics MemoryPoolScope::statistics() const
+{
+  MemoryPool::Statistics stats = MemoryPool::statistics();
+  stats.nhits   -= itsStart.nhits;
+  stats.nmisses -= itsStart.nmisses;
+  stats.nlarge  -= itsStart.nlarge;
+  return stats;
+}
+
 }
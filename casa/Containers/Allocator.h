@@ -178,6 +178,176 @@ inline bool operator!=(const casacore_allocator<T, ALIGNMENT>&,
   return false;
 }
 
+// <summary>
+// Thread-local pool of memory blocks in size classes.
+// </summary>
+// <synopsis>
+// MemoryPool keeps freed memory blocks of up to <src>MaxPooledSize</src>
+// bytes in per-thread free lists, one for each power-of-two size class.
+// An allocation is served from the free list of its size class if
+// possible (a hit); otherwise it is done by <src>malloc</src> (a miss).
+// Larger blocks are not pooled at all. Because the free lists are
+// thread-local, no locking is needed. A block can be freed by another
+// thread than the one that allocated it; it is then added to the free
+// list of the freeing thread.
+// <br>The statistics are kept per thread and can be used to judge if
+// pooling is effective.
+// <p>
+// Pooled memory is used by Blocks created with
+// <src>AllocSpec<PoolAllocator<T> >::value</src> and by Arrays created
+// while a <linkto class=MemoryPoolScope>MemoryPoolScope</linkto> is active.
+// </synopsis>
+class MemoryPool {
+public:
+  enum {
+    // The smallest size class (in bytes).
+    MinPooledSize = 16,
+    // The largest size class (in bytes).
+    MaxPooledSize = 4096,
+    // The number of size classes.
+    NSizeClass = 9,
+    // The maximum number of free blocks kept per size class.
+    MaxFreePerClass = 256
+  };
+
+  // Usage statistics of the pool of the current thread.
+  struct Statistics {
+    Statistics()
+      : nhits(0), nmisses(0), nlarge(0)
+      {}
+    // Number of allocations served from a free list.
+    uInt64 nhits;
+    // Number of pooled allocations done by malloc.
+    uInt64 nmisses;
+    // Number of allocations too large to be pooled.
+    uInt64 nlarge;
+  };
+
+  // Allocate or free a memory block of the given size.
+  // The size given to <src>deallocate</src> must match the size used
+  // when allocating the block.
+  // <group>
+  static void* allocate (size_t nbytes);
+  static void deallocate (void* ptr, size_t nbytes) throw();
+  // </group>
+
+  // Get or reset the statistics of the current thread.
+  // <group>
+  static Statistics statistics();
+  static void resetStatistics();
+  // </group>
+
+  // Get the number of free blocks kept by the current thread.
+  static size_t nfree();
+
+  // Free all blocks in the free lists of the current thread.
+  static void releaseFree();
+
+  // Is a MemoryPoolScope active in the current thread?
+  static Bool inScope();
+
+private:
+  friend class MemoryPoolScope;
+  static void enterScope();
+  static void leaveScope();
+};
+
+// <summary>
+// Scope in which Arrays are allocated from the thread's memory pool.
+// </summary>
+// <synopsis>
+// While a MemoryPoolScope object exists, the storage of Arrays (and
+// Vectors, Matrices, etc.) created by the current thread is allocated from
+// the <linkto class=MemoryPool>MemoryPool</linkto> of the thread.
+// It is meant to be opened around an inner loop creating many small
+// short-lived arrays, so the storage of an array freed in one iteration
+// is reused in the next iteration instead of going through malloc.
+// When the outermost scope ends, the free blocks of the thread are released.
+// Arrays allocated in the scope can safely outlive it; their storage is
+// returned to the pool when they are destructed.
+// <br>Scopes can be nested.
+// </synopsis>
+// <example>
+// <srcblock>
+// {
+//   MemoryPoolScope scope;
+//   for (uInt i=0; i<nrow; ++i) {
+//     Matrix<Complex> jones(2,2);
+//     ...
+//   }
+//   cout << scope.statistics().nhits << endl;
+// }
+// </srcblock>
+// </example>
+class MemoryPoolScope {
+public:
+  MemoryPoolScope();
+  ~MemoryPoolScope();
+
+  // Get the statistics of the pool since the scope was opened.
+  MemoryPool::Statistics statistics() const;
+
+private:
+  // Forbid copy and assignment.
+  MemoryPoolScope (const MemoryPoolScope&);
+  MemoryPoolScope& operator= (const MemoryPoolScope&);
+
+  MemoryPool::Statistics itsStart;
+};
+
+template<typename T>
+struct casacore_pool_allocator: public std11_allocator<T> {
+  typedef std11_allocator<T> Super;
+  typedef typename Super::size_type size_type;
+  typedef typename Super::difference_type difference_type;
+  typedef typename Super::pointer pointer;
+  typedef typename Super::const_pointer const_pointer;
+  typedef typename Super::reference reference;
+  typedef typename Super::const_reference const_reference;
+  typedef typename Super::value_type value_type;
+
+  template<typename TOther>
+  struct rebind {
+    typedef casacore_pool_allocator<TOther> other;
+  };
+  casacore_pool_allocator() throw () {
+  }
+
+  casacore_pool_allocator(const casacore_pool_allocator&other) noexcept
+  :Super(other) {
+  }
+
+  template<typename TOther>
+  casacore_pool_allocator(const casacore_pool_allocator<TOther>&) noexcept {
+  }
+
+  ~casacore_pool_allocator() noexcept {
+  }
+
+  pointer allocate(size_type elements, const void* = 0) {
+    if (elements > this->max_size()) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>(MemoryPool::allocate(sizeof(T) * elements));
+  }
+
+  void deallocate(pointer ptr, size_type elements) {
+    MemoryPool::deallocate(ptr, sizeof(T) * elements);
+  }
+};
+
+template<typename T>
+inline bool operator==(const casacore_pool_allocator<T>&,
+    const casacore_pool_allocator<T>&) {
+  return true;
+}
+
+template<typename T>
+inline bool operator!=(const casacore_pool_allocator<T>&,
+    const casacore_pool_allocator<T>&) {
+  return false;
+}
+
 template<typename T>
 struct new_del_allocator: public std11_allocator<T> {
   typedef std11_allocator<T> Super;
@@ -272,6 +442,14 @@ struct AlignedAllocator: BaseAllocator<T, AlignedAllocator<T, ALIGNMENT> > {
 template<typename T, size_t ALIGNMENT>
 AlignedAllocator<T, ALIGNMENT> AlignedAllocator<T, ALIGNMENT>::value;
 
+template<typename T>
+struct PoolAllocator: BaseAllocator<T, PoolAllocator<T> > {
+  typedef casacore_pool_allocator<T> type;
+  static PoolAllocator<T> value;
+};
+template<typename T>
+PoolAllocator<T> PoolAllocator<T>::value;
+
 // <summary>Allocator specifier</summary>
 // <synopsis>
 // This class is just used to avoid ambiguity between overloaded functions.
@@ -620,6 +620,10 @@ public:
   // Is the block empty (i.e. no elements)?
   Bool empty() const {return size() == 0;}
 
+  // Does the block own its storage, i.e. is the storage deleted by the
+  // block? It is False if the storage was given without taking it over.
+  Bool ownsStorage() const {return destroyPointer;}
+
   // Define the STL-style iterators.
   // It makes it possible to iterate through all data elements.
   // <srcblock>
@@ -157,6 +157,22 @@ public:
   const Record&         asRecord       () const;
   // </group>
 
+  // Get a reference to the array held, thus without copying it.
+  // Unlike the asArrayXXX functions, it does not convert the data.
+  // An exception is thrown if the value is not an array of type T.
+  // Note that uChar, Short and uShort arrays cannot be obtained this way,
+  // because they are held as Int arrays.
+  template<typename T> const Array<T>& asArrayRef() const
+    { return itsRep->asArrayRef<T>(); }
+
+  // Tell if this object is the only one referencing the array held and
+  // if that array is the only one referencing its data. Only then the data
+  // can be handed over to another owner without other objects seeing
+  // changes made by that owner.
+  // An exception is thrown if the value is not an array of type T.
+  template<typename T> Bool hasUniqueArray() const
+    { return itsRep.nrefs() == 1  &&  itsRep->asArrayRef<T>().nrefs() == 1; }
+
   // Get the data in a way useful for templates.
   // If possible, it converts the the data as needed.
   // <group>
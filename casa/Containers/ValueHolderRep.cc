@@ -986,6 +986,14 @@ const Record& ValueHolderRep::asRecord() const
   throw AipsError ("ValueHolderRep::asRecord - invalid data type");
 }
 
+void ValueHolderRep::checkArrayRef (DataType dtype) const
+{
+  if (dtype != itsType  ||  dtype == TpArrayUChar  ||
+      dtype == TpArrayShort  ||  dtype == TpArrayUShort) {
+    throw AipsError ("ValueHolderRep::asArrayRef - invalid data type");
+  }
+}
+
 
 void ValueHolderRep::toRecord (Record& rec, const RecordFieldId& id) const
 {
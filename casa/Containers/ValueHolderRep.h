@@ -134,6 +134,16 @@ public:
   const Record&         asRecord       () const;
   // </group>
 
+  // Get a reference to the array held, thus without copying it.
+  // An exception is thrown if the value is not an array of type T.
+  // Note that uChar, Short and uShort arrays cannot be obtained this way,
+  // because they are held as Int arrays.
+  template<typename T> const Array<T>& asArrayRef() const
+  {
+    checkArrayRef (whatType (static_cast<const Array<T>*>(0)));
+    return *static_cast<const Array<T>*>(itsPtr);
+  }
+
   // Put the value as a field in a record.
   void toRecord (Record&, const RecordFieldId&) const;
 
@@ -162,6 +172,9 @@ private:
   ValueHolderRep& operator= (const ValueHolderRep&);
   // </group>
 
+  // Check if the value is an array held with the given data type.
+  void checkArrayRef (DataType dtype) const;
+
 
   uInt     itsNdim;
   DataType itsType;
@@ -341,10 +341,69 @@ void testIO()
   }
 }
 
+void testPool()
+{
+  MemoryPool::releaseFree();
+  MemoryPool::resetStatistics();
+  {
+    // The first allocation is a miss; the second one reuses the block.
+    {
+      Block<Double> b1(4, AllocSpec<PoolAllocator<Double> >::value);
+      b1[3] = 1;
+    }
+    AlwaysAssertExit (MemoryPool::nfree() == 1);
+    Block<Double> b2(3, 2., AllocSpec<PoolAllocator<Double> >::value);
+    AlwaysAssertExit (b2[0] == 2  &&  b2[2] == 2);
+    MemoryPool::Statistics stats = MemoryPool::statistics();
+    AlwaysAssertExit (stats.nmisses == 1  &&  stats.nhits == 1);
+    AlwaysAssertExit (MemoryPool::nfree() == 0);
+    // Resizing uses the pool as well.
+    b2.resize (100, False, True);
+    AlwaysAssertExit (b2[0] == 2  &&  b2[2] == 2);
+    AlwaysAssertExit (MemoryPool::statistics().nmisses == 2);
+    AlwaysAssertExit (MemoryPool::nfree() == 1);
+    // Large blocks are not pooled.
+    Block<Double> b3(1000, AllocSpec<PoolAllocator<Double> >::value);
+    AlwaysAssertExit (MemoryPool::statistics().nlarge == 1);
+  }
+  AlwaysAssertExit (MemoryPool::nfree() == 2);
+  {
+    // Non-trivial types get constructed and destructed.
+    LifecycleChecker::clear();
+    {
+      Block<LifecycleChecker> b(10, AllocSpec<PoolAllocator<LifecycleChecker> >::value);
+    }
+    AlwaysAssertExit (LifecycleChecker::ctor_count == 10);
+    AlwaysAssertExit (LifecycleChecker::dtor_count == 10);
+  }
+  MemoryPool::releaseFree();
+  AlwaysAssertExit (MemoryPool::nfree() == 0);
+  {
+    // The scope statistics are relative to the start of the scope.
+    AlwaysAssertExit (! MemoryPool::inScope());
+    MemoryPoolScope scope;
+    AlwaysAssertExit (MemoryPool::inScope());
+    {
+      MemoryPoolScope scope2;
+    }
+    AlwaysAssertExit (MemoryPool::inScope());
+    for (uInt i=0; i<10; ++i) {
+      Block<Int> b(5, AllocSpec<PoolAllocator<Int> >::value);
+    }
+    AlwaysAssertExit (scope.statistics().nmisses == 1);
+    AlwaysAssertExit (scope.statistics().nhits == 9);
+    AlwaysAssertExit (MemoryPool::nfree() == 1);
+  }
+  // Leaving the outer scope releases the free blocks.
+  AlwaysAssertExit (! MemoryPool::inScope());
+  AlwaysAssertExit (MemoryPool::nfree() == 0);
+}
+
 int main()
 {
     doit();
     testIO();
+    testPool();
     cout << "OK\n";
     return 0;
 }
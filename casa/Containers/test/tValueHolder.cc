@@ -255,6 +255,45 @@ void doArrayDComplex (const Array<DComplex>& v)
   cout << vh << ' ' << vhc << endl;
 }
 
+void doArrayRef()
+{
+  // Getting an array by reference does not copy it.
+  Array<Int> arr(IPosition(2,3,4));
+  indgen (arr);
+  ValueHolder vh(arr);
+  const Array<Int>& ref = vh.asArrayRef<Int>();
+  AlwaysAssertExit (allEQ (ref, arr));
+  AlwaysAssertExit (ref.data() == vh.asArrayRef<Int>().data());
+  AlwaysAssertExit (ref.data() == vh.asArrayInt().data());
+  // The data are shared with arr, so they are not unique.
+  AlwaysAssertExit (! vh.hasUniqueArray<Int>());
+  ValueHolder vhu(Array<Int>(IPosition(1,5), 1));
+  AlwaysAssertExit (vhu.hasUniqueArray<Int>());
+  {
+    // A copy of the ValueHolder shares the array.
+    ValueHolder vhc(vhu);
+    AlwaysAssertExit (! vhu.hasUniqueArray<Int>());
+  }
+  AlwaysAssertExit (vhu.hasUniqueArray<Int>());
+  // It fails for another type (no conversion is done).
+  Bool failed = False;
+  try {
+    vh.asArrayRef<Int64>();
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // A Short array is held as an Int array.
+  ValueHolder vhs(Array<Short>(IPosition(1,2), Short(1)));
+  failed = False;
+  try {
+    vhs.asArrayRef<Short>();
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
 void doArrayString (const Array<String>& v)
 {
   ValueHolder vh1(v);
@@ -306,6 +345,8 @@ int main()
     Array<String> strings(IPosition(2,1,1));
     strings = "abc";
     doArrayString (strings);
+
+    doArrayRef();
   } catch (AipsError& x) {
     cout << "Caught an exception: " << x.getMesg() << endl;
     return 1;
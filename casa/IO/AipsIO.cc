@@ -32,8 +32,10 @@
 #include <casacore/casa/IO/RegularFileIO.h>
 #include <casacore/casa/IO/MFFileIO.h>
 #include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <cstring>                  //# for strcmp with gcc-4.3
+#include <algorithm>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -53,7 +55,13 @@ AipsIO::AipsIO()
   objlen_p (10),
   objtln_p (10),
   objptr_p (10),
-  hasCachedType_p(False)
+  hasCachedType_p(False),
+  canBuffer_p (False),
+  byteio_p (0),
+  bufMode_p (0),
+  buflen_p (0),
+  bufpos_p (0),
+  rootLeft_p (0)
 {}
 
 AipsIO::AipsIO (const String& fileName, ByteIO::OpenOption fop,
@@ -62,7 +70,13 @@ AipsIO::AipsIO (const String& fileName, ByteIO::OpenOption fop,
   maxlev_p (10),
   objlen_p (10),
   objtln_p (10),
-  objptr_p (10)
+  objptr_p (10),
+  canBuffer_p (False),
+  byteio_p (0),
+  bufMode_p (0),
+  buflen_p (0),
+  bufpos_p (0),
+  rootLeft_p (0)
 {
     // Open the file.
   open (fileName, fop, filebufSize, mfile);
@@ -73,7 +87,13 @@ AipsIO::AipsIO (ByteIO* file)
   maxlev_p   (10),
   objlen_p   (10),
   objtln_p   (10),
-  objptr_p   (10)
+  objptr_p   (10),
+  canBuffer_p (False),
+  byteio_p   (0),
+  bufMode_p  (0),
+  buflen_p   (0),
+  bufpos_p   (0),
+  rootLeft_p (0)
 {
     open (file);
 }
@@ -83,7 +103,13 @@ AipsIO::AipsIO (TypeIO* file)
   maxlev_p   (10),
   objlen_p   (10),
   objtln_p   (10),
-  objptr_p   (10)
+  objptr_p   (10),
+  canBuffer_p (False),
+  byteio_p   (0),
+  bufMode_p  (0),
+  buflen_p   (0),
+  bufpos_p   (0),
+  rootLeft_p (0)
 {
     open (file);
 }
@@ -108,8 +134,10 @@ void AipsIO::open (const String& fileName, ByteIO::OpenOption fop,
       file_p = new RegularFileIO (fileName, fopt_p, filebufSize);
     }
     io_p = new CanonicalIO (file_p);
-    seekable_p = True;
-    opened_p   = 1;
+    seekable_p  = True;
+    canBuffer_p = True;
+    byteio_p    = file_p;
+    opened_p    = 1;
 }
 
 void AipsIO::open (ByteIO* file)
@@ -119,7 +147,9 @@ void AipsIO::open (ByteIO* file)
     file_p = 0;
     io_p   = new CanonicalIO (file);
     AlwaysAssert (io_p != 0, AipsError);
-    seekable_p = io_p->isSeekable();
+    seekable_p  = io_p->isSeekable();
+    canBuffer_p = True;
+    byteio_p    = file;
     if (! io_p->isReadable()) {
 	swget_p = -1;
     }
@@ -153,6 +183,11 @@ void AipsIO::openInit (ByteIO::OpenOption fop)
 	throw (AipsError ("AipsIO: already open"));
     }
     hasCachedType_p = False;
+    canBuffer_p = False;
+    byteio_p  = 0;
+    bufMode_p = 0;
+    buflen_p  = 0;
+    bufpos_p  = 0;
     fopt_p  = fop;
     swget_p = 0;
     swput_p = 0;
@@ -168,6 +203,15 @@ void AipsIO::openInit (ByteIO::OpenOption fop)
 // Delete the file if required.
 void AipsIO::close()
 {
+    // Write the data of an unfinished object (as done without buffering).
+    if (bufMode_p == 1) {
+        flushPut();
+    }
+    bufMode_p = 0;
+    buflen_p  = 0;
+    bufpos_p  = 0;
+    canBuffer_p = False;
+    byteio_p  = 0;
     if (opened_p == 1) {
 	delete io_p;
 	delete file_p;
@@ -189,7 +233,14 @@ void AipsIO::close()
 
 Int64 AipsIO::getpos()
 {
-    return io_p->seek (0, ByteIO::Current);
+    // Take the data in the buffer into account.
+    Int64 pos = io_p->seek (0, ByteIO::Current);
+    if (bufMode_p == 1) {
+        pos += buflen_p;
+    } else if (bufMode_p == 2) {
+        pos -= buflen_p - bufpos_p;
+    }
+    return pos;
 }
 
 Int64 AipsIO::setpos (Int64 pos)
@@ -202,6 +253,234 @@ Int64 AipsIO::setpos (Int64 pos)
 }
 
 
+// The buffered fast path.
+// The values are converted directly into or from the buffer using the
+// bulk CanonicalConversion functions. Values which do not fit in the
+// buffer (large arrays when putting) are handled by the TypeIO object.
+
+// Default size of the buffer.
+static const size_t bufferSize = 65536;
+
+void AipsIO::flushPut()
+{
+    if (buflen_p > 0) {
+	byteio_p->write (buflen_p, buffer_p.storage());
+	buflen_p = 0;
+    }
+}
+
+const char* AipsIO::getBytes (size_t nbytes)
+{
+    if (buflen_p - bufpos_p < nbytes) {
+	// Move the remaining bytes to the start and read the next part
+	// of the root object (but not beyond it).
+	size_t left = buflen_p - bufpos_p;
+	if (nbytes > left + rootLeft_p) {
+	    testgeterrLength();
+	}
+	if (left > 0) {
+	    memmove (buffer_p.storage(), buffer_p.storage() + bufpos_p, left);
+	}
+	size_t size = std::min (bufferSize, left + rootLeft_p);
+	if (buffer_p.nelements() < size) {
+	    buffer_p.resize (size, False, True);
+	}
+	size_t nread = std::min (buffer_p.nelements() - left, rootLeft_p);
+	nread = byteio_p->read (nread, buffer_p.storage() + left, False);
+	rootLeft_p -= nread;
+	buflen_p = left + nread;
+	bufpos_p = 0;
+	if (buflen_p < nbytes) {
+	    throw AipsError ("AipsIO: read beyond end of file");
+	}
+    }
+    const char* ptr = buffer_p.storage() + bufpos_p;
+    bufpos_p += nbytes;
+    return ptr;
+}
+
+void AipsIO::readBytes (char* to, size_t nbytes)
+{
+    size_t left = buflen_p - bufpos_p;
+    if (nbytes > left + rootLeft_p) {
+	testgeterrLength();
+    }
+    size_t n = std::min (left, nbytes);
+    if (n > 0) {
+	memcpy (to, buffer_p.storage() + bufpos_p, n);
+	bufpos_p += n;
+    }
+    if (n < nbytes) {
+	size_t nread = byteio_p->read (nbytes - n, to + n, False);
+	rootLeft_p -= nread;
+	if (nread < nbytes - n) {
+	    throw AipsError ("AipsIO: read beyond end of file");
+	}
+    }
+}
+
+template<typename T>
+uInt AipsIO::putValues (uInt nrv, const T* var)
+{
+    if (bufMode_p == 1) {
+	size_t size = nrv * CanonicalConversion::canonicalSize (var);
+	if (size > buffer_p.nelements() - buflen_p) {
+	    flushPut();
+	    if (buffer_p.nelements() == 0  &&  size <= bufferSize) {
+		buffer_p.resize (bufferSize);
+	    }
+	}
+	if (size <= buffer_p.nelements()) {
+	    char* ptr = buffer_p.storage() + buflen_p;
+	    if (nrv == 1) {
+		CanonicalConversion::fromLocal (ptr, *var);
+	    } else {
+		CanonicalConversion::fromLocal (ptr, var, nrv);
+	    }
+	    buflen_p += size;
+	    return size;
+	}
+    }
+    return io_p->write (nrv, var);
+}
+
+uInt AipsIO::putValues (uInt nrv, const Bool* var)
+{
+    if (bufMode_p == 1) {
+	size_t size = (nrv + 7) / 8;
+	if (size > buffer_p.nelements() - buflen_p) {
+	    flushPut();
+	    if (buffer_p.nelements() == 0  &&  size <= bufferSize) {
+		buffer_p.resize (bufferSize);
+	    }
+	}
+	if (size <= buffer_p.nelements()) {
+	    Conversion::boolToBit (buffer_p.storage() + buflen_p, var, nrv);
+	    buflen_p += size;
+	    return size;
+	}
+    }
+    return io_p->write (nrv, var);
+}
+
+uInt AipsIO::putValues (uInt nrv, const Complex* var)
+{
+    if (sizeof(Complex) == 2*sizeof(float)) {
+	return putValues (2*nrv, (const float*)var);
+    }
+    flushPut();
+    return io_p->write (nrv, var);
+}
+
+uInt AipsIO::putValues (uInt nrv, const DComplex* var)
+{
+    if (sizeof(DComplex) == 2*sizeof(double)) {
+	return putValues (2*nrv, (const double*)var);
+    }
+    flushPut();
+    return io_p->write (nrv, var);
+}
+
+uInt AipsIO::putValues (uInt nrv, const String* var)
+{
+    uInt n = 0;
+    for (uInt i=0; i<nrv; i++) {
+	uInt len = var[i].length();
+	n += putValues (1, &len);
+	n += putValues (len, var[i].chars());
+    }
+    return n;
+}
+
+template<typename T>
+uInt AipsIO::getValues (uInt nrv, T* var)
+{
+    if (bufMode_p == 2) {
+	size_t valSize = CanonicalConversion::canonicalSize (var);
+	size_t size = nrv * valSize;
+	if (size <= bufferSize) {
+	    const char* ptr = getBytes (size);
+	    if (nrv == 1) {
+		CanonicalConversion::toLocal (*var, ptr);
+	    } else {
+		CanonicalConversion::toLocal (var, ptr, nrv);
+	    }
+	} else if (valSize == sizeof(T)) {
+	    // Read a large array directly into its destination and
+	    // convert it in place.
+	    readBytes ((char*)var, size);
+	    CanonicalConversion::toLocal (var, var, nrv);
+	} else {
+	    // Convert in parts fitting in the buffer.
+	    size_t nrPart = bufferSize / valSize;
+	    for (size_t i=0; i<nrv; i+=nrPart) {
+		size_t nr = std::min (nrPart, size_t(nrv) - i);
+		CanonicalConversion::toLocal (var+i, getBytes (nr*valSize), nr);
+	    }
+	}
+	return size;
+    }
+    return io_p->read (nrv, var);
+}
+
+uInt AipsIO::getValues (uInt nrv, Bool* var)
+{
+    if (bufMode_p == 2) {
+	// Convert in parts fitting in the buffer (a multiple of 8 values).
+	size_t size = (nrv + 7) / 8;
+	size_t nrPart = 8 * bufferSize;
+	for (size_t i=0; i<nrv; i+=nrPart) {
+	    size_t nr = std::min (nrPart, size_t(nrv) - i);
+	    Conversion::bitToBool (var+i, getBytes ((nr + 7) / 8), nr);
+	}
+	return size;
+    }
+    return io_p->read (nrv, var);
+}
+
+uInt AipsIO::getValues (uInt nrv, Complex* var)
+{
+    if (sizeof(Complex) == 2*sizeof(float)) {
+	return getValues (2*nrv, (float*)var);
+    }
+    uInt n = 0;
+    for (uInt i=0; i<nrv; i++) {
+	float f[2];
+	n += getValues (2, f);
+	var[i] = Complex(f[0], f[1]);
+    }
+    return n;
+}
+
+uInt AipsIO::getValues (uInt nrv, DComplex* var)
+{
+    if (sizeof(DComplex) == 2*sizeof(double)) {
+	return getValues (2*nrv, (double*)var);
+    }
+    uInt n = 0;
+    for (uInt i=0; i<nrv; i++) {
+	double d[2];
+	n += getValues (2, d);
+	var[i] = DComplex(d[0], d[1]);
+    }
+    return n;
+}
+
+uInt AipsIO::getValues (uInt nrv, String* var)
+{
+    uInt n = 0;
+    for (uInt i=0; i<nrv; i++) {
+	uInt len;
+	n += getValues (1, &len);
+	var[i].resize (len);               // resize storage which adds trailing 0
+	if (len > 0) {
+	    n += getValues (len, &(var[i][0]));
+	}
+    }
+    return n;
+}
+
+
 // The primitive put functions (operator <<) put one value at a time.
 // The value is converted to canonical format.
 // They test if a put is allowed; an exception is thrown if not.
@@ -211,98 +490,98 @@ Int64 AipsIO::setpos (Int64 pos)
 AipsIO& AipsIO::operator<< (const Bool& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const Char& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const uChar& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const short& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const unsigned short& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const int& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const unsigned int& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const Int64& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const uInt64& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const float& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
     
 AipsIO& AipsIO::operator<< (const double& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const Complex& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const DComplex& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
 AipsIO& AipsIO::operator<< (const String& var)
 {
     testput();
-    objlen_p[level_p] += io_p->write (1, &var);
+    objlen_p[level_p] += putValues (1, &var);
     return (*this);
 }
 
@@ -310,7 +589,7 @@ AipsIO& AipsIO::operator<< (const Char* var)
 {
     testput();
     String str(var);
-    objlen_p[level_p] += io_p->write (1, &str);
+    objlen_p[level_p] += putValues (1, &str);
     return (*this);
 }
 
@@ -325,7 +604,7 @@ AipsIO& AipsIO::put (uInt nrv, const Bool* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -335,7 +614,7 @@ AipsIO& AipsIO::put (uInt nrv, const Char* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -345,7 +624,7 @@ AipsIO& AipsIO::put (uInt nrv, const uChar* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -355,7 +634,7 @@ AipsIO& AipsIO::put (uInt nrv, const short* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -365,7 +644,7 @@ AipsIO& AipsIO::put (uInt nrv, const unsigned short* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -375,7 +654,7 @@ AipsIO& AipsIO::put (uInt nrv, const int* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -385,7 +664,7 @@ AipsIO& AipsIO::put (uInt nrv, const unsigned int* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -395,7 +674,7 @@ AipsIO& AipsIO::put (uInt nrv, const Int64* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -405,7 +684,7 @@ AipsIO& AipsIO::put (uInt nrv, const uInt64* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -415,7 +694,7 @@ AipsIO& AipsIO::put (uInt nrv, const float* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -425,7 +704,7 @@ AipsIO& AipsIO::put (uInt nrv, const double* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -435,7 +714,7 @@ AipsIO& AipsIO::put (uInt nrv, const Complex* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -445,7 +724,7 @@ AipsIO& AipsIO::put (uInt nrv, const DComplex* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    objlen_p[level_p] += io_p->write (nrv, var);
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -455,9 +734,7 @@ AipsIO& AipsIO::put (uInt nrv, const String* var, Bool putNR)
     if (putNR) {
 	operator<< (nrv);                        // store #values
     }
-    for (uInt i=0; i<nrv; i++) {
-	operator<< (var[i]);
-    }
+    objlen_p[level_p] += putValues (nrv, var);
     return (*this);
 }
 
@@ -492,6 +769,10 @@ uInt AipsIO::putstart (const String& type, uInt vers)
     if (level_p == 0) {
 	swput_p = 1;                           // indicate putting is possible
 	objlen_p[0] = 0;
+	if (canBuffer_p) {
+	    bufMode_p = 1;                     // put the object via buffer
+	    buflen_p  = 0;
+	}
 	operator<< (magicval_p);               // write magic value
     }
     level_p++;
@@ -520,13 +801,26 @@ uInt AipsIO::putend()
     uInt len = objlen_p[level_p];            // object length
     if (seekable_p) {
 	Int64 pos = getpos();
-	io_p->seek (objptr_p[level_p]);
-	operator<< (objlen_p[level_p]);
-	io_p->seek (pos);
+	Int64 bufStart = pos - Int64(buflen_p);
+	if (bufMode_p == 1  &&  objptr_p[level_p] >= bufStart) {
+	    // The length field is still in the buffer, so fill it in there.
+	    CanonicalConversion::fromLocal
+	      (buffer_p.storage() + (objptr_p[level_p] - bufStart), len);
+	} else {
+	    flushPut();
+	    pos = getpos();
+	    io_p->seek (objptr_p[level_p]);
+	    io_p->write (1, &len);
+	    io_p->seek (pos);
+	}
     }
     level_p--;
     if (level_p == 0) {
 	swput_p = 0;                     // putting is not possible anymore
+	if (bufMode_p == 1) {
+	    flushPut();                  // make the file up-to-date
+	    bufMode_p = 0;
+	}
     }else{
 	objlen_p[level_p] += len;        // add length to parent object
     }
@@ -543,7 +837,7 @@ uInt AipsIO::putend()
 AipsIO& AipsIO::operator>> (Bool& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -551,7 +845,7 @@ AipsIO& AipsIO::operator>> (Bool& var)
 AipsIO& AipsIO::operator>> (Char& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -559,7 +853,7 @@ AipsIO& AipsIO::operator>> (Char& var)
 AipsIO& AipsIO::operator>> (uChar& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -567,7 +861,7 @@ AipsIO& AipsIO::operator>> (uChar& var)
 AipsIO& AipsIO::operator>> (short& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -575,7 +869,7 @@ AipsIO& AipsIO::operator>> (short& var)
 AipsIO& AipsIO::operator>> (unsigned short& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -583,7 +877,7 @@ AipsIO& AipsIO::operator>> (unsigned short& var)
 AipsIO& AipsIO::operator>> (int& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -591,7 +885,7 @@ AipsIO& AipsIO::operator>> (int& var)
 AipsIO& AipsIO::operator>> (unsigned int& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -599,7 +893,7 @@ AipsIO& AipsIO::operator>> (unsigned int& var)
 AipsIO& AipsIO::operator>> (Int64& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -607,7 +901,7 @@ AipsIO& AipsIO::operator>> (Int64& var)
 AipsIO& AipsIO::operator>> (uInt64& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -615,7 +909,7 @@ AipsIO& AipsIO::operator>> (uInt64& var)
 AipsIO& AipsIO::operator>> (float& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -623,7 +917,7 @@ AipsIO& AipsIO::operator>> (float& var)
 AipsIO& AipsIO::operator>> (double& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -631,7 +925,7 @@ AipsIO& AipsIO::operator>> (double& var)
 AipsIO& AipsIO::operator>> (Complex& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -639,7 +933,7 @@ AipsIO& AipsIO::operator>> (Complex& var)
 AipsIO& AipsIO::operator>> (DComplex& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -647,7 +941,7 @@ AipsIO& AipsIO::operator>> (DComplex& var)
 AipsIO& AipsIO::operator>> (String& var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (1, &var);
+    objlen_p[level_p] += getValues (1, &var);
     testgetLength();
     return (*this);
 }
@@ -663,7 +957,7 @@ AipsIO& AipsIO::operator>> (String& var)
 AipsIO& AipsIO::get (uInt nrv, Bool* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -671,7 +965,7 @@ AipsIO& AipsIO::get (uInt nrv, Bool* var)
 AipsIO& AipsIO::get (uInt nrv, Char* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -679,7 +973,7 @@ AipsIO& AipsIO::get (uInt nrv, Char* var)
 AipsIO& AipsIO::get (uInt nrv, uChar* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -687,7 +981,7 @@ AipsIO& AipsIO::get (uInt nrv, uChar* var)
 AipsIO& AipsIO::get (uInt nrv, short* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -695,7 +989,7 @@ AipsIO& AipsIO::get (uInt nrv, short* var)
 AipsIO& AipsIO::get (uInt nrv, unsigned short* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -703,7 +997,7 @@ AipsIO& AipsIO::get (uInt nrv, unsigned short* var)
 AipsIO& AipsIO::get (uInt nrv, int* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -711,7 +1005,7 @@ AipsIO& AipsIO::get (uInt nrv, int* var)
 AipsIO& AipsIO::get (uInt nrv, unsigned int* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -719,7 +1013,7 @@ AipsIO& AipsIO::get (uInt nrv, unsigned int* var)
 AipsIO& AipsIO::get (uInt nrv, Int64* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -727,7 +1021,7 @@ AipsIO& AipsIO::get (uInt nrv, Int64* var)
 AipsIO& AipsIO::get (uInt nrv, uInt64* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -735,7 +1029,7 @@ AipsIO& AipsIO::get (uInt nrv, uInt64* var)
 AipsIO& AipsIO::get (uInt nrv, float* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -743,7 +1037,7 @@ AipsIO& AipsIO::get (uInt nrv, float* var)
 AipsIO& AipsIO::get (uInt nrv, double* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -751,7 +1045,7 @@ AipsIO& AipsIO::get (uInt nrv, double* var)
 AipsIO& AipsIO::get (uInt nrv, Complex* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -759,7 +1053,7 @@ AipsIO& AipsIO::get (uInt nrv, Complex* var)
 AipsIO& AipsIO::get (uInt nrv, DComplex* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -767,7 +1061,7 @@ AipsIO& AipsIO::get (uInt nrv, DComplex* var)
 AipsIO& AipsIO::get (uInt nrv, String* var)
 {
     testget();
-    objlen_p[level_p] += io_p->read (nrv, var);
+    objlen_p[level_p] += getValues (nrv, var);
     testgetLength();
     return (*this);
 }
@@ -940,6 +1234,15 @@ const String& AipsIO::getNextType()
     objlen_p[level_p] = 0;                 // length already read
     objtln_p[level_p] = 16;                // to satisfy test in read
     operator>> (objtln_p[level_p]);        // total object length to read
+    // Read the remainder of a root object via the buffer if its length
+    // is known (i.e., it was written to a seekable file).
+    if (level_p == 1  &&  canBuffer_p  &&  bufMode_p == 0
+    &&  objtln_p[1] != magicval_p  &&  objtln_p[1] >= 4) {
+        bufMode_p  = 2;
+        buflen_p   = 0;
+        bufpos_p   = 0;
+        rootLeft_p = objtln_p[1] - 4;
+    }
     operator>> (objectType_p);             // object type
     // Getting may not be possible till getstart has been done.
     swget_p = swgetOld;
@@ -980,6 +1283,15 @@ uInt AipsIO::getend()
 	}
         if (--level_p == 0) {
             swget_p = 0;                   // reading not possible anymore
+	    if (bufMode_p == 2) {
+	        bufMode_p = 0;
+		buflen_p  = 0;
+		bufpos_p  = 0;
+		// Do not keep a buffer enlarged for a large array.
+		if (buffer_p.nelements() > bufferSize) {
+		    buffer_p.resize (bufferSize, True, False);
+		}
+	    }
 	}else{
 	    objlen_p[level_p] += len;      // increase length read of parent
 	}
@@ -130,6 +130,18 @@ class MultiFileBase;
 // Obviously these functions are to be used by a storage manager and
 // are not for public use.  Someday they should be made private with
 // a friend defined.
+// <p>
+// If AipsIO creates the CanonicalIO object itself (i.e., when opened
+// with a file name or a ByteIO object), it uses a buffered fast path.
+// The values of a root object are converted to canonical format directly
+// into an internal buffer which is written in large chunks, and the
+// lengths of nested objects are filled in while still in that buffer.
+// When reading, the root object is read in large chunks and its values
+// are converted directly from that buffer.
+// In this way an array is converted with a single conversion call
+// and the virtual TypeIO and ByteIO functions are not called per value.
+// The underlying ByteIO object is up-to-date after the outermost
+// putend or getend has been done.
 // </synopsis> 
 
 // <example>
@@ -423,6 +435,33 @@ private:
     // Throw exception for testgetLength
     void testgeterrLength();
 
+    // Write the values in the put buffer to the file.
+    void flushPut();
+
+    // Get a pointer to the next <src>nbytes</src> of the root object
+    // being read. The buffer is refilled from the file if needed.
+    // The number of bytes must not exceed the default buffer size.
+    const char* getBytes (size_t nbytes);
+
+    // Copy the next <src>nbytes</src> of the root object being read into
+    // <src>to</src>. Bytes not in the buffer are read directly from the file.
+    void readBytes (char* to, size_t nbytes);
+
+    // Put or get values using the buffer if possible, otherwise
+    // using the TypeIO object. They return the number of bytes.
+    // <group>
+    template<typename T> uInt putValues (uInt nrv, const T* var);
+    uInt putValues (uInt nrv, const Bool* var);
+    uInt putValues (uInt nrv, const Complex* var);
+    uInt putValues (uInt nrv, const DComplex* var);
+    uInt putValues (uInt nrv, const String* var);
+    template<typename T> uInt getValues (uInt nrv, T* var);
+    uInt getValues (uInt nrv, Bool* var);
+    uInt getValues (uInt nrv, Complex* var);
+    uInt getValues (uInt nrv, DComplex* var);
+    uInt getValues (uInt nrv, String* var);
+    // </group>
+
 
     //  1 = file was opened by AipsIO
     //  0 = file not opened
@@ -458,6 +497,21 @@ private:
     TypeIO*      io_p;
     // Is the file is seekable?
     Bool         seekable_p;
+    // Can the buffered fast path be used (i.e., is io_p a CanonicalIO
+    // created by this object on top of byteio_p)?
+    Bool         canBuffer_p;
+    // The ByteIO object used by the buffered fast path.
+    ByteIO*      byteio_p;
+    // Buffer mode: 0 = not used, 1 = put, 2 = get.
+    Int          bufMode_p;
+    // The buffer holding canonical data of the current root object.
+    Block<char>  buffer_p;
+    // Number of bytes used in the buffer.
+    size_t       buflen_p;
+    // Position of the next value to get from the buffer.
+    size_t       bufpos_p;
+    // Number of bytes of the root object not read into the buffer yet.
+    size_t       rootLeft_p;
     // magic value to check sync.
     static const uInt magicval_p;
 };
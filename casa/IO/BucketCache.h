@@ -319,6 +319,20 @@ public:
     // Show the statistics.
     void showStatistics (ostream& os) const;
 
+    // Get the statistics gathered since the last <src>initStatistics</src>:
+    // the number of bucket accesses, and the number of buckets read,
+    // initialized and written.
+    // <group>
+    uInt nAccess() const
+      { return naccess_p; }
+    uInt nRead() const
+      { return nread_p; }
+    uInt nInit() const
+      { return ninit_p; }
+    uInt nWrite() const
+      { return nwrite_p; }
+    // </group>
+
 private:
     // The file used.
     BucketFile* its_file;
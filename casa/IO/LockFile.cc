@@ -71,9 +71,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 LockFile::LockFile (const String& fileName, double inspectInterval,
 		    Bool create, Bool setRequestFlag, Bool mustExist,
-		    uInt seqnr, Bool permLocking, Bool noLocking)
+		    uInt seqnr, Bool permLocking, Bool noLocking,
+		    Bool sharedMemory)
 : itsFileIO      (0),
   itsCanIO       (0),
+  itsShm         (0),
   itsWritable    (True),
   itsAddToList   (setRequestFlag),
   itsInterval    (inspectInterval),
@@ -131,11 +133,35 @@ LockFile::LockFile (const String& fileName, double inspectInterval,
       itsCanIO  = new CanonicalIO (itsFileIO);
       // Set the file to in use by acquiring a read lock.
       itsUseLocker.acquire (FileLocker::Read, 1);
+      //# Keep the locks and info in shared memory if requested.
+      //# The process creating the segment initializes it with the info
+      //# in the lock file.
+      //# While using the segment, a read lock is held on the file, so
+      //# processes using file locking cannot get a write lock.
+      //# If such a process holds a write lock, file locking is used.
+      if (sharedMemory  &&  SharedMemLock::isSupported()
+      &&  itsLocker.acquire (FileLocker::Read, 1)) {
+        itsShm = new SharedMemLock (itsName, seqnr);
+        if (itsShm->isNew()) {
+          MemoryIO info;
+          getFileInfo (info);
+          itsShm->initialize (info);
+        }
+      }
     }
 }
 
 LockFile::~LockFile()
 {
+    //# The last process using the shared memory writes the info into
+    //# the lock file (before the segment is removed).
+    if (itsShm != 0) {
+        MemoryIO info;
+        if (itsShm->detach (info)) {
+            putFileInfo (info);
+        }
+        delete itsShm;
+    }
     delete itsCanIO;
     delete itsFileIO;
     int fd = itsLocker.fd();
@@ -162,6 +188,16 @@ Bool LockFile::acquire (MemoryIO* info, FileLocker::LockType type,
 	}
 	return True;
     }
+    //# With shared memory the waiting processes are counted in the segment.
+    if (itsShm != 0) {
+        Bool succ = itsShm->acquire (type, nattempts);
+        if (succ  &&  info != 0) {
+            itsShm->getInfo (*info);
+        }
+        itsLastTime.now();
+        itsInspectCount = 0;
+        return succ;
+    }
     //# Try to set a lock without waiting.
     Bool succ = itsLocker.acquire (type, 1);
     Bool added = False;
@@ -207,6 +243,9 @@ Bool LockFile::release (const MemoryIO* info)
     if (info != 0) {
 	putInfo (*info);
     }
+    if (itsShm != 0) {
+        return itsShm->release();
+    }
     return itsLocker.release();
 }
 
@@ -232,12 +271,32 @@ Bool LockFile::inspect (Bool always)
     }
 
     //# Get the number of request id's and reset the time.
-    uInt nr = getNrReqId();
+    uInt nr = (itsShm == 0  ?  getNrReqId() : itsShm->nrRequests());
     itsLastTime.now();
     return  (nr > 0);
 }
 
 void LockFile::getInfo (MemoryIO& info)
+{
+    if (itsShm != 0) {
+        itsShm->getInfo (info);
+    } else {
+        getFileInfo (info);
+    }
+}
+
+void LockFile::putInfo (const MemoryIO& info) const
+{
+    if (itsShm != 0) {
+        if (itsWritable  &&  const_cast<MemoryIO&>(info).length() > 0) {
+            itsShm->putInfo (info);
+        }
+    } else {
+        putFileInfo (info);
+    }
+}
+
+void LockFile::getFileInfo (MemoryIO& info)
 {
     // Do nothing if no locking.
     if (itsLocker.fd() < 0) {
@@ -280,7 +339,7 @@ void LockFile::getInfo (MemoryIO& info)
     info.seek (Int64(0));
 }
 
-void LockFile::putInfo (const MemoryIO& info) const
+void LockFile::putFileInfo (const MemoryIO& info) const
 {
     uInt infoLeng = ((MemoryIO&)info).length();
     if (itsLocker.fd() < 0  ||  !itsWritable  ||  infoLeng == 0) {
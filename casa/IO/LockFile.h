@@ -32,6 +32,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/IO/FileLocker.h>
+#include <casacore/casa/IO/SharedMemLock.h>
 #include <casacore/casa/OS/Time.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicSL/String.h>
@@ -132,6 +133,17 @@ class CanonicalIO;
 // locks held by the other LockFile objects. This behaviour is due to the way
 // file locking is working on UNIX machines (certainly on Solaris 2.6).
 // One can use the test program tLockFile to test for this behaviour.
+// <p>
+// Optionally the locks, request count and synchronization info can be kept
+// in shared memory using class <linkto class=SharedMemLock>SharedMemLock</linkto>.
+// That avoids all file IO when locking, but can only be used if all
+// processes accessing the file are on the same host and use shared memory
+// locking. The lock file then only holds the synchronization info while
+// no process uses the file.
+// A process using shared memory keeps a read lock on the lock file, so a
+// process using file locking cannot acquire a write lock meanwhile.
+// Conversely, if a process using file locking holds a write lock when the
+// LockFile object is created, file locking is used instead of shared memory.
 // </synopsis>
 
 // <example>
@@ -194,10 +206,18 @@ public:
     // way showLock() can find out if if table is permanently locked.
     // <br> The <src>noLocking</src> argument is used to indicate that
     // no locking is needed. It means that acquiring a lock always succeeds.
+    // <br> The <src>sharedMemory</src> argument tells that the locks and
+    // synchronization info are kept in shared memory
+    // (see <linkto class=SharedMemLock>SharedMemLock</linkto>) instead of
+    // in the lock file. The lock file is only used to hold the info when
+    // no process uses it. It is ignored if shared memory locking is not
+    // supported on this system or if another process holds a write lock
+    // on the lock file.
     explicit LockFile (const String& fileName, double inspectInterval = 0,
 		       Bool create = False, Bool addToRequestList = True,
 		       Bool mustExist = True, uInt seqnr = 0,
-		       Bool permLocking = False, Bool noLocking = False);
+		       Bool permLocking = False, Bool noLocking = False,
+		       Bool sharedMemory = False);
 
     // The destructor does not delete the file, because it is not known
     // when the last process using the lock file will stop.
@@ -261,6 +281,10 @@ public:
     // Get the name of the lock file.
     const String& name() const;
 
+    // Are the locks kept in shared memory?
+    Bool usesSharedMemory() const
+      { return itsShm != 0; }
+
     // Get the block of request id's.
     const Block<Int>& reqIds() const;
 
@@ -314,12 +338,19 @@ private:
     // Get the number of request id's.
     Int getNrReqId() const;
 
+    // Read or write the info from or into the lock file.
+    // <group>
+    void getFileInfo (MemoryIO& info);
+    void putFileInfo (const MemoryIO& info) const;
+    // </group>
+
 
     //# The member variables.
     FileLocker   itsLocker;
     FileLocker   itsUseLocker;
     FiledesIO*   itsFileIO;
     CanonicalIO* itsCanIO;
+    SharedMemLock* itsShm;            //# shared memory locking (if used)
     Bool         itsWritable;         //# lock file is writable?
     Bool         itsAddToList;        //# Should acquire add to request list?
     double       itsInterval;         //# interval between inspections
@@ -355,10 +386,16 @@ inline Bool LockFile::release (const MemoryIO& info)
 }
 inline Bool LockFile::canLock (FileLocker::LockType type)
 {
+    if (itsShm != 0) {
+        return itsShm->canLock (type);
+    }
     return (itsFileIO == 0  ?  True : itsLocker.canLock (type));
 }
 inline Bool LockFile::hasLock (FileLocker::LockType type) const
 {
+    if (itsShm != 0) {
+        return itsShm->hasLock (type);
+    }
     return (itsFileIO == 0  ?  True : itsLocker.hasLock (type));
 }
 inline int LockFile::lastError() const
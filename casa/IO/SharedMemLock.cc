@@ -0,0 +1,577 @@
+//# SharedMemLock.cc: Class to lock a file using shared memory
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/SharedMemLock.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/sstream.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+//# Robust process-shared mutexes are needed, which are available on Linux.
+#if defined(AIPS_LINUX)
+# define SHMLOCK_SUPPORTED 1
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <fcntl.h>
+# include <signal.h>
+# include <pthread.h>
+# include <time.h>
+#endif
+
+//# Magic value telling that the segment has been initialized.
+#define SHMLOCK_MAGIC    0x43534c4bu
+//# Maximum number of processes using the segment.
+#define SHMLOCK_NPROC    256u
+//# Maximum length of the synchronization info.
+#define SHMLOCK_INFOSIZE 32768u
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+#ifdef SHMLOCK_SUPPORTED
+
+//# The layout of the shared memory segment.
+//# It is zero-filled when created.
+//# The creator pid has to be the first field, because it is written
+//# before the segment is mapped.
+struct SharedMemLockData
+{
+  Int             creator;                  //# pid of process creating it
+  volatile uInt   magic;
+  Int             remover;                  //# pid of process removing it
+  pthread_mutex_t mutex;
+  pthread_cond_t  cond;
+  Int             writer;                   //# pid of write lock holder
+  volatile Int    nrequest;                 //# #processes waiting for lock
+  Int             readers[SHMLOCK_NPROC];   //# pids of read lock holders
+  Int             users[SHMLOCK_NPROC];     //# pids of attached processes
+  uInt            infoLength;
+  uChar           info[SHMLOCK_INFOSIZE];
+};
+
+#define SHMDATA (static_cast<SharedMemLockData*>(itsData))
+
+//# Test if a process is still alive.
+static Bool shmIsAlive (Int pid)
+{
+  return (kill (pid, 0) == 0  ||  errno == EPERM);
+}
+
+//# Put a pid in the first free slot. False is returned if full.
+static Bool shmAddPid (Int* pids, Int pid)
+{
+  for (uInt i=0; i<SHMLOCK_NPROC; ++i) {
+    if (pids[i] == 0) {
+      pids[i] = pid;
+      return True;
+    }
+  }
+  return False;
+}
+
+//# Remove the first occurrence of a pid.
+static void shmRemovePid (Int* pids, Int pid)
+{
+  for (uInt i=0; i<SHMLOCK_NPROC; ++i) {
+    if (pids[i] == pid) {
+      pids[i] = 0;
+      return;
+    }
+  }
+}
+
+//# Remove a segment left behind by a process which died while creating it.
+//# It is only removed if the name still refers to the same segment.
+static void shmUnlinkStale (const String& name, ino_t inode)
+{
+  int fd = shm_open (name.chars(), O_RDONLY, 0);
+  if (fd >= 0) {
+    struct stat st;
+    Bool same = (fstat (fd, &st) == 0  &&  st.st_ino == inode);
+    close (fd);
+    if (same) {
+      shm_unlink (name.chars());
+    }
+  }
+}
+
+#endif
+
+
+SharedMemLock::SharedMemLock (const String& lockFileName, uInt seqnr)
+: itsData        (0),
+  itsPid         (getpid()),
+  itsIsNew       (False),
+  itsDetached    (False),
+  itsRemove      (False),
+  itsReadLocked  (False),
+  itsWriteLocked (False)
+{
+#ifndef SHMLOCK_SUPPORTED
+  throw AipsError ("SharedMemLock: shared memory locking is not supported "
+                   "on this system");
+#else
+  struct stat st;
+  if (stat (lockFileName.chars(), &st) != 0) {
+    throw AipsError ("SharedMemLock: lock file " + lockFileName +
+                     " does not exist");
+  }
+  ostringstream oss;
+  oss << "/casacore_lock_" << std::hex << uInt64(st.st_dev) << '_'
+      << uInt64(st.st_ino) << '_' << std::dec << seqnr;
+  itsName = oss.str();
+  // Another process may be initializing or removing the segment,
+  // so retry for a while (10 seconds).
+  for (uInt i=0; i<10000; ++i) {
+    if (create()  ||  attach()) {
+      return;
+    }
+    usleep (1000);
+  }
+  throw AipsError ("SharedMemLock: could not attach to shared memory segment "
+                   + itsName + " for lock file " + lockFileName +
+                   "; it might be a leftover of a crashed process");
+#endif
+}
+
+SharedMemLock::~SharedMemLock()
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (itsData == 0) {
+    return;
+  }
+  if (itsIsNew  &&  SHMDATA->magic != SHMLOCK_MAGIC) {
+    // Never initialized (e.g. because of an exception), so remove it.
+    itsRemove = True;
+  } else if (! itsDetached) {
+    MemoryIO info;
+    detach (info);
+  }
+  unmap();
+  if (itsRemove) {
+    shm_unlink (itsName.chars());
+  }
+#endif
+}
+
+Bool SharedMemLock::isSupported()
+{
+#ifdef SHMLOCK_SUPPORTED
+  return True;
+#else
+  return False;
+#endif
+}
+
+Bool SharedMemLock::create()
+{
+#ifdef SHMLOCK_SUPPORTED
+  int fd = shm_open (itsName.chars(), O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd < 0) {
+    if (errno == EEXIST) {
+      return False;
+    }
+    throw AipsError ("SharedMemLock: could not create shared memory segment "
+                     + itsName + ": " + strerror(errno));
+  }
+  // Like the lock file, every process has to be able to write it.
+  fchmod (fd, 0666);
+  // Store the creator first, so other processes can find out if the
+  // segment is stale because its creator died before initializing it.
+  void* ptr = MAP_FAILED;
+  if (pwrite (fd, &itsPid, sizeof(Int), 0) == Int(sizeof(Int))  &&
+      ftruncate (fd, sizeof(SharedMemLockData)) == 0) {
+    ptr = mmap (0, sizeof(SharedMemLockData), PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+  }
+  int err = errno;
+  close (fd);
+  if (ptr == MAP_FAILED) {
+    shm_unlink (itsName.chars());
+    throw AipsError ("SharedMemLock: could not map shared memory segment "
+                     + itsName + ": " + strerror(err));
+  }
+  itsData = ptr;
+  itsIsNew = True;
+  // The mutex has to be robust, so it can be recovered if a process
+  // dies while holding it.
+  pthread_mutexattr_t mattr;
+  pthread_mutexattr_init (&mattr);
+  pthread_mutexattr_setpshared (&mattr, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust (&mattr, PTHREAD_MUTEX_ROBUST);
+  pthread_mutex_init (&(SHMDATA->mutex), &mattr);
+  pthread_mutexattr_destroy (&mattr);
+  pthread_condattr_t cattr;
+  pthread_condattr_init (&cattr);
+  pthread_condattr_setpshared (&cattr, PTHREAD_PROCESS_SHARED);
+  pthread_cond_init (&(SHMDATA->cond), &cattr);
+  pthread_condattr_destroy (&cattr);
+  SHMDATA->users[0] = itsPid;
+  return True;
+#else
+  return False;
+#endif
+}
+
+Bool SharedMemLock::attach()
+{
+#ifdef SHMLOCK_SUPPORTED
+  int fd = shm_open (itsName.chars(), O_RDWR, 0);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return False;
+    }
+    throw AipsError ("SharedMemLock: could not open shared memory segment "
+                     + itsName + ": " + strerror(errno));
+  }
+  // The creator might not have sized the segment yet.
+  // If it died before doing so, the segment is removed, so it can be
+  // created again.
+  struct stat st;
+  if (fstat (fd, &st) != 0) {
+    close (fd);
+    return False;
+  }
+  if (st.st_size < off_t(sizeof(SharedMemLockData))) {
+    Int creator = 0;
+    if (st.st_size < off_t(sizeof(Int))  ||
+        pread (fd, &creator, sizeof(Int), 0) != Int(sizeof(Int))) {
+      creator = 0;
+    }
+    close (fd);
+    if (creator != 0  &&  ! shmIsAlive (creator)) {
+      shmUnlinkStale (itsName, st.st_ino);
+    }
+    return False;
+  }
+  void* ptr = mmap (0, sizeof(SharedMemLockData), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  int err = errno;
+  close (fd);
+  if (ptr == MAP_FAILED) {
+    throw AipsError ("SharedMemLock: could not map shared memory segment "
+                     + itsName + ": " + strerror(err));
+  }
+  itsData = ptr;
+  // Wait until the creator has initialized it.
+  // If the creator died before doing so, remove the segment.
+  if (SHMDATA->magic != SHMLOCK_MAGIC) {
+    if (! shmIsAlive (SHMDATA->creator)) {
+      shmUnlinkStale (itsName, st.st_ino);
+    }
+    unmap();
+    return False;
+  }
+  lockMutex();
+  // Do not use a segment being removed. If the remover died, remove it.
+  if (SHMDATA->remover != 0) {
+    if (! shmIsAlive (SHMDATA->remover)) {
+      shm_unlink (itsName.chars());
+    }
+    unlockMutex();
+    unmap();
+    return False;
+  }
+  removeDead();
+  Bool added = shmAddPid (SHMDATA->users, itsPid);
+  unlockMutex();
+  if (!added) {
+    unmap();
+    throw AipsError ("SharedMemLock: too many processes use shared memory "
+                     "segment " + itsName);
+  }
+  return True;
+#else
+  return False;
+#endif
+}
+
+void SharedMemLock::unmap()
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (itsData != 0) {
+    munmap (itsData, sizeof(SharedMemLockData));
+    itsData = 0;
+  }
+#endif
+}
+
+void SharedMemLock::initialize (const MemoryIO& info)
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (itsIsNew  &&  SHMDATA->magic != SHMLOCK_MAGIC) {
+    putInfo (info);
+    // Make sure all data are visible before other processes can use it.
+    __sync_synchronize();
+    SHMDATA->magic = SHMLOCK_MAGIC;
+  }
+#endif
+}
+
+void SharedMemLock::lockMutex()
+{
+#ifdef SHMLOCK_SUPPORTED
+  int status = pthread_mutex_lock (&(SHMDATA->mutex));
+  if (status == EOWNERDEAD) {
+    // The holder died; the lock state is cleaned up by removeDead.
+    pthread_mutex_consistent (&(SHMDATA->mutex));
+  } else if (status != 0) {
+    throw AipsError ("SharedMemLock: could not lock the mutex in shared "
+                     "memory segment " + itsName + ": " + strerror(status));
+  }
+#endif
+}
+
+void SharedMemLock::unlockMutex()
+{
+#ifdef SHMLOCK_SUPPORTED
+  pthread_mutex_unlock (&(SHMDATA->mutex));
+#endif
+}
+
+void SharedMemLock::removeDead()
+{
+#ifdef SHMLOCK_SUPPORTED
+  Bool changed = False;
+  if (SHMDATA->writer != 0  &&  ! shmIsAlive (SHMDATA->writer)) {
+    SHMDATA->writer = 0;
+    changed = True;
+  }
+  for (uInt i=0; i<SHMLOCK_NPROC; ++i) {
+    if (SHMDATA->readers[i] != 0  &&  ! shmIsAlive (SHMDATA->readers[i])) {
+      SHMDATA->readers[i] = 0;
+      changed = True;
+    }
+    if (SHMDATA->users[i] != 0  &&  ! shmIsAlive (SHMDATA->users[i])) {
+      SHMDATA->users[i] = 0;
+    }
+  }
+  if (changed) {
+    pthread_cond_broadcast (&(SHMDATA->cond));
+  }
+#endif
+}
+
+Bool SharedMemLock::canGrant (FileLocker::LockType type) const
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (SHMDATA->writer != 0  &&  SHMDATA->writer != itsPid) {
+    return False;
+  }
+  if (type == FileLocker::Write) {
+    for (uInt i=0; i<SHMLOCK_NPROC; ++i) {
+      if (SHMDATA->readers[i] != 0  &&  SHMDATA->readers[i] != itsPid) {
+        return False;
+      }
+    }
+  }
+  return True;
+#else
+  return True;
+#endif
+}
+
+void SharedMemLock::grant (FileLocker::LockType type)
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (type == FileLocker::Write) {
+    SHMDATA->writer = itsPid;
+    itsWriteLocked  = True;
+    itsReadLocked   = True;
+  } else if (! itsReadLocked) {
+    if (! shmAddPid (SHMDATA->readers, itsPid)) {
+      unlockMutex();
+      throw AipsError ("SharedMemLock: too many readers in shared memory "
+                       "segment " + itsName);
+    }
+    itsReadLocked = True;
+  }
+#endif
+}
+
+void SharedMemLock::removeLocks()
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (SHMDATA->writer == itsPid) {
+    SHMDATA->writer = 0;
+  }
+  shmRemovePid (SHMDATA->readers, itsPid);
+  itsReadLocked  = False;
+  itsWriteLocked = False;
+#endif
+}
+
+Bool SharedMemLock::acquire (FileLocker::LockType type, uInt nattempts)
+{
+  // A write lock implies a read lock.
+  if (hasLock (type)) {
+    return True;
+  }
+#ifdef SHMLOCK_SUPPORTED
+  lockMutex();
+  removeDead();
+  Bool succ = canGrant (type);
+  if (!succ  &&  nattempts != 1) {
+    // Tell the lock holders that a process is waiting.
+    SHMDATA->nrequest++;
+    struct timespec ts;
+    clock_gettime (CLOCK_REALTIME, &ts);
+    time_t endTime = ts.tv_sec + nattempts - 1;
+    while (!succ) {
+      clock_gettime (CLOCK_REALTIME, &ts);
+      if (nattempts > 0  &&  ts.tv_sec >= endTime) {
+        break;
+      }
+      // Wake up at least every second to detect processes which died.
+      ts.tv_sec += 1;
+      int status = pthread_cond_timedwait (&(SHMDATA->cond),
+                                           &(SHMDATA->mutex), &ts);
+      if (status == EOWNERDEAD) {
+        pthread_mutex_consistent (&(SHMDATA->mutex));
+      }
+      removeDead();
+      succ = canGrant (type);
+    }
+    SHMDATA->nrequest--;
+  }
+  if (succ) {
+    grant (type);
+  }
+  unlockMutex();
+  return succ;
+#else
+  return False;
+#endif
+}
+
+Bool SharedMemLock::release()
+{
+#ifdef SHMLOCK_SUPPORTED
+  if (itsReadLocked) {
+    lockMutex();
+    removeLocks();
+    pthread_cond_broadcast (&(SHMDATA->cond));
+    unlockMutex();
+  }
+#endif
+  return True;
+}
+
+Bool SharedMemLock::canLock (FileLocker::LockType type)
+{
+  if (hasLock (type)) {
+    return True;
+  }
+#ifdef SHMLOCK_SUPPORTED
+  lockMutex();
+  removeDead();
+  Bool succ = canGrant (type);
+  unlockMutex();
+  return succ;
+#else
+  return False;
+#endif
+}
+
+uInt SharedMemLock::nrRequests() const
+{
+#ifdef SHMLOCK_SUPPORTED
+  return SHMDATA->nrequest;
+#else
+  return 0;
+#endif
+}
+
+void SharedMemLock::getInfo (MemoryIO& info)
+{
+  info.clear();
+#ifdef SHMLOCK_SUPPORTED
+  lockMutex();
+  if (SHMDATA->infoLength > 0) {
+    info.write (SHMDATA->infoLength, SHMDATA->info);
+  }
+  unlockMutex();
+#endif
+  info.seek (Int64(0));
+}
+
+void SharedMemLock::putInfo (const MemoryIO& info)
+{
+#ifdef SHMLOCK_SUPPORTED
+  uInt infoLeng = const_cast<MemoryIO&>(info).length();
+  if (infoLeng > SHMLOCK_INFOSIZE) {
+    throw AipsError ("SharedMemLock: synchronization info too long for "
+                     "shared memory segment " + itsName);
+  }
+  lockMutex();
+  if (infoLeng > 0) {
+    memcpy (SHMDATA->info, info.getBuffer(), infoLeng);
+  }
+  SHMDATA->infoLength = infoLeng;
+  unlockMutex();
+#endif
+}
+
+Bool SharedMemLock::detach (MemoryIO& info)
+{
+  if (itsDetached) {
+    return False;
+  }
+  itsDetached = True;
+#ifdef SHMLOCK_SUPPORTED
+  lockMutex();
+  removeLocks();
+  shmRemovePid (SHMDATA->users, itsPid);
+  removeDead();
+  Bool last = True;
+  for (uInt i=0; i<SHMLOCK_NPROC; ++i) {
+    if (SHMDATA->users[i] != 0) {
+      last = False;
+      break;
+    }
+  }
+  if (last) {
+    // Mark the segment as being removed, so other processes do not use it.
+    SHMDATA->remover = itsPid;
+    info.clear();
+    info.write (SHMDATA->infoLength, SHMDATA->info);
+    info.seek (Int64(0));
+  }
+  pthread_cond_broadcast (&(SHMDATA->cond));
+  unlockMutex();
+  itsRemove = last;
+  return last;
+#else
+  return False;
+#endif
+}
+
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,210 @@
+//# SharedMemLock.h: Class to lock a file using shared memory
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef CASA_SHAREDMEMLOCK_H
+#define CASA_SHAREDMEMLOCK_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/FileLocker.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MemoryIO;
+
+
+// <summary>
+// Class to lock a file using shared memory.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tSharedMemLock" demos="">
+// </reviewed>
+
+// <prerequisite>
+//    <li> class <linkto class=LockFile>LockFile</linkto>
+// </prerequisite>
+
+// <synopsis>
+// This class offers the same read/write locking as
+// <linkto class=FileLocker>FileLocker</linkto>, but the lock state is kept
+// in a POSIX shared memory segment instead of using fcntl locks on a file.
+// The segment also contains the synchronization info and the number of
+// processes waiting for a lock, which <linkto class=LockFile>LockFile</linkto>
+// otherwise keeps in the lock file itself. Thus acquiring, releasing and
+// inspecting a lock does not need any file IO, which makes it much cheaper
+// than file locking, in particular on NFS.
+// <br>It can only be used by processes on the same host. All processes
+// accessing the file have to use this class, because the locks are not
+// visible to processes using file locking.
+// <p>
+// The segment is named after the device and inode of the lock file and
+// the lock sequence number, so all processes on the host share the same
+// segment. The state in it is protected by a robust, process-shared mutex.
+// Waiting for a lock is done using a process-shared condition variable
+// (which is implemented with futexes on Linux), so a waiting process is
+// woken up as soon as a lock is released. The processes using the segment
+// and holding a lock are registered by their pid; locks held by processes
+// which died are removed automatically.
+// <p>
+// The process creating the segment has to fill it with the synchronization
+// info (read from the lock file) using function <src>initialize</src>.
+// Other processes wait until that is done. The pid of the creator is
+// stored in the segment before anything else, so a segment whose creator
+// died before initializing it is recognized and removed by the next
+// process trying to attach to it. When the last process detaches
+// from the segment, it gets the final synchronization info (to be written
+// into the lock file) and the segment is removed.
+// <p>
+// Shared memory locking is only supported on Linux. The function
+// <src>isSupported</src> tells if it can be used.
+// </synopsis>
+
+// <motivation>
+// Processes on the same host spent a lot of time in file locking and
+// reading the synchronization info from the lock file.
+// </motivation>
+
+
+class SharedMemLock
+{
+public:
+    // Attach to (or create) the shared memory segment belonging to the
+    // given lock file (which must exist) and lock sequence number.
+    // If the segment has been created, function <src>initialize</src>
+    // has to be called to make it available to the other processes.
+    // An exception is thrown if shared memory locking is not supported.
+    SharedMemLock (const String& lockFileName, uInt seqnr);
+
+    // Detach from the segment. If <src>detach</src> was called and this
+    // was the last process using it, the segment is removed.
+    ~SharedMemLock();
+
+    // Can shared memory locking be used on this system?
+    static Bool isSupported();
+
+    // Has this object created the segment?
+    Bool isNew() const
+      { return itsIsNew; }
+
+    // Set the initial synchronization info in a newly created segment
+    // and make the segment available to other processes.
+    void initialize (const MemoryIO& info);
+
+    // Acquire a read or write lock. The argument <src>nattempts</src> has
+    // the same meaning as in FileLocker: 0 means waiting forever, otherwise
+    // it waits at most <src>nattempts-1</src> seconds.
+    Bool acquire (FileLocker::LockType type, uInt nattempts);
+
+    // Release the lock.
+    Bool release();
+
+    // Test if the lock can be acquired (without acquiring it).
+    Bool canLock (FileLocker::LockType type);
+
+    // Test if the process has a read or write lock.
+    Bool hasLock (FileLocker::LockType type) const
+      { return (type == FileLocker::Write  ?  itsWriteLocked : itsReadLocked); }
+
+    // Get the number of processes waiting for a lock.
+    uInt nrRequests() const;
+
+    // Get or put the synchronization info.
+    // The seek pointer of the <src>MemoryIO</src> object is set to 0.
+    // An exception is thrown if the info does not fit in the segment.
+    // <group>
+    void getInfo (MemoryIO& info);
+    void putInfo (const MemoryIO& info);
+    // </group>
+
+    // Detach from the segment, which releases the lock.
+    // If this is the last process using it, the synchronization info is
+    // copied into <src>info</src> and True is returned. The segment is
+    // removed by the destructor, thus after the caller has had the
+    // opportunity to write the info into the lock file.
+    Bool detach (MemoryIO& info);
+
+    // Get the name of the shared memory segment.
+    const String& name() const
+      { return itsName; }
+
+private:
+    // Copy constructor and assignment cannot be used.
+    // <group>
+    SharedMemLock (const SharedMemLock&);
+    SharedMemLock& operator= (const SharedMemLock&);
+    // </group>
+
+    // Try to create the segment. It returns False if it already exists.
+    Bool create();
+
+    // Try to attach to an existing segment. It returns False if the
+    // segment does not exist (anymore) or is not initialized yet.
+    // A segment whose creator died before initializing it, is removed.
+    Bool attach();
+
+    // Lock and unlock the mutex in the segment.
+    // <group>
+    void lockMutex();
+    void unlockMutex();
+    // </group>
+
+    // Remove the locks and registrations of processes which died.
+    void removeDead();
+
+    // Test if the lock can be granted (mutex must be locked).
+    Bool canGrant (FileLocker::LockType type) const;
+
+    // Grant the lock (mutex must be locked).
+    void grant (FileLocker::LockType type);
+
+    // Remove the read and write lock of this process (mutex must be locked).
+    void removeLocks();
+
+    // Unmap the segment.
+    void unmap();
+
+    //# Data members.
+    void*  itsData;            //# pointer to the mapped segment
+    String itsName;
+    Int    itsPid;
+    Bool   itsIsNew;
+    Bool   itsDetached;
+    Bool   itsRemove;          //# remove segment in destructor?
+    Bool   itsReadLocked;
+    Bool   itsWriteLocked;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
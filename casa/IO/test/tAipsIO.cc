@@ -30,11 +30,15 @@
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/IO/MemoryIO.h>
 #include <casacore/casa/IO/RawIO.h>
+#include <casacore/casa/IO/CanonicalIO.h>
 #include <casacore/casa/IO/MultiFile.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
+#include <cstring>
 
 
 #include <casacore/casa/namespace.h>
@@ -54,11 +58,13 @@
 void doit (Bool doExcp);
 void doIO (Bool doExcp, Bool out, AipsIO&);
 void doTry (AipsIO&);
+void doBuffer();
 
 int main (int argc, const char*[])
 {
     try {
 	doit (argc<2);
+	doBuffer();
     } catch (AipsError& x) {
 	cout << "\nCaught an exception: " << x.getMesg() << endl;
         return 1;
@@ -513,3 +519,132 @@ void doTry (AipsIO& io)
     io.open ("tAipsIO_tmp.aa", ByteIO::New);
     io.close();
 }
+
+
+// Write nested objects with the buffered fast path (AipsIO on a ByteIO)
+// and without it (AipsIO on a TypeIO). The objects are such that the
+// buffer gets flushed while nested objects are still open.
+void putNested (AipsIO& io)
+{
+    Int arr[30000];
+    for (Int i=0; i<30000; i++) {
+        arr[i] = i-10;
+    }
+    Bool barr[13];
+    for (Int i=0; i<13; i++) {
+        barr[i] = (i%3 == 0);
+    }
+    String strs[3];
+    strs[0] = "";
+    strs[1] = "a string";
+    strs[2] = String(70000, 'x');
+    // A Bool array needing more bits than fit in the buffer.
+    Block<Bool> bigBool(600001);
+    for (uInt i=0; i<bigBool.size(); i++) {
+        bigBool[i] = (i%7 == 0);
+    }
+    io.putstart ("outer", 1);
+    io << Short(-3) << uInt64(1) << Complex(1,2) << DComplex(-3,4);
+    io.put (bigBool.size(), bigBool.storage());
+    for (uInt i=0; i<3; i++) {
+        io.putstart ("inner", 2);
+        io.put (30000, arr);
+        io.putstart ("innermost", 3);
+        for (Int j=0; j<20000; j++) {
+            io << Double(j);
+        }
+        io.put (13, barr);
+        io.putend();
+        io.put (3, strs);
+        io.putend();
+    }
+    io << True;
+    io.putend();
+}
+
+void getNested (AipsIO& io)
+{
+    Short sv;
+    uInt64 uv;
+    Complex cv;
+    DComplex dv;
+    AlwaysAssertExit (io.getstart ("outer") == 1);
+    io >> sv >> uv >> cv >> dv;
+    AlwaysAssertExit (sv == -3  &&  uv == 1);
+    AlwaysAssertExit (cv == Complex(1,2)  &&  dv == DComplex(-3,4));
+    uInt nbig;
+    Bool* bigBool;
+    io.getnew (nbig, bigBool);
+    AlwaysAssertExit (nbig == 600001);
+    for (uInt i=0; i<nbig; i++) {
+        AlwaysAssertExit (bigBool[i] == (i%7 == 0));
+    }
+    delete [] bigBool;
+    for (uInt i=0; i<3; i++) {
+        AlwaysAssertExit (io.getNextType() == "inner");
+        AlwaysAssertExit (io.getstart ("inner") == 2);
+        uInt n;
+        Int* arr;
+        io.getnew (n, arr);
+        AlwaysAssertExit (n == 30000  &&  arr[0] == -10  &&  arr[29999] == 29989);
+        delete [] arr;
+        AlwaysAssertExit (io.getstart ("innermost") == 3);
+        for (Int j=0; j<20000; j++) {
+            Double d;
+            io >> d;
+            AlwaysAssertExit (d == j);
+        }
+        Bool* barr;
+        io.getnew (n, barr);
+        AlwaysAssertExit (n == 13);
+        for (Int j=0; j<13; j++) {
+            AlwaysAssertExit (barr[j] == (j%3 == 0));
+        }
+        delete [] barr;
+        io.getend();
+        String* strs;
+        io.getnew (n, strs);
+        AlwaysAssertExit (n == 3  &&  strs[0].empty()  &&  strs[1] == "a string");
+        AlwaysAssertExit (strs[2] == String(70000, 'x'));
+        delete [] strs;
+        io.getend();
+    }
+    Bool b;
+    io >> b;
+    AlwaysAssertExit (b);
+    io.getend();
+}
+
+void doBuffer()
+{
+    cout << endl << "Test buffered AipsIO ..." << endl;
+    MemoryIO membuf1;
+    MemoryIO membuf2;
+    {
+        AipsIO io(&membuf1);
+        putNested (io);
+        putNested (io);
+        // The ByteIO must be up-to-date after the outermost putend.
+        AlwaysAssertExit (io.getpos() == membuf1.length());
+    }
+    {
+        CanonicalIO cio(&membuf2);
+        AipsIO io(&cio);
+        putNested (io);
+        putNested (io);
+    }
+    AlwaysAssertExit (membuf1.length() == membuf2.length());
+    AlwaysAssertExit (memcmp (membuf1.getBuffer(), membuf2.getBuffer(),
+                              membuf1.length()) == 0);
+    cout << "buffered and unbuffered output are equal" << endl;
+    {
+        MemoryIO membuf (membuf1.getBuffer(), membuf1.length());
+        AipsIO io(&membuf);
+        getNested (io);
+        // The ByteIO must be positioned after the object.
+        AlwaysAssertExit (io.getpos() == membuf.seek (0, ByteIO::Current));
+        getNested (io);
+        AlwaysAssertExit (io.getpos() == membuf.length());
+    }
+    cout << "buffered input is correct" << endl;
+}
@@ -0,0 +1,248 @@
+//# tSharedMemLock.cc: Test program for shared memory locking
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/IO/LockFile.h>
+#include <casacore/casa/IO/SharedMemLock.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <string.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class SharedMemLock and its use in LockFile.
+// </summary>
+
+const String lockName ("tSharedMemLock_tmp.lock");
+
+// Put a string into a MemoryIO object.
+void putString (MemoryIO& info, const char* str)
+{
+  info.clear();
+  info.write (strlen(str), str);
+}
+
+// Check if the MemoryIO object contains the given string.
+Bool checkString (MemoryIO& info, const char* str)
+{
+  uInt leng = strlen(str);
+  return (info.length() == Int64(leng)  &&
+          memcmp (info.getBuffer(), str, leng) == 0);
+}
+
+// The child process tries to get the write lock held by the parent.
+// It waits for it, checks the info, writes new info and releases the lock.
+int doChild()
+{
+  LockFile lock (lockName, 0, False, True, True, 0, False, False, True);
+  if (lock.canLock (FileLocker::Write)  ||  lock.canLock (FileLocker::Read)) {
+    return 2;
+  }
+  if (lock.acquire (FileLocker::Write, 1)) {
+    return 3;
+  }
+  MemoryIO info;
+  if (! lock.acquire (info, FileLocker::Write, 0)) {
+    return 4;
+  }
+  if (! checkString (info, "parent info")) {
+    return 5;
+  }
+  putString (info, "child info");
+  lock.release (info);
+  return 0;
+}
+
+void doTest()
+{
+  LockFile lock (lockName, 0, True, True, True, 0, False, False, True);
+  MemoryIO info;
+  AlwaysAssertExit (lock.acquire (info, FileLocker::Write, 1));
+  AlwaysAssertExit (lock.hasLock (FileLocker::Write));
+  AlwaysAssertExit (lock.hasLock (FileLocker::Read));
+  AlwaysAssertExit (info.length() == 0);
+  AlwaysAssertExit (! lock.inspect (True));
+  putString (info, "parent info");
+  lock.putInfo (info);
+  pid_t pid = fork();
+  AlwaysAssertExit (pid >= 0);
+  if (pid == 0) {
+    int status = 1;
+    try {
+      status = doChild();
+    } catch (AipsError& x) {
+      cout << "Child caught an exception: " << x.getMesg() << endl;
+    }
+    _exit (status);
+  }
+  // Wait (at most 20 seconds) until the child requests the lock.
+  Bool requested = False;
+  for (uInt i=0; i<2000  &&  !requested; ++i) {
+    requested = lock.inspect (True);
+    if (!requested) {
+      usleep (10000);
+    }
+  }
+  AlwaysAssertExit (requested);
+  AlwaysAssertExit (lock.release());
+  AlwaysAssertExit (! lock.hasLock (FileLocker::Read));
+  int status;
+  AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+  AlwaysAssertExit (WIFEXITED(status));
+  AlwaysAssertExit (WEXITSTATUS(status) == 0);
+  // The child has written the info and exited.
+  AlwaysAssertExit (lock.acquire (info, FileLocker::Read, 1));
+  AlwaysAssertExit (checkString (info, "child info"));
+  AlwaysAssertExit (lock.canLock (FileLocker::Write));
+  AlwaysAssertExit (lock.release());
+}
+
+void checkFile()
+{
+  // The last process detaching writes the info into the lock file.
+  {
+    LockFile lock (lockName);
+    MemoryIO info;
+    AlwaysAssertExit (lock.acquire (info, FileLocker::Read, 1));
+    AlwaysAssertExit (checkString (info, "child info"));
+  }
+  // A new segment gets initialized from the lock file.
+  {
+    LockFile lock (lockName, 0, False, True, True, 0, False, False, True);
+    MemoryIO info;
+    AlwaysAssertExit (lock.acquire (info, FileLocker::Read, 1));
+    AlwaysAssertExit (checkString (info, "child info"));
+  }
+  // Using another lock sequence number gives another segment.
+  {
+    SharedMemLock shm1 (lockName, 0);
+    SharedMemLock shm2 (lockName, 1);
+    AlwaysAssertExit (shm1.isNew()  &&  shm2.isNew());
+    AlwaysAssertExit (shm1.name() != shm2.name());
+    MemoryIO info;
+    shm1.initialize (info);
+    shm2.initialize (info);
+    AlwaysAssertExit (shm1.acquire (FileLocker::Write, 1));
+    AlwaysAssertExit (shm2.canLock (FileLocker::Write));
+    AlwaysAssertExit (shm1.nrRequests() == 0);
+  }
+}
+
+// Processes using file locking cannot get a write lock while shared
+// memory locking is used and vice versa.
+void checkFilePeer()
+{
+  {
+    LockFile lock (lockName, 0, False, True, True, 0, False, False, True);
+    AlwaysAssertExit (lock.usesSharedMemory());
+    pid_t pid = fork();
+    AlwaysAssertExit (pid >= 0);
+    if (pid == 0) {
+      int status = 1;
+      try {
+        LockFile flock (lockName);
+        status = (flock.canLock (FileLocker::Write)  ||
+                  flock.acquire (FileLocker::Write, 1)  ?  2 : 0);
+      } catch (AipsError& x) {
+        cout << "Child caught an exception: " << x.getMesg() << endl;
+      }
+      _exit (status);
+    }
+    int status;
+    AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+    AlwaysAssertExit (WIFEXITED(status)  &&  WEXITSTATUS(status) == 0);
+  }
+  {
+    LockFile flock (lockName);
+    AlwaysAssertExit (flock.acquire (FileLocker::Write, 1));
+    pid_t pid = fork();
+    AlwaysAssertExit (pid >= 0);
+    if (pid == 0) {
+      int status = 1;
+      try {
+        LockFile lock (lockName, 0, False, True, True, 0, False, False, True);
+        status = (lock.usesSharedMemory()  ?  2 : 0);
+      } catch (AipsError& x) {
+        cout << "Child caught an exception: " << x.getMesg() << endl;
+      }
+      _exit (status);
+    }
+    int status;
+    AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+    AlwaysAssertExit (WIFEXITED(status)  &&  WEXITSTATUS(status) == 0);
+  }
+}
+
+// A segment whose creator died before initializing it is replaced.
+void checkStale()
+{
+  pid_t pid = fork();
+  AlwaysAssertExit (pid >= 0);
+  if (pid == 0) {
+    int status = 1;
+    try {
+      // Exit without initializing and removing the segment.
+      SharedMemLock* shm = new SharedMemLock (lockName, 7);
+      status = (shm->isNew()  ?  0 : 2);
+    } catch (AipsError& x) {
+      cout << "Child caught an exception: " << x.getMesg() << endl;
+    }
+    _exit (status);
+  }
+  int status;
+  AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+  AlwaysAssertExit (WIFEXITED(status)  &&  WEXITSTATUS(status) == 0);
+  SharedMemLock shm (lockName, 7);
+  AlwaysAssertExit (shm.isNew());
+  MemoryIO info;
+  shm.initialize (info);
+  AlwaysAssertExit (shm.acquire (FileLocker::Write, 1));
+}
+
+int main()
+{
+  if (! SharedMemLock::isSupported()) {
+    cout << "Shared memory locking is not supported on this system" << endl;
+    return 3;                           // untested
+  }
+  try {
+    doTest();
+    checkFile();
+    checkFilePeer();
+    checkStale();
+    RegularFile(lockName).remove();
+  } catch (AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;                             // exit with success status
+}
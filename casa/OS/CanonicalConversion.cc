@@ -135,6 +135,9 @@ size_t CanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE  && \
+	      Conversion::byteSwap (to, from, nr, SIZE)) { \
+	/* Only the byte order differs; swap all values in one pass. */ \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -153,6 +156,9 @@ size_t CanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE  && \
+	      Conversion::byteSwap (to, from, nr, SIZE)) { \
+	/* Only the byte order differs; swap all values in one pass. */ \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
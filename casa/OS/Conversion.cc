@@ -34,6 +34,12 @@
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -515,6 +521,138 @@ void Conversion::bitToBool (void* to, const void* from,
 }
 
 
+//# Byte swap a single unsigned value. Compilers turn these into a
+//# bswap/rev instruction.
+static inline uint16_t swapValue (uint16_t v)
+{
+    return uint16_t((v >> 8) | (v << 8));
+}
+static inline uint32_t swapValue (uint32_t v)
+{
+    return ((v >> 24)             | ((v >> 8) & 0xff00u) |
+            ((v << 8) & 0xff0000u) | (v << 24));
+}
+static inline uint64_t swapValue (uint64_t v)
+{
+    return (uint64_t(swapValue (uint32_t(v))) << 32) |
+            swapValue (uint32_t(v >> 32));
+}
+
+//# Swap the values in the bytes [start,nbytes) one by one.
+//# memcpy is used to deal with unaligned buffers.
+template<typename U>
+static inline void swapValues (char* to, const char* from,
+                               size_t start, size_t nbytes)
+{
+    U v;
+    for (size_t i=start; i<nbytes; i+=sizeof(U)) {
+        memcpy (&v, from+i, sizeof(U));
+        v = swapValue(v);
+        memcpy (to+i, &v, sizeof(U));
+    }
+}
+
+//# Swap the values in full blocks of 16 (or 32) bytes using a byte shuffle.
+//# The shuffle mask is given for 32 bytes; it returns the number of
+//# bytes done. Without SSSE3 the values are swapped using shifts and
+//# 16-bit shuffles in SSE2 registers.
+static inline size_t swapBlocks (char* to, const char* from, size_t nbytes,
+                                 const char* mask, size_t valueSize)
+{
+    size_t i = 0;
+#ifdef __AVX2__
+    __m256i mask32 = _mm256_loadu_si256((const __m256i*)mask);
+    for (; i+32 <= nbytes; i+=32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(from+i));
+        _mm256_storeu_si256((__m256i*)(to+i), _mm256_shuffle_epi8(v, mask32));
+    }
+#endif
+#if defined(__SSSE3__)
+    (void)valueSize;
+    __m128i mask16 = _mm_loadu_si128((const __m128i*)mask);
+    for (; i+16 <= nbytes; i+=16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(from+i));
+        _mm_storeu_si128((__m128i*)(to+i), _mm_shuffle_epi8(v, mask16));
+    }
+#elif defined(__SSE2__)
+    (void)mask;
+    for (; i+16 <= nbytes; i+=16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(from+i));
+        //# First reverse the 16-bit words within each value.
+        if (valueSize == 4) {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+        } else if (valueSize == 8) {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+        }
+        //# Then swap the bytes within each word.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i*)(to+i), v);
+    }
+#else
+    (void)to; (void)from; (void)nbytes; (void)mask; (void)valueSize;
+#endif
+    return i;
+}
+
+void Conversion::byteSwap2 (void* to, const void* from, size_t nvalues)
+{
+    static const char mask[32] = { 1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8,11,10,13,12,15,14,
+                                   1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8,11,10,13,12,15,14};
+    char* out = (char*)to;
+    const char* in = (const char*)from;
+    size_t nbytes = 2*nvalues;
+    size_t done = swapBlocks (out, in, nbytes, mask, 2);
+    swapValues<uint16_t> (out, in, done, nbytes);
+}
+
+void Conversion::byteSwap4 (void* to, const void* from, size_t nvalues)
+{
+    static const char mask[32] = { 3, 2, 1, 0, 7, 6, 5, 4,
+                                  11,10, 9, 8,15,14,13,12,
+                                   3, 2, 1, 0, 7, 6, 5, 4,
+                                  11,10, 9, 8,15,14,13,12};
+    char* out = (char*)to;
+    const char* in = (const char*)from;
+    size_t nbytes = 4*nvalues;
+    size_t done = swapBlocks (out, in, nbytes, mask, 4);
+    swapValues<uint32_t> (out, in, done, nbytes);
+}
+
+void Conversion::byteSwap8 (void* to, const void* from, size_t nvalues)
+{
+    static const char mask[32] = { 7, 6, 5, 4, 3, 2, 1, 0,
+                                  15,14,13,12,11,10, 9, 8,
+                                   7, 6, 5, 4, 3, 2, 1, 0,
+                                  15,14,13,12,11,10, 9, 8};
+    char* out = (char*)to;
+    const char* in = (const char*)from;
+    size_t nbytes = 8*nvalues;
+    size_t done = swapBlocks (out, in, nbytes, mask, 8);
+    swapValues<uint64_t> (out, in, done, nbytes);
+}
+
+Bool Conversion::byteSwap (void* to, const void* from, size_t nvalues,
+                           size_t valueSize)
+{
+    switch (valueSize) {
+    case 2:
+        byteSwap2 (to, from, nvalues);
+        return True;
+    case 4:
+        byteSwap4 (to, from, nvalues);
+        return True;
+    case 8:
+        byteSwap8 (to, from, nvalues);
+        return True;
+    }
+    return False;
+}
+
+
 size_t Conversion::valueCopy (void* to, const void* from,
                               size_t nbytes)
 {
@@ -130,6 +130,23 @@ public:
 			   size_t nvalues);
     // </group>
 
+    // Reverse the byte order of <src>nvalues</src> values of 2, 4 or 8 bytes
+    // while copying them from <src>from</src> to <src>to</src>.
+    // The buffers do not need to be aligned. They can be the same
+    // (in-place swap), but should not overlap partially.
+    // SSSE3 or AVX2 shuffles are used if the library is compiled for them.
+    // <group>
+    static void byteSwap2 (void* to, const void* from, size_t nvalues);
+    static void byteSwap4 (void* to, const void* from, size_t nvalues);
+    static void byteSwap8 (void* to, const void* from, size_t nvalues);
+    // </group>
+
+    // Reverse the byte order of <src>nvalues</src> values of
+    // <src>valueSize</src> bytes using the functions above.
+    // It returns False (and does nothing) if the value size is not 2, 4 or 8.
+    static Bool byteSwap (void* to, const void* from, size_t nvalues,
+                          size_t valueSize);
+
     // Copy a value using memcpy.
     // It differs from memcpy in the return value.
     // <note> This version has the <src>ValueFunction</src> signature,
@@ -31,6 +31,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <string.h>
 
 
 #include <casacore/casa/namespace.h>
@@ -70,6 +71,53 @@ void checkAll()
   }
 }
 
+// Check the bulk byte swap for all lengths up to a few blocks, unaligned
+// buffers and in-place swapping.
+void checkSwap (size_t valueSize)
+{
+  cout << "checkSwap " << valueSize << " ..." << endl;
+  char in[8*80+1];
+  char out[8*80+1];
+  for (uInt i=0; i<sizeof(in); ++i) {
+    in[i] = char(i*7 + 3);
+  }
+  for (uInt offset=0; offset<2; ++offset) {
+    for (size_t nr=0; nr<80; ++nr) {
+      memset (out, 0, sizeof(out));
+      const char* from = in + offset;
+      char* to = out + offset;
+      switch (valueSize) {
+      case 2:
+        Conversion::byteSwap2 (to, from, nr);
+        break;
+      case 4:
+        Conversion::byteSwap4 (to, from, nr);
+        break;
+      default:
+        Conversion::byteSwap8 (to, from, nr);
+        break;
+      }
+      for (size_t i=0; i<nr; ++i) {
+        for (size_t j=0; j<valueSize; ++j) {
+          AlwaysAssertExit (to[i*valueSize + j] ==
+                            from[i*valueSize + valueSize-1-j]);
+        }
+      }
+      // Bytes beyond the values should be untouched.
+      AlwaysAssertExit (to[nr*valueSize] == 0);
+    }
+  }
+  // Swapping twice in place should give the original values.
+  memcpy (out, in, sizeof(in));
+  for (uInt i=0; i<2; ++i) {
+    AlwaysAssertExit (Conversion::byteSwap (out+1, out+1, 77, valueSize));
+    AlwaysAssertExit ((memcmp (out, in, sizeof(in)) == 0) == (i==1));
+  }
+  // Other value sizes are not supported and leave the data untouched.
+  AlwaysAssertExit (! Conversion::byteSwap (out, in, 10, valueSize+1));
+  AlwaysAssertExit (memcmp (out, in, sizeof(in)) == 0);
+}
+
 int main()
 {
     uInt nbool = 100;
@@ -155,6 +203,9 @@ int main()
     delete [] bits;
 
     checkAll();
+    checkSwap (2);
+    checkSwap (4);
+    checkSwap (8);
     cout << "OK" << endl;
     return 0;
 }
@@ -27,6 +27,7 @@
 
 //# Includes
 #include <casacore/casa/Quanta/MVBaseline.h>
+#include <casacore/casa/Arrays/FixedArray.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Utilities/Register.h>
@@ -212,8 +213,8 @@ const Vector<Double> &MVBaseline::getValue() const {
 }
 
 Quantum<Vector<Double> > MVBaseline::getAngle() const{
-  Vector<Double> tp(3), tmp(2);
-  tp = get();
+  const Vector<Double> tp(get());
+  Vector<Double> tmp(2);
   tmp(0) = tp(1);
   tmp(1) = tp(2);
   return Quantum<Vector<Double> >(tmp,"rad");
@@ -233,10 +234,8 @@ Quantity MVBaseline::getLength(const Unit &unit) const {
 }
 
 Double MVBaseline::BaselineAngle(const MVBaseline &other) const {
-  Vector<Double> t1(3);
-  Vector<Double> t2(3);
-  t1 = get();
-  t2 = other.get();
+  const Vector<Double> t1(get());
+  const Vector<Double> t2(other.get());
   Double s1,c1;
   c1 = std::cos(t1(2)) * std::sin(t2(2)) -
     std::sin(t1(2)) * std::cos(t2(2)) * std::cos(t1(1) - t2(1));
@@ -298,8 +297,7 @@ void MVBaseline::putVector(const Vector<Double> &in) {
 }
 
 Vector<Quantum<Double> > MVBaseline::getRecordValue() const {
-  Vector<Double> t(3);
-  t = get();
+  const Vector<Double> t(get());
   Vector<Quantum<Double> > tmp(3);
   tmp(2) = Quantity(t(0), "m");
   tmp(0) = Quantity(t(1), "rad"); 
@@ -326,7 +324,7 @@ Bool MVBaseline::putValue(const Vector<Quantum<Double> > &in) {
       }
     } else if (in(1).check(UnitVal::ANGLE) &&
 	       in(2).check(UnitVal::ANGLE)) {
-      Vector<Double> tsin(2), tcos(2);
+      FixedVector<Double,2> tsin, tcos;
       for (uInt j=1; j < i; j++) {
 	tsin(j-1) = (sin(in(j))).getValue(); 
 	tcos(j-1) = (cos(in(j))).getValue(); 
@@ -342,7 +340,7 @@ Bool MVBaseline::putValue(const Vector<Quantum<Double> > &in) {
   } else if (in(2).check(UnitVal::LENGTH)) {
     if (in(0).check(UnitVal::ANGLE) &&
 	in(1).check(UnitVal::ANGLE)) {
-      Vector<Double> tsin(2), tcos(2);
+      FixedVector<Double,2> tsin, tcos;
       Int j;
       for (j=0; j < 2; j++) {
 	tsin(j) = (sin(in(j))).getValue(); 
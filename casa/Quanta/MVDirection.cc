@@ -33,6 +33,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Register.h>
 #include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/casa/Arrays/FixedArray.h>
 #include <casacore/casa/Quanta/UnitVal.h>
 #include <casacore/casa/Quanta/QMath.h>
 #include <casacore/casa/Quanta/Unit.h>
@@ -186,8 +187,7 @@ Quantity MVDirection::getLat(const Unit &unit) const {
 }
 
 Vector<Quantum<Double> > MVDirection::getRecordValue() const {
-  Vector<Double> t(2);
-  t = get();
+  const Vector<Double> t(get());
   Vector<Quantum<Double> > tmp(2);
   tmp(0) = Quantity(t(0), "rad"); 
   tmp(1) = Quantity(t(1), "rad"); 
@@ -222,7 +222,7 @@ Bool MVDirection::putValue(const Vector<Quantum<Double> > &in) {
     for (j = 0; j<i; j++) {
       if (!in(j).check(UnitVal::ANGLE)) return False;
     }
-    Vector<Double> tsin(i), tcos(i);
+    FixedVector<Double,3> tsin, tcos;
     for (j=0; j < i; j++) {
       tsin(j) = (sin(in(j))).getValue(); 
       tcos(j) = (cos(in(j))).getValue(); 
@@ -323,8 +323,7 @@ void MVDirection::shift(const Quantum<Double> &lng,
 }
 
 void MVDirection::shift(Double lng, Double lat, Bool trueAngle) {
-  Vector<Double> x(2);
-  x = get();
+  Vector<Double> x(get());
   if (trueAngle) {
   // The following calculation could maybe done quicker, but for now this
   // is more transparent.
@@ -355,8 +354,7 @@ void MVDirection::shiftLatitude(Double lat, Bool trueAngle) {
 }
 
 void MVDirection::shift(const MVDirection &shft, Bool trueAngle) {
-  Vector<Double> x(2);
-  x = shft.get();
+  const Vector<Double> x(shft.get());
   shift(x(0), x(1), trueAngle);
 }
 
@@ -366,8 +364,7 @@ void MVDirection::shiftAngle(const Quantum<Double> &off,
 }
 
 void MVDirection::shiftAngle(Double off, Double pa) {
-  Vector<Double> x(2);
-  x = get();
+  Vector<Double> x(get());
   Double nlat = std::asin(std::cos(off)*std::sin(x(1)) + std::sin(off)*std::cos(x(1))*std::cos(pa));
   Double nlng = std::sin(off)*std::sin(pa);
   if (std::cos(nlat) != 0) {
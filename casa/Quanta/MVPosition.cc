@@ -31,6 +31,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Register.h>
 #include <casacore/casa/Quanta/MVPosition.h>
+#include <casacore/casa/Arrays/FixedArray.h>
 #include <casacore/casa/Quanta/RotMatrix.h>
 #include <casacore/casa/Quanta/UnitVal.h>
 #include <casacore/casa/Quanta/QMath.h>
@@ -340,8 +341,8 @@ const Vector<Double> &MVPosition::getValue() const {
 }
 
 Quantum<Vector<Double> > MVPosition::getAngle() const{
-  Vector<Double> tp(3), tmp(2);
-  tp = get();
+  const Vector<Double> tp(get());
+  Vector<Double> tmp(2);
   tmp(0) = tp(1);
   tmp(1) = tp(2);
   return Quantum<Vector<Double> >(tmp,"rad");
@@ -444,8 +445,7 @@ void MVPosition::putVector(const Vector<Double> &in) {
 }
 
 Vector<Quantum<Double> > MVPosition::getRecordValue() const {
-  Vector<Double> t(3);
-  t = get();
+  const Vector<Double> t(get());
   Vector<Quantum<Double> > tmp(3);
   tmp(2) = Quantity(t(0), "m");
   tmp(0) = Quantity(t(1), "rad"); 
@@ -473,7 +473,7 @@ Bool MVPosition::putValue(const Vector<Quantum<Double> > &in) {
       }
     } else if (in(1).check(UnitVal::ANGLE) &&
 	       in(2).check(UnitVal::ANGLE)) {
-      Vector<Double> tsin(2), tcos(2);
+      FixedVector<Double,2> tsin, tcos;
       uInt j;
       for (j=1; j < i; j++) {
 	tsin(j-1) = (sin(in(j))).getValue(); 
@@ -493,7 +493,7 @@ Bool MVPosition::putValue(const Vector<Quantum<Double> > &in) {
   } else if (in(2).check(UnitVal::LENGTH)) {
     if (in(0).check(UnitVal::ANGLE) &&
 	in(1).check(UnitVal::ANGLE)) {
-      Vector<Double> tsin(2), tcos(2);
+      FixedVector<Double,2> tsin, tcos;
       Int j;
       for (j=0; j < 2; j++) {
 	tsin(j) = (sin(in(j))).getValue(); 
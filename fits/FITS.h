@@ -33,6 +33,7 @@
 #include <casacore/fits/FITS/BinTable.h> 
 #include <casacore/fits/FITS/blockio.h>         
 #include <casacore/fits/FITS/CopyRecord.h>        
+#include <casacore/fits/FITS/FITSColumnReader.h>
 #include <casacore/fits/FITS/FITS2.h>             
 #include <casacore/fits/FITS/FITSDateUtil.h>    
 #include <casacore/fits/FITS/FITSError.h>        
@@ -136,6 +137,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //       enumerations. They form the basic vocabulary of a FITS application. For example,
 //       instead of referring to the FITS <src>NAXIS</src> keyword, 
 //       <src>FITS::NAXIS</src> should be used.
+//  <li> Class <linkto class=FITSColumnReader:description>
+//       FITSColumnReader</linkto>
+//       Read selected columns of a FITS binary table in blocks of rows
+//       directly into arrays.
 //  <li> Class <linkto class=FITSDateUtil:description>
 //       FITSDateUtil</linkto>
 //       A class with static functions to help deal with FITS dates
@@ -28,6 +28,7 @@
 //# Includes
 #include <casacore/fits/FITS/BinTable.h>
 #include <casacore/fits/FITS/fits.h>
+#include <casacore/fits/FITS/FITSColumnReader.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/DataMan/IncrementalStMan.h>
@@ -43,6 +44,7 @@
 #include <casacore/tables/Tables/RowCopier.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Utilities/Regex.h>
 #include <casacore/casa/sstream.h>
@@ -979,18 +981,7 @@ Table BinaryTable::fullTable(const String& tabname,
 
     //		and actually create the table
     Table full(newtab,nrows());
-    RowCopier rowcop(full, *currRowTab);
-    //			loop over all rows remaining
-    for (Int outrow = 0, infitsrow = currrow(); infitsrow < nrows(); 
-	 outrow++, infitsrow++) {
-	rowcop.copy(outrow, 0);
-	//		don't read past the end of the table
-	if ((infitsrow+1) < nrows()) {
-	    if (!theheap_p) read(1);
-	    else ++(*this);
-	    fillRow();
-	}
-    }		// end of loop over rows
+    fillTable(full);
     return full;
 }
 
@@ -1001,7 +992,154 @@ Table BinaryTable::fullTable()
        newtab.bindAll(stman);
     //		and actually create the table
     Table *full= new Table(newtab,Table::Memory, nrows());
-    RowCopier rowcop(*full, *currRowTab);
+    fillTable(*full);
+    return *full;
+}
+
+// Apply TSCALn and TZEROn to a block of values in the same way as fillRow.
+// As in there, integer columns are not scaled.
+// <group>
+template<typename T>
+static void binTableScale(Array<T>&, Double, Double)
+{}
+static void binTableScale(Array<Float>& values, Double scale, Double zero)
+{
+    if (scale != 1) {
+	Array<Double> dvalues(values.shape());
+	convertArray(dvalues, values);
+	dvalues *= scale;
+	dvalues += zero;
+	convertArray(values, dvalues);
+    } else if (zero != 0) {
+	values += (Float )zero;
+    }
+}
+static void binTableScale(Array<Double>& values, Double scale, Double zero)
+{
+    if (scale != 1) {
+	values *= scale;
+	values += zero;
+    } else if (zero != 0) {
+	values += zero;
+    }
+}
+static void binTableScale(Array<Complex>& values, Double scale, Double zero)
+{
+    if (scale != 1) {
+	values *= Complex(scale,0);
+	values += Complex(zero,0);
+    } else if (zero != 0) {
+	values += Complex(zero,0);
+    }
+}
+static void binTableScale(Array<DComplex>& values, Double scale, Double zero)
+{
+    if (scale != 1) {
+	values *= DComplex(scale,0);
+	values += DComplex(zero,0);
+    } else if (zero != 0) {
+	values += DComplex(zero,0);
+    }
+}
+// </group>
+
+// Put a block of values read by FITSColumnReader into a column
+// after applying the scale and zero.
+template<typename T>
+static void binTablePutColumn(Table& tab, const String& colName,
+			      const Record& block, uInt fld,
+			      uInt startRow, uInt nrow,
+			      Double scale, Double zero)
+{
+    Slicer rows(IPosition(1,startRow), IPosition(1,nrow));
+    Array<T> values;
+    block.get(fld, values);
+    binTableScale(values, scale, zero);
+    if (tab.tableDesc().columnDesc(colName).isScalar()) {
+	ScalarColumn<T> col(tab, colName);
+	col.putColumnRange(rows, Vector<T>(values));
+    } else {
+	ArrayColumn<T> col(tab, colName);
+	col.putColumnRange(rows, values);
+    }
+}
+
+void BinaryTable::fillTable(Table& full)
+{
+    //		the current row has already been converted
+    RowCopier rowcop(full, *currRowTab);
+    //		the remaining rows (but the last) can be converted per
+    //		column if there is no heap and there are no virtual columns
+    Bool bulk = (!theheap_p && kwSet.nfields() == 0 &&
+		 currrow()+2 < nrows());
+    for (Int j=0; bulk && j<tfields(); j++) {
+	bulk = FITSColumnReader::isSupported(field(j).fieldtype());
+    }
+    if (bulk) {
+	rowcop.copy(0, 0);
+	const uInt nbulk = nrows() - currrow() - 2;
+	FITSColumnReader reader(*this, currrow()+1);
+	//		use blocks of about 1 MB
+	uInt blockRows = std::max(1u, (1024*1024) / std::max(1u, rowsize()));
+	uInt outrow = 1;
+	uInt nr;
+	while ((nr = reader.read(std::min(blockRows, nbulk+1-outrow))) > 0) {
+	    const Record& block = reader.block();
+	    for (uInt k=0; k<block.nfields(); k++) {
+		const Int j = reader.columnNumbers()[k];
+		const String& colName = (*colNames)(j);
+		switch (block.dataType(k)) {
+		case TpArrayBool:
+		    binTablePutColumn<Bool>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayUChar:
+		    binTablePutColumn<uChar>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayShort:
+		    binTablePutColumn<Short>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayInt:
+		    binTablePutColumn<Int>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayFloat:
+		    binTablePutColumn<Float>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayDouble:
+		    binTablePutColumn<Double>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayComplex:
+		    binTablePutColumn<Complex>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayDComplex:
+		    binTablePutColumn<DComplex>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		case TpArrayString:
+		    binTablePutColumn<String>(full, colName, block, k, outrow, nr,
+						   tscal(j), tzero(j));
+		    break;
+		default:
+		    throw AipsError("BinaryTable: unexpected column data type");
+		}
+	    }
+	    outrow += nr;
+	}
+	//		the last row is read as usual, so afterwards the
+	//		current row and currRowTab are the last row as in the
+	//		row by row loop below
+	end_row += nbulk;
+	read(1);
+	fillRow();
+	rowcop.copy(outrow, 0);
+	return;
+    }
     //			loop over all rows remaining
     for (Int outrow = 0, infitsrow = currrow(); infitsrow < nrows(); 
 	 outrow++, infitsrow++) {
@@ -1013,7 +1151,6 @@ Table BinaryTable::fullTable()
 	    fillRow();
 	}
     }		// end of loop over rows
-    return *full;
 }
 
 
@@ -127,6 +127,9 @@ public:
     // The table will contain all data from the current row to the end of the
     // BinarTableExtension.If useMiriadSM is True, use the Miriad storage
     // manager for all columns, otherwise AipsIO.
+    // If the table has no variable length arrays and no virtual columns,
+    // the rows are converted in blocks per column using FITSColumnReader.
+    // In either case the current row is the last row afterwards.
     Table fullTable(const String& tabName, 
 		    const Table::TableOption = Table::NewNoReplace,
 		    Bool useMiriadSM = False);
@@ -177,6 +180,11 @@ private:
 
     // this is the function that fills each row in as needed
     void fillRow();
+
+    // Fill the given table with the rows from the current row on.
+    // Tables without heap and virtual columns are converted in blocks
+    // of rows using FITSColumnReader, otherwise row by row.
+    void fillTable(Table& full);
 };
 
 
@@ -0,0 +1,378 @@
+//# FITSColumnReader.cc: Read selected columns of a FITS binary table in blocks
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+//# Includes
+#include <casacore/fits/FITS/FITSColumnReader.h>
+#include <casacore/fits/FITS/hdu.h>
+#include <casacore/fits/FITS/fitsio.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/string.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// Copy the bytes of a field in each row to a contiguous buffer
+// and convert them from big-endian to local format.
+// The size of the values to be swapped is given (0 means no swap).
+static void fitsGetField (void* to, const char* from, uInt nrow,
+                          uInt rowSize, uInt nbytes, uInt swapSize)
+{
+  char* out = static_cast<char*>(to);
+  for (uInt i=0; i<nrow; ++i) {
+    memcpy (out, from, nbytes);
+    out  += nbytes;
+    from += rowSize;
+  }
+#if defined(AIPS_LITTLE_ENDIAN)
+  if (swapSize > 1) {
+    size_t nval = size_t(nrow) * nbytes / swapSize;
+    switch (swapSize) {
+    case 2:
+      Conversion::byteSwap2 (to, to, nval);
+      break;
+    case 4:
+      Conversion::byteSwap4 (to, to, nval);
+      break;
+    default:
+      Conversion::byteSwap8 (to, to, nval);
+      break;
+    }
+  }
+#endif
+}
+
+// Get the values of a numeric field in a new array.
+template<typename T>
+static void fitsGetArray (Record& rec, const String& name,
+                          const IPosition& shape, const char* from,
+                          uInt nrow, uInt rowSize, uInt nelem, uInt swapSize)
+{
+  Array<T> arr(shape);
+  Bool deleteIt;
+  T* data = arr.getStorage (deleteIt);
+  fitsGetField (data, from, nrow, rowSize, nelem*sizeof(T), swapSize);
+  arr.putStorage (data, deleteIt);
+  rec.define (name, arr);
+}
+
+
+FITSColumnReader::FITSColumnReader (FitsInput& fitsin,
+                                    const Vector<String>& columns)
+: itsTable    (0),
+  itsOwner    (True),
+  itsRowsRead (0)
+{
+  if (fitsin.rectype() != FITS::HDURecord  ||
+      fitsin.hdutype() != FITS::BinaryTableHDU) {
+    throw AipsError ("FITSColumnReader: FITS input is not positioned "
+                     "at a binary table");
+  }
+  itsTable = new BinaryTableExtension (fitsin);
+  if (itsTable->err() != HeaderDataUnit::OK) {
+    delete itsTable;
+    throw AipsError ("FITSColumnReader: binary table header is invalid");
+  }
+  Block<Int> fields;
+  if (columns.empty()) {
+    fields.resize (itsTable->ncols());
+    for (uInt i=0; i<fields.size(); ++i) {
+      fields[i] = i;
+    }
+  } else {
+    fields.resize (columns.size());
+    for (uInt i=0; i<fields.size(); ++i) {
+      fields[i] = findColumn (columns[i]);
+      if (fields[i] < 0) {
+        delete itsTable;
+        throw AipsError ("FITSColumnReader: column " + columns[i] +
+                         " does not exist");
+      }
+    }
+  }
+  try {
+    init (fields);
+  } catch (AipsError&) {
+    delete itsTable;
+    throw;
+  }
+}
+
+FITSColumnReader::FITSColumnReader (BinaryTableExtension& bintab,
+                                    uInt rowsRead,
+                                    const Vector<Int>& columns)
+: itsTable    (&bintab),
+  itsOwner    (False),
+  itsRowsRead (rowsRead)
+{
+  Block<Int> fields;
+  if (columns.empty()) {
+    fields.resize (itsTable->ncols());
+    for (uInt i=0; i<fields.size(); ++i) {
+      fields[i] = i;
+    }
+  } else {
+    fields.resize (columns.size());
+    for (uInt i=0; i<fields.size(); ++i) {
+      fields[i] = columns[i];
+      if (fields[i] < 0  ||  fields[i] >= itsTable->ncols()) {
+        throw AipsError ("FITSColumnReader: column number " +
+                         String::toString(fields[i]) + " does not exist");
+      }
+    }
+  }
+  init (fields);
+}
+
+FITSColumnReader::~FITSColumnReader()
+{
+  if (itsOwner) {
+    delete itsTable;
+  }
+}
+
+Bool FITSColumnReader::isSupported (FITS::ValueType type)
+{
+  switch (type) {
+  case FITS::LOGICAL:
+  case FITS::BIT:
+  case FITS::CHAR:
+  case FITS::BYTE:
+  case FITS::SHORT:
+  case FITS::LONG:
+  case FITS::FLOAT:
+  case FITS::DOUBLE:
+  case FITS::COMPLEX:
+  case FITS::ICOMPLEX:
+  case FITS::DCOMPLEX:
+    return True;
+  default:
+    break;
+  }
+  return False;
+}
+
+Int FITSColumnReader::findColumn (const String& name) const
+{
+  String uname(name);
+  uname.upcase();
+  for (Int i=0; i<itsTable->ncols(); ++i) {
+    String colName(itsTable->ttype(i));
+    colName.rtrim(' ');
+    colName.upcase();
+    if (colName == uname) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void FITSColumnReader::init (const Block<Int>& fields)
+{
+  itsNrow    = itsTable->nrows();
+  itsRowSize = itsTable->rowsize();
+  if (itsRowsRead > itsNrow) {
+    throw AipsError ("FITSColumnReader: more rows read than in table");
+  }
+  // Determine the offset of each field in a FITS row.
+  Block<uInt> offsets(itsTable->ncols() + 1);
+  offsets[0] = 0;
+  for (Int i=0; i<itsTable->ncols(); ++i) {
+    offsets[i+1] = offsets[i] + itsTable->field(i).fitsfieldsize();
+  }
+  // Keep the fields having elements.
+  uInt nfld = 0;
+  itsFields.resize (fields.size());
+  itsOffsets.resize (fields.size());
+  itsNames.resize (fields.size());
+  for (uInt i=0; i<fields.size(); ++i) {
+    Int fld = fields[i];
+    FITS::ValueType type = itsTable->field(fld).fieldtype();
+    if (! isSupported(type)) {
+      throw AipsError ("FITSColumnReader: column " +
+                       String(itsTable->ttype(fld)) +
+                       " has a variable length or unsupported data type");
+    }
+    if (itsTable->field(fld).nelements() > 0) {
+      String name(itsTable->ttype(fld));
+      name.rtrim(' ');
+      for (uInt j=0; j<nfld; ++j) {
+        if (itsNames[j] == name) {
+          name = String();
+          break;
+        }
+      }
+      if (name.empty()) {
+        name = "Col" + String::toString(fld+1);
+      }
+      itsFields[nfld]  = fld;
+      itsOffsets[nfld] = offsets[fld];
+      itsNames[nfld]   = name;
+      nfld++;
+    }
+  }
+  itsFields.resize (nfld, True, True);
+  itsOffsets.resize (nfld, True, True);
+  itsNames.resize (nfld, True);
+}
+
+uInt FITSColumnReader::read (uInt nrow)
+{
+  nrow = std::min (nrow, itsNrow - itsRowsRead);
+  if (nrow == 0) {
+    return 0;
+  }
+  Int nbytes = nrow * itsRowSize;
+  if (itsBuffer.size() < uInt(nbytes)) {
+    itsBuffer.resize (nbytes, True, False);
+  }
+  if (itsTable->ExtensionHeaderDataUnit::read (itsBuffer.storage(),
+                                               nbytes) != nbytes) {
+    throw AipsError ("FITSColumnReader: error reading rows " +
+                     String::toString(itsRowsRead) + " - " +
+                     String::toString(itsRowsRead + nrow - 1));
+  }
+  for (uInt i=0; i<itsFields.size(); ++i) {
+    convertColumn (i, nrow);
+  }
+  itsRowsRead += nrow;
+  return nrow;
+}
+
+void FITSColumnReader::convertColumn (uInt col, uInt nrow)
+{
+  const FitsBase& field = itsTable->field (itsFields[col]);
+  const String& name = itsNames[col];
+  const char* from = itsBuffer.storage() + itsOffsets[col];
+  uInt nelem = field.nelements();
+  IPosition shape(1, nrow);
+  if (nelem > 1) {
+    shape = IPosition(2, nelem, nrow);
+  }
+  switch (field.fieldtype()) {
+  case FITS::LOGICAL:
+    {
+      Array<Bool> arr(shape);
+      Bool deleteIt;
+      Bool* data = arr.getStorage (deleteIt);
+      for (uInt i=0; i<nrow; ++i) {
+        const char* ptr = from + i*itsRowSize;
+        for (uInt j=0; j<nelem; ++j) {
+          *data++ = (ptr[j] == 'T');
+        }
+      }
+      data -= arr.size();
+      arr.putStorage (data, deleteIt);
+      itsBlock.define (name, arr);
+    }
+    break;
+  case FITS::BIT:
+    {
+      Array<Bool> arr(shape);
+      Bool deleteIt;
+      Bool* data = arr.getStorage (deleteIt);
+      for (uInt i=0; i<nrow; ++i) {
+        const uChar* ptr = (const uChar*)(from + i*itsRowSize);
+        for (uInt j=0; j<nelem; ++j) {
+          *data++ = ((ptr[j/8] & (0200 >> (j%8))) != 0);
+        }
+      }
+      data -= arr.size();
+      arr.putStorage (data, deleteIt);
+      itsBlock.define (name, arr);
+    }
+    break;
+  case FITS::CHAR:
+    {
+      Vector<String> vec(nrow);
+      for (uInt i=0; i<nrow; ++i) {
+        const char* ptr = from + i*itsRowSize;
+        uInt length = nelem;
+        while (length > 0  &&
+               (ptr[length-1] == '\0'  ||  ptr[length-1] == ' ')) {
+          length--;
+        }
+        vec[i] = String(ptr, length);
+      }
+      itsBlock.define (name, vec);
+    }
+    break;
+  case FITS::BYTE:
+    fitsGetArray<uChar> (itsBlock, name, shape, from, nrow, itsRowSize,
+                         nelem, 0);
+    break;
+  case FITS::SHORT:
+    fitsGetArray<Short> (itsBlock, name, shape, from, nrow, itsRowSize,
+                         nelem, 2);
+    break;
+  case FITS::LONG:
+    fitsGetArray<Int> (itsBlock, name, shape, from, nrow, itsRowSize,
+                       nelem, 4);
+    break;
+  case FITS::FLOAT:
+    fitsGetArray<Float> (itsBlock, name, shape, from, nrow, itsRowSize,
+                         nelem, 4);
+    break;
+  case FITS::DOUBLE:
+    fitsGetArray<Double> (itsBlock, name, shape, from, nrow, itsRowSize,
+                          nelem, 8);
+    break;
+  case FITS::COMPLEX:
+    fitsGetArray<Complex> (itsBlock, name, shape, from, nrow, itsRowSize,
+                           nelem, 4);
+    break;
+  case FITS::DCOMPLEX:
+    fitsGetArray<DComplex> (itsBlock, name, shape, from, nrow, itsRowSize,
+                            nelem, 8);
+    break;
+  case FITS::ICOMPLEX:
+    {
+      // Convert the integer pairs to DComplex.
+      Block<Int> ivals(2*nrow*nelem);
+      fitsGetField (ivals.storage(), from, nrow, itsRowSize,
+                    2*nelem*sizeof(Int), 4);
+      Array<DComplex> arr(shape);
+      Bool deleteIt;
+      DComplex* data = arr.getStorage (deleteIt);
+      for (uInt i=0; i<arr.size(); ++i) {
+        data[i] = DComplex(ivals[2*i], ivals[2*i+1]);
+      }
+      arr.putStorage (data, deleteIt);
+      itsBlock.define (name, arr);
+    }
+    break;
+  default:
+    throw AipsError ("FITSColumnReader: unsupported data type");
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
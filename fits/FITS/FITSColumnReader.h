@@ -0,0 +1,199 @@
+//# FITSColumnReader.h: Read selected columns of a FITS binary table in blocks
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#ifndef FITS_FITSCOLUMNREADER_H
+#define FITS_FITSCOLUMNREADER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/fits/FITS/fits.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class FitsInput;
+class BinaryTableExtension;
+
+
+// <summary>
+// Read selected columns of a FITS binary table in blocks of rows.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tFITSColumnReader">
+// </reviewed>
+
+// <prerequisite>
+//   <li> FitsInput
+//   <li> BinaryTableExtension
+//   <li> Record
+// </prerequisite>
+
+// <synopsis>
+// <linkto class=BinaryTable>BinaryTable</linkto> and
+// <linkto class=FITSTable>FITSTable</linkto> read a FITS binary table
+// row by row and convert each field of a row separately.
+// This class reads a block of rows at once and converts only the
+// selected columns of the block directly into arrays, one per column.
+// The conversion from big-endian FITS format is done for an entire column
+// of the block at once, which is much faster than converting each value.
+// <p>
+// The arrays are kept in a Record containing a field for each selected
+// column in the order given. The field name is the (trimmed) TTYPE of the
+// column; if empty or already used, <src>Col</src> followed by the
+// 1-based column number is used.
+// A scalar column results in a Vector with a value for each row in the
+// block. An array column results in a Matrix with shape
+// <src>[nelem,nrow]</src>, thus each column in the Matrix contains a row.
+// TDIM is not applied to the shape.
+// The FITS types are mapped to the same data types as BinaryTable does:
+// <ul>
+//  <li> LOGICAL and BIT are converted to Bool.
+//  <li> BYTE, SHORT, LONG, FLOAT, DOUBLE and COMPLEX are converted to
+//       uChar, Short, Int, Float, Double and Complex.
+//  <li> ICOMPLEX and DCOMPLEX are converted to DComplex.
+//  <li> A CHAR (i.e. character string) column is converted to String,
+//       where trailing blanks and zero bytes are removed.
+// </ul>
+// No scaling (TSCAL, TZERO) or blanking (TNULL) is applied.
+// Columns with variable length arrays (which are stored in the heap) cannot
+// be read; columns without elements are ignored.
+// <p>
+// BinaryTable::fullTable uses this class if possible. FITSTable (and thus
+// the fits2table program) still converts row by row, because it applies
+// scaling, TDIM and the SD-FITS virtual columns, which this class does not.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//    FitsInput infits("myFITSFile", FITS::Disk);
+//    infits.skip_hdu();       // skip the primary array
+//    Vector<String> cols(2);
+//    cols[0] = "TIME";
+//    cols[1] = "FLUX";
+//    FITSColumnReader reader(infits, cols);
+//    while (reader.read (1000) > 0) {
+//      Vector<Double> time (reader.block().asArrayDouble (0));
+//      Matrix<Float>  flux (reader.block().asArrayFloat (1));
+//      ...
+//    }
+// </srcblock>
+// </example>
+
+// <motivation>
+// Large SDFITS and FITS-IDI tables are often read for a few columns only,
+// so it is wasteful to convert all fields of all rows.
+// </motivation>
+
+class FITSColumnReader
+{
+public:
+  // Read the binary table at the current HDU of the FitsInput.
+  // Only the given columns are read; if no columns are given, all columns
+  // are read. An exception is thrown if the HDU is not a binary table,
+  // if a column does not exist or if its type is not supported.
+  explicit FITSColumnReader (FitsInput& fitsin,
+                             const Vector<String>& columns = Vector<String>());
+
+  // Read the remaining rows of the given binary table, of which
+  // <src>rowsRead</src> rows have already been read from the FitsInput.
+  // The object is not copied, so it has to stay alive while this
+  // object is used.
+  // The columns are given by number; if none are given all columns are
+  // read.
+  FITSColumnReader (BinaryTableExtension& bintab, uInt rowsRead,
+                    const Vector<Int>& columns = Vector<Int>());
+
+  ~FITSColumnReader();
+
+  // Test if a column of the given FITS type can be read.
+  static Bool isSupported (FITS::ValueType type);
+
+  // Get the number of rows in the table.
+  uInt nrow() const
+    { return itsNrow; }
+
+  // Get the number of rows read so far.
+  uInt rowsRead() const
+    { return itsRowsRead; }
+
+  // Get the names of the columns read (the field names in the block).
+  const Vector<String>& columnNames() const
+    { return itsNames; }
+
+  // Get the (0-based) numbers of the columns read.
+  const Block<Int>& columnNumbers() const
+    { return itsFields; }
+
+  // Read the next block of (at most) <src>nrow</src> rows and convert
+  // the selected columns. It returns the number of rows read, which is 0
+  // if all rows have been read.
+  // An exception is thrown if the FITS data could not be read.
+  uInt read (uInt nrow);
+
+  // Get the arrays of the last block read.
+  const Record& block() const
+    { return itsBlock; }
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  FITSColumnReader (const FITSColumnReader&);
+  FITSColumnReader& operator= (const FITSColumnReader&);
+  // </group>
+
+  // Set up the selected columns (given by number).
+  void init (const Block<Int>& fields);
+
+  // Get the column number of a name (which is case-insensitive).
+  Int findColumn (const String& name) const;
+
+  // Convert a column in the buffer to an array.
+  void convertColumn (uInt col, uInt nrow);
+
+  BinaryTableExtension* itsTable;
+  Bool           itsOwner;        //# True = itsTable is owned by this object
+  uInt           itsNrow;
+  uInt           itsRowsRead;
+  uInt           itsRowSize;
+  Block<Int>     itsFields;       //# selected FITS field numbers
+  Block<uInt>    itsOffsets;      //# offset of each field in a FITS row
+  Vector<String> itsNames;
+  Record         itsBlock;
+  Block<char>    itsBuffer;       //# raw FITS rows of a block
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -465,6 +465,16 @@ public:
     // Write the current group (row()).
     void write();
 
+    // Write <src>ngroups</src> groups at once, which is much faster than
+    // writing them one by one. Each group in <src>groups</src> holds the
+    // random parameters (in the order of the scalar fields in the
+    // description) followed by the data array, thus <src>groupSize()</src>
+    // values. The buffer is converted to FITS format in place.
+    void write(Float *groups, uInt ngroups);
+
+    // Get the number of values in a group (parameters and data array).
+    uInt groupSize() const {return group_size_p;}
+
     // Don't delete this out from under us!
     FitsOutput *writer() {return writer_p;}
 private:
@@ -476,6 +486,7 @@ private:
     Bool delete_writer_p;
     FitsOutput *writer_p;
     uInt nrows_written_p, nrows_total_p;
+    uInt group_size_p;
     PrimaryGroup<Float> *group_p;
     Record row_p;
     Int error_count_p;
@@ -51,7 +51,7 @@ FITSGroupWriter::FITSGroupWriter(const String &fileName,
 				 const Record &extraKeywords,
 				 Bool freeOutput)
     : delete_writer_p(freeOutput), writer_p(0), nrows_written_p(0),
-      nrows_total_p(nrows),  group_p(0), error_count_p(0)
+      nrows_total_p(nrows), group_size_p(0), group_p(0), error_count_p(0)
 {
     LogIO log(LogOrigin("FITSGroupWriter", "FITSGroupWriter", WHERE));
 
@@ -78,6 +78,7 @@ FITSGroupWriter::FITSGroupWriter(const String &fileName,
 
     // The description is ok!
     row_p.restructure(description);
+    group_size_p = nfields - 1 + description.shape(arrayField).product();
     
     // See if we can open the output file
     // use Path so that environment variables and any tilde in fileName are parse
@@ -214,6 +215,23 @@ void FITSGroupWriter::write()
     nrows_written_p++;
 }
 
+void FITSGroupWriter::write(Float *groups, uInt ngroups)
+{
+    if (nrows_written_p + ngroups > nrows_total_p) {
+	LogIO log(LogOrigin("FITSGroupWriter", "write", WHERE));
+	log << LogIO::SEVERE << "Attempt to write more rows than declared; "
+	    "only " << nrows_total_p - nrows_written_p << " are written" <<
+	    LogIO::POST;
+	ngroups = nrows_total_p - nrows_written_p;
+    }
+    if (ngroups == 0) {
+	return;
+    }
+    group_p->write(*writer_p, groups, ngroups);
+    check_error("error writing rows");
+    nrows_written_p += ngroups;
+}
+
 void FITSGroupWriter::check_error(const char *extra_info)
 {
     static LogOrigin OR("FITSGroupWriter", "");
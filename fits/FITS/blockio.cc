@@ -334,6 +334,40 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 	}	
 	return (int)m_err_status;
     }
+//========================================================================================================
+// attach nrec contiguous logical records to the fits file.
+    int BlockOutput::write(char *addr, int nrec) {
+	// first fill up the partially filled buffer
+	while (nrec > 0  &&  m_current > 0) {
+	    write(addr);
+	    addr += m_recsize;
+	    nrec--;
+	}
+	// write all full physical records in a single call
+	int nblock = nrec / m_nrec;
+	if (nblock > 0) {
+	    int l_status = 0;
+	    OFF_T nbytes = OFF_T(nblock) * m_blocksize;
+	    ffpbyt( m_fptr, nbytes, addr, &l_status);
+	    m_block_no += nblock;
+	    m_rec_no += nblock * m_nrec;
+	    if ( l_status  ){
+		errmsg(WRITEERR,"[BlockOutput::write()] Error writing records");
+	    }else{
+		m_iosize = m_blocksize;
+		m_err_status = OK;
+	    }
+	    addr += nbytes;
+	    nrec -= nblock * m_nrec;
+	}
+	// buffer the remaining records
+	while (nrec > 0) {
+	    write(addr);
+	    addr += m_recsize;
+	    nrec--;
+	}
+	return (int)m_err_status;
+    }
 //========================================================================================================
     BlockInput::BlockInput(const char *f, int r, int n, 
 			   FITSErrorHandler errhandler) :
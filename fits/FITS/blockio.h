@@ -192,6 +192,11 @@ class BlockOutput : public BlockIO {
 	// write the next logical record. The input must point
 	// to a logical record
 	virtual int write(char *);
+
+	// write the next <src>nrec</src> logical records, which must be
+	// contiguous in memory. Whole physical records are written
+	// directly from the input without copying them to the buffer.
+	int write(char *, int nrec);
 };
 
 } //# NAMESPACE CASACORE - END
@@ -1278,12 +1278,13 @@ int FitsOutput::write(FITS::HDUType t, char *addr, Int bytes, char pad) {
         addr += n;
         bytes -= n;
         m_fout.write(m_curr); // write a record
-        while (bytes >= m_recsize) {
-            memcpy(m_curr, addr, m_recsize);
-            m_fout.write(m_curr); // write a record
-            addr += m_recsize;
-            m_curr_size += m_recsize;
-            bytes -= m_recsize;
+        // Write all full records directly from the input.
+        Int nrec = bytes / m_recsize;
+        if (nrec > 0) {
+            m_fout.write(addr, nrec);
+            addr += nrec * m_recsize;
+            m_curr_size += nrec * m_recsize;
+            bytes -= nrec * m_recsize;
         }
         m_bytepos = bytes;
         if (bytes) {
@@ -626,6 +626,12 @@ class PrimaryGroup : public PrimaryArray<TYPE> {
 	int read();
 	int write(FitsOutput &);
 	//</group>
+
+	// write the next <src>ngroups</src> groups in one operation.
+	// Each group in <src>groups</src> consists of the raw parameters
+	// followed by the data array. The values are converted to FITS
+	// format in place, so the buffer is altered.
+	int write(FitsOutput &, TYPE *groups, Int ngroups);
 	// write the required keywords for PrimaryGroup
 	//<group>
 	int write_priGrp_hdr( FitsOutput &fout, int simple, int bitpix,   
@@ -1135,6 +1135,22 @@ int PrimaryGroup<TYPE>::write(FitsOutput &fout) {
 	return 0;
 }
 //====================================================================================
+template <class TYPE>
+int PrimaryGroup<TYPE>::write(FitsOutput &fout, TYPE *groups, Int ngroups) {
+	// convert and write all groups at once, so the records are
+	// passed to the output in large contiguous blocks
+	int ne = (pcount() + nelements()) * ngroups;
+	FITS::l2f( groups, groups, ne );
+	OFF_T nb = fitsitemsize() * OFF_T(ne);
+
+	if (write_data(fout,(char *)groups,nb) != 0) {
+	    errmsg(BADIO,"Error writing groups");
+	    return -1;
+	}
+	current_group += ngroups;
+	return 0;
+}
+//====================================================================================
 
 template <class TYPE>
 PrimaryTable<TYPE>::PrimaryTable(FitsInput &f, 
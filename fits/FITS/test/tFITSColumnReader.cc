@@ -0,0 +1,254 @@
+//# tFITSColumnReader.cc: Test program for class FITSColumnReader
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+//# Includes
+#include <casacore/fits/FITS/FITSColumnReader.h>
+#include <casacore/fits/FITS/BinTable.h>
+#include <casacore/fits/FITS/hdu.h>
+#include <casacore/fits/FITS/fitsio.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <fitsio.h>
+
+#include <casacore/casa/namespace.h>
+
+const int nrows = 20;
+
+// Write a FITS file with a small primary array and a binary table.
+void writeTable (const char* fileName)
+{
+  FitsOutput fout(fileName, FITS::Disk);
+  AlwaysAssertExit (fout.err() != FitsIO::IOERR);
+  FitsLong data[2][2] = {{1,2},{3,4}};
+  PrimaryArray<FitsLong> hdu1;
+  long naxes[2] = {2,2};
+  AlwaysAssertExit (hdu1.write_priArr_hdr(fout, True, 32, 2, naxes, True)
+                    == 0);
+  hdu1.store (&data[0][0], FITS::CtoF);
+  hdu1.write (fout);
+
+  const char* ttype[] = {"ID", "FLUX", "NAME", "FLAG", "SHORTS", "DBL"};
+  const char* tform[] = {"J",  "3E",   "4A",   "L",    "2I",     "D"};
+  const char* tunit[] = {"\0", "Jy",   "\0",   "\0",   "\0",     "m"};
+  BinaryTableExtension bt;
+  AlwaysAssertExit (bt.err() == 0);
+  bt.write_binTbl_hdr (fout, nrows, 6, ttype, tform, tunit, "TEST", 0);
+  FitsField<FitsLong>    id;
+  FitsField<float>       flux(3);
+  FitsField<char>        name(4);
+  FitsField<FitsLogical> flag;
+  FitsField<short>       shorts(2);
+  FitsField<double>      dbl;
+  bt.bind (0, id);
+  bt.bind (1, flux);
+  bt.bind (2, name);
+  bt.bind (3, flag);
+  bt.bind (4, shorts);
+  bt.bind (5, dbl);
+  for (int i=0; i<nrows; ++i) {
+    bt.set_next (1);
+    id = i;
+    for (int k=0; k<3; ++k) {
+      flux(k) = i*10 + k + 0.5;
+    }
+    name(0) = 'A' + i;
+    name(1) = 'B';
+    name(2) = ' ';
+    name(3) = ' ';
+    flag = (i%2 == 0);
+    shorts(0) = -i;
+    shorts(1) = 2*i;
+    dbl = i * 0.25;
+    bt.write (fout);
+  }
+}
+
+// Read a projection of the columns in blocks of 7 rows.
+void readColumns (const char* fileName)
+{
+  FitsInput fin(fileName, FITS::Disk);
+  AlwaysAssertExit (fin.skip_hdu() == 0);
+  Vector<String> cols(4);
+  cols[0] = "dbl";
+  cols[1] = "FLUX";
+  cols[2] = "NAME";
+  cols[3] = "SHORTS";
+  FITSColumnReader reader(fin, cols);
+  AlwaysAssertExit (reader.nrow() == uInt(nrows));
+  AlwaysAssertExit (reader.columnNames().size() == 4);
+  AlwaysAssertExit (reader.columnNames()[0] == "DBL");
+  AlwaysAssertExit (reader.columnNumbers()[1] == 1);
+  uInt row = 0;
+  uInt nr;
+  while ((nr = reader.read(7)) > 0) {
+    AlwaysAssertExit (nr == std::min(7u, nrows-row));
+    Vector<Double> dbl (reader.block().asArrayDouble(0));
+    Matrix<Float>  flux (reader.block().asArrayFloat(1));
+    Vector<String> name (reader.block().asArrayString(2));
+    Matrix<Short>  shorts (reader.block().asArrayShort(3));
+    AlwaysAssertExit (dbl.size() == nr);
+    AlwaysAssertExit (flux.shape() == IPosition(2,3,nr));
+    for (uInt i=0; i<nr; ++i, ++row) {
+      AlwaysAssertExit (dbl[i] == row*0.25);
+      for (uInt k=0; k<3; ++k) {
+        AlwaysAssertExit (flux(k,i) == row*10 + k + 0.5);
+      }
+      AlwaysAssertExit (name[i] == String(char('A'+row)) + "B");
+      AlwaysAssertExit (shorts(0,i) == -Short(row));
+      AlwaysAssertExit (shorts(1,i) == 2*Short(row));
+    }
+    AlwaysAssertExit (reader.rowsRead() == row);
+  }
+  AlwaysAssertExit (row == uInt(nrows));
+  // A non-existing column gives an exception.
+  FitsInput fin2(fileName, FITS::Disk);
+  fin2.skip_hdu();
+  cols.resize (1);
+  cols[0] = "NOCOL";
+  Bool caught = False;
+  try {
+    FITSColumnReader reader2(fin2, cols);
+  } catch (AipsError&) {
+    caught = True;
+  }
+  AlwaysAssertExit (caught);
+}
+
+// Convert the table using BinaryTable, which reads in blocks.
+void readBinaryTable (const char* fileName)
+{
+  FitsInput fin(fileName, FITS::Disk);
+  fin.skip_hdu();
+  BinaryTable bintab(fin);
+  Table tab = bintab.fullTable();
+  AlwaysAssertExit (tab.nrow() == uInt(nrows));
+  ScalarColumn<Int>    id  (tab, "ID");
+  ArrayColumn<Float>   flux(tab, "FLUX");
+  ScalarColumn<String> name(tab, "NAME");
+  ScalarColumn<Bool>   flag(tab, "FLAG");
+  ArrayColumn<Short>   shorts(tab, "SHORTS");
+  ScalarColumn<Double> dbl (tab, "DBL");
+  for (Int i=0; i<nrows; ++i) {
+    AlwaysAssertExit (id(i) == i);
+    Vector<Float> fluxv(flux(i));
+    for (Int k=0; k<3; ++k) {
+      AlwaysAssertExit (fluxv[k] == i*10 + k + 0.5);
+    }
+    AlwaysAssertExit (name(i) == String(char('A'+i)) + "B");
+    AlwaysAssertExit (flag(i) == (i%2 == 0));
+    Vector<Short> shortv(shorts(i));
+    AlwaysAssertExit (shortv[0] == -i  &&  shortv[1] == 2*i);
+    AlwaysAssertExit (dbl(i) == i*0.25);
+  }
+  // Afterwards the current row is the last row, as with row-wise reading.
+  AlwaysAssertExit (bintab.currrow() == nrows-1);
+  AlwaysAssertExit (ScalarColumn<Int>(bintab.thisRow(), "ID")(0) == nrows-1);
+}
+
+// Write a FITS file with a binary table containing scaled columns.
+// The raw values are written first, thereafter the TSCALn and TZEROn
+// keywords are added, so cfitsio does not scale the values written.
+void writeScaledTable (const char* fileName)
+{
+  fitsfile* fptr = 0;
+  int status = 0;
+  fits_create_file (&fptr, (String("!") + fileName).chars(), &status);
+  fits_create_img (fptr, BYTE_IMG, 0, 0, &status);
+  char* ttype[] = {const_cast<char*>("RAW"), const_cast<char*>("FSC"),
+                   const_cast<char*>("DSC")};
+  char* tform[] = {const_cast<char*>("J"), const_cast<char*>("2E"),
+                   const_cast<char*>("D")};
+  fits_create_tbl (fptr, BINARY_TBL, nrows, 3, ttype, tform, 0,
+                   const_cast<char*>("SCALED"), &status);
+  for (int i=0; i<nrows; ++i) {
+    int raw = i;
+    float fsc[2] = {float(i), i+0.5f};
+    double dsc = i*0.25;
+    fits_write_col (fptr, TINT, 1, i+1, 1, 1, &raw, &status);
+    fits_write_col (fptr, TFLOAT, 2, i+1, 1, 2, fsc, &status);
+    fits_write_col (fptr, TDOUBLE, 3, i+1, 1, 1, &dsc, &status);
+  }
+  double scale = 2;
+  double zero2 = 10;
+  double zero3 = 100;
+  fits_write_key (fptr, TDOUBLE, const_cast<char*>("TSCAL2"), &scale, 0,
+                  &status);
+  fits_write_key (fptr, TDOUBLE, const_cast<char*>("TZERO2"), &zero2, 0,
+                  &status);
+  fits_write_key (fptr, TDOUBLE, const_cast<char*>("TZERO3"), &zero3, 0,
+                  &status);
+  fits_close_file (fptr, &status);
+  if (status != 0) {
+    fits_report_error (stderr, status);
+    throw AipsError ("Could not create FITS file " + String(fileName));
+  }
+}
+
+// Convert the scaled table using BinaryTable. The scale and zero must be
+// applied to all rows, thus also to the rows converted in blocks.
+void readScaledTable (const char* fileName)
+{
+  FitsInput fin(fileName, FITS::Disk);
+  fin.skip_hdu();
+  BinaryTable bintab(fin);
+  Table tab = bintab.fullTable();
+  AlwaysAssertExit (tab.nrow() == uInt(nrows));
+  ScalarColumn<Int>    raw(tab, "RAW");
+  ArrayColumn<Float>   fsc(tab, "FSC");
+  ScalarColumn<Double> dsc(tab, "DSC");
+  for (Int i=0; i<nrows; ++i) {
+    AlwaysAssertExit (raw(i) == i);
+    Vector<Float> fscv(fsc(i));
+    AlwaysAssertExit (fscv[0] == 2*i + 10.f);
+    AlwaysAssertExit (fscv[1] == 2*(i+0.5f) + 10.f);
+    AlwaysAssertExit (dsc(i) == i*0.25 + 100);
+  }
+}
+
+int main()
+{
+  try {
+    writeTable ("tFITSColumnReader_tmp.fits");
+    readColumns ("tFITSColumnReader_tmp.fits");
+    readBinaryTable ("tFITSColumnReader_tmp.fits");
+    writeScaledTable ("tFITSColumnReader_tmp2.fits");
+    readScaledTable ("tFITSColumnReader_tmp2.fits");
+  } catch (AipsError& x) {
+    cout << "Unexpected exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
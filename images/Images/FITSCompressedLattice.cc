@@ -0,0 +1,463 @@
+//# FITSCompressedLattice.cc: Read-only access to a tile-compressed FITS image
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/images/Images/FITSCompressedLattice.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+FITSCompressedLattice::FITSCompressedLattice (const String& fileName)
+: itsFileName (fileName),
+  itsNDim     (0),
+  itsMaxCacheTiles (1),
+  itsNHit     (0),
+  itsNMiss    (0)
+{
+  itsFiles.resize (1);
+  itsFiles[0] = openFile();
+  fitsfile* fptr = itsFiles[0];
+  int status = 0;
+  if (! fits_is_compressed_image (fptr, &status)) {
+    closeFiles();
+    throw AipsError ("FITSCompressedLattice: " + fileName +
+                     " is not a tile-compressed image");
+  }
+  // Get the shape of the uncompressed image.
+  int naxis = 0;
+  fits_get_img_dim (fptr, &naxis, &status);
+  std::vector<long> naxes(std::max(naxis, 1));
+  fits_get_img_size (fptr, naxis, &(naxes[0]), &status);
+  if (status != 0  ||  naxis <= 0) {
+    closeFiles();
+    throwError ("no valid image shape in " + fileName, status);
+  }
+  itsNDim = naxis;
+  itsShape.resize (naxis);
+  itsTileShape.resize (naxis);
+  for (int i=0; i<naxis; ++i) {
+    itsShape[i] = naxes[i];
+    // Get the tile shape; by default each image row is a tile.
+    long tileLen = (i==0 ? naxes[0] : 1);
+    char keyName[FLEN_KEYWORD];
+    int keyStatus = 0;
+    fits_make_keyn ("ZTILE", i+1, keyName, &keyStatus);
+    long val;
+    if (fits_read_key (fptr, TLONG, keyName, &val, 0, &keyStatus) == 0) {
+      tileLen = val;
+    }
+    itsTileShape[i] = std::max(1L, std::min(tileLen, naxes[i]));
+  }
+  itsNTiles = (itsShape + itsTileShape - 1) / itsTileShape;
+  // Get the header of the equivalent uncompressed image.
+  char* hdr = 0;
+  int nkeys = 0;
+  if (fits_convert_hdr2str (fptr, 0, 0, 0, &hdr, &nkeys, &status)) {
+    closeFiles();
+    throwError ("cannot read the header of " + fileName, status);
+  }
+  String hdrStr(hdr);
+  free (hdr);
+  uInt ncard = hdrStr.length() / 80;
+  Bool hasEnd = (ncard > 0  &&  hdrStr.at(Int((ncard-1)*80), 3) == "END");
+  itsHeader.resize (hasEnd ? ncard : ncard+1);
+  for (uInt i=0; i<ncard; ++i) {
+    itsHeader[i] = hdrStr.at(Int(i*80), 80);
+  }
+  if (!hasEnd) {
+    itsHeader[ncard] = "END" + String(77, ' ');
+  }
+  setMaximumCacheSize (16*1024*1024);
+}
+
+FITSCompressedLattice::~FITSCompressedLattice()
+{
+  closeFiles();
+}
+
+Int FITSCompressedLattice::findImage (const String& fileName)
+{
+  fitsfile* fptr = 0;
+  int status = 0;
+  if (fits_open_image (&fptr, fileName.chars(), READONLY, &status)) {
+    return -1;
+  }
+  Int hdu = -1;
+  if (fits_is_compressed_image (fptr, &status)) {
+    int hdunum = 0;
+    fits_get_hdu_num (fptr, &hdunum);
+    hdu = hdunum - 1;
+  }
+  status = 0;
+  fits_close_file (fptr, &status);
+  return hdu;
+}
+
+Bool FITSCompressedLattice::hasCompressedHDU (const String& fileName)
+{
+  RegularFile file(fileName);
+  if (! file.exists()) {
+    return False;
+  }
+  RegularFileIO fio(file);
+  const Int64 fileSize = fio.length();
+  char block[2880];
+  Int64 offset = 0;
+  // Loop over the HDUs; only their headers are read.
+  while (offset + 2880 <= fileSize) {
+    Bool isBinTable = False;
+    Bool isZImage   = False;
+    Bool hasEnd     = False;
+    Int64 bitpix = 0;
+    Int64 pcount = 0;
+    Int64 gcount = 1;
+    std::vector<Int64> naxes;
+    while (!hasEnd) {
+      if (offset + 2880 > fileSize) {
+        return False;
+      }
+      fio.seek (offset);
+      fio.read (2880, block);
+      offset += 2880;
+      for (uInt i=0; i<36  &&  !hasEnd; ++i) {
+        const char* card = block + i*80;
+        String key(card, 8);
+        key.trim();
+        // The value is in columns 11-80 (without a possible comment).
+        String value(card+10, 70);
+        value = value.before('/');
+        value.trim();
+        if (key == "END") {
+          hasEnd = True;
+        } else if (key == "XTENSION") {
+          isBinTable = value.contains ("BINTABLE");
+        } else if (key == "ZIMAGE") {
+          isZImage = (value == "T");
+        } else if (key == "BITPIX") {
+          bitpix = atol (value.chars());
+        } else if (key == "NAXIS") {
+          naxes.resize (atol (value.chars()));
+        } else if (key.startsWith ("NAXIS")) {
+          uInt axis = atoi (key.chars() + 5);
+          if (axis >= 1  &&  axis <= naxes.size()) {
+            naxes[axis-1] = atol (value.chars());
+          }
+        } else if (key == "PCOUNT") {
+          pcount = atol (value.chars());
+        } else if (key == "GCOUNT") {
+          gcount = atol (value.chars());
+        }
+      }
+    }
+    if (isBinTable  &&  isZImage) {
+      return True;
+    }
+    // Skip the data. NAXIS1 is 0 for random groups.
+    if (! naxes.empty()) {
+      Int64 nelem = 1;
+      for (uInt i=(naxes[0]==0 ? 1:0); i<naxes.size(); ++i) {
+        nelem *= naxes[i];
+      }
+      Int64 nbytes = abs(bitpix) / 8 * gcount * (pcount + nelem);
+      offset += (nbytes + 2879) / 2880 * 2880;
+    }
+  }
+  return False;
+}
+
+fitsfile* FITSCompressedLattice::openFile() const
+{
+  fitsfile* fptr = 0;
+  int status = 0;
+  if (fits_open_image (&fptr, itsFileName.chars(), READONLY, &status)) {
+    throwError ("cannot open " + itsFileName, status);
+  }
+  return fptr;
+}
+
+void FITSCompressedLattice::closeFiles()
+{
+  for (uInt i=0; i<itsFiles.nelements(); ++i) {
+    if (itsFiles[i] != 0) {
+      int status = 0;
+      fits_close_file (itsFiles[i], &status);
+      itsFiles[i] = 0;
+    }
+  }
+}
+
+void FITSCompressedLattice::throwError (const String& msg, int status) const
+{
+  char text[FLEN_STATUS];
+  fits_get_errstatus (status, text);
+  throw AipsError ("FITSCompressedLattice: " + msg + " (" + String(text) + ")");
+}
+
+Lattice<Float>* FITSCompressedLattice::clone() const
+{
+  FITSCompressedLattice* lat = new FITSCompressedLattice (itsFileName);
+  lat->addDegenerateAxes (itsShape.nelements());
+  lat->setCacheSize (itsMaxCacheTiles);
+  return lat;
+}
+
+Bool FITSCompressedLattice::isWritable() const
+{
+  return False;
+}
+
+IPosition FITSCompressedLattice::shape() const
+{
+  return itsShape;
+}
+
+void FITSCompressedLattice::addDegenerateAxes (uInt ndim)
+{
+  uInt nold = itsShape.nelements();
+  if (ndim > nold) {
+    itsShape.resize (ndim);
+    itsTileShape.resize (ndim);
+    itsNTiles.resize (ndim);
+    for (uInt i=nold; i<ndim; ++i) {
+      itsShape[i] = 1;
+      itsTileShape[i] = 1;
+      itsNTiles[i] = 1;
+    }
+  }
+}
+
+uInt FITSCompressedLattice::advisedMaxPixels() const
+{
+  return itsTileShape.product();
+}
+
+void FITSCompressedLattice::tileBox (Int64 tileNr,
+                                     IPosition& blc, IPosition& trc) const
+{
+  uInt ndim = itsShape.nelements();
+  blc.resize (ndim, False);
+  trc.resize (ndim, False);
+  for (uInt i=0; i<ndim; ++i) {
+    blc[i] = (tileNr % itsNTiles[i]) * itsTileShape[i];
+    trc[i] = std::min(blc[i] + itsTileShape[i], itsShape[i]) - 1;
+    tileNr /= itsNTiles[i];
+  }
+}
+
+int FITSCompressedLattice::decodeTile (fitsfile* fptr, Int64 tileNr,
+                                       Array<Float>& tile) const
+{
+  IPosition blc, trc;
+  tileBox (tileNr, blc, trc);
+  // Degenerate axes added to the shape are not passed to cfitsio.
+  std::vector<long> fpixel(itsNDim), lpixel(itsNDim), inc(itsNDim, 1);
+  for (uInt i=0; i<itsNDim; ++i) {
+    fpixel[i] = blc[i] + 1;
+    lpixel[i] = trc[i] + 1;
+  }
+  Float nulval;
+  setNaN (nulval);
+  int anynul = 0;
+  int status = 0;
+  fits_read_subset (fptr, TFLOAT, &(fpixel[0]), &(lpixel[0]), &(inc[0]),
+                    &nulval, tile.data(), &anynul, &status);
+  return status;
+}
+
+Bool FITSCompressedLattice::doGetSlice (Array<Float>& buffer,
+                                        const Slicer& section)
+{
+  const uInt ndim = itsShape.nelements();
+  const IPosition blc = section.start();
+  const IPosition trc = section.end();
+  // Determine the tiles overlapping the section.
+  const IPosition tblc = blc / itsTileShape;
+  const IPosition ttrc = trc / itsTileShape;
+  std::vector<Int64> tiles;
+  IPosition tpos(tblc);
+  while (True) {
+    Int64 tileNr = 0;
+    for (Int i=ndim-1; i>=0; --i) {
+      tileNr = tileNr * itsNTiles[i] + tpos[i];
+    }
+    tiles.push_back (tileNr);
+    uInt ax;
+    for (ax=0; ax<ndim; ++ax) {
+      if (++tpos[ax] <= ttrc[ax]) {
+        break;
+      }
+      tpos[ax] = tblc[ax];
+    }
+    if (ax == ndim) {
+      break;
+    }
+  }
+  // Find the tiles not in the cache and decompress them.
+  std::vector<Array<Float>*> tilePtrs(tiles.size());
+  std::vector<Int64> missing;
+  std::vector<uInt> missingIndex;
+  for (uInt i=0; i<tiles.size(); ++i) {
+    std::map<Int64, Array<Float> >::iterator iter = itsCache.find (tiles[i]);
+    if (iter == itsCache.end()) {
+      missing.push_back (tiles[i]);
+      missingIndex.push_back (i);
+    } else {
+      tilePtrs[i] = &(iter->second);
+      itsNHit++;
+    }
+  }
+  const Int nmissing = missing.size();
+  itsNMiss += nmissing;
+  std::vector<Array<Float> > decoded(nmissing);
+  IPosition tb, te;
+  for (Int i=0; i<nmissing; ++i) {
+    tileBox (missing[i], tb, te);
+    decoded[i].resize (te - tb + 1);
+    tilePtrs[missingIndex[i]] = &(decoded[i]);
+  }
+  // Each thread needs its own file handle; cfitsio must be reentrant.
+  Int nthread = 1;
+#ifdef _OPENMP
+  if (nmissing > 1  &&  fits_is_reentrant()) {
+    nthread = min(nmissing, omp_get_max_threads());
+  }
+#endif
+  while (itsFiles.nelements() < uInt(nthread)) {
+    uInt n = itsFiles.nelements();
+    itsFiles.resize (n+1);
+    itsFiles[n] = 0;
+    itsFiles[n] = openFile();
+  }
+  Block<int> status(nmissing, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthread) if (nthread > 1)
+#endif
+  for (Int i=0; i<nmissing; ++i) {
+    Int thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    status[i] = decodeTile (itsFiles[thread], missing[i], decoded[i]);
+  }
+  for (Int i=0; i<nmissing; ++i) {
+    if (status[i] != 0) {
+      throwError ("cannot decompress tile in " + itsFileName, status[i]);
+    }
+  }
+  // Copy the overlapping parts of the tiles.
+  // A strided section is copied to a temporary buffer first.
+  const Bool strided = !section.stride().allOne();
+  Array<Float> box;
+  if (strided) {
+    box.resize (trc - blc + 1);
+  } else {
+    if (! buffer.shape().isEqual (section.length())) {
+      buffer.resize (section.length());
+    }
+    box.reference (buffer);
+  }
+  for (uInt i=0; i<tiles.size(); ++i) {
+    tileBox (tiles[i], tb, te);
+    IPosition st = max(blc, tb);
+    IPosition end = min(trc, te);
+    box(st - blc, end - blc) = (*tilePtrs[i])(st - tb, end - tb);
+  }
+  if (strided) {
+    if (! buffer.shape().isEqual (section.length())) {
+      buffer.resize (section.length());
+    }
+    buffer = box(IPosition(ndim, 0), trc - blc, section.stride());
+  }
+  // Add the new tiles to the cache; remove the oldest ones if too many.
+  for (Int i=0; i<nmissing; ++i) {
+    itsCache[missing[i]].reference (decoded[i]);
+    itsCacheOrder.push_back (missing[i]);
+  }
+  while (itsCacheOrder.size() > itsMaxCacheTiles) {
+    itsCache.erase (itsCacheOrder.front());
+    itsCacheOrder.pop_front();
+  }
+  return False;
+}
+
+void FITSCompressedLattice::doPutSlice (const Array<Float>&,
+                                        const IPosition&,
+                                        const IPosition&)
+{
+  throw AipsError ("FITSCompressedLattice::putSlice - "
+                   "a compressed FITS image is not writable");
+}
+
+uInt FITSCompressedLattice::maximumCacheSize() const
+{
+  return itsMaxCacheTiles * itsTileShape.product() * sizeof(Float);
+}
+
+void FITSCompressedLattice::setMaximumCacheSize (uInt nbytes)
+{
+  setCacheSize (nbytes / (itsTileShape.product() * sizeof(Float)));
+}
+
+void FITSCompressedLattice::setCacheSize (uInt nTiles)
+{
+  itsMaxCacheTiles = max(1u, nTiles);
+  while (itsCacheOrder.size() > itsMaxCacheTiles) {
+    itsCache.erase (itsCacheOrder.front());
+    itsCacheOrder.pop_front();
+  }
+}
+
+void FITSCompressedLattice::clearCache()
+{
+  itsCache.clear();
+  itsCacheOrder.clear();
+}
+
+void FITSCompressedLattice::showCacheStatistics (ostream& os) const
+{
+  os << "FITSCompressedLattice cache statistics:" << endl;
+  os << "  tile shape   " << itsTileShape << endl;
+  os << "  max #tiles   " << itsMaxCacheTiles << endl;
+  os << "  #tiles used  " << itsCache.size() << endl;
+  os << "  #hits        " << itsNHit << endl;
+  os << "  #misses      " << itsNMiss << endl;
+}
+
+
+} //# NAMESPACE CASACORE - END
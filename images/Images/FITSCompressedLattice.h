@@ -0,0 +1,199 @@
+//# FITSCompressedLattice.h: Read-only access to a tile-compressed FITS image
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef IMAGES_FITSCOMPRESSEDLATTICE_H
+#define IMAGES_FITSCOMPRESSEDLATTICE_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/lattices/Lattices/Lattice.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/iosfwd.h>
+#include <fitsio.h>    //# header file from cfitsio
+#include <map>
+#include <deque>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Read-only access to a tile-compressed FITS image.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=Lattice>Lattice</linkto>
+//   <li> <linkto class=FITSImage>FITSImage</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A tile-compressed FITS image (as made by, for instance, fpack) is stored
+// as a binary table extension (keyword ZIMAGE=T), where each row contains
+// a compressed tile of the image. This class gives access to such an image
+// as a Lattice<Float>. The decompression is done by cfitsio, which also
+// applies the scale factors and blanking (blanked pixels get a NaN value).
+// <p>
+// Only the tiles overlapping the requested slice are decompressed.
+// The decoded tiles are kept in a cache, so subsequent slices in the same
+// tiles do not need to decompress them again. The maximum cache size can
+// be set; by default it is 16 MB. The tiles missing in the cache are
+// decompressed in parallel if OpenMP is used and cfitsio is reentrant.
+// Each thread uses its own cfitsio file handle for that purpose.
+// <p>
+// The class is used by <linkto class=FITSImage>FITSImage</linkto>
+// and <linkto class=FITSMask>FITSMask</linkto>.
+// </synopsis>
+
+// <motivation>
+// Large images are often stored compressed, but usually only a small part
+// of them is needed, so decompressing the entire file is a waste.
+// </motivation>
+
+class FITSCompressedLattice : public Lattice<Float>
+{
+public:
+  // Open the tile-compressed image in the given file. The name can contain
+  // an extension specification as supported by cfitsio (e.g.
+  // <src>file.fits[1]</src>). If none is given, the first image found is
+  // used. An exception is thrown if it is not a tile-compressed image.
+  explicit FITSCompressedLattice (const String& fileName);
+
+  ~FITSCompressedLattice();
+
+  // Find the image in the given file (which can contain an extension
+  // specification like the constructor) and return its 0-based HDU number
+  // if it is a tile-compressed image. Otherwise -1 is returned.
+  static Int findImage (const String& fileName);
+
+  // Tell if the given file (without extension specification) contains a
+  // tile-compressed image, thus a BINTABLE extension with ZIMAGE=T.
+  // Only the headers are scanned, so it is much cheaper than
+  // <src>findImage</src>. It does not use cfitsio.
+  static Bool hasCompressedHDU (const String& fileName);
+
+  // Make a copy of the object, which opens the file again.
+  virtual Lattice<Float>* clone() const;
+
+  // A compressed image cannot be written.
+  virtual Bool isWritable() const;
+
+  // Get the shape and tile shape of the image.
+  // <group>
+  virtual IPosition shape() const;
+  const IPosition& tileShape() const
+    { return itsTileShape; }
+  // </group>
+
+  // Add degenerate axes to the shape. It is needed if the coordinate
+  // system of the image has more axes than the FITS image.
+  void addDegenerateAxes (uInt ndim);
+
+  // Get the header cards (of 80 characters) of the equivalent uncompressed
+  // image. The last card is END.
+  const Vector<String>& header() const
+    { return itsHeader; }
+
+  // Get the file name (including the extension specification).
+  const String& fileName() const
+    { return itsFileName; }
+
+  // The advised number of pixels is the number of pixels in a tile.
+  virtual uInt advisedMaxPixels() const;
+
+  // Get a slice by decompressing the tiles it overlaps.
+  virtual Bool doGetSlice (Array<Float>& buffer, const Slicer& section);
+
+  // Putting data is not possible; an exception is thrown.
+  virtual void doPutSlice (const Array<Float>& sourceBuffer,
+                           const IPosition& where,
+                           const IPosition& stride);
+
+  // Get or set the maximum size of the tile cache (in bytes).
+  // <group>
+  uInt maximumCacheSize() const;
+  void setMaximumCacheSize (uInt nbytes);
+  // </group>
+
+  // Set the cache size as the number of tiles to keep.
+  void setCacheSize (uInt nTiles);
+
+  // Remove all tiles from the cache.
+  void clearCache();
+
+  // Show the statistics of the tile cache.
+  void showCacheStatistics (ostream& os) const;
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  FITSCompressedLattice (const FITSCompressedLattice&);
+  FITSCompressedLattice& operator= (const FITSCompressedLattice&);
+  // </group>
+
+  // Open the file and move to the image. Throw an exception if failing.
+  fitsfile* openFile() const;
+
+  // Close all open file handles.
+  void closeFiles();
+
+  // Get the blc and trc of a tile.
+  void tileBox (Int64 tileNr, IPosition& blc, IPosition& trc) const;
+
+  // Decompress a tile using the given file handle.
+  // It returns the cfitsio status.
+  int decodeTile (fitsfile* fptr, Int64 tileNr, Array<Float>& tile) const;
+
+  // Throw an exception for a cfitsio error.
+  void throwError (const String& msg, int status) const;
+
+  String              itsFileName;
+  uInt                itsNDim;           //# dimensionality in the file
+  IPosition           itsShape;
+  IPosition           itsTileShape;
+  IPosition           itsNTiles;         //# nr of tiles per axis
+  Vector<String>      itsHeader;
+  Block<fitsfile*>    itsFiles;          //# file handle per thread
+  std::map<Int64, Array<Float> > itsCache;
+  std::deque<Int64>   itsCacheOrder;     //# tiles in order of insertion
+  uInt                itsMaxCacheTiles;
+  uInt                itsNHit;
+  uInt                itsNMiss;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -79,7 +79,8 @@ FITSImage::FITSImage (const String& name, uInt whichRep, uInt whichHDU)
   filterZeroMask_p(False),
   whichRep_p(whichRep),
   whichHDU_p(whichHDU),
-  _hasBeamsTable(False)
+  _hasBeamsTable(False),
+  isCompressed_p(False)
 {
    setup();
 }
@@ -102,7 +103,8 @@ FITSImage::FITSImage (const String& name, const MaskSpecifier& maskSpec, uInt wh
   filterZeroMask_p(False),
   whichRep_p(whichRep),
   whichHDU_p(whichHDU),
-  _hasBeamsTable(False)
+  _hasBeamsTable(False),
+  isCompressed_p(False)
 {
    setup();
 }
@@ -113,6 +115,7 @@ FITSImage::FITSImage (const FITSImage& other)
   fullname_p  (other.fullname_p),
   maskSpec_p  (other.maskSpec_p),
   pTiledFile_p(other.pTiledFile_p),
+  pCompressed_p(other.pCompressed_p),
   pPixelMask_p(0),
   shape_p     (other.shape_p),
   scale_p     (other.scale_p),
@@ -127,7 +130,8 @@ FITSImage::FITSImage (const FITSImage& other)
   filterZeroMask_p(other.filterZeroMask_p),
   whichRep_p(other.whichRep_p),
   whichHDU_p(other.whichHDU_p),
-  _hasBeamsTable(other._hasBeamsTable)
+  _hasBeamsTable(other._hasBeamsTable),
+  isCompressed_p(other.isCompressed_p)
 
 {
    if (other.pPixelMask_p != 0) {
@@ -144,6 +148,7 @@ FITSImage& FITSImage::operator=(const FITSImage& other)
       ImageInterface<Float>::operator= (other);
 //
       pTiledFile_p = other.pTiledFile_p;             // Counted pointer
+      pCompressed_p = other.pCompressed_p;           // Counted pointer
 //
       delete pPixelMask_p;
       pPixelMask_p = 0;
@@ -168,6 +173,7 @@ FITSImage& FITSImage::operator=(const FITSImage& other)
       whichRep_p = other.whichRep_p;
       whichHDU_p = other.whichHDU_p;
       _hasBeamsTable = other._hasBeamsTable;
+      isCompressed_p = other.isCompressed_p;
    }
    return *this;
 } 
@@ -376,7 +382,9 @@ Bool FITSImage::doGetSlice(Array<Float>& buffer,
                            const Slicer& section)
 {
    reopenIfNeeded();
-   if (pTiledFile_p->dataType() == TpFloat) {
+   if (isCompressed_p) {
+      pCompressed_p->getSlice (buffer, section);
+   } else if (pTiledFile_p->dataType() == TpFloat) {
       pTiledFile_p->get (buffer, section);
    } else if (pTiledFile_p->dataType() == TpDouble) {
       Array<Double> tmp;
@@ -482,6 +490,7 @@ void FITSImage::tempClose()
       pPixelMask_p = 0;
 //
       pTiledFile_p = 0;
+      pCompressed_p = 0;
       isClosed_p = True;
    }
 }
@@ -496,6 +505,9 @@ void FITSImage::reopen()
 uInt FITSImage::maximumCacheSize() const
 {
    reopenIfNeeded();
+   if (isCompressed_p) {
+      return pCompressed_p->maximumCacheSize() / sizeof(Float);
+   }
    return pTiledFile_p->maximumCacheSize() / ValType::getTypeSize(dataType_p);
 }
 
@@ -503,7 +515,11 @@ void FITSImage::setMaximumCacheSize (uInt howManyPixels)
 {
    reopenIfNeeded();
    const uInt sizeInBytes = howManyPixels * ValType::getTypeSize(dataType_p);
-   pTiledFile_p->setMaximumCacheSize (sizeInBytes);
+   if (isCompressed_p) {
+      pCompressed_p->setMaximumCacheSize (sizeInBytes);
+   } else {
+      pTiledFile_p->setMaximumCacheSize (sizeInBytes);
+   }
 }
 
 void FITSImage::setCacheSizeFromPath (const IPosition& sliceShape, 
@@ -512,21 +528,32 @@ void FITSImage::setCacheSizeFromPath (const IPosition& sliceShape,
 				      const IPosition& axisPath)
 {
    reopenIfNeeded();
-   pTiledFile_p->setCacheSize (sliceShape, windowStart,
-			       windowLength, axisPath);
+// The compressed tiles are cached as they are used.
+   if (! isCompressed_p) {
+      pTiledFile_p->setCacheSize (sliceShape, windowStart,
+                                  windowLength, axisPath);
+   }
 }
 
 void FITSImage::setCacheSizeInTiles (uInt howManyTiles)  
 {  
    reopenIfNeeded();
-   pTiledFile_p->setCacheSize (howManyTiles);
+   if (isCompressed_p) {
+      pCompressed_p->setCacheSize (howManyTiles);
+   } else {
+      pTiledFile_p->setCacheSize (howManyTiles);
+   }
 }
 
 
 void FITSImage::clearCache()
 {
    if (! isClosed_p) {
-      pTiledFile_p->clearCache();
+      if (isCompressed_p) {
+         pCompressed_p->clearCache();
+      } else {
+         pTiledFile_p->clearCache();
+      }
    }
 }
 
@@ -534,7 +561,11 @@ void FITSImage::showCacheStatistics (ostream& os) const
 {
    reopenIfNeeded();
    os << "FITSImage statistics : ";
-   pTiledFile_p->showCacheStatistics (os);
+   if (isCompressed_p) {
+      pCompressed_p->showCacheStatistics (os);
+   } else {
+      pTiledFile_p->showCacheStatistics (os);
+   }
 }
 
 
@@ -545,6 +576,18 @@ void FITSImage::setup()
 // possible extension specification
 
    name_p = get_fitsname(fullname_p);
+   if (name_p.empty()) {
+      throw AipsError("FITSImage: given file name is empty");
+   }
+//
+   if (!maskSpec_p.name().empty()) {
+      throw AipsError("FITSImage " + name_p + " has no named masks");
+   }
+
+// A tile-compressed image is handled separately.
+   if (setupCompressed()) {
+      return;
+   }
 
 // Determine the HDU index from the extension specification
    uInt HDUnum = get_hdunum(fullname_p);
@@ -570,13 +613,6 @@ void FITSImage::setup()
 	   }
    }
 
-   if (name_p.empty()) {
-      throw AipsError("FITSImage: given file name is empty");
-   }
-//
-   if (!maskSpec_p.name().empty()) {
-      throw AipsError("FITSImage " + name_p + " has no named masks");
-   }
    Path path(name_p);
    String fullName = path.absoluteName();
 
@@ -659,17 +695,153 @@ void FITSImage::setup()
 }
 
 
+Bool FITSImage::setupCompressed()
+{
+// Form the name for cfitsio, which can have an extension specification.
+// Without specification cfitsio uses the first image found.
+   String fitsName = Path(name_p).expandedName();
+// Only let cfitsio look at the file if it contains a compressed image.
+   if (! FITSCompressedLattice::hasCompressedHDU (fitsName)) {
+      return False;
+   }
+   String spec(fullname_p);
+   spec.trim();
+   String extSpec = spec.from(Int(name_p.length()));
+   if (extSpec.empty()  &&  whichHDU_p > 0) {
+      extSpec = "[" + String::toString(whichHDU_p) + "]";
+   }
+   Int hdu = FITSCompressedLattice::findImage (fitsName + extSpec);
+   if (hdu < 0) {
+      return False;
+   }
+   whichHDU_p = hdu;
+   isCompressed_p = True;
+   dataType_p = TpFloat;
+   pCompressed_p = new FITSCompressedLattice
+     (fitsName + "[" + String::toString(whichHDU_p) + "]");
+//
+   LogIO os(LogOrigin("FITSImage", "setupCompressed", WHERE));
+   CoordinateSystem cSys;
+   IPosition shape;
+   ImageInfo imageInfo;
+   Unit brightnessUnit;
+   Record miscInfo;
+   crackCompressedHeader (cSys, shape, imageInfo, brightnessUnit, miscInfo,
+                          os, pCompressed_p->header(), whichRep_p);
+   pCompressed_p->addDegenerateAxes (shape.nelements());
+   if (! pCompressed_p->shape().isEqual (shape)) {
+      throw AipsError("FITSImage: shape of compressed image " + name_p +
+                      " mismatches its coordinate system");
+   }
+   shape_p = TiledShape (shape, pCompressed_p->tileShape());
+   setMiscInfoMember (miscInfo);
+   setCoordsMember (cSys);
+   setUnitMember (brightnessUnit);
+
+// Blanked pixels are NaN, so use a mask unless told otherwise.
+   hasBlanks_p = maskSpec_p.useDefault();
+   open();
+   if (_hasBeamsTable) {
+     ImageFITSConverter::readBeamsTable(imageInfo, Path(name_p).absoluteName(),
+                                        dataType_p);
+   }
+   setImageInfoMember (imageInfo);
+   return True;
+}
+
+void FITSImage::crackCompressedHeader (CoordinateSystem& cSys,
+                                       IPosition& shape, ImageInfo& imageInfo,
+                                       Unit& brightnessUnit,
+                                       RecordInterface& miscInfo, LogIO& os,
+                                       const Vector<String>& header,
+                                       uInt whichRep)
+{
+// The header is the one of the equivalent uncompressed image.
+// cfitsio already applies the scale factors and blanking.
+   shape = pCompressed_p->shape();
+   Record headerRec;
+   Bool dropStokes = True;
+   Int stokesFITSValue = 1;
+   cSys = ImageFITSConverter::getCoordinateSystem(stokesFITSValue, headerRec,
+                                                  header, os, whichRep,
+                                                  shape, dropStokes);
+   _hasBeamsTable = headerRec.isDefined(ImageFITSConverter::CASAMBM)
+     && headerRec.asRecord(ImageFITSConverter::CASAMBM).asBool("value");
+   brightnessUnit = ImageFITSConverter::getBrightnessUnit(headerRec, os);
+   imageInfo = ImageFITSConverter::getImageInfo(headerRec);
+   if (stokesFITSValue != -1) {
+      ImageInfo::ImageTypes type = ImageInfo::imageTypeFromFITS(stokesFITSValue);
+      if (type!= ImageInfo::Undefined) {
+         imageInfo.setImageType(type);
+      }
+   }
+
+// Get rid of anything else we don't want to end up in MiscInfo.
+
+   Vector<String> ignore(13);
+   ignore(0) = "^datamax$";
+   ignore(1) = "^datamin$";
+   ignore(2) = "^origin$";
+   ignore(3) = "^extend$";
+   ignore(4) = "^blocked$";
+   ignore(5) = "^blank$";
+   ignore(6) = "^simple$";
+   ignore(7) = "bscale";
+   ignore(8) = "bzero";
+   ignore(9) = "xtension";
+   ignore(10) = "pcount";
+   ignore(11) = "gcount";
+   ignore(12) = "^bitpix$";
+   FITSKeywordUtil::removeKeywords(headerRec, ignore);
+   ImageFITSConverter::extractMiscInfo(miscInfo, headerRec);
+
+// Get and store history.
+
+   FitsKeywordList kwl;
+   for (uInt i=0; i<header.nelements(); ++i) {
+      String card(header[i]);
+      if (card.length() < 80) {
+         card += String(80 - card.length(), ' ');
+      }
+      kwl.parse (card.chars(), 80);
+   }
+   ConstFitsKeywordList kw(kwl);
+   kw.first();
+   LoggerHolder& log = logger();
+   ImageFITSConverter::restoreHistory(log, kw);
+   if (! imageInfo.hasSingleBeam()) {
+      imageInfo.getRestoringBeam(log);
+   }
+}
+
+
 void FITSImage::open()
 {
+   if (isCompressed_p) {
+      if (pCompressed_p.null()) {
+         pCompressed_p = new FITSCompressedLattice
+           (Path(name_p).expandedName() + "[" +
+            String::toString(whichHDU_p) + "]");
+         pCompressed_p->addDegenerateAxes (shape_p.shape().nelements());
+      }
+      if (hasBlanks_p) {
+         FITSMask* fitsMask = new FITSMask(&(*pCompressed_p));
+         fitsMask->setFilterZero(filterZeroMask_p);
+         pPixelMask_p = fitsMask;
+      }
+      isClosed_p = False;
+      return;
+   }
    Bool writable = False;
    Bool canonical = True;    
 
 // The tile shape must not be a subchunk in all dimensions
+// The file is memory-mapped if possible, so slices are read directly.
 
    pTiledFile_p = new TiledFileAccess(name_p, fileOffset_p,
 				      shape_p.shape(), shape_p.tileShape(),
                                       dataType_p, TSMOption(),
-				      writable, canonical);
+				      writable, canonical, True);
 
 // Shares the pTiledFile_p pointer. Scale factors for integers
 
@@ -33,6 +33,7 @@
 #include <casacore/casa/aips.h>
 #include <casacore/images/Images/ImageInterface.h>
 #include <casacore/images/Images/MaskSpecifier.h>
+#include <casacore/images/Images/FITSCompressedLattice.h>
 #include <casacore/tables/DataMan/TiledFileAccess.h>
 #include <casacore/lattices/Lattices/TiledShape.h>
 #include <casacore/fits/FITS/fits.h>
@@ -79,13 +80,20 @@ class FitsInput;
 
 // <synopsis> 
 //  A FITSImage provides native access to FITS images by accessing them
-//  with the TiledFileAccess class.  The FITSImage is read only.
+//  with the TiledFileAccess class.  If possible, the file is memory-mapped,
+//  so slices are copied directly from the mapping without the overhead
+//  of a tile cache.  The FITSImage is read only.
 //  We could implement a writable FITSImage but putting the mask
 //  would lose data values (uses magic blanking) and FITS is really
 //  meant as an interchange medium, not an internal format.
 //
 //  Because FITS uses magic value blanking, the mask is generated
 //  on the fly as needed.
+//
+//  A tile-compressed image (as made by fpack) is also supported. It is
+//  accessed with the <linkto class=FITSCompressedLattice>
+//  FITSCompressedLattice</linkto> class, which only decompresses the tiles
+//  needed for a slice. In this case the data type is always TpFloat.
 // </synopsis> 
 
 // <example>
@@ -262,6 +270,7 @@ private:
   String         fullname_p;
   MaskSpecifier  maskSpec_p;
   CountedPtr<TiledFileAccess> pTiledFile_p;
+  CountedPtr<FITSCompressedLattice> pCompressed_p;
   Lattice<Bool>* pPixelMask_p;
   TiledShape     shape_p;
   Float          scale_p;
@@ -277,6 +286,7 @@ private:
   uInt           whichRep_p;
   uInt           whichHDU_p;
   Bool           _hasBeamsTable;
+  Bool           isCompressed_p;
 
 // Reopen the image if needed.
    void reopenIfNeeded() const
@@ -285,6 +295,10 @@ private:
 // Setup the object (used by constructors).
    void setup();
 
+// Setup the object for a tile-compressed image.
+// It returns False if the image is not tile-compressed.
+   Bool setupCompressed();
+
 // Open the image (used by setup and reopen).
    void open();
 
@@ -315,6 +329,12 @@ private:
 			Short& magicShort,
                         Int& magicLong, Bool& hasBlanks, LogIO& os, FitsInput& infile,
                         uInt whichRep);
+
+// Crack the header of a tile-compressed image.
+   void crackCompressedHeader (CoordinateSystem& cSys, IPosition& shape,
+                               ImageInfo& imageInfo, Unit& brightnessUnit,
+                               RecordInterface& miscInfo, LogIO& os,
+                               const Vector<String>& header, uInt whichRep);
 		     
 };
 
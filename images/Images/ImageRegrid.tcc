@@ -32,6 +32,7 @@
 #include <casacore/images/Images/ImageRegrid.h>
 
 #include <casacore/casa/Arrays/ArrayAccessor.h>
+#include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
 #include <casacore/coordinates/Coordinates/LinearCoordinate.h>
@@ -47,6 +48,10 @@
 #include <casacore/casa/sstream.h>
 #include <casacore/casa/fstream.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 template<class T>
@@ -1265,33 +1270,72 @@ void ImageRegrid<T>::make2DCoordinateGrid(LogIO& os, Bool& allFailed, Bool&misse
   Timer t0;
   uInt ii = 0;
   uInt jj = 0;
+//
+// The conversions are done per row of the (sparse) grid using the
+// batched toWorldMany and toPixelMany. These fail as a whole if the
+// conversion of a single pixel fails (e.g. outside an all-sky projection),
+// in which case the row is converted pixel by pixel.
+//
+  uInt nRowPix = 0;
+  for (uInt i=0; i<ni; i+=iInc) nRowPix++;
+  Matrix<Double> outPixels(2, nRowPix);
+  Matrix<Double> worlds, inPixels;
+  Vector<Bool> failures;
   for (uInt j=0; j<nj; j+=jInc,jj++) {
 	  ii = 0;
 	  for (uInt i=0; i<ni; i+=iInc,ii++) {
-		  outPixel(outXIdx) = i + outPos[xOutAxis];
-		  outPixel(outYIdx) = j + outPos[yOutAxis];
-
-		  // Do coordinate conversions (outpixel to world to inpixel)
-		  // for the axes of interest
-
-		  if (useMachine) {                             // must be Direction
-			  ok1 = outDir.toWorld(outMVD, outPixel);
-			  ok2 = False;
-			  if (ok1) {
+		  outPixels(outXIdx,ii) = i + outPos[xOutAxis];
+		  outPixels(outYIdx,ii) = j + outPos[yOutAxis];
+	  }
+	  Bool rowOK;
+	  if (isDir) {
+		  rowOK = outDir.toWorldMany(worlds, outPixels, failures);
+		  if (rowOK && useMachine) {
+			  for (ii=0; ii<nRowPix; ii++) {
+				  outMVD.setAngle(worlds(0,ii)*C::degree,
+						  worlds(1,ii)*C::degree);
 				  inMVD = machine(outMVD).getValue();
-				  ok2 = inDir.toPixel(inPixel, inMVD);
-			  };
+				  worlds(0,ii) = inMVD.getLong() / C::degree;
+				  worlds(1,ii) = inMVD.getLat() / C::degree;
+			  }
+		  }
+		  rowOK = rowOK && inDir.toPixelMany(inPixels, worlds, failures);
+	  } else {
+		  rowOK = outLin.toWorldMany(worlds, outPixels, failures)  &&
+				  inLin.toPixelMany(inPixels, worlds, failures);
+	  }
+	  ii = 0;
+	  for (uInt i=0; i<ni; i+=iInc,ii++) {
+		  if (rowOK) {
+			  ok1 = ok2 = True;
+			  inPixel(0) = inPixels(0,ii);
+			  inPixel(1) = inPixels(1,ii);
 		  } else {
-			  if (isDir) {
-				  ok1 = outDir.toWorld(world, outPixel);
+			  outPixel(outXIdx) = i + outPos[xOutAxis];
+			  outPixel(outYIdx) = j + outPos[yOutAxis];
+
+			  // Do coordinate conversions (outpixel to world to inpixel)
+			  // for the axes of interest
+
+			  if (useMachine) {                             // must be Direction
+				  ok1 = outDir.toWorld(outMVD, outPixel);
 				  ok2 = False;
-				  if (ok1) ok2 = inDir.toPixel(inPixel, world);
+				  if (ok1) {
+					  inMVD = machine(outMVD).getValue();
+					  ok2 = inDir.toPixel(inPixel, inMVD);
+				  };
 			  } else {
-				  ok1 = outLin.toWorld(world, outPixel);
-				  ok2 = False;
-				  if (ok1) ok2 = inLin.toPixel(inPixel, world);
-			  }
-		  };
+				  if (isDir) {
+					  ok1 = outDir.toWorld(world, outPixel);
+					  ok2 = False;
+					  if (ok1) ok2 = inDir.toPixel(inPixel, world);
+				  } else {
+					  ok1 = outLin.toWorld(world, outPixel);
+					  ok2 = False;
+					  if (ok1) ok2 = inLin.toPixel(inPixel, world);
+				  }
+			  };
+		  }
 		  //
 		  if (!ok1 || !ok2) {
 			  succeed(i,j) = False;
@@ -1332,38 +1376,56 @@ void ImageRegrid<T>::make2DCoordinateGrid(LogIO& os, Bool& allFailed, Bool&misse
     Timer t1;
     //
     Interpolate2D interp(Interpolate2D::LINEAR);
-    Vector<Double> pos(2);
-    Double resultI=0.0, resultJ=0.0;
-
-    ArrayAccessor<Bool, Axis<0> > sucp0;
-    ArrayAccessor<Bool, Axis<1> > sucp1(succeed);
-    ArrayAccessor<Double, Axis<0> > in2Dp0;
-    ArrayAccessor<Double, Axis<1> > in2Dp1(in2DPos);
-    for (uInt j=0; j<nj; j++) {
-      pos[1] = Double(j) / Double(jInc); 
-      sucp0 = sucp1;
-      in2Dp0 = in2Dp1;
-      for (uInt i=0; i<ni; i++) {
-	pos[0] = Double(i) / Double(iInc); 
-	ok1 = interp.interp(resultI, resultJ, pos,
-			    iInPos2D, jInPos2D, ijInMask2D);
-	if (ok1) {
-	  *in2Dp0 = resultI;
-	  in2Dp0.next(AxisN(2)) = resultJ;
-	  *sucp0 = True;
-	  allFailed = False;
-	  //
-	  minInX = minInX < resultI ? minInX : resultI;
-	  minInY = minInY < resultJ ? minInY : resultJ;
-	  maxInX = maxInX > resultI ? maxInX : resultI;
-	  maxInY = maxInY > resultJ ? maxInY : resultJ;
-	} else *sucp0 = False;
-	sucp0++;
-	in2Dp0++;
+    const Int nColumn = nj;
+
+// The columns are interpolated in parallel, each thread keeping
+// its own extrema which are merged at the end.
+
+#ifdef _OPENMP
+#pragma omp parallel if (ni*nj >= 4096)
+#endif
+    {
+      Vector<Double> pos(2);
+      Double resultI=0.0, resultJ=0.0;
+      Double tMinInX = minInX;
+      Double tMinInY = minInY;
+      Double tMaxInX = maxInX;
+      Double tMaxInY = maxInY;
+      Bool tAllFailed = True;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (Int j=0; j<nColumn; j++) {
+	pos[1] = Double(j) / Double(jInc); 
+	for (uInt i=0; i<ni; i++) {
+	  pos[0] = Double(i) / Double(iInc); 
+	  if (interp.interp(resultI, resultJ, pos,
+			    iInPos2D, jInPos2D, ijInMask2D)) {
+	    in2DPos(i,j,0) = resultI;
+	    in2DPos(i,j,1) = resultJ;
+	    succeed(i,j) = True;
+	    tAllFailed = False;
+	    //
+	    tMinInX = tMinInX < resultI ? tMinInX : resultI;
+	    tMinInY = tMinInY < resultJ ? tMinInY : resultJ;
+	    tMaxInX = tMaxInX > resultI ? tMaxInX : resultI;
+	    tMaxInY = tMaxInY > resultJ ? tMaxInY : resultJ;
+	  } else {
+	    succeed(i,j) = False;
+	  }
+	};
       };
-      sucp1++;
-      in2Dp1++;
-    };
+#ifdef _OPENMP
+#pragma omp critical(ImageRegrid_make2DCoordinateGrid)
+#endif
+      {
+	allFailed = allFailed && tAllFailed;
+	minInX = min(minInX, tMinInX);
+	minInY = min(minInY, tMinInY);
+	maxInX = max(maxInX, tMaxInX);
+	maxInY = max(maxInY, tMaxInY);
+      }
+    }
     if (itsShowLevel > 0) {
       cerr << "Interpolated grid took " << t1.all() << endl;
     };
@@ -1598,55 +1660,62 @@ void ImageRegrid<T>::regrid2DMatrix(Lattice<T>& outCursor,
       outMaskMCursor = &(outMaskCursorIterPtr->rwMatrixCursor());
     };
     
-    ArrayAccessor<Bool, Axis<0> > sucp0;
-    ArrayAccessor<Bool, Axis<1> > sucp1(succeed);
-    ArrayAccessor<T, Axis<0> > outMp0;
-    ArrayAccessor<T, Axis<1> > outMp1(outMCursor);
-    ArrayAccessor<Bool, Axis<0> > outMaskMp0;
-    ArrayAccessor<Bool, Axis<1> > outMaskMp1;
-    if (outIsMasked) outMaskMp1.init(*outMaskMCursor);
-    uInt dpix2DPos = &pix2DPos(0,0,1) - &pix2DPos(0,0,0);
-
-    for (uInt j=0; j<nCol; j++) {
-      if (outIsMasked) outMaskMp0 = outMaskMp1;
-      sucp0 = sucp1;
-      outMp0 = outMp1;
-      for (uInt i=0; i<nRow; i++) {
-	if (! *sucp0) {
-	  *outMp0 = 0.0;
-	  if (outIsMasked) *outMaskMp0 = False;
-	} else {
-	  
-	  // Now do the interpolation. pix2DPos(i,j,) is the absolute input
-	  // pixel coordinate in the input lattice for the
-	  // current output pixel.
-	  uInt ii = outPos3[xOutAxis] + i;
-	  uInt jj = outPos3[yOutAxis] + j;
-	  const Double *pix2Dp = &pix2DPos(ii,jj,0);
-	  pix2DPos2[0] = *pix2Dp - inChunkBlc[xInAxis];
-	  pix2DPos2[1] = *(pix2Dp + dpix2DPos) - inChunkBlc[yInAxis];
-	  if (inIsMasked) {                     
-	    interpOK = interp.interp(result, pix2DPos2, inDataChunk2D,
-				     *inMaskChunk2DPtr);
+    // The output pixels are independent, so the columns of the matrix
+    // are interpolated in parallel. Each column is interpolated in a
+    // single call of the batch interpolation.
+    // Small planes are not worth the threading overhead.
+    const Int nColumn = nCol;
+#ifdef _OPENMP
+#pragma omp parallel if (nRow*nCol >= 4096)
+#endif
+    {
+      Vector<Double> xPos(nRow), yPos(nRow);
+      Vector<uInt> rows(nRow);
+      Vector<T> result;
+      Vector<Bool> interpOK;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (Int j=0; j<nColumn; j++) {
+
+	// Collect the output pixels with a valid input pixel coordinate.
+	// pix2DPos(ii,jj,) is the absolute input pixel coordinate in the
+	// input lattice for the current output pixel.
+	const uInt jj = outPos3[yOutAxis] + j;
+	uInt n = 0;
+	for (uInt i=0; i<nRow; i++) {
+	  if (! succeed(i,j)) {
+	    outMCursor(i,j) = 0.0;
+	    if (outIsMasked) (*outMaskMCursor)(i,j) = False;
 	  } else {
-	    interpOK = interp.interp(result, pix2DPos2, inDataChunk2D);
+	    const uInt ii = outPos3[xOutAxis] + i;
+	    xPos[n] = pix2DPos(ii,jj,0) - inChunkBlc[xInAxis];
+	    yPos[n] = pix2DPos(ii,jj,1) - inChunkBlc[yInAxis];
+	    rows[n++] = i;
 	  };
-	  if (interpOK) {
-	    *outMp0 = scale * result;
-	    if (outIsMasked) *outMaskMp0 = True; 
+	};
+	if (n > 0) {
+	  Vector<Double> x(xPos(Slice(0,n)));
+	  Vector<Double> y(yPos(Slice(0,n)));
+	  if (inIsMasked) {
+	    interp.interpMany(result, interpOK, x, y, inDataChunk2D,
+			      *inMaskChunk2DPtr, False);
 	  } else {
-	    *outMp0 = 0.0;
-	    if (outIsMasked) *outMaskMp0 = False; 
+	    interp.interpMany(result, interpOK, x, y, inDataChunk2D, False);
+	  };
+	  for (uInt k=0; k<n; k++) {
+	    const uInt i = rows[k];
+	    if (interpOK[k]) {
+	      outMCursor(i,j) = scale * result[k];
+	      if (outIsMasked) (*outMaskMCursor)(i,j) = True;
+	    } else {
+	      outMCursor(i,j) = 0.0;
+	      if (outIsMasked) (*outMaskMCursor)(i,j) = False;
+	    };
 	  };
 	};
-	sucp0++;
-	outMp0++;
-	outMaskMp0++;
       };
-      sucp1++;
-      outMp1++;
-      outMaskMp1++;
-    };
+    }
     //
     if (pProgressMeter) {
       pProgressMeter->update(iPix); 
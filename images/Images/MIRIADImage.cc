@@ -442,7 +442,7 @@ void MIRIADImage::open()
    pTiledFile_p = new TiledFileAccess(iname, fileOffset_p,
 				      shape_p.shape(), shape_p.tileShape(),
                                       dataType_p, TSMOption(),
-				      writable, canonical);
+				      writable, canonical, True);
 
    // Shares the pTiledFile_p pointer. 
 
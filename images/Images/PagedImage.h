@@ -369,6 +369,10 @@ public:
   // Report on cache success.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Get the statistics of the tile cache of the pixels.
+  virtual Bool getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                   uInt& nWrite) const;
+
   // Handle the (un)locking.
   // Unlocking also unlocks the logtable and a possible mask table.
   // Locking only locks the image itself.
@@ -709,6 +709,13 @@ void PagedImage<T>::showCacheStatistics(ostream& os) const
   }
 }
 
+template<class T> 
+Bool PagedImage<T>::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                        uInt& nWrite) const
+{
+  return map_p.getCacheStatistics (nAccess, nRead, nWrite);
+}
+
 template<class T> 
 uInt PagedImage<T>::advisedMaxPixels() const
 {
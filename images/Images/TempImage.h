@@ -274,6 +274,10 @@ public:
   // Report on cache success.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Get the statistics of the tile cache.
+  virtual Bool getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                   uInt& nWrite) const;
+
   // Check for symmetry in data members.
   virtual Bool ok() const;
 
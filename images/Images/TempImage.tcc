@@ -402,6 +402,13 @@ void TempImage<T>::showCacheStatistics (ostream& os) const
   mapPtr_p->showCacheStatistics (os);
 }
 
+template<class T>
+Bool TempImage<T>::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                       uInt& nWrite) const
+{
+  return mapPtr_p->getCacheStatistics (nAccess, nRead, nWrite);
+}
+
 
 template<class T>
 T TempImage<T>::getAt (const IPosition& where) const
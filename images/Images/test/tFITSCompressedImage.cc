@@ -0,0 +1,122 @@
+//# tFITSCompressedImage.cc: Test program for tile-compressed FITS images
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/images/Images/FITSImage.h>
+#include <casacore/images/Images/FITSCompressedLattice.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <fitsio.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for tile-compressed images in class FITSImage.
+// A tile-compressed copy of a FITS image is made with cfitsio; its pixels
+// must be the same as the ones of the uncompressed image.
+// </summary>
+
+// Write a losslessly tile-compressed copy of the image.
+void compressImage (const String& in, const String& out, int compType)
+{
+  fitsfile* infptr = 0;
+  fitsfile* outfptr = 0;
+  int status = 0;
+  fits_open_image (&infptr, in.chars(), READONLY, &status);
+  fits_create_file (&outfptr, ("!" + out).chars(), &status);
+  fits_set_compression_type (outfptr, compType, &status);
+  // Floating point values must not be quantized, so the result is exact.
+  fits_set_quantize_level (outfptr, 0., &status);
+  fits_img_compress (infptr, outfptr, &status);
+  fits_close_file (outfptr, &status);
+  fits_close_file (infptr, &status);
+  if (status != 0) {
+    fits_report_error (stderr, status);
+    throw AipsError ("Could not create compressed image " + out);
+  }
+}
+
+// Check that the pixels and masks are the same where the masks are set.
+void checkEqual (const Array<Float>& data1, const Array<Bool>& mask1,
+                 const Array<Float>& data2, const Array<Bool>& mask2)
+{
+  AlwaysAssertExit (data1.shape().isEqual (data2.shape()));
+  AlwaysAssertExit (allEQ (mask1, mask2));
+  Array<Float> d1 = data1.copy();
+  Array<Float> d2 = data2.copy();
+  d1(!mask1) = 0;
+  d2(!mask2) = 0;
+  AlwaysAssertExit (allEQ (d1, d2));
+}
+
+void doTest (const String& in, const String& out, int compType)
+{
+  compressImage (in, out, compType);
+  AlwaysAssertExit (! FITSCompressedLattice::hasCompressedHDU (in));
+  AlwaysAssertExit (FITSCompressedLattice::hasCompressedHDU (out));
+  FITSImage image(in);
+  FITSImage cimage(out);
+  AlwaysAssertExit (cimage.shape().isEqual (image.shape()));
+  AlwaysAssertExit (cimage.coordinates().near (image.coordinates()));
+  AlwaysAssertExit (cimage.units().getName() == image.units().getName());
+  // Compare all pixels.
+  checkEqual (image.get(), image.getMask(), cimage.get(), cimage.getMask());
+  // Compare a part crossing tile boundaries.
+  IPosition shape = image.shape();
+  IPosition start (shape.nelements(), 0);
+  IPosition length (shape);
+  start[0] = shape[0] / 3;
+  length[0] = shape[0] - start[0];
+  if (shape.nelements() > 1) {
+    start[1] = shape[1] / 4;
+    length[1] = shape[1] / 2;
+  }
+  checkEqual (image.getSlice(start, length), image.getMaskSlice(start, length),
+              cimage.getSlice(start, length),
+              cimage.getMaskSlice(start, length));
+  // A clone must give the same result.
+  ImageInterface<Float>* pImage = cimage.cloneII();
+  checkEqual (image.get(), image.getMask(), pImage->get(), pImage->getMask());
+  delete pImage;
+}
+
+int main()
+{
+  try {
+    // Lossless compression of floating point values requires GZIP.
+    doTest ("imagetestimage.fits", "tFITSCompressedImage_tmp1.fits", GZIP_1);
+    doTest ("imagetestimage.fits", "tFITSCompressedImage_tmp2.fits", GZIP_2);
+  } catch (AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -43,6 +43,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 FITSMask::FITSMask (TiledFileAccess* tiledFile)
 : itsTiledFilePtr(tiledFile),
+  itsLatticePtr(0),
   itsScale(1.0),
   itsOffset(0.0),
   itsUCharMagic(0),
@@ -59,6 +60,7 @@ FITSMask::FITSMask (TiledFileAccess* tiledFile)
 FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
                     uChar magic, Bool hasBlanks)
 : itsTiledFilePtr(tiledFile),
+  itsLatticePtr(0),
   itsScale(scale),
   itsOffset(offset),
   itsUCharMagic(magic),
@@ -73,6 +75,7 @@ FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
 FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
                     Short magic, Bool hasBlanks)
 : itsTiledFilePtr(tiledFile),
+  itsLatticePtr(0),
   itsScale(scale),
   itsOffset(offset),
   itsUCharMagic(0),
@@ -87,6 +90,7 @@ FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
 FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
                     Int magic, Bool hasBlanks)
 : itsTiledFilePtr(tiledFile),
+  itsLatticePtr(0),
   itsScale(scale),
   itsOffset(offset),
   itsUCharMagic(0),
@@ -98,10 +102,23 @@ FITSMask::FITSMask (TiledFileAccess* tiledFile, Float scale, Float offset,
    AlwaysAssert(itsTiledFilePtr->dataType()==TpInt, AipsError);
 }
 
+FITSMask::FITSMask (Lattice<Float>* dataLattice)
+: itsTiledFilePtr(0),
+  itsLatticePtr(dataLattice),
+  itsScale(1.0),
+  itsOffset(0.0),
+  itsUCharMagic(0),
+  itsShortMagic(0),
+  itsLongMagic(0),
+  itsHasIntBlanks(False),
+  itsFilterZero(False)
+{}
+
 
 FITSMask::FITSMask (const FITSMask& other)
 : Lattice<Bool>(other),
   itsTiledFilePtr(other.itsTiledFilePtr),
+  itsLatticePtr(other.itsLatticePtr),
   itsScale(other.itsScale),
   itsOffset(other.itsOffset),
   itsUCharMagic(other.itsUCharMagic),
@@ -118,6 +135,7 @@ FITSMask& FITSMask::operator= (const FITSMask& other)
 {
   if (this != &other) {
     itsTiledFilePtr = other.itsTiledFilePtr;
+    itsLatticePtr = other.itsLatticePtr;
     itsBuffer.resize();
     itsBuffer = other.itsBuffer.copy();
     itsScale = other.itsScale;
@@ -143,6 +161,9 @@ Bool FITSMask::isWritable() const
 
 IPosition FITSMask::shape() const
 {
+  if (itsLatticePtr) {
+    return itsLatticePtr->shape();
+  }
   return itsTiledFilePtr->shape();
 }
 
@@ -152,7 +173,9 @@ Bool FITSMask::doGetSlice (Array<Bool>& mask, const Slicer& section)
    if (!mask.shape().isEqual(shp)) mask.resize(shp);
    if (!itsBuffer.shape().isEqual(shp)) itsBuffer.resize(shp);
 //
-   if (itsTiledFilePtr->dataType()==TpFloat) {
+   if (itsLatticePtr) {
+      itsLatticePtr->getSlice(itsBuffer, section);
+   } else if (itsTiledFilePtr->dataType()==TpFloat) {
       itsTiledFilePtr->get(itsBuffer, section);
    } else if (itsTiledFilePtr->dataType()==TpDouble) {
       Array<Double> tmp(shp);
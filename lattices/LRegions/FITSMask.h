@@ -119,6 +119,11 @@ public:
   // the FITS header ('bscale', 'bzero', 'blank')
   FITSMask (TiledFileAccess* tiledFileAccess, Float scale, Float offset,
             Int magic, Bool hasBlanks);
+
+  // Constructor for a lattice giving the (already scaled) data, such as
+  // a tile-compressed FITS image. Blanked values must be NaN.
+  // The pointer is not cloned, just copied.
+  FITSMask (Lattice<Float>* dataLattice);
   
   // Copy constructor (reference semantics).  The TiledFileAccess pointer
   // is just copied.
@@ -164,6 +169,7 @@ private:
  
 //
   TiledFileAccess* itsTiledFilePtr;
+  Lattice<Float>*  itsLatticePtr;
   Array<Float> itsBuffer;
   Float itsScale, itsOffset;
   Short itsUCharMagic;
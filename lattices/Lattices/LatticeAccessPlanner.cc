@@ -0,0 +1,241 @@
+//# LatticeAccessPlanner.cc: Plan a tile cache friendly traversal of a lattice
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casacore/lattices/Lattices/LatticeAccessPlanner.h>
+#include <casacore/lattices/Lattices/LatticeBase.h>
+#include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/sstream.h>
+#include <algorithm>
+#include <limits>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+LatticeAccessPlanner::LatticeAccessPlanner (const IPosition& latticeShape,
+                                            const IPosition& tileShape,
+                                            const IPosition& accessAxes,
+                                            uInt pixelSize,
+                                            uInt64 memoryBudget)
+: itsLatticeShape  (latticeShape),
+  itsTileShape     (tileShape),
+  itsPixelSize     (pixelSize),
+  itsBudget        (memoryBudget),
+  itsCacheSize     (0),
+  itsExpectedReads (0)
+{
+  makePlan (accessAxes);
+}
+
+LatticeAccessPlanner::LatticeAccessPlanner (const LatticeBase& lattice,
+                                            const IPosition& accessAxes,
+                                            uInt64 memoryBudget)
+: itsLatticeShape  (lattice.shape()),
+  itsTileShape     (lattice.niceCursorShape()),
+  itsPixelSize     (ValType::getTypeSize (lattice.dataType())),
+  itsBudget        (memoryBudget),
+  itsCacheSize     (0),
+  itsExpectedReads (0)
+{
+  makePlan (accessAxes);
+}
+
+uInt64 LatticeAccessPlanner::cacheSizeInBytes() const
+{
+  return uInt64(itsCacheSize) * itsTileShape.product() * itsPixelSize;
+}
+
+uInt64 LatticeAccessPlanner::cursorSizeInBytes() const
+{
+  return uInt64(itsCursorShape.product()) * itsPixelSize;
+}
+
+Bool LatticeAccessPlanner::fitsBudget() const
+{
+  return itsBudget == 0  ||
+         cacheSizeInBytes() + cursorSizeInBytes() <= itsBudget;
+}
+
+uInt64 LatticeAccessPlanner::minimumTileReads() const
+{
+  return nrTiles (itsLatticeShape);
+}
+
+LatticeStepper LatticeAccessPlanner::stepper() const
+{
+  return LatticeStepper (itsLatticeShape, itsCursorShape, itsAxisPath,
+                         LatticeStepper::RESIZE);
+}
+
+void LatticeAccessPlanner::apply (LatticeBase& lattice) const
+{
+  uInt64 npixels = uInt64(itsCacheSize) * itsTileShape.product();
+  lattice.setMaximumCacheSize
+    (std::min (npixels, uInt64(std::numeric_limits<uInt>::max())));
+  lattice.setCacheSizeInTiles (itsCacheSize);
+}
+
+uInt64 LatticeAccessPlanner::nrTiles (const IPosition& cursorShape) const
+{
+  uInt64 n = 1;
+  for (uInt i=0; i<cursorShape.nelements(); ++i) {
+    n *= (cursorShape[i] + itsTileShape[i] - 1) / itsTileShape[i];
+  }
+  return n;
+}
+
+void LatticeAccessPlanner::makePlan (const IPosition& accessAxes)
+{
+  const uInt ndim = itsLatticeShape.nelements();
+  if (itsTileShape.nelements() != ndim) {
+    ostringstream ostr;
+    ostr << "LatticeAccessPlanner: tile shape " << itsTileShape
+         << " and lattice shape " << itsLatticeShape
+         << " have different dimensionality";
+    throw AipsError (ostr.str());
+  }
+  if (itsPixelSize == 0) {
+    throw AipsError ("LatticeAccessPlanner: pixel size cannot be 0");
+  }
+  for (uInt i=0; i<ndim; ++i) {
+    if (itsLatticeShape[i] <= 0  ||  itsTileShape[i] <= 0) {
+      throw AipsError ("LatticeAccessPlanner: lattice and tile shape "
+                       "must be positive");
+    }
+    itsTileShape[i] = std::min (itsTileShape[i], itsLatticeShape[i]);
+  }
+  Block<Bool> isAccessAxis(ndim, False);
+  for (uInt i=0; i<accessAxes.nelements(); ++i) {
+    if (accessAxes[i] < 0  ||  accessAxes[i] >= Int(ndim)
+    ||  isAccessAxis[accessAxes[i]]) {
+      ostringstream ostr;
+      ostr << "LatticeAccessPlanner: access axes " << accessAxes
+           << " are invalid or not unique";
+      throw AipsError (ostr.str());
+    }
+    isAccessAxis[accessAxes[i]] = True;
+  }
+  // The access axes go first in the axis path. They are followed by the
+  // other axes in order of decreasing tile length, so the cursor can be
+  // shrunk most along the first of them if needed.
+  const uInt naccess = accessAxes.nelements();
+  itsAxisPath.resize (ndim);
+  for (uInt i=0; i<naccess; ++i) {
+    itsAxisPath[i] = accessAxes[i];
+  }
+  uInt nax = naccess;
+  for (uInt i=0; i<ndim; ++i) {
+    if (! isAccessAxis[i]) {
+      uInt j = nax++;
+      while (j > naccess  &&  itsTileShape[itsAxisPath[j-1]] < itsTileShape[i]) {
+        itsAxisPath[j] = itsAxisPath[j-1];
+        --j;
+      }
+      itsAxisPath[j] = i;
+    }
+  }
+  // The cursor covers the access axes entirely and is aligned with the
+  // tiles on the other axes. In that way the tiles in a cursor form a
+  // column which is used completely before moving to the next one.
+  itsCursorShape = itsTileShape;
+  for (uInt i=0; i<naccess; ++i) {
+    itsCursorShape[accessAxes[i]] = itsLatticeShape[accessAxes[i]];
+  }
+  const uInt64 tileBytes = uInt64(itsTileShape.product()) * itsPixelSize;
+  const uInt64 columnTiles = nrTiles (itsCursorShape);
+  const uInt64 budget = (itsBudget == 0  ?
+                         std::numeric_limits<uInt64>::max() : itsBudget);
+  itsCacheSize = columnTiles;
+  itsExpectedReads = minimumTileReads();
+  if (columnTiles * tileBytes + cursorSizeInBytes() <= budget) {
+    // It fits. If a budget is given, use it to enlarge the cursor along
+    // the non-access axes (in path order) to reduce the number of steps.
+    // A cursor of multiple whole tiles still reads each tile once.
+    if (itsBudget > 0) {
+      for (uInt i=naccess; i<ndim; ++i) {
+        uInt axis = itsAxisPath[i];
+        while (itsCursorShape[axis] < itsLatticeShape[axis]) {
+          IPosition trial (itsCursorShape);
+          trial[axis] = std::min (2*itsCursorShape[axis],
+                                  itsLatticeShape[axis]);
+          uInt64 ntiles = nrTiles (trial);
+          if (ntiles * tileBytes + uInt64(trial.product()) * itsPixelSize
+              > budget) {
+            break;
+          }
+          itsCursorShape = trial;
+          itsCacheSize = ntiles;
+        }
+        if (itsCursorShape[axis] < itsLatticeShape[axis]) {
+          break;
+        }
+      }
+    }
+  } else if (naccess < ndim) {
+    // Shrink the cursor along the first non-access axis. Its length is
+    // kept a divisor of the tile length, so a cursor never straddles
+    // a tile boundary on that axis.
+    uInt axis = itsAxisPath[naccess];
+    uInt64 lineBytes = cursorSizeInBytes() / itsCursorShape[axis];
+    uInt64 cacheBytes = columnTiles * tileBytes;
+    uInt64 maxLength;
+    if (cacheBytes + lineBytes <= budget) {
+      // The cache for a single read of each tile fits.
+      maxLength = (budget - cacheBytes) / lineBytes;
+    } else {
+      // It does not fit, so tiles are read multiple times.
+      // Divide the budget evenly over cursor and cache.
+      maxLength = budget / 2 / lineBytes;
+    }
+    Int length = std::max (Int64(1),
+                           std::min (Int64(maxLength),
+                                     Int64(itsTileShape[axis])));
+    while (itsTileShape[axis] % length != 0) {
+      --length;
+    }
+    itsCursorShape[axis] = length;
+    if (cacheBytes + cursorSizeInBytes() > budget) {
+      uInt64 left = (budget > cursorSizeInBytes()  ?
+                     budget - cursorSizeInBytes() : 0);
+      itsCacheSize = std::max (uInt64(1), left / tileBytes);
+      // Each tile is read again for each cursor step within it.
+      itsExpectedReads *= itsTileShape[axis] / length;
+    }
+  } else {
+    // The cursor is the entire lattice, which is read in a single step.
+    // Each tile is read once, regardless of the cache size.
+    uInt64 left = (budget > cursorSizeInBytes()  ?
+                   budget - cursorSizeInBytes() : 0);
+    itsCacheSize = std::max (uInt64(1), std::min (columnTiles,
+                                                  left / tileBytes));
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
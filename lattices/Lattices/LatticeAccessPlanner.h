@@ -0,0 +1,202 @@
+//# LatticeAccessPlanner.h: Plan a tile cache friendly traversal of a lattice
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef LATTICES_LATTICEACCESSPLANNER_H
+#define LATTICES_LATTICEACCESSPLANNER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/lattices/Lattices/LatticeStepper.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class LatticeBase;
+
+
+// <summary>
+// Plan a tile cache friendly traversal of a tiled lattice.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tLatticeAccessPlanner.cc">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=LatticeStepper>LatticeStepper</linkto>
+//   <li> <linkto class=TiledShape>TiledShape</linkto>
+//   <li> <linkto class=PagedArray>PagedArray</linkto>
+// </prerequisite>
+
+// <etymology>
+// LatticeAccessPlanner plans how a lattice should be accessed.
+// </etymology>
+
+// <synopsis>
+// The speed of iterating through a tiled lattice (e.g. a
+// <linkto class=PagedArray>PagedArray</linkto>) depends heavily on the
+// cursor shape, the order in which the cursor moves through the lattice
+// and the size of the tile cache. A poor combination causes tiles to be
+// read many times, which can easily make an iteration 10-100 times slower.
+// A typical example is reading spectral profiles from a cube tiled for
+// plane access.
+// <p>
+// Given the lattice shape, the tile shape, the axes that have to be
+// accessed in full by each cursor (e.g. the spectral axis for profiles or
+// the first two axes for planes), the pixel size and a memory budget for
+// the tile cache plus the cursor, LatticeAccessPlanner determines:
+// <ul>
+//  <li> The cursor shape. It spans the full lattice along the access axes
+//       and is aligned with the tile boundaries along the other axes,
+//       so that each tile is used completely before it is dropped from the
+//       cache. If the budget allows, the cursor contains multiple tiles
+//       along the other axes, which reduces the number of iteration steps.
+//       If the budget is too small, the cursor is shrunk along the first
+//       non-access axis in the axis path; that does not require extra
+//       tile reads.
+//  <li> The axis path, i.e. the order in which the cursor moves. The
+//       access axes come first, followed by the other axes in order of
+//       decreasing tile length, so that the cursor can be shrunk the most
+//       along the first one.
+//  <li> The cache size (in tiles) needed to read each tile only once.
+//       If it does not fit in the budget, the cache gets whatever is
+//       left of the budget and some tiles will be read more than once.
+// </ul>
+// The expected number of tile reads can be compared with the minimum
+// (the number of tiles in the lattice) to judge the quality of the plan.
+// After the iteration the actual number of tile reads can be obtained
+// from the lattice using the function
+// <src>LatticeBase::getCacheStatistics</src>.
+// <p>
+// Function <src>apply</src> sets the (maximum) cache size of a lattice
+// according to the plan, while <src>stepper</src> returns a
+// <linkto class=LatticeStepper>LatticeStepper</linkto> with the planned
+// cursor shape and axis path.
+// </synopsis>
+
+// <example>
+// Get all spectra (axis 2) of a cube using at most 64 MBytes.
+// <srcblock>
+// PagedArray<Float> cube("cube.data");
+// LatticeAccessPlanner plan(cube, IPosition(1,2), 64*1024*1024);
+// plan.apply (cube);
+// RO_LatticeIterator<Float> iter(cube, plan.stepper());
+// for (iter.reset(); !iter.atEnd(); iter++) {
+//   const Array<Float>& block = iter.cursor();
+//   // process all spectra in the block
+// }
+// uInt nAccess, nRead, nWrite;
+// cube.getCacheStatistics (nAccess, nRead, nWrite);
+// cout << nRead << " tiles read; expected " << plan.expectedTileReads()
+//      << endl;
+// </srcblock>
+// </example>
+
+// <motivation>
+// Users should not need to know the intricacies of the tiled storage
+// manager to iterate efficiently through a lattice.
+// </motivation>
+
+class LatticeAccessPlanner
+{
+public:
+  // Plan the access of a lattice with the given shape and tile shape.
+  // <src>accessAxes</src> gives the axes that have to be accessed in full
+  // by each cursor. The memory budget (in bytes) is for the tile cache
+  // plus the cursor. A budget of 0 means unlimited.
+  // An exception is thrown if the arguments are inconsistent.
+  LatticeAccessPlanner (const IPosition& latticeShape,
+                        const IPosition& tileShape,
+                        const IPosition& accessAxes,
+                        uInt pixelSize, uInt64 memoryBudget);
+
+  // Plan the access of the given lattice. Its tile shape is taken from
+  // <src>niceCursorShape()</src> and its pixel size from its data type.
+  LatticeAccessPlanner (const LatticeBase& lattice,
+                        const IPosition& accessAxes,
+                        uInt64 memoryBudget);
+
+  // Get the planned cursor shape.
+  const IPosition& cursorShape() const
+    { return itsCursorShape; }
+
+  // Get the planned axis path.
+  const IPosition& axisPath() const
+    { return itsAxisPath; }
+
+  // Get the planned cache size (in tiles).
+  uInt cacheSizeInTiles() const
+    { return itsCacheSize; }
+
+  // Get the memory (in bytes) used by the tile cache and by the cursor.
+  // <group>
+  uInt64 cacheSizeInBytes() const;
+  uInt64 cursorSizeInBytes() const;
+  // </group>
+
+  // Does the plan fit in the memory budget?
+  // It can only exceed the budget if a single cursor line plus a single
+  // tile do not fit.
+  Bool fitsBudget() const;
+
+  // Get the expected number of tile reads for a full traversal.
+  uInt64 expectedTileReads() const
+    { return itsExpectedReads; }
+
+  // Get the minimum number of tile reads, i.e. the number of tiles.
+  uInt64 minimumTileReads() const;
+
+  // Get a stepper following the plan. The RESIZE policy is used, so the
+  // cursor never extends beyond the lattice.
+  LatticeStepper stepper() const;
+
+  // Set the maximum cache size and cache size of the lattice.
+  void apply (LatticeBase& lattice) const;
+
+private:
+  // Make the plan.
+  void makePlan (const IPosition& accessAxes);
+
+  // Get the number of tiles needed for the given cursor shape.
+  uInt64 nrTiles (const IPosition& cursorShape) const;
+
+  IPosition itsLatticeShape;
+  IPosition itsTileShape;
+  uInt      itsPixelSize;
+  uInt64    itsBudget;
+  IPosition itsCursorShape;
+  IPosition itsAxisPath;
+  uInt      itsCacheSize;
+  uInt64    itsExpectedReads;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
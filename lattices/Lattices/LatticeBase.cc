@@ -153,6 +153,13 @@ void LatticeBase::clearCache()
 void LatticeBase::showCacheStatistics (ostream&) const
 {}
 
+Bool LatticeBase::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                      uInt& nWrite) const
+{
+  nAccess = nRead = nWrite = 0;
+  return False;
+}
+
 void LatticeBase::throwBoolMath() const
 {
   throw AipsError ("Operator +=, etc. cannot be used for a Boolean lattice");
@@ -253,6 +253,14 @@ public:
   // <br>The default implementation does nothing.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Get the statistics of the tile cache since it was last cleared: the
+  // number of tile accesses and the number of tiles read from and written
+  // to disk. The cache hit ratio is <src>1 - nRead/nAccess</src>.
+  // It returns False if the lattice has no tile cache.
+  // <br>The default implementation sets all values to 0 and returns False.
+  virtual Bool getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                   uInt& nWrite) const;
+
 
 protected:
   // Define default constructor to be used by derived classes.
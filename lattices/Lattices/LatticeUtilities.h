@@ -29,6 +29,7 @@
 #define LATTICES_LATTICEUTILITIES_H
 
 #include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -36,7 +37,6 @@ template <class T> class Array;
 template <class T> class Lattice;
 template <class T> class MaskedLattice;
 template <class T> class MaskedArray;
-class IPosition;
 class LogIO;
 class Slicer;
 
@@ -99,6 +99,27 @@ class LatticeUtilities
 // holds an ExtendLattice.  The pointer is the callers responsibility to delete.
    template <class T>
    static void addDegenerateAxes (Lattice<T>*& pLatOut, const Lattice<T>& latIn, uInt nDim);
+
+// Copy the data of the input lattice to the output lattice, which usually
+// has another tile shape (e.g. to turn a cube tiled for plane access into
+// one tiled for spectral access). Optionally the axes are reordered as
+// well; <src>axisOrder</src> has the same meaning as in function
+// <linkto group="ArrayUtil.h#reorderArray">reorderArray</linkto>, thus
+// output axis i is input axis <src>axisOrder[i]</src>. An empty axis order
+// means no reordering. The output shape must match the reordered input shape.
+// <br>The copy is done as a blocked transpose with memory usage bounded by
+// <src>memoryBudget</src> (in bytes; 0 means a quarter of the free memory).
+// The blocks contain whole tiles of both lattices, so each tile is read
+// and written only once. If such a block does not fit in the budget, it is
+// processed in multiple passes of smaller blocks aligned with the output
+// tiles, while the tile cache of the input holds the input tiles of the
+// block (as far as the budget allows).
+// <br>Only the data are copied; masks and, for images, coordinates
+// have to be handled by the caller.
+   template <class T>
+   static void retile (Lattice<T>& out, const Lattice<T>& in,
+                       const IPosition& axisOrder = IPosition(),
+                       uInt64 memoryBudget = 0);
 };
 
 
@@ -34,6 +34,8 @@
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/MaskedArray.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/lattices/Lattices/Lattice.h>
 #include <casacore/lattices/Lattices/ArrayLattice.h>
 #include <casacore/lattices/Lattices/ExtendLattice.h>
@@ -45,9 +47,13 @@
 #include <casacore/lattices/Lattices/RebinLattice.h>
 #include <casacore/casa/Logging/LogIO.h>
 #include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+#include <algorithm>
 
 namespace casacore {  //# namespace casacore begin
 
@@ -186,6 +192,159 @@ void LatticeUtilities::bin (MaskedArray<T>& out, const MaskedArray<T>& in,
    out = tmp;
 }
 
+template <class T>
+void LatticeUtilities::retile (Lattice<T>& out, const Lattice<T>& in,
+                               const IPosition& axisOrder,
+                               uInt64 memoryBudget)
+{
+   const uInt nDim = in.ndim();
+   const IPosition inShape = in.shape();
+   IPosition order (axisOrder);
+   if (order.nelements() == 0) {
+      order = IPosition::makeAxisPath (nDim);
+   }
+// Check the axis order and the output shape
+
+   Block<Bool> used(nDim, False);
+   IPosition outShape(nDim);
+   Bool ok = (order.nelements() == nDim);
+   for (uInt i=0; ok && i<nDim; ++i) {
+      if (order[i] < 0  ||  order[i] >= Int(nDim)  ||  used[order[i]]) {
+         ok = False;
+      } else {
+         used[order[i]] = True;
+         outShape[i] = inShape[order[i]];
+      }
+   }
+   if (!ok) {
+      ostringstream oss;
+      oss << "LatticeUtilities::retile - axis order " << axisOrder
+          << " is invalid for a lattice with " << nDim << " axes";
+      throw AipsError (oss.str());
+   }
+   if (! outShape.isEqual (out.shape())) {
+      ostringstream oss;
+      oss << "LatticeUtilities::retile - output shape " << out.shape()
+          << " differs from reordered input shape " << outShape;
+      throw AipsError (oss.str());
+   }
+   if (memoryBudget == 0) {
+      memoryBudget = std::max (Int64(HostInfo::memoryFree()) * 1024 / 4,
+                               Int64(16*1024*1024));
+   }
+   const uInt64 pixelSize = sizeof(T);
+
+// Get the tile shapes expressed in the output axes.
+// A unit block consists of whole tiles of both lattices, so no tile
+// is shared between unit blocks.
+
+   const IPosition inTile (in.niceCursorShape());
+   const IPosition outTile (out.niceCursorShape());
+   IPosition inTileOut(nDim);
+   IPosition unit(nDim);
+   for (uInt i=0; i<nDim; ++i) {
+      inTileOut[i] = inTile[order[i]];
+      Int64 a = inTileOut[i];
+      Int64 b = outTile[i];
+      while (b != 0) {
+         Int64 t = a % b;
+         a = b;
+         b = t;
+      }
+      unit[i] = std::min (Int64(inTileOut[i] / a * outTile[i]),
+                          Int64(outShape[i]));
+   }
+
+// The memory used is the input block and its reordered copy.
+// If a unit block fits, use blocks of as many unit blocks as possible
+// (the first axes filled first). Otherwise process a unit block in
+// multiple passes of sub blocks consisting of whole output tiles.
+
+   IPosition block (unit);
+   IPosition subBlock (unit);
+   uInt inCacheSize = 0;
+   if (2 * pixelSize * block.product() <= memoryBudget) {
+      for (uInt i=0; i<nDim; ++i) {
+         while (block[i] < outShape[i]) {
+            IPosition trial (block);
+            trial[i] = std::min (2*block[i], outShape[i]);
+            if (2 * pixelSize * trial.product() > memoryBudget) {
+               break;
+            }
+            block = trial;
+         }
+         if (block[i] < outShape[i]) {
+            break;
+         }
+      }
+      subBlock = block;
+   } else {
+      uInt64 nInTiles = 1;
+      for (uInt i=0; i<nDim; ++i) {
+         nInTiles *= (unit[i] + inTileOut[i] - 1) / inTileOut[i];
+      }
+      const uInt64 inTileBytes = pixelSize * inTile.product();
+      const uInt64 cacheBytes = nInTiles * inTileBytes;
+      for (Int i=nDim-1; i>=0; --i) {
+         while (subBlock[i] > outTile[i]  &&
+                2 * pixelSize * subBlock.product() + cacheBytes >
+                memoryBudget) {
+            subBlock[i] = std::max (Int64(1),
+                                    Int64(subBlock[i] / outTile[i] / 2)) *
+                          outTile[i];
+         }
+      }
+      const uInt64 subBytes = 2 * pixelSize * subBlock.product();
+      inCacheSize = nInTiles;
+      if (subBytes + cacheBytes > memoryBudget) {
+         inCacheSize = std::max (uInt64(1),
+                                 (memoryBudget > subBytes  ?
+                                  (memoryBudget - subBytes) / inTileBytes
+                                  : uInt64(0)));
+      }
+   }
+
+// Use copies of the lattices, so their cache settings can be changed.
+// Note that for a paged lattice such a copy references the same table.
+
+   CountedPtr<Lattice<T> > inLat (in.clone());
+   const uInt maxCacheSize = inLat->maximumCacheSize();
+   if (inCacheSize > 0) {
+      inLat->setMaximumCacheSize (inCacheSize * inTile.product());
+      inLat->setCacheSizeInTiles (inCacheSize);
+   }
+
+// Step through the output in blocks and through each block in sub blocks.
+
+   IPosition inBlc(nDim);
+   IPosition inLen(nDim);
+   Array<T> buffer;
+   LatticeStepper blockStepper (outShape, block, LatticeStepper::RESIZE);
+   for (blockStepper.reset(); !blockStepper.atEnd(); blockStepper++) {
+      const IPosition blockStart = blockStepper.position();
+      const IPosition blockShape = blockStepper.cursorShape();
+      IPosition subShape (subBlock);
+      for (uInt i=0; i<nDim; ++i) {
+         subShape[i] = std::min (subShape[i], blockShape[i]);
+      }
+      LatticeStepper subStepper (blockShape, subShape, LatticeStepper::RESIZE);
+      for (subStepper.reset(); !subStepper.atEnd(); subStepper++) {
+         const IPosition blc = blockStart + subStepper.position();
+         const IPosition len = subStepper.cursorShape();
+         for (uInt i=0; i<nDim; ++i) {
+            inBlc[order[i]] = blc[i];
+            inLen[order[i]] = len[i];
+         }
+         inLat->getSlice (buffer, Slicer(inBlc, inLen));
+         out.putSlice (reorderArray (buffer, order, False), blc);
+      }
+   }
+   if (inCacheSize > 0) {
+      inLat->clearCache();
+      inLat->setMaximumCacheSize (maxCacheSize);
+   }
+}
+
 } //# End namespace casacore
 
 #endif
@@ -518,6 +518,11 @@ public:
   // time <src>clearCache</src> is called.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Get the statistics of the tile cache since <src>clearCache</src>
+  // was last called.
+  virtual Bool getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                   uInt& nWrite) const;
+
   // Return the value of the single element located at the argument
   // IPosition.
   // Note that <src>Lattice::operator()</src> can also be used.
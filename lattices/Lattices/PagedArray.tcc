@@ -374,6 +374,15 @@ void PagedArray<T>::showCacheStatistics (ostream& os) const
   itsAccessor.showCacheStatistics (os);
 }
 
+template<class T>
+Bool PagedArray<T>::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                        uInt& nWrite) const
+{
+  doReopen();
+  itsAccessor.getCacheStatistics (itsRowNumber, nAccess, nRead, nWrite);
+  return True;
+}
+
 template<class T>
 T PagedArray<T>::getAt(const IPosition& where) const
 {
@@ -245,6 +245,10 @@ public:
   // Report on cache success.
   virtual void showCacheStatistics (ostream& os) const;
 
+  // Get the statistics of the tile cache.
+  virtual Bool getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                   uInt& nWrite) const;
+
   // Get or put a single element in the lattice.
   // Note that Lattice::operator() can also be used to get a single element.
   // <group>
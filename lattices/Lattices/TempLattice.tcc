@@ -176,6 +176,13 @@ void TempLattice<T>::showCacheStatistics (ostream& os) const
   itsImpl->showCacheStatistics (os);
 }
 
+template<class T>
+Bool TempLattice<T>::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                         uInt& nWrite) const
+{
+  return itsImpl->getCacheStatistics (nAccess, nRead, nWrite);
+}
+
 
 template<class T>
 T TempLattice<T>::getAt (const IPosition& where) const
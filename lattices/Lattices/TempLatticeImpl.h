@@ -182,6 +182,10 @@ public:
   void showCacheStatistics (ostream& os) const
     { itsLatticePtr->showCacheStatistics (os); }
 
+  // Get the statistics of the tile cache.
+  Bool getCacheStatistics (uInt& nAccess, uInt& nRead, uInt& nWrite) const
+    { return itsLatticePtr->getCacheStatistics (nAccess, nRead, nWrite); }
+
   // Get or put a single element in the lattice.
   // Note that Lattice::operator() can also be used to get a single element.
   // <group>
@@ -0,0 +1,191 @@
+//# tLatticeAccessPlanner.cc: Test program for class LatticeAccessPlanner
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casacore/lattices/Lattices/LatticeAccessPlanner.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/lattices/Lattices/LatticeIterator.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+
+#include <casacore/casa/namespace.h>
+
+void testShapes()
+{
+  IPosition latShape(3,64,64,100);
+  IPosition tileShape(3,16,16,10);
+  uInt tileBytes = 16*16*10*4;
+  {
+    // Profiles without a budget: a column of 10 tiles is needed.
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(1,2), 4, 0);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,16,16,100));
+    AlwaysAssertExit (plan.axisPath() == IPosition(3,2,0,1));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 10);
+    AlwaysAssertExit (plan.minimumTileReads() == 160);
+    AlwaysAssertExit (plan.expectedTileReads() == 160);
+    AlwaysAssertExit (plan.fitsBudget());
+  }
+  {
+    // A large budget enlarges the cursor.
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(1,2), 4,
+                              1024*1024);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,64,16,100));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 40);
+    AlwaysAssertExit (plan.expectedTileReads() == 160);
+    AlwaysAssertExit (plan.cacheSizeInBytes() == 40*tileBytes);
+    AlwaysAssertExit (plan.fitsBudget());
+  }
+  {
+    // A smaller budget shrinks the cursor, but still reads tiles once.
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(1,2), 4,
+                              150000);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,4,16,100));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 10);
+    AlwaysAssertExit (plan.expectedTileReads() == 160);
+    AlwaysAssertExit (plan.fitsBudget());
+  }
+  {
+    // A too small budget makes tiles read multiple times.
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(1,2), 4,
+                              100000);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,4,16,100));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 7);
+    AlwaysAssertExit (plan.expectedTileReads() == 4*160);
+    AlwaysAssertExit (plan.fitsBudget());
+  }
+  {
+    // Planes.
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(2,0,1), 4, 0);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,64,64,10));
+    AlwaysAssertExit (plan.axisPath() == IPosition(3,0,1,2));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 16);
+    AlwaysAssertExit (plan.expectedTileReads() == 160);
+    LatticeStepper stepper = plan.stepper();
+    AlwaysAssertExit (stepper.cursorShape() == plan.cursorShape());
+    AlwaysAssertExit (stepper.axisPath() == plan.axisPath());
+    uInt nsteps = 0;
+    for (stepper.reset(); !stepper.atEnd(); stepper++) {
+      nsteps++;
+    }
+    AlwaysAssertExit (nsteps == 10);
+  }
+  {
+    // All axes; the tile shape gets clipped to the lattice shape.
+    LatticeAccessPlanner plan(IPosition(2,10,20), IPosition(2,16,16),
+                              IPosition(2,1,0), 8, 0);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(2,10,20));
+    AlwaysAssertExit (plan.axisPath() == IPosition(2,1,0));
+    AlwaysAssertExit (plan.cacheSizeInTiles() == 2);
+    AlwaysAssertExit (plan.expectedTileReads() == 2);
+  }
+  // Check the errors.
+  Bool failed = False;
+  try {
+    LatticeAccessPlanner plan(latShape, tileShape, IPosition(2,2,2), 4, 0);
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  failed = False;
+  try {
+    LatticeAccessPlanner plan(latShape, IPosition(2,16,16), IPosition(1,2),
+                              4, 0);
+  } catch (AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testPagedArray()
+{
+  IPosition latShape(3,32,32,40);
+  IPosition tileShape(3,8,8,5);
+  {
+    PagedArray<Float> arr(TiledShape(latShape, tileShape),
+                          "tLatticeAccessPlanner_tmp.data");
+    Array<Float> data(latShape);
+    indgen (data);
+    arr.put (data);
+  }
+  // Iterate through profiles using a plan reading each tile once.
+  {
+    PagedArray<Float> arr("tLatticeAccessPlanner_tmp.data");
+    LatticeAccessPlanner plan(arr, IPosition(1,2), 0);
+    AlwaysAssertExit (plan.cursorShape() == IPosition(3,8,8,40));
+    plan.apply (arr);
+    RO_LatticeIterator<Float> iter(arr, plan.stepper());
+    Double total = 0;
+    for (iter.reset(); !iter.atEnd(); iter++) {
+      total += sum(iter.cursor());
+    }
+    Double n = latShape.product();
+    AlwaysAssertExit (near (total, (n-1)*n/2, 1e-5));
+    uInt nAccess, nRead, nWrite;
+    AlwaysAssertExit (arr.getCacheStatistics (nAccess, nRead, nWrite));
+    cout << "tiles read: " << nRead << " (expected "
+         << plan.expectedTileReads() << ')' << endl;
+    AlwaysAssertExit (nRead == plan.expectedTileReads());
+    AlwaysAssertExit (nWrite == 0);
+  }
+  // Do the same with a budget too small to hold a tile column.
+  {
+    PagedArray<Float> arr("tLatticeAccessPlanner_tmp.data");
+    LatticeAccessPlanner plan(arr, IPosition(1,2), 3*8*8*5*4);
+    AlwaysAssertExit (plan.expectedTileReads() > plan.minimumTileReads());
+    plan.apply (arr);
+    RO_LatticeIterator<Float> iter(arr, plan.stepper());
+    for (iter.reset(); !iter.atEnd(); iter++) {
+      iter.cursor();
+    }
+    uInt nAccess, nRead, nWrite;
+    arr.getCacheStatistics (nAccess, nRead, nWrite);
+    cout << "tiles read: " << nRead << " (expected "
+         << plan.expectedTileReads() << ')' << endl;
+    AlwaysAssertExit (nRead >= plan.minimumTileReads());
+    AlwaysAssertExit (nRead <= plan.expectedTileReads());
+  }
+}
+
+int main()
+{
+  try {
+    testShapes();
+    testPagedArray();
+  } catch (AipsError x) {
+    cerr << "Caught exception: " << x.getMesg() << endl;
+    cout << "FAIL" << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
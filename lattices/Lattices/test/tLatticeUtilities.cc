@@ -44,6 +44,9 @@
 #include <casacore/lattices/LEL/LatticeExprNode.h>
 #include <casacore/lattices/LEL/LatticeExpr.h>
 #include <casacore/lattices/Lattices/ArrayLattice.h>
+#include <casacore/lattices/Lattices/PagedArray.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
 
 #include <casacore/casa/iostream.h>
 
@@ -52,6 +55,7 @@
 void doCopy();
 void doReplicate();
 void doBin();
+void doRetile();
 
 int main()
 {
@@ -69,6 +73,10 @@ int main()
 
      doBin();
 
+// Retile
+
+     doRetile();
+
   } catch (const AipsError& x) {
     cout<< "FAIL"<< endl;
     cerr << x.getMesg() << endl;
@@ -211,3 +219,51 @@ void doBin ()
    AlwaysAssert(allEQ(mArrOut.getMask(),True), AipsError);
 }
 
+
+void doRetile ()
+{
+    cerr << "retile" << endl;
+    IPosition shape(3, 20, 18, 30);
+    Array<Float> data(shape);
+    indgen(data);
+    PagedArray<Float> latIn(TiledShape(shape, IPosition(3,20,18,1)),
+                            "tLatticeUtilities_tmp.in");
+    latIn.put(data);
+    latIn.clearCache();
+// Retile to profile access; the unit blocks fit in the budget.
+    {
+       PagedArray<Float> latOut(TiledShape(shape, IPosition(3,4,6,30)),
+                                "tLatticeUtilities_tmp.out1");
+       LatticeUtilities::retile (latOut, latIn, IPosition(), 1024*1024);
+       AlwaysAssert(allEQ(latOut.get(), data), AipsError);
+       uInt nAccess, nRead, nWrite;
+       latIn.getCacheStatistics (nAccess, nRead, nWrite);
+       AlwaysAssert(nRead == 30, AipsError);
+    }
+// Also reorder the axes and use a budget requiring multiple passes.
+    {
+       IPosition order(3, 2, 0, 1);
+       PagedArray<Float> latOut(TiledShape(IPosition(3,30,20,18),
+                                           IPosition(3,30,4,6)),
+                                "tLatticeUtilities_tmp.out2");
+       LatticeUtilities::retile (latOut, latIn, order, 16*1024);
+       AlwaysAssert(allEQ(latOut.get(), reorderArray(data, order)),
+                    AipsError);
+    }
+// Reorder an in-memory lattice.
+    {
+       ArrayLattice<Float> latIn2(data);
+       ArrayLattice<Float> latOut(IPosition(3,18,30,20));
+       IPosition order(3, 1, 2, 0);
+       LatticeUtilities::retile (latOut, latIn2, order);
+       AlwaysAssert(allEQ(latOut.get(), reorderArray(data, order)),
+                    AipsError);
+       Bool failed = False;
+       try {
+          LatticeUtilities::retile (latOut, latIn2, IPosition(3,0,1,1));
+       } catch (const AipsError&) {
+          failed = True;
+       }
+       AlwaysAssert(failed, AipsError);
+    }
+}
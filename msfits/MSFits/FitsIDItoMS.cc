@@ -36,6 +36,7 @@
 #include <casacore/casa/Arrays/MatrixMath.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Slice.h> 
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/fits/FITS/fitsio.h>
@@ -149,10 +150,15 @@ static Int getIndexContains(Vector<String>& map, const String& key,
   return -1;
 }
 
-Bool FITSIDItoMS1::firstMain = True; // initialize the class variable firstMain
-Double FITSIDItoMS1::rdate = 0.; // initialize the class variable rdate
-String FITSIDItoMS1::array_p = ""; // initialize the class variable array_p
-SimpleOrderedMap<Int,Int> FITSIDItoMS1::antIdFromNo(-1); // initialize the class variable antIdFromNo
+FITSIDItoMS1::FileState::FileState()
+  : firstMain   (True),
+    rdate       (0.),
+    array       (""),
+    antIdFromNo (-1)
+{}
+
+// the state used by the constructor without a FileState
+FITSIDItoMS1::FileState FITSIDItoMS1::theirDefaultState;
 
 //	
 // Constructor
@@ -165,10 +171,40 @@ SimpleOrderedMap<Int,Int> FITSIDItoMS1::antIdFromNo(-1); // initialize the class
     itsMSKV(itsNrMSKs," "),
     itsgotMSK(itsNrMSKs,False),
     ///infile_p(fitsin),
+    array_p(theirDefaultState.array),
+    rdate(theirDefaultState.rdate),
+    itsObsType(obsType),
+    msc_p(0),
+    firstMain(theirDefaultState.firstMain),
+    antIdFromNo(theirDefaultState.antIdFromNo)
+{
+  if(initFirstMain){
+      firstMain = True;
+      antIdFromNo.clear();
+      rdate = 0.;
+  }
+  init();
+}
+
+  FITSIDItoMS1::FITSIDItoMS1(FitsInput& fitsin, FileState& state, const Int& obsType)
+  : BinaryTableExtension(fitsin),
+    itsNrMSKs(10),
+    itsMSKC(itsNrMSKs," "),
+    itsMSKN(itsNrMSKs," "),
+    itsMSKV(itsNrMSKs," "),
+    itsgotMSK(itsNrMSKs,False),
+    array_p(state.array),
+    rdate(state.rdate),
     itsObsType(obsType),
-    msc_p(0)
+    msc_p(0),
+    firstMain(state.firstMain),
+    antIdFromNo(state.antIdFromNo)
 {
+  init();
+}
 
+void FITSIDItoMS1::init()
+{
   itsLog = new LogIO();
   
   //
@@ -180,12 +216,6 @@ SimpleOrderedMap<Int,Int> FITSIDItoMS1::antIdFromNo(-1); // initialize the class
   itsIsArray.resize(nfield);   // array flags per field
   itsIsArray = False;          // assume scalar-type
   
-  if(initFirstMain){
-      firstMain = True;
-      antIdFromNo.clear();
-      rdate = 0.;
-  }
-  
   //
   // Step 0: The mandatory and reserved FITS keywords have been read
   // and put into the data members by the BinaryTableExtension
@@ -1770,10 +1800,6 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
   //cout << "nCorr=" << nCorr << endl;
   //cout << "nChan=" << nChan << endl;
 
-  Matrix<Complex> vis(nCorr,nChan);
-  Vector<Float> sigma(nCorr);
-  Matrix<Float> weightSpec(nCorr, nChan);
-  Vector<Float> weight(nCorr);
 
   const Int nCat = 3; // three initial categories
   // define the categories
@@ -1782,8 +1808,6 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
   cat(1)="ORIGINAL"; 
   cat(2)="USER"; 
   msc.flagCategory().rwKeywordSet().define("CATEGORY",cat);
-  Cube<Bool> flagCat(nCorr,nChan,nCat,False);
-  Matrix<Bool> flag = flagCat.xyPlane(0); // references flagCat's storage
 
   // find out the indices for U, V and W, there are several naming schemes
   Int iU,iV,iW;
@@ -1849,11 +1873,58 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
   }
   //cout << "scanNumber=" << nScan<< endl;
 
+  Int nIF_p = 0;
+  nIF_p = getIndex(coordType_p,"BAND");
+  if (nIF_p>=0) {
+    nIF_p=nPixel_p(nIF_p);
+  } else {
+    nIF_p=1;
+  }
+  const Int nBand = max(1,nIF_p);
+  //cout <<"ifnomax ="<<nBand<<endl;
+
+  // The FITS rows are read in blocks and the resulting MS rows are
+  // buffered, so each column is written only once per block.
+  // A block holds about 4 MB of visibilities.
+  const Int blockRows = std::max(1, Int(4*1024*1024 / 
+					(nBand*nCorr*nChan*sizeof(Complex) + 1)));
+  Cube<Complex>  bufVis;
+  Cube<Float>    bufWeightSpec;
+  Cube<Bool>     bufFlag;
+  Matrix<Float>  bufWeight;
+  Matrix<Double> bufUvw;
+  Vector<Int>    bufAnt1, bufAnt2, bufArray, bufSpW, bufField;
+  Vector<Double> bufTime, bufCentroid, bufInterval;
+  Vector<Bool>   bufFlagRow;
+  Int nbuf = 0;
+
   for (Int trow=0; trow<nRows; trow++) {
-    // Read next row and
+    // Read the next block of rows or go to the next row in the block and
     // get time in MJD seconds
     const Double JDofMJD0=2400000.5;
-    read(1);
+    if (trow % blockRows == 0) {
+      Int nblock = std::min(blockRows, nRows-trow);
+      read(nblock);
+      Int nout = nblock*nBand;
+      bufVis.resize(nCorr, nChan, nout);
+      bufWeightSpec.resize(nCorr, nChan, nout);
+      bufFlag.resize(nCorr, nChan, nout);
+      bufWeight.resize(nCorr, nout);
+      bufWeight = 1.0;
+      bufUvw.resize(3, nout);
+      bufAnt1.resize(nout);
+      bufAnt2.resize(nout);
+      bufArray.resize(nout);
+      bufSpW.resize(nout);
+      bufField.resize(nout);
+      bufTime.resize(nout);
+      bufCentroid.resize(nout);
+      bufInterval.resize(nout);
+      bufFlagRow.resize(nout);
+      nbuf = 0;
+    } else {
+      ++(*this);
+    }
     
     //
     //get actual Time0 data value from field array,
@@ -1936,6 +2007,9 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
 	interval=time-startTime;
 	msc.interval().fillColumn(interval);
 	msc.exposure().fillColumn(interval);
+	if (nbuf > 0) {
+	  bufInterval(Slice(0,nbuf)) = Double(interval);
+	}
 	startTime = DBL_MAX; // do this only once
       }
     }
@@ -1995,21 +2069,12 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
     Float visImag = 0.;
     Float visWeight = 1.;
 
-    Int nIF_p = 0;
-    nIF_p = getIndex(coordType_p,"BAND");
-    if (nIF_p>=0) {
-      nIF_p=nPixel_p(nIF_p);
-    } else {
-      nIF_p=1;
-    }
-    
-    //cout <<"ifnomax ="<<max(1,nIF_p)<<endl;
-
-    for (Int ifno=0; ifno<max(1,nIF_p); ifno++) {
+    for (Int ifno=0; ifno<nBand; ifno++) {
       // BANDs go to separate rows in the MS
-      ms.addRow();
       row++;
-      putrow++;
+      Matrix<Complex> vis(bufVis.xyPlane(nbuf));
+      Matrix<Float> weightSpec(bufWeightSpec.xyPlane(nbuf));
+      Matrix<Bool> flag(bufFlag.xyPlane(nbuf));
  
       for (Int chan=0; chan<nChan; chan++) {
 	for (Int pol=0; pol<nCorr; pol++) {
@@ -2054,47 +2119,19 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
  	}
       }
 
-      // fill in values for all the unused columns
-      msc.feed1().put(putrow,0);
-      msc.feed2().put(putrow,0);
-      msc.flagRow().put(putrow,False);
-      msc.processorId().put(putrow,-1);
-      msc.observationId().put(putrow,0);
-      msc.stateId().put(putrow,-1);
-
-      Vector<Float> tmp(nCorr); tmp=1.0;
-      msc.sigma().put(putrow,tmp);
-      msc.weight().put(putrow,tmp);
-
-      msc.interval().put(putrow,interval);
-      msc.exposure().put(putrow,interval);
-      msc.scanNumber().put(putrow,nScan);
-
-      msc.data().put(putrow,vis);
       // single channel case: make weight and weightSpectrum identical.
       // multichannel case: weight should not be used.
       if (nChan==1) { 
- 	const Vector<Float> weight(weightSpec.column(0).copy()); 
-
-	msc.weight().put(putrow,weight);
-
-      }
-
-      if(uv_data_hasWeights_p){
-	msc.weightSpectrum().put(putrow,weightSpec); 
+	bufWeight.column(nbuf) = weightSpec.column(0);
       }
-      msc.flag().put(putrow,flag);
-      msc.flagCategory().put(putrow,flagCat);
-
-      Bool rowFlag=allEQ(flag,True);
-      msc.flagRow().put(putrow,rowFlag);
-
-      msc.antenna1().put(putrow,ant1);
-      msc.antenna2().put(putrow,ant2);
-      msc.arrayId().put(putrow,array);
-      msc.time().put(putrow,time);
-      msc.timeCentroid().put(putrow,time+interval/2.);
-      msc.uvw().put(putrow,uvw);
+      bufFlagRow(nbuf) = allEQ(flag,True);
+      bufAnt1(nbuf) = ant1;
+      bufAnt2(nbuf) = ant2;
+      bufArray(nbuf) = array;
+      bufTime(nbuf) = time;
+      bufCentroid(nbuf) = time+interval/2.;
+      bufInterval(nbuf) = interval;
+      bufUvw.column(nbuf) = uvw;
       
       // determine the spectralWindowId
       Int spW = ifno;
@@ -2109,11 +2146,10 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
  	}
       }
       if (spW!=lastSpW) {
- 	//msc.dataDescId().put(row,spW);
- 	msc.dataDescId().put(putrow,spW);
  	nSpW = max(nSpW, spW+1);
  	lastSpW=spW;
       }
+      bufSpW(nbuf) = spW;
     
       // store the sourceId 
       Int sourceId = 0;
@@ -2124,9 +2160,46 @@ void FITSIDItoMS1::fillMSMainTable(const String& MSFileName, Int& nField, Int& n
         sourceId += (Int)tzero(iSource); 
  	sourceId--; // make 0-based
       }
-      msc.fieldId().put(putrow,sourceId);
+      bufField(nbuf) = sourceId;
       nField = max(nField, sourceId+1);
+      nbuf++;
     } // end for(ifno=0 ...
+
+    // Write the buffered rows at the end of a block.
+    if ((trow+1) % blockRows == 0  ||  trow == nRows-1) {
+      ms.addRow(nbuf);
+      Slicer rows(IPosition(1,putrow+1), IPosition(1,nbuf));
+      // fill in values for all the unused columns
+      msc.feed1().putColumnRange(rows, Vector<Int>(nbuf,0));
+      msc.feed2().putColumnRange(rows, Vector<Int>(nbuf,0));
+      msc.processorId().putColumnRange(rows, Vector<Int>(nbuf,-1));
+      msc.observationId().putColumnRange(rows, Vector<Int>(nbuf,0));
+      msc.stateId().putColumnRange(rows, Vector<Int>(nbuf,-1));
+      msc.scanNumber().putColumnRange(rows, Vector<Int>(nbuf,nScan));
+      msc.sigma().putColumnRange(rows, Matrix<Float>(nCorr,nbuf,1.0));
+      msc.weight().putColumnRange(rows, bufWeight);
+      msc.interval().putColumnRange(rows, bufInterval);
+      msc.exposure().putColumnRange(rows, bufInterval);
+      msc.data().putColumnRange(rows, bufVis);
+      if(uv_data_hasWeights_p){
+	msc.weightSpectrum().putColumnRange(rows, bufWeightSpec); 
+      }
+      msc.flag().putColumnRange(rows, bufFlag);
+      Array<Bool> flagCat(IPosition(4,nCorr,nChan,nCat,nbuf), False);
+      flagCat(IPosition(4,0,0,0,0), IPosition(4,nCorr-1,nChan-1,0,nbuf-1)) =
+	bufFlag.reform(IPosition(4,nCorr,nChan,1,nbuf));
+      msc.flagCategory().putColumnRange(rows, flagCat);
+      msc.flagRow().putColumnRange(rows, bufFlagRow);
+      msc.antenna1().putColumnRange(rows, bufAnt1);
+      msc.antenna2().putColumnRange(rows, bufAnt2);
+      msc.arrayId().putColumnRange(rows, bufArray);
+      msc.time().putColumnRange(rows, bufTime);
+      msc.timeCentroid().putColumnRange(rows, bufCentroid);
+      msc.uvw().putColumnRange(rows, bufUvw);
+      msc.dataDescId().putColumnRange(rows, bufSpW);
+      msc.fieldId().putColumnRange(rows, bufField);
+      putrow += nbuf;
+    }
     meter.update((trow+1)*1.0);
   } // end for(trow=0 ...
 
@@ -117,12 +117,32 @@ class FITSIDItoMS1 : public BinaryTableExtension
 {
 public: 
 
+  // The state shared by the objects converting the binary tables of a
+  // FITS-IDI file. Each file converted concurrently needs its own state.
+  struct FileState {
+    FileState();
+    // Is the next UV_DATA table the first one?
+    Bool firstMain;
+    // The reference date (MJD seconds) of the ARRAY_GEOMETRY table.
+    Double rdate;
+    // The name of the array.
+    String array;
+    // Map of ANTENNA_NO to antenna id.
+    SimpleOrderedMap<Int,Int> antIdFromNo;
+  };
+
   //
-  // The only constructor is from a FitsInput.
+  // Construct from a FitsInput. The state is shared with the other
+  // objects constructed this way; it is reset if initFirstMain is True.
   //
-
   FITSIDItoMS1(FitsInput& in, const Int& obsType=0, const Bool& initFirstMain=True);
 
+  //
+  // Construct from a FitsInput using the given state of the file, which
+  // has to stay alive while this object is used.
+  //
+  FITSIDItoMS1(FitsInput& in, FileState& state, const Int& obsType=0);
+
   ~FITSIDItoMS1();
   
   //
@@ -277,10 +297,10 @@ protected:
   Matrix<Int> corrProduct_p;
   Vector<String> coordType_p;
   Vector<Double> refVal_p, refPix_p, delta_p; 
-  static String array_p;
+  String& array_p;
   String object_p,timsys_p;
   Double epoch_p;
-  static Double rdate;
+  Double& rdate;
   Int nAnt_p;
   Vector<Double> receptorAngle_p;
   MFrequency::Types freqsys_p;
@@ -292,18 +312,24 @@ protected:
   Int itsObsType;
   MeasurementSet ms_p;
   MSColumns* msc_p;
-  static Bool firstMain;
+  Bool& firstMain;
   Bool uv_data_hasWeights_p;
   Bool weightKwPresent_p;
   Bool weightypKwPresent_p;
   String weightyp_p;
   Matrix<Float> weightsFromKW_p;
-  static SimpleOrderedMap<Int,Int> antIdFromNo;
+  SimpleOrderedMap<Int,Int>& antIdFromNo;
+
+  // The state used by the constructor without a FileState.
+  static FileState theirDefaultState;
 
   //
   //# Member Functions
   //
   
+  // Initialize the object (called by the constructors).
+  void init();
+
   // Fill in each row as needed
   void fillRow();
   
@@ -37,11 +37,17 @@
 #include <casacore/casa/IO/TapeIO.h>
 #include <casacore/ms/MeasurementSets/MSColumns.h>
 #include <casacore/ms/MeasurementSets/MSTileLayout.h>
+#include <casacore/ms/MSOper/MSConcat.h>
 #include <casacore/tables/DataMan/IncrementalStMan.h>
 #include <casacore/tables/DataMan/StandardStMan.h>
 #include <casacore/tables/DataMan/TiledColumnStMan.h>
 #include <casacore/tables/DataMan/TiledShapeStMan.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/casa/Containers/Block.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -54,7 +60,8 @@ MSFitsIDI::MSFitsIDI(const Path& tapeDevice, const String& msOut,
   itsDeviceType(FITS::Tape9),
   itsMSOut(""),
   itsMSExists(False),
-  itsSelectedFiles(0)
+  itsSelectedFiles(0),
+  itsVirtualConcat(False)
 {
 // Construct from a tape device and output MS file name
 // Input:
@@ -87,7 +94,8 @@ MSFitsIDI::MSFitsIDI(const String& inFile, const String& msOut,
   //DP  itsMS(0),
   itsMSExists(False),
   //DP itsOverWrite(False),
-  itsSelectedFiles(0)
+  itsSelectedFiles(0),
+  itsVirtualConcat(False)
 {
 // Construct from an input FITS-IDI file name and an output MS file name
 // Input:
@@ -112,6 +120,51 @@ MSFitsIDI::MSFitsIDI(const String& inFile, const String& msOut,
 
 //----------------------------------------------------------------------------
 
+MSFitsIDI::MSFitsIDI(const Vector<String>& inFiles, const String& msOut, 
+		     const Bool& overWrite, const Int& obsType,
+		     const Bool& virtualConcat) :
+  itsDataSource(""),
+  itsDeviceType(FITS::Disk),
+  itsMSOut(""),
+  itsMSExists(False),
+  itsSelectedFiles(0),
+  itsVirtualConcat(virtualConcat)
+{
+// Construct from a list of input FITS-IDI file names and an output MS 
+// file name
+// Input:
+//    inFiles              const Vector<String>&  Input FITS-IDI file names
+//    msOut                const String&      Output MS name
+//    overWrite            const Bool&        True if existing MS is to 
+//                                            be overwritten
+//    virtualConcat        const Bool&        True if the MSs of the files
+//                                            are concatenated virtually
+// Output to private data:
+//    itsDataSources       Vector<String>     Input file names
+//    itsVirtualConcat     Bool               True if virtual concatenation
+//
+  LogIO os(LogOrigin("MSFitsIDI", "MSFitsIDI()", WHERE));
+  if (inFiles.nelements() == 0) {
+    os << LogIO::SEVERE << "No FITS-IDI input files given"
+       << LogIO::EXCEPTION;
+  }
+  init(inFiles(0), FITS::Disk, msOut, overWrite, obsType);
+  itsDataSources.resize(inFiles.nelements());
+  itsDataSources(0) = itsDataSource;
+  for (uInt i=1; i<inFiles.nelements(); i++) {
+    Path sourcePath(inFiles(i));
+    if (!sourcePath.isValid() || !File(sourcePath).exists() || 
+	!File(sourcePath).isReadable()) {
+      os << LogIO::SEVERE << "FITS-IDI data source " << inFiles(i)
+	 << " is not readable" << LogIO::EXCEPTION;
+    }
+    itsDataSources(i) = sourcePath.absoluteName();
+  }
+//
+}
+
+//----------------------------------------------------------------------------
+
 MSFitsIDI::~MSFitsIDI()
 {
 //DP // Default desctructor
@@ -195,7 +248,11 @@ Bool MSFitsIDI::fillMS()
     // Disk input:
     //
   } else if (itsDeviceType == FITS::Disk) {
-    readFITSFile(atEnd);
+    if (itsDataSources.nelements() > 1) {
+      readFITSFiles();
+    } else {
+      readFITSFile(atEnd);
+    }
   }
   return True;
 }
@@ -268,11 +325,123 @@ void MSFitsIDI::readFITSFile(Bool& atEnd)
 // Output:
 //    atEnd                Bool               True if at EOF
 //
-  LogIO os(LogOrigin("MSFitsIDI", "readFITSFile()", WHERE));
+  convertFile(itsDataSource, itsDeviceType, itsMSOut, itsObsType, atEnd);
+}
+
+//----------------------------------------------------------------------------
+
+void MSFitsIDI::readFITSFiles()
+{
+// Convert all FITS-IDI input files (on disk) to separate MSs and
+// concatenate them into the output MS.
+//
+  LogIO os(LogOrigin("MSFitsIDI", "readFITSFiles()", WHERE));
+  Int nfile = itsDataSources.nelements();
+  os << LogIO::NORMAL << "Converting " << nfile << " FITS-IDI files"
+     << LogIO::POST;
+
+  // Each file is converted to its own MS. They are created in a new
+  // temporary directory next to the output MS, so no existing table
+  // can be overwritten.
+  Path msPath(Path(itsMSOut).absoluteName());
+  const String tmpDir = File::newUniqueName(msPath.dirName(),
+					    msPath.baseName() + "_parts")
+    .absoluteName();
+  Directory(tmpDir).create(False);
+  Block<String> partNames(nfile);
+  for (Int i=0; i<nfile; i++) {
+    partNames[i] = tmpDir + "/" + msPath.baseName() + "_part" +
+                   String::toString(i);
+  }
+  // The files can only be converted in parallel if cfitsio is thread-safe.
+  Bool parallel = (nfile > 1  &&  fits_is_reentrant());
+  (void)parallel;
+  // An exception cannot leave an OpenMP loop, so keep the message.
+  String errMsg;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+  for (Int i=0; i<nfile; i++) {
+    String msg;
+    try {
+      Bool atEnd;
+      convertFile(itsDataSources(i), FITS::Disk, partNames[i],
+		  itsObsType, atEnd);
+    } catch (AipsError& x) {
+      msg = x.getMesg();
+    } catch (std::exception& x) {
+      msg = x.what();
+    } catch (...) {
+      msg = "unknown exception";
+    }
+    if (! msg.empty()) {
+#ifdef _OPENMP
+#pragma omp critical(MSFitsIDI_readFITSFiles)
+#endif
+      {
+	errMsg = itsDataSources(i) + ": " + msg;
+      }
+    }
+  }
+  if (! errMsg.empty()) {
+    Directory(tmpDir).removeRecursive();
+    os << LogIO::SEVERE << "Error converting FITS-IDI file " << errMsg
+       << LogIO::EXCEPTION;
+  }
+
+  // Also remove the directory if the concatenation fails.
+  try {
+    if (itsVirtualConcat) {
+      // The concatenation moves the MSs into its subdirectory.
+      os << LogIO::NORMAL << "Concatenating the MSs virtually"
+	 << LogIO::POST;
+      Table concTab(partNames, Block<String>(), Table::Old, TSMOption(),
+		    "SUBMSS");
+      concTab.rename(itsMSOut, Table::New);
+    } else {
+      os << LogIO::NORMAL << "Concatenating the MSs" << LogIO::POST;
+      {
+	Table firstTab(partNames[0], Table::Update);
+	firstTab.rename(itsMSOut, Table::New);
+      }
+      MeasurementSet ms(itsMSOut, Table::Update);
+      MSConcat mscat(ms);
+      for (Int i=1; i<nfile; i++) {
+	{
+	  MeasurementSet partMS(partNames[i]);
+	  mscat.concatenate(partMS);
+	}
+	Table::deleteTable(partNames[i]);
+      }
+    }
+  } catch (...) {
+    Directory(tmpDir).removeRecursive();
+    throw;
+  }
+  // The parts have been moved or deleted, so remove the directory.
+  Directory(tmpDir).removeRecursive();
+}
+
+//----------------------------------------------------------------------------
+
+void MSFitsIDI::convertFile(const String& dataSource,
+			    const FITS::FitsDevice& deviceType,
+			    const String& msOut, Int obsType, Bool& atEnd)
+{
+// Read and process a FITS-IDI input file (on tape or disk)
+// Input:
+//    dataSource    const String&            Input file name or tape device
+//    deviceType    const FITS::FitsDevice   FITS device type (tape or disk)
+//    msOut         const String&            Output MS name
+//    obsType       Int                      Observation type
+// Output:
+//    atEnd                Bool               True if at EOF
+//
+  LogIO os(LogOrigin("MSFitsIDI", "convertFile()", WHERE));
   atEnd = False;
 
   // Construct a FitsInput object
-  FitsInput infits(itsDataSource.chars(), itsDeviceType);
+  FitsInput infits(dataSource.chars(), deviceType);
   if (infits.err() != FitsIO::OK) {
     os << LogIO::SEVERE << "Error reading FITS input" << LogIO::EXCEPTION;
   }
@@ -281,7 +450,7 @@ void MSFitsIDI::readFITSFile(Bool& atEnd)
   Regex trailing(" *$");
 
   // Create a temporary work directory for the sub-tables
-  Directory tmpDir(itsMSOut + "_tmp");
+  Directory tmpDir(msOut + "_tmp");
   tmpDir.create();
 
   // Vector of sub-table names
@@ -289,8 +458,8 @@ void MSFitsIDI::readFITSFile(Bool& atEnd)
   Int subTableNr = -1;
   Table maintab;
   
-  // Loop over all HDU in the FITS-IDI file
-  Bool initFirstMain = True;
+  // Loop over all HDU in the FITS-IDI file, sharing the state of the file
+  FITSIDItoMS1::FileState fileState;
   while (infits.err() == FitsIO::OK && !infits.eof()) {
 
     // Skip non-binary table HDU's
@@ -304,11 +473,10 @@ void MSFitsIDI::readFITSFile(Bool& atEnd)
 
     } else {
       // Process the FITS-IDI input from the position of this binary table
-      FITSIDItoMS1 bintab(infits, itsObsType, initFirstMain);
-      initFirstMain = False;
+      FITSIDItoMS1 bintab(infits, fileState, obsType);
       String hduName = bintab.extname();
       hduName = hduName.before(trailing);
-      String tableName = itsMSOut;
+      String tableName = msOut;
       if (hduName != "") {
 	if (hduName != "UV_DATA") {
 	  tableName = tableName + "_tmp/" + hduName;
@@ -339,50 +507,50 @@ void MSFitsIDI::readFITSFile(Bool& atEnd)
   //
   os << LogIO::NORMAL << "Subtables found: " << subTableName << LogIO::POST;
   // Open the main table to be updated.
-  Table msmain (itsMSOut, Table::Update);
+  Table msmain (msOut, Table::Update);
   // Loop over all subtables.
   for (Int isub=0; isub<=subTableNr; isub++) {
     //cout << "renaming subtable " << subTableName(isub) << endl;
     // Open the subtable to be updated.
     if (subTableName(isub)=="ARRAY_GEOMETRY") {
-      Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/ANTENNA",Table::Update);
+      Table mssub(msOut+"_tmp/"+subTableName(isub)+"/ANTENNA",Table::Update);
       // Rename the subtable.
-      mssub.rename (itsMSOut+"/ANTENNA",Table::Update);
+      mssub.rename (msOut+"/ANTENNA",Table::Update);
       // Attach the subtable to the main table.
       msmain.rwKeywordSet().defineTable("ANTENNA",mssub);
     }
     if (subTableName(isub)=="SOURCE") {
-      Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/FIELD",Table::Update);
-      mssub.rename (itsMSOut+"/FIELD",Table::Update);
+      Table mssub(msOut+"_tmp/"+subTableName(isub)+"/FIELD",Table::Update);
+      mssub.rename (msOut+"/FIELD",Table::Update);
       msmain.rwKeywordSet().defineTable("FIELD",mssub);
     }
     if (subTableName(isub)=="FREQUENCY") {
-      Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/SPECTRAL_WINDOW",Table::Update);
-      mssub.rename (itsMSOut+"/SPECTRAL_WINDOW",Table::Update);
+      Table mssub(msOut+"_tmp/"+subTableName(isub)+"/SPECTRAL_WINDOW",Table::Update);
+      mssub.rename (msOut+"/SPECTRAL_WINDOW",Table::Update);
       msmain.rwKeywordSet().defineTable("SPECTRAL_WINDOW",mssub);
       
-      Table mssub2(itsMSOut+"_tmp/"+subTableName(isub)+"/DATA_DESCRIPTION",Table::Update);
-      mssub2.rename (itsMSOut+"/DATA_DESCRIPTION",Table::Update);
+      Table mssub2(msOut+"_tmp/"+subTableName(isub)+"/DATA_DESCRIPTION",Table::Update);
+      mssub2.rename (msOut+"/DATA_DESCRIPTION",Table::Update);
       msmain.rwKeywordSet().defineTable("DATA_DESCRIPTION",mssub2);
 
-      Table mssub3(itsMSOut+"_tmp/"+subTableName(isub)+"/POLARIZATION",Table::Update);
-      mssub3.rename (itsMSOut+"/POLARIZATION",Table::Update);
+      Table mssub3(msOut+"_tmp/"+subTableName(isub)+"/POLARIZATION",Table::Update);
+      mssub3.rename (msOut+"/POLARIZATION",Table::Update);
       msmain.rwKeywordSet().defineTable("POLARIZATION",mssub3);
       
     }
     if (subTableName(isub)=="ANTENNA") {
-      Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/FEED",Table::Update);
-      mssub.rename (itsMSOut+"/FEED",Table::Update);
+      Table mssub(msOut+"_tmp/"+subTableName(isub)+"/FEED",Table::Update);
+      mssub.rename (msOut+"/FEED",Table::Update);
       msmain.rwKeywordSet().defineTable("FEED",mssub);
     }
     if (subTableName(isub)=="POINTING_DATA") {
-      Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/POINTING",Table::Update);
-      mssub.rename (itsMSOut+"/POINTING",Table::Update);
+      Table mssub(msOut+"_tmp/"+subTableName(isub)+"/POINTING",Table::Update);
+      mssub.rename (msOut+"/POINTING",Table::Update);
       msmain.rwKeywordSet().defineTable("POINTING",mssub);
     }
     //if (subTableName(isub)=="INTERFEROMETER_MODEL") {
-    //  Table mssub(itsMSOut+"_tmp/"+subTableName(isub)+"/IDI_CORRELATOR_MODEL",Table::Update);
-    //  mssub.rename (itsMSOut+"/IDI_CORRELATOR_MODEL",Table::Update);
+    //  Table mssub(msOut+"_tmp/"+subTableName(isub)+"/IDI_CORRELATOR_MODEL",Table::Update);
+    //  mssub.rename (msOut+"/IDI_CORRELATOR_MODEL",Table::Update);
     //  msmain.rwKeywordSet().defineTable("IDI_CORRELATOR_MODEL",mssub);
     //}
     
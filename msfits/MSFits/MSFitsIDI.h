@@ -57,7 +57,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <synopsis>
 // The MSFitsIDI class converts FITS-IDI data, on tape or disk,
 // to MeasurementSet (MS) format.
-// </etymology>
+// <p>
+// A VLBI correlation usually results in many FITS-IDI files.
+// They can be converted to a single MS in one go by giving a list of files.
+// Each file is converted into a separate MS, where the files are converted
+// in parallel if OpenMP is used. Thereafter the MSs are concatenated.
+// It can be done physically (using <linkto class=MSConcat>MSConcat</linkto>)
+// or virtually, in which case the MS is a
+// <linkto class=ConcatTable>concatenation</linkto> of the MSs converted
+// from the files, which are moved into its subdirectory SUBMSS.
+// A virtually concatenated MS uses the subtables of the first file only,
+// so it should only be used if the subtables of all files are the same
+// (as is normally the case for the files of a single correlation).
+// </synopsis>
 //
 // <example>
 // <srcblock>
@@ -85,6 +97,13 @@ class MSFitsIDI
   MSFitsIDI(const String& inFile, const String& msOut, 
 	    const Bool& overWrite, const Int& obsType=0);
 
+  // Construct from a list of input file names and an MS output file name.
+  // If virtualConcat is True, the MSs converted from the files are
+  // concatenated virtually, otherwise physically.
+  MSFitsIDI(const Vector<String>& inFiles, const String& msOut, 
+	    const Bool& overWrite, const Int& obsType=0,
+	    const Bool& virtualConcat=False);
+
   // Destructor
   ~MSFitsIDI();
   
@@ -102,6 +121,15 @@ class MSFitsIDI
   // Read and process a FITS-IDI file
   void readFITSFile(Bool& atEnd);
 
+  // Convert all input files to separate MSs and concatenate them
+  void readFITSFiles();
+
+  // Convert the FITS-IDI file (on tape or disk) to the given MS.
+  // The conversion of different files can be done concurrently.
+  static void convertFile(const String& dataSource,
+			  const FITS::FitsDevice& deviceType,
+			  const String& msOut, Int obsType, Bool& atEnd);
+
  private:
   // Data source and device type
   String itsDataSource;
@@ -116,6 +144,10 @@ class MSFitsIDI
   Vector<Int> itsSelectedFiles;
   Bool itsAllFilesSelected;
 
+  // Input files to be converted and concatenated (if more than one)
+  Vector<String> itsDataSources;
+  Bool itsVirtualConcat;
+
 };
 
 
@@ -60,7 +60,6 @@
 #include <casacore/measures/Measures/Stokes.h>
 #include <casacore/measures/Measures/MeasTable.h>
 #include <casacore/casa/OS/File.h>
-#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/Quanta/MVTime.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/DataMan/IncrementalStMan.h>
@@ -166,6 +165,23 @@ void MSPrimaryGroupHolder::attach(FitsInput& infile) {
     }
 }
 
+void MSPrimaryGroupHolder::copy(Double* target, Int nelem) const {
+    // Test the data type outside the loop.
+    if (pf) {
+        for (Int i = 0; i < nelem; ++i) {
+            target[i] = (*pf)(i);
+        }
+    } else if (pl) {
+        for (Int i = 0; i < nelem; ++i) {
+            target[i] = (*pl)(i);
+        }
+    } else {
+        for (Int i = 0; i < nelem; ++i) {
+            target[i] = (*ps)(i);
+        }
+    }
+}
+
 MSPrimaryGroupHolder::~MSPrimaryGroupHolder() {
     detach();
 }
@@ -238,7 +254,8 @@ void MSPrimaryTableHolder::detach() {
 MSFitsInput::MSFitsInput(const String& msFile, const String& fitsFile,
         const Bool useNewStyle) :
     infile_p(0), msc_p(0), addSourceTable_p(False), itsLog(LogOrigin(
-            "MSFitsInput", "MSFitsInput")), newNameStyle(useNewStyle) {
+            "MSFitsInput", "MSFitsInput")), newNameStyle(useNewStyle),
+    chunkSize_p(64 * 1024 * 1024) {
     // First, lets verify that fitsfile exists and that it appears to be a
     // FITS file.
     File f(fitsFile);
@@ -322,14 +339,6 @@ void MSFitsInput::readRandomGroupUVFits(Int obsType) {
         // fill the OBSERVATION table
         fillObsTables();
 
-        Int totMem = HostInfo::memoryTotal();
-
-        // 8 bytes per complex number and the other data like flag, weight is
-        // is 1/2 of the total
-        Int estMem = priGroup_p.gcount() * max(1, nIF_p) / 1024 * nPixel_p(
-                getIndex(coordType_p, "STOKES")) * nPixel_p(getIndex(
-                coordType_p, "FREQ")) * 8 * 2;
-        
         Int ns = max(1, nIF_p);
         Int nc = nPixel_p( getIndex(coordType_p, "STOKES"));
         Int nf = nPixel_p( getIndex(coordType_p, "FREQ"));
@@ -350,32 +359,14 @@ void MSFitsInput::readRandomGroupUVFits(Int obsType) {
                << "\n                      Free Space in MB: " << freeS 
                << LogIO::POST;
 
-        // In reality it can be twice that number
-        // We can remove the estMem limit of 1 Gbyte, below,
-        // if we are fully in 64 bits world
-        //
-
-        // fill the main table
-        if ((estMem < totMem) && (estMem < 1000000)) {
-            //fill column wise and keep columns in memory
-            try {
-                fillMSMainTableColWise(nField, nSpW);
-            }
-            catch(AipsError ex) {
-                itsLog << LogOrigin("MSFitsInput", "readRandomGroupUVFits")
-                   << ex.getMesg() 
-                   << LogIO::EXCEPTION;
-            }
-        } else {
-            //else fill row wise
-            try {
-                fillMSMainTable(nField, nSpW);
-            }
-            catch(AipsError ex) {
-                itsLog << LogOrigin("MSFitsInput", "readRandomGroupUVFits")
-                   << ex.getMesg() 
-                   << LogIO::EXCEPTION;
-            }
+        // fill the main table (in chunks, so no need to check the memory)
+        try {
+            fillMSMainTableColWise(nField, nSpW);
+        }
+        catch(AipsError ex) {
+            itsLog << LogOrigin("MSFitsInput", "readRandomGroupUVFits")
+               << ex.getMesg() 
+               << LogIO::EXCEPTION;
         }
         // now handle the BinaryTable extensions for the subtables
         Bool haveAn = False, haveField = False, haveSpW = False;
@@ -1118,7 +1109,10 @@ void MSFitsInput::fillHistoryTable(ConstFitsKeywordList &kwl) {
 
 // Extract the data from the PrimaryGroup object and stick it into
 // the MeasurementSet 
-// keep the arrays of data in memory before dumping them in columns
+// The groups are processed in chunks. The groups of a chunk are read
+// sequentially, then the visibilities are decoded into column buffers
+// (in parallel if OpenMP is used), and finally the buffers are written
+// as column ranges. So the memory used is limited by the chunk size.
 void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
     itsLog << LogOrigin("MSFitsInput", "fillMSMainTable");
     // Get access to the MS columns
@@ -1135,15 +1129,12 @@ void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
         pType(i) = priGroup_p.ptype(i);
         pType(i) = pType(i).before(trailing);
     }
-    Int totRows = nGroups * max(1, nIF_p);
+    const Int nif = max(1, nIF_p);
+    Int totRows = nGroups * nif;
 
     Int nCorr = nPixel_p(getIndex(coordType_p, "STOKES"));
     Int nChan = nPixel_p(getIndex(coordType_p, "FREQ"));
 
-    Cube<Complex> vis(nCorr, nChan, totRows);
-    Matrix<Float> sigma(nCorr, totRows);
-    Cube<Float> weightSpec(nCorr, nChan, totRows);
-    Matrix<Float> weight(nCorr, totRows);
     const Int nCat = 3; // three initial categories
     // define the categories
     Vector<String> cat(nCat);
@@ -1151,9 +1142,6 @@ void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
     cat(1) = "ORIGINAL";
     cat(2) = "USER";
     msc.flagCategory().rwKeywordSet().define("CATEGORY", cat);
-    Cube<Bool> flagCat(nCorr, nChan, nCat, False);
-    //  Matrix<Bool> flag = flagCat.xyPlane(0); // references flagCat's storage
-    Cube<Bool> flag(nCorr, nChan, totRows);
     // find out the indices for U, V and W, there are several naming schemes
     Int iU, iV, iW;
     iU = getIndexContains(pType, "UU");
@@ -1175,6 +1163,17 @@ void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
     // get index for Integration time
     Int iInttim = getIndex(pType, "INTTIM");
 
+    // Work out which axis increments fastests, pol or channel
+    // The COMPLEX axis is assumed to be first, and the IF axis is assumed
+    // to be after STOKES and FREQ.
+    const Bool polFastest = (getIndex(coordType_p, "STOKES") < getIndex(
+            coordType_p, "FREQ"));
+    const Int nx = (polFastest ? nChan : nCorr);
+    const Int ny = (polFastest ? nCorr : nChan);
+    // Number of values (real, imag, weight) per row and per group.
+    const Int nRowVal = 3 * nCorr * nChan;
+    const Int nGroupVal = nRowVal * nif;
+
     receptorAngle_p.resize(1);
     nAnt_p = 0;
     itsLog << LogIO::NORMAL << "Reading and writing " << nGroups
@@ -1187,10 +1186,8 @@ void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
     Bool discernIntExp(True);
     Double discernedInt(DBL_MAX);
 
-    // ProgressMeter meter(0.0, nGroups*1.0, "UVFITS Filler", "Groups copied", "",//               "", True,  nGroups/100);
-
-
-    Matrix<Double> uvw(3, totRows);
+    ProgressMeter meter(0.0, nGroups * 1.0, "UVFITS Filler", "Groups copied",
+            "", "", True, max(1, nGroups / 100));
 
     // Remember last-filled values for TSM use
     Int lastFillArrayId, lastFillFieldId, lastFillScanNumber;
@@ -1210,521 +1207,283 @@ void MSFitsInput::fillMSMainTableColWise(Int& nField, Int& nSpW) {
     nArray_p = -1;
 
     Bool lastRowFlag = False;
-    Vector<Int> ant1(totRows);
-    Vector<Int> ant2(totRows);
-    Vector<Double> interv(totRows);
-    Vector<Double> expos(totRows);
-    Vector<Int> datDescId(totRows);
 
     ms_p.addRow(totRows);
-    Int nif = max(1, nIF_p);
-
-    // Loop over groups
-    for (Int group = 0; group < nGroups; group++) {
-
-        // Read next group and
-        priGroup_p.read();
-
-        // Extract time in MJD seconds
-        const Double JDofMJD0 = 2400000.5;
-        Double time = priGroup_p.parm(iTime0);
-        time -= JDofMJD0;
-        if (iTime1 >= 0)
-            time += priGroup_p.parm(iTime1);
-        time *= C::day;
-
-        // Extract fqid
-        Int freqId = Int(priGroup_p.parm(iFreq));
-
-        // Extract field Id
-        Int fieldId = 0;
-        if (iSource >= 0) {
-            // make 0-based
-            fieldId = (Int) priGroup_p.parm(iSource) - 1;
-        }
-        Float baseline = priGroup_p.parm(iBsln);
-        Int arrayId = Int(100.0 * (baseline - Int(baseline) + 0.001));
-        nArray_p = max(nArray_p, arrayId + 1);
-        for (Int k = 0; k < nif; ++k) {
 
-            Int index = group * nif + k;
-            // Extract uvw
-            uvw(0, index) = priGroup_p.parm(iU) * C::c;
-            uvw(1, index) = priGroup_p.parm(iV) * C::c;
-            uvw(2, index) = priGroup_p.parm(iW) * C::c;
-            // Convert from units of seconds to meters
+    // Determine the number of groups per chunk, such that the buffers
+    // take about chunkSize_p bytes.
+    const Int64 bytesPerGroup = nif * (Int64(nCorr) * nChan *
+        (sizeof(Complex) + sizeof(Float) + (1 + nCat) * sizeof(Bool)
+         + 3 * sizeof(Double))
+        + 2 * nCorr * sizeof(Float) + 3 * sizeof(Double) + 16 * sizeof(Int));
+    Int64 nGroupChunk = chunkSize_p / bytesPerGroup;
+    if (nGroupChunk > nGroups) {
+        nGroupChunk = nGroups;
+    }
+    const Int chunkGroups = max(1, Int(nGroupChunk));
+    // The buffers for the parameters and data of the groups in a chunk.
+    Matrix<Double> parms(max(1, nParams), chunkGroups);
+    Matrix<Double> groupData(nGroupVal, chunkGroups);
+    // The column buffers.
+    Cube<Complex> vis;
+    Cube<Float> weightSpec;
+    Cube<Bool> flag;
+    Array<Bool> flagCat;
+    Matrix<Float> weight, sigma;
+    Matrix<Double> uvw;
+    Vector<Int> ant1, ant2, datDescId;
+    Vector<Double> interv, expos;
+
+    // Loop over chunks of groups
+    for (Int firstGroup = 0; firstGroup < nGroups; firstGroup += chunkGroups) {
+        const Int nGrp = min(chunkGroups, nGroups - firstGroup);
+        const Int nRow = nGrp * nif;
+        const Int firstRow = row + 1;
+        if (nRow != Int(ant1.nelements())) {
+            vis.resize(nCorr, nChan, nRow);
+            weightSpec.resize(nCorr, nChan, nRow);
+            flag.resize(nCorr, nChan, nRow);
+            // Only the first category gets the flags.
+            flagCat.resize(IPosition(4, nCorr, nChan, nCat, nRow));
+            flagCat = False;
+            weight.resize(nCorr, nRow);
+            sigma.resize(nCorr, nRow);
+            uvw.resize(3, nRow);
+            ant1.resize(nRow);
+            ant2.resize(nRow);
+            datDescId.resize(nRow);
+            interv.resize(nRow);
+            expos.resize(nRow);
+        }
+
+        // Read the groups sequentially and handle the parameters.
+        for (Int grp = 0; grp < nGrp; grp++) {
+            // Read next group and keep its parameters and data
+            priGroup_p.read();
+            priGroup_p.copyparm(&parms(0, grp));
+            priGroup_p.copy(&groupData(0, grp), nGroupVal);
+            const Double* parm = &parms(0, grp);
+
+            // Extract time in MJD seconds
+            const Double JDofMJD0 = 2400000.5;
+            Double time = parm[iTime0];
+            time -= JDofMJD0;
+            if (iTime1 >= 0)
+                time += parm[iTime1];
+            time *= C::day;
 
-            ant1(index) = Int(baseline) / 256;
-            nAnt_p = max(nAnt_p, ant1(index));
-            ant2(index) = Int(baseline) - ant1(index) * 256;
-            nAnt_p = max(nAnt_p, ant2(index));
-            ant1(index)--;
-            ant2(index)--; // make 0-based
-        }
-        // Ensure arrayId-specific params are of correct length:
-        if (scanNumber.shape() < nArray_p) {
-            scanNumber.resize(nArray_p, True);
-            lastFieldId.resize(nArray_p, True);
-            lastFreqId.resize(nArray_p, True);
-            scanNumber(nArray_p - 1) = 0;
-            lastFieldId(nArray_p - 1) = -1;
-            lastFreqId(nArray_p - 1) = -1;
-        }
-
-        // Detect new scan (field or freqid change) for each arrayId
-        if (fieldId != lastFieldId(arrayId) || freqId != lastFreqId(arrayId)
-                || time - lastFillTime > 300.0) {
-            scanNumber(arrayId)++;
-            lastFieldId(arrayId) = fieldId;
-            lastFreqId(arrayId) = freqId;
-        }
-
-        // If integration time is a RP, use it:
-        if (iInttim > -1) {
-            discernIntExp = False;
-            exposure = priGroup_p.parm(iInttim);
-            interval = exposure;
-        } else {
-            // keep track of minimum which is the only one
-            // (if time step is larger than UVFITS precision (and zero))
-            discernIntExp = True;
-            Double tempint;
-            tempint = time - lastFillTime;
-            if (tempint > 0.01) {
-                discernedInt = min(discernedInt, tempint);
-            }
-        }
-
-        // Work out which axis increments fastests, pol or channel
-        // The COMPLEX axis is assumed to be first, and the IF axis is assumed
-        // to be after STOKES and FREQ.
-        Bool polFastest = (getIndex(coordType_p, "STOKES") < getIndex(
-                coordType_p, "FREQ"));
-        const Int nx = (polFastest ? nChan : nCorr);
-        const Int ny = (polFastest ? nCorr : nChan);
-
-        Int count = 0;
-        for (Int ifno = 0; ifno < nif; ifno++) {
-            // IFs go to separate rows in the MS
-            row++;
+            // Extract fqid
+            Int freqId = Int(parm[iFreq]);
 
-            // fill in values for all the unused columns
-            if (row == 0) {
-                msc.feed1().put(row, 0);
-                msc.feed2().put(row, 0);
-                msc.flagRow().put(row, False);
-                lastRowFlag = False;
-                msc.processorId().put(row, -1);
-                msc.observationId().put(row, 0);
-                msc.stateId().put(row, -1);
+            // Extract field Id
+            Int fieldId = 0;
+            if (iSource >= 0) {
+                // make 0-based
+                fieldId = (Int) parm[iSource] - 1;
             }
+            Float baseline = parm[iBsln];
+            Int arrayId = Int(100.0 * (baseline - Int(baseline) + 0.001));
+            nArray_p = max(nArray_p, arrayId + 1);
 
-            // Fill scanNumber if changed since last row
-            if (scanNumber(arrayId) != lastFillScanNumber) {
-                msc.scanNumber().put(row, scanNumber(arrayId));
-                lastFillScanNumber = scanNumber(arrayId);
+            // Ensure arrayId-specific params are of correct length:
+            if (scanNumber.shape() < nArray_p) {
+                scanNumber.resize(nArray_p, True);
+                lastFieldId.resize(nArray_p, True);
+                lastFreqId.resize(nArray_p, True);
+                scanNumber(nArray_p - 1) = 0;
+                lastFieldId(nArray_p - 1) = -1;
+                lastFreqId(nArray_p - 1) = -1;
             }
 
-            weight.column(row).set(0.0);
-
-            // Loop over chans and corrs:
-            for (Int ix = 0; ix < nx; ix++) {
-                for (Int iy = 0; iy < ny; iy++) {
-                    const Float visReal = priGroup_p(count++);
-                    const Float visImag = priGroup_p(count++);
-                    const Float wt = priGroup_p(count++);
-                    const Int pol = (polFastest ? corrIndex_p[iy]
-                            : corrIndex_p[ix]);
-                    const Int chan = (polFastest ? ix : iy);
-                    if (wt <= 0.0) {
-                        weightSpec(pol, chan, row) = abs(wt);
-                        flag(pol, chan, row) = True;
-                        weight(pol, row) += abs(wt);
-                    } else {
-                        weightSpec(pol, chan, row) = wt;
-                        flag(pol, chan, row) = False;
-                        // weight column is sum of weight_spectrum (each pol):
-                        weight(pol, row) += wt;
-                    }
-                    vis(pol, chan, row) = Complex(visReal, visImag);
-                }
+            // Detect new scan (field or freqid change) for each arrayId
+            if (fieldId != lastFieldId(arrayId) || freqId != lastFreqId(arrayId)
+                    || time - lastFillTime > 300.0) {
+                scanNumber(arrayId)++;
+                lastFieldId(arrayId) = fieldId;
+                lastFreqId(arrayId) = freqId;
             }
 
-            // calculate sigma (weight = inverse variance)
-            for (Int nc = 0; nc < nCorr; nc++) {
-                if (weight(nc, row) > 0.0) {
-                    sigma(nc, row) = sqrt(1.0 / weight(nc, row));
-                } else {
-                    sigma(nc, row) = 0.0;
+            // If integration time is a RP, use it:
+            if (iInttim > -1) {
+                discernIntExp = False;
+                exposure = parm[iInttim];
+                interval = exposure;
+            } else {
+                // keep track of minimum which is the only one
+                // (if time step is larger than UVFITS precision (and zero))
+                discernIntExp = True;
+                Double tempint;
+                tempint = time - lastFillTime;
+                if (tempint > 0.01) {
+                    discernedInt = min(discernedInt, tempint);
                 }
             }
 
-            if (!discernIntExp) {
-                interv(row) = interval;
-                expos(row) = exposure;
-            }
-
-            Bool rowFlag = allEQ(flag.xyPlane(row), True);
-            if (rowFlag != lastRowFlag) {
-                msc.flagRow().put(row, rowFlag);
-                lastRowFlag = rowFlag;
-            }
-
-            if (arrayId != lastFillArrayId) {
-                msc.arrayId().put(row, arrayId);
-                lastFillArrayId = arrayId;
-            }
-            // Always put antenna1 & antenna2 since it is bound to the
-            // aipsStMan and is assumed to change every row
-            //     msc.antenna1().put(row,ant1);
-            //     msc.antenna2().put(row,ant2);
-            if (time != lastFillTime) {
-                msc.time().put(row, time);
-                msc.timeCentroid().put(row, time);
-                lastFillTime = time;
-            }
+            for (Int ifno = 0; ifno < nif; ifno++) {
+                // IFs go to separate rows in the MS
+                row++;
+                const Int index = row - firstRow;
 
-            // determine the spectralWindowId
-            Int spW = ifno;
-            if (iFreq >= 0) {
-                spW = (Int) priGroup_p.parm(iFreq) - 1; // make 0-based
-                if (nIF_p > 0) {
-                    spW *= nIF_p;
-                    spW += ifno;
+                // fill in values for all the unused columns
+                if (row == 0) {
+                    msc.feed1().put(row, 0);
+                    msc.feed2().put(row, 0);
+                    msc.flagRow().put(row, False);
+                    lastRowFlag = False;
+                    msc.processorId().put(row, -1);
+                    msc.observationId().put(row, 0);
+                    msc.stateId().put(row, -1);
                 }
-            }
-            nSpW = max(nSpW, spW + 1);
-
-            // Always put DDI (SSM) since it might change rapidly
-            //   msc.dataDescId().put(row,spW);
-            datDescId[row] = spW;
-            // store the fieldId
-            if (fieldId != lastFillFieldId) {
-                msc.fieldId().put(row, fieldId);
-                nField = max(nField, fieldId + 1);
-                lastFillFieldId = fieldId;
-            }
-        }
-    } 
-    // If determining interval on-the-fly, fill interval/exposure columns
-    //  now:
-    if (discernIntExp) {
-        discernedInt = floor(100.0 * discernedInt + 0.5) / 100.0;
-        msc.interval().fillColumn(discernedInt);
-        msc.exposure().fillColumn(discernedInt);
-    } else {
-        msc.interval().putColumn(interv);
-        msc.exposure().putColumn(expos);
-    }
-    msc.uvw().putColumn(uvw);
-    msc.antenna1().putColumn(ant1);
-    msc.antenna2().putColumn(ant2);
-    msc.dataDescId().putColumn(datDescId);
-    msc.data().putColumn(vis);
-    msc.weight().putColumn(weight);
-    msc.sigma().putColumn(sigma);
-    msc.weightSpectrum().putColumn(weightSpec);
-    msc.flag().putColumn(flag);
-    // fill the receptorAngle with defaults, just in case there is no AN table
-    receptorAngle_p = 0;
-}
-
-// Extract the data from the PrimaryGroup object and stick it into
-// the MeasurementSet 
-// Doing it row by row
-void MSFitsInput::fillMSMainTable(Int& nField, Int& nSpW) {
-    itsLog << LogOrigin("MSFitsInput", "fillMSMainTable");
-    // Get access to the MS columns
-    MSColumns& msc(*msc_p);
-    const Regex trailing(" *$"); // trailing blanks
-
-    // get the random group parameter names
-    Int nParams;
-    Int nGroups;
-    nParams = priGroup_p.pcount();
-    nGroups = priGroup_p.gcount();
-    Vector<String> pType(nParams);
-    for (Int i = 0; i < nParams; i++) {
-        pType(i) = priGroup_p.ptype(i);
-        pType(i) = pType(i).before(trailing);
-    }
-
-    Int nCorr = nPixel_p(getIndex(coordType_p, "STOKES"));
-    Int nChan = nPixel_p(getIndex(coordType_p, "FREQ"));
-
-
-    Matrix<Complex> vis(nCorr, nChan);
-    Vector<Float> sigma(nCorr);
-    Matrix<Float> weightSpec(nCorr, nChan);
-    Vector<Float> weight(nCorr);
-    const Int nCat = 3; // three initial categories
-    // define the categories
-    Vector<String> cat(nCat);
-    cat(0) = "FLAG_CMD";
-    cat(1) = "ORIGINAL";
-    cat(2) = "USER";
-    msc.flagCategory().rwKeywordSet().define("CATEGORY", cat);
-    Cube<Bool> flagCat(nCorr, nChan, nCat, False);
-    Matrix<Bool> flag = flagCat.xyPlane(0); // references flagCat's storage
-
-    // find out the indices for U, V and W, there are several naming schemes
-    Int iU, iV, iW;
-    iU = getIndexContains(pType, "UU");
-    iV = getIndexContains(pType, "VV");
-    iW = getIndexContains(pType, "WW");
-    if (iU < 0 || iV < 0 || iW < 0) {
-        throw(AipsError("MSFitsInput: Cannot find UVW information"));
-    }
-    // get index for baseline
-    Int iBsln = getIndex(pType, "BASELINE");
-    // get indices for time
-    Int iTime0 = getIndex(pType, "DATE", 0);
-    Int iTime1 = getIndex(pType, "DATE", 1);
-    // get index for source
-    Int iSource = getIndex(pType, "SOURCE");
-    // get index for Freq
-    Int iFreq = getIndex(pType, "FREQSEL");
 
-    // get index for Integration time
-    Int iInttim = getIndex(pType, "INTTIM");
-
-    receptorAngle_p.resize(1);
-    nAnt_p = 0;
-    itsLog << LogIO::NORMAL << "Reading and writing " << nGroups
-            << " visibility groups" << LogIO::POST;
-    Int row = -1;
-
-    Double interval, exposure;
-    interval = 0.0;
-    exposure = 0.0;
-    Bool discernIntExp(True);
-    Double discernedInt(DBL_MAX);
+                // Fill scanNumber if changed since last row
+                if (scanNumber(arrayId) != lastFillScanNumber) {
+                    msc.scanNumber().put(row, scanNumber(arrayId));
+                    lastFillScanNumber = scanNumber(arrayId);
+                }
 
-    ProgressMeter meter(0.0, nGroups * 1.0, "UVFITS Filler", "Groups copied",
-            "", "", True, nGroups / 100);
+                // Extract uvw and convert from units of seconds to meters
+                uvw(0, index) = parm[iU] * C::c;
+                uvw(1, index) = parm[iV] * C::c;
+                uvw(2, index) = parm[iW] * C::c;
 
-    Vector<Double> uvw(3);
+                // Extract antennas (make 0-based)
+                ant1(index) = Int(baseline) / 256;
+                nAnt_p = max(nAnt_p, ant1(index));
+                ant2(index) = Int(baseline) - ant1(index) * 256;
+                nAnt_p = max(nAnt_p, ant2(index));
+                ant1(index)--;
+                ant2(index)--;
 
-    // Remember last-filled values for TSM use
-    Int lastFillArrayId, lastFillFieldId, lastFillScanNumber;
-    lastFillArrayId = -1;
-    lastFillFieldId = -1, lastFillScanNumber = 0;
-    Double lastFillTime = 0;
+                if (!discernIntExp) {
+                    interv(index) = interval;
+                    expos(index) = exposure;
+                }
 
-    // Keep track of array-specific scanNumbers, FieldIds and FreqIds
-    Vector<Int> scanNumber(1);
-    Vector<Int> lastFieldId(1), lastFreqId(1);
-    scanNumber = 0;
-    lastFieldId = -1, lastFreqId = -1;
-    // nArray_p was uninitialized so could be HUGE ie causing std::bad_alloc
-    // to be thrown as it is used below for dimensioning, using the construction
-    //  nArray_p = max(nArray_p, arrayId+1). In order for this to work you'd better
-    // initialize nArray_p first...
-    nArray_p = -1;
+                if (arrayId != lastFillArrayId) {
+                    msc.arrayId().put(row, arrayId);
+                    lastFillArrayId = arrayId;
+                }
+                if (time != lastFillTime) {
+                    msc.time().put(row, time);
+                    msc.timeCentroid().put(row, time);
+                    lastFillTime = time;
+                }
 
-    Bool lastRowFlag = False;
+                // determine the spectralWindowId
+                Int spW = ifno;
+                if (iFreq >= 0) {
+                    spW = (Int) parm[iFreq] - 1; // make 0-based
+                    if (nIF_p > 0) {
+                        spW *= nIF_p;
+                        spW += ifno;
+                    }
+                }
+                nSpW = max(nSpW, spW + 1);
+                datDescId(index) = spW;
 
-    // Loop over groups
-    for (Int group = 0; group < nGroups; group++) {
-
-        // Read next group and
-        priGroup_p.read();
-
-        // Extract time in MJD seconds
-        //  (this has VERY limited precision [~0.01s])
-        const Double JDofMJD0 = 2400000.5;
-        Double time = priGroup_p.parm(iTime0);
-        time -= JDofMJD0;
-        if (iTime1 >= 0)
-            time += priGroup_p.parm(iTime1);
-        time *= C::day;
-
-        // Extract fqid
-        Int freqId = Int(priGroup_p.parm(iFreq));
-
-        // Extract field Id
-        Int fieldId = 0;
-        if (iSource >= 0) {
-            // make 0-based
-            fieldId = (Int) priGroup_p.parm(iSource) - 1;
-        }
-
-        // Extract uvw
-        uvw(0) = priGroup_p.parm(iU);
-        uvw(1) = priGroup_p.parm(iV);
-        uvw(2) = priGroup_p.parm(iW);
-        // Convert from units of seconds to meters
-        uvw *= C::c;
-
-        // Extract array/baseline/antenna info
-        Float baseline = priGroup_p.parm(iBsln);
-        Int arrayId = Int(100.0 * (baseline - Int(baseline) + 0.001));
-        nArray_p = max(nArray_p, arrayId + 1);
-
-        Int ant1 = Int(baseline) / 256;
-        nAnt_p = max(nAnt_p, ant1);
-        Int ant2 = Int(baseline) - ant1 * 256;
-        nAnt_p = max(nAnt_p, ant2);
-        ant1--;
-        ant2--; // make 0-based
-
-        // Ensure arrayId-specific params are of correct length:
-        if (scanNumber.shape() < nArray_p) {
-            scanNumber.resize(nArray_p, True);
-            lastFieldId.resize(nArray_p, True);
-            lastFreqId.resize(nArray_p, True);
-            scanNumber(nArray_p - 1) = 0;
-            lastFieldId(nArray_p - 1) = -1;
-            lastFreqId(nArray_p - 1) = -1;
-        }
-
-        // Detect new scan (field or freqid change) for each arrayId
-        if (fieldId != lastFieldId(arrayId) || freqId != lastFreqId(arrayId)
-                || time - lastFillTime > 300.0) {
-            scanNumber(arrayId)++;
-            lastFieldId(arrayId) = fieldId;
-            lastFreqId(arrayId) = freqId;
-        }
-
-        // If integration time is a RP, use it:
-        if (iInttim > -1) {
-            discernIntExp = False;
-            exposure = priGroup_p.parm(iInttim);
-            interval = exposure;
-        } else {
-            // keep track of minimum which is the only one
-            // (if time step is larger than UVFITS precision (and zero))
-            discernIntExp = True;
-            Double tempint;
-            tempint = time - lastFillTime;
-            if (tempint > 0.01) {
-                discernedInt = min(discernedInt, tempint);
+                // store the fieldId
+                if (fieldId != lastFillFieldId) {
+                    msc.fieldId().put(row, fieldId);
+                    nField = max(nField, fieldId + 1);
+                    lastFillFieldId = fieldId;
+                }
             }
         }
 
-        // Work out which axis increments fastests, pol or channel
-        // The COMPLEX axis is assumed to be first, and the IF axis is assumed
-        // to be after STOKES and FREQ.
-        Bool polFastest = (getIndex(coordType_p, "STOKES") < getIndex(
-                coordType_p, "FREQ"));
-        const Int nx = (polFastest ? nChan : nCorr);
-        const Int ny = (polFastest ? nCorr : nChan);
-
-        Int count = 0;
-        for (Int ifno = 0; ifno < max(1, nIF_p); ifno++) {
-            // IFs go to separate rows in the MS
-            ms_p.addRow();
-            row++;
-
-            // fill in values for all the unused columns
-            if (row == 0) {
-                msc.feed1().put(row, 0);
-                msc.feed2().put(row, 0);
-                msc.flagRow().put(row, False);
-                lastRowFlag = False;
-                msc.processorId().put(row, -1);
-                msc.observationId().put(row, 0);
-                msc.stateId().put(row, -1);
-            }
-
-            // Fill scanNumber if changed since last row
-            if (scanNumber(arrayId) != lastFillScanNumber) {
-                msc.scanNumber().put(row, scanNumber(arrayId));
-                lastFillScanNumber = scanNumber(arrayId);
+        // Decode the visibilities, weights and flags of all rows in the chunk.
+        // Each row only writes its own part of the buffers, so the rows
+        // can be handled in parallel.
+        const Double* dataPtr = groupData.data();
+        Complex* visPtr = vis.data();
+        Float* wspecPtr = weightSpec.data();
+        Bool* flagPtr = flag.data();
+        Float* weightPtr = weight.data();
+        Float* sigmaPtr = sigma.data();
+        const Block<Int>& corrIndex = corrIndex_p;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16) if (nRow >= 64)
+#endif
+        for (Int index = 0; index < nRow; index++) {
+            // The rows of a group (one per IF) are consecutive,
+            // so are their values.
+            const Double* val = dataPtr + Int64(index) * nRowVal;
+            const Int64 offset = Int64(index) * nCorr * nChan;
+            Float* wgt = weightPtr + Int64(index) * nCorr;
+            for (Int nc = 0; nc < nCorr; nc++) {
+                wgt[nc] = 0.0;
             }
-
-            weight = 0.0;
+            Int count = 0;
             // Loop over chans and corrs:
             for (Int ix = 0; ix < nx; ix++) {
                 for (Int iy = 0; iy < ny; iy++) {
-                    const Float visReal = priGroup_p(count++);
-                    const Float visImag = priGroup_p(count++);
-                    const Float wt = priGroup_p(count++);
-                    const Int pol = (polFastest ? corrIndex_p[iy]
-                            : corrIndex_p[ix]);
+                    const Float visReal = val[count++];
+                    const Float visImag = val[count++];
+                    const Float wt = val[count++];
+                    const Int pol = (polFastest ? corrIndex[iy]
+                            : corrIndex[ix]);
                     const Int chan = (polFastest ? ix : iy);
+                    const Int64 inx = offset + chan * nCorr + pol;
                     if (wt <= 0.0) {
-                        weightSpec(pol, chan) = abs(wt);
-                        flag(pol, chan) = True;
-                        weight(pol) += abs(wt);
+                        wspecPtr[inx] = abs(wt);
+                        flagPtr[inx] = True;
+                        wgt[pol] += abs(wt);
                     } else {
-                        weightSpec(pol, chan) = wt;
-                        flag(pol, chan) = False;
+                        wspecPtr[inx] = wt;
+                        flagPtr[inx] = False;
                         // weight column is sum of weight_spectrum (each pol):
-                        weight(pol) += wt;
+                        wgt[pol] += wt;
                     }
-                    vis(pol, chan) = Complex(visReal, visImag);
+                    visPtr[inx] = Complex(visReal, visImag);
                 }
             }
-
             // calculate sigma (weight = inverse variance)
+            Float* sig = sigmaPtr + Int64(index) * nCorr;
             for (Int nc = 0; nc < nCorr; nc++) {
-                if (weight(nc) > 0.0) {
-                    sigma(nc) = sqrt(1.0 / weight(nc));
+                if (wgt[nc] > 0.0) {
+                    sig[nc] = sqrt(1.0 / wgt[nc]);
                 } else {
-                    sigma(nc) = 0.0;
+                    sig[nc] = 0.0;
                 }
             }
+        }
 
-            // If available, store interval/exposure
-            if (!discernIntExp) {
-                msc.interval().put(row, interval);
-                msc.exposure().put(row, exposure);
+        // Fill the row flag if changed since last row.
+        const Int64 nCell = Int64(nCorr) * nChan;
+        for (Int index = 0; index < nRow; index++) {
+            const Bool* fl = flagPtr + index * nCell;
+            Bool rowFlag = True;
+            for (Int64 i = 0; i < nCell; i++) {
+                if (!fl[i]) {
+                    rowFlag = False;
+                    break;
+                }
             }
-
-            msc.data().put(row, vis);
-
-            msc.weight().put(row, weight);
-            msc.sigma().put(row, sigma);
-            msc.weightSpectrum().put(row, weightSpec);
-
-            msc.flag().put(row, flag);
-            msc.flagCategory().put(row, flagCat);
-            Bool rowFlag = allEQ(flag, True);
             if (rowFlag != lastRowFlag) {
-                msc.flagRow().put(row, rowFlag);
+                msc.flagRow().put(firstRow + index, rowFlag);
                 lastRowFlag = rowFlag;
             }
-
-            if (arrayId != lastFillArrayId) {
-                msc.arrayId().put(row, arrayId);
-                lastFillArrayId = arrayId;
-            }
-            // Always put antenna1 & antenna2 since it is bound to the
-            // aipsStMan and is assumed to change every row
-            msc.antenna1().put(row, ant1);
-            msc.antenna2().put(row, ant2);
-            if (time != lastFillTime) {
-                msc.time().put(row, time);
-                msc.timeCentroid().put(row, time);
-                lastFillTime = time;
-            }
-            msc.uvw().put(row, uvw);
-
-            // determine the spectralWindowId
-            Int spW = ifno;
-            if (iFreq >= 0) {
-                spW = (Int) priGroup_p.parm(iFreq) - 1; // make 0-based
-                if (nIF_p > 0) {
-                    spW *= nIF_p;
-                    spW += ifno;
-                }
-            }
-            nSpW = max(nSpW, spW + 1);
-
-            // Always put DDI (SSM) since it might change rapidly
-            msc.dataDescId().put(row, spW);
-
-            // store the fieldId
-            if (fieldId != lastFillFieldId) {
-                msc.fieldId().put(row, fieldId);
-                nField = max(nField, fieldId + 1);
-                lastFillFieldId = fieldId;
-            }
         }
-        meter.update((group + 1) * 1.0);
-    }
 
+        // Write the buffers as column ranges.
+        Slicer rowRange(IPosition(1, firstRow), IPosition(1, nRow));
+        if (!discernIntExp) {
+            msc.interval().putColumnRange(rowRange, interv);
+            msc.exposure().putColumnRange(rowRange, expos);
+        }
+        msc.uvw().putColumnRange(rowRange, uvw);
+        msc.antenna1().putColumnRange(rowRange, ant1);
+        msc.antenna2().putColumnRange(rowRange, ant2);
+        msc.dataDescId().putColumnRange(rowRange, datDescId);
+        msc.data().putColumnRange(rowRange, vis);
+        msc.weight().putColumnRange(rowRange, weight);
+        msc.sigma().putColumnRange(rowRange, sigma);
+        msc.weightSpectrum().putColumnRange(rowRange, weightSpec);
+        msc.flag().putColumnRange(rowRange, flag);
+        flagCat(IPosition(4, 0), IPosition(4, nCorr-1, nChan-1, 0, nRow-1)) =
+            flag.reform(IPosition(4, nCorr, nChan, 1, nRow));
+        msc.flagCategory().putColumnRange(rowRange, flagCat);
+        meter.update((firstGroup + nGrp) * 1.0);
+    }
     // If determining interval on-the-fly, fill interval/exposure columns
     //  now:
     if (discernIntExp) {
@@ -1732,24 +1491,8 @@ void MSFitsInput::fillMSMainTable(Int& nField, Int& nSpW) {
         msc.interval().fillColumn(discernedInt);
         msc.exposure().fillColumn(discernedInt);
     }
-
     // fill the receptorAngle with defaults, just in case there is no AN table
     receptorAngle_p = 0;
-    // set the Measure References
-
-
-    // Extract and print data manager cache statistics
-    // for flag and weight spectrum
-    // ROTiledStManAccessor dmFlag(ms_p, "TiledFlag");
-    //  cout << "TiledFlag statistics" << endl;
-    //  dmFlag.showCacheStatistics(cout);
-    //  cout << "---------------------------------------------------" << endl;
-
-    //  cout << endl;
-    //  cout << "TiledWgtSpectrum statistics" << endl;
-    //  ROTiledStManAccessor dmWeight(ms_p, "TiledWgtSpectrum");
-    //  dmWeight.showCacheStatistics(cout);
-    //  cout << "---------------------------------------------------" << endl;
 }
 
 void MSFitsInput::fillAntennaTable(BinaryTable& bt) {
@@ -235,6 +235,13 @@ public:
   Double operator () (Int i) const
   { return pf ? (*pf)(i) : ( pl ? (*pl)(i) : (*ps)(i));}
 
+  // Copy all parameters, scaled and converted to Double
+  void copyparm(Double* target) const
+  { pf ? pf->copyparm(target) : ( pl ? pl->copyparm(target) : ps->copyparm(target));}
+
+  // Copy the first nelem group data values, scaled and converted to Double
+  void copy(Double* target, Int nelem) const;
+
 private:
   HeaderDataUnit* hdu_p;
   PrimaryGroup<Short>* ps;
@@ -281,6 +288,13 @@ public:
   // 
   void readFitsFile(Int obsType = MSTileLayout::Standard);
 
+  // Set the approximate size (in bytes) of the buffers used to fill the
+  // main table from the random groups. The groups are processed in chunks
+  // fitting in that size; a chunk contains at least one group.
+  // The default is 64 MB.
+  void setChunkSize(Int64 nbytes)
+    { chunkSize_p = nbytes; }
+
 protected:
 
   // Check that the input is a UV fits file with required contents.
@@ -338,11 +352,9 @@ protected:
   // Fill the Observation and ObsLog tables
   void fillObsTables();
 
-  // Fill the main table from the Primary group data
-  // if we have enough memory try to do it in mem
+  // Fill the main table from the Primary group data.
+  // It is done in chunks of groups, which are written column-wise.
   void fillMSMainTableColWise(Int& nField, Int& nSpW);
-  //else do it row by row
-  void fillMSMainTable(Int& nField, Int& nSpW);
 
   // fill spectralwindow table from FITS FQ table + header info
   void fillSpectralWindowTable(BinaryTable& bt, Int nSpW);
@@ -418,6 +430,7 @@ private:
 
   Matrix<Double> restFreq_p; // used for UVFITS
   Matrix<Double> sysVel_p;
+  Int64 chunkSize_p;
 
 };
 
@@ -41,6 +41,8 @@
 #include <casacore/fits/FITS/FITSTable.h>
 #include <casacore/fits/FITS/FITSDateUtil.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/MatrixMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
@@ -66,6 +68,7 @@
 #include <casacore/casa/Logging/LogIO.h>
 
 #include <set>
+#include <algorithm>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -75,6 +78,22 @@ static String toFITSDate(const MVTime &time) {
     return date;
 }
 
+// Get the index of a random group parameter in a group written by
+// FITSGroupWriter. The parameters are in the order of the scalar fields
+// in the description. -1 is returned if the parameter does not exist.
+static Int groupParmIndex(const RecordDesc& desc, const String& name) {
+    Int parmnr = 0;
+    for (uInt i = 0; i < desc.nfields(); ++i) {
+        if (desc.type(i) != TpArrayFloat) {
+            if (desc.name(i) == name) {
+                return parmnr;
+            }
+            parmnr++;
+        }
+    }
+    return -1;
+}
+
 // MJD seconds to day number and day fraction
 void MSFitsOutput::timeToDay(Int &day, Double &dayFraction, Double time) {
     const Double JDofMJD0 = 2400000.5;
@@ -810,28 +829,12 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
     // Similarly, record the sort order (the following didn't work....)
     //  ek.define("history aips sort order", "TB");
 
-    Bool deleteIptr;
-    Matrix<Complex> indatatmp(IPosition(2, numcorr0, numchan0));
-    const Complex *iptr = indatatmp.getStorage(deleteIptr);
-
-    Bool deleteWtPtr;
-    Matrix<Float> inwttmp(numcorr0, numchan0);
-    const Float *wptr = inwttmp.getStorage(deleteWtPtr);
-
-    Bool deleteFlagPtr;
-    Matrix<Bool> inflagtmp(IPosition(2, numcorr0, numchan0));
-    const Bool *fptr = inflagtmp.getStorage(deleteFlagPtr);
-
     Bool deleteIndPtr;
     const uInt *indptr = stokesIndex.getStorage(deleteIndPtr);
 
     // Do we need to check units? I think the MS rules are that units cannot
     // be changed.
 
-    Vector<Double> uvw(3);
-    Int day;
-    Double dayFraction;
-
     const Double oneOverC = 1.0 / C::c;
 
     // Sort the table in order of TIME, ANTENNA1, ANTENNA2, FIELDID, SPWID.
@@ -990,63 +993,16 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
         }
     }
 
-    // Finally, make the writer.  If it breaks past this point, the user gets to
-    // look at the pieces.
-    FITSGroupWriter writer(outFITSFile, desc, nOutRow, ek, False);
-    outfile = writer.writer();
-
-    // DATA - out
-    RecordFieldPtr<Array<Float> > odata(writer.row(), "data");
-    Bool deleteOptr;
-    Float *optr = (*odata).getStorage(deleteOptr);
-
-    os << LogIO::DEBUG1 << "output data shape = " << writer.row().asArrayFloat(
-            writer.row().fieldNumber("data")).shape() << " "
-            << writer.row().asArrayFloat("data").shape() << " "
-            << writer.row().asArrayFloat(writer.row().fieldNumber("data")).data()
-            << " " << LogIO::POST;
-
-    RecordFieldPtr<Float> ouu(writer.row(), "u");
-    RecordFieldPtr<Float> ovv(writer.row(), "v");
-    RecordFieldPtr<Float> oww(writer.row(), "w");
-    RecordFieldPtr<Float> odate1(writer.row(), "date1");
-    RecordFieldPtr<Float> odate2(writer.row(), "date2");
-    RecordFieldPtr<Float> obaseline(writer.row(), "baseline");
-    RecordFieldPtr<Float> ofreqsel(writer.row(), "freqsel");
-    RecordFieldPtr<Float> osource;
-    RecordFieldPtr<Float> ointtim;
-    if (asMultiSource) {
-        osource = RecordFieldPtr<Float> (writer.row(), "source");
-        ointtim = RecordFieldPtr<Float> (writer.row(), "inttim");
-    }
-
-    // Check if first cell has a WEIGHT of correct shape.
-    if (hasWeightArray) {
-        IPosition shp = inweightarray.shape(0);
-        if (shp.nelements() > 0 && !shp.isEqual(inwttmp.shape())) {
-            hasWeightArray = False;
-            os << LogIO::WARN << "WEIGHT_SPECTRUM is ignored (incorrect shape)"
-                    << LogIO::POST;
-        }
-    }
-
-    Vector<Int> antnumbers;
-    handleAntNumbers(rawms, antnumbers);
-
-    // Loop through all rows.
-    ProgressMeter meter(0.0, nOutRow * 1.0, "UVFITS Writer", "Rows copied", "",
-            "", True, nOutRow / 100);
+    // Determine for each output group, i.e. each (time, baseline, field),
+    // its first input row and the input row to use for each IF (-1 means
+    // that the IF is padded with flags). This is also done before creating
+    // the writer, so no partial UVFITS file is left if it exits.
+    Vector<Int> spwids = inspwinid.getColumn();
+    Block<uInt> groupStart(nOutRow);
+    Block<Int> groupRows(nOutRow * nif, -1);
 
     uInt tbfrownr = 0; // Input row # of (time, baseline, field).
     uInt outrownr = 0; // Output row #.
-
-    //Double lasttime(0.0);
-    Vector<Float> realcorr(numcorr0);
-    Vector<Float> imagcorr(numcorr0);
-    Vector<Float> wgtaver(numcorr0);
-    Vector<Float> realcorrf(numcorr0);
-    Vector<Float> imagcorrf(numcorr0);
-    Vector<Float> wgtaverf(numcorr0);
     Int old_nspws_found = -1; // Just for debugging curiosity.
     while (tbfrownr < nrow) {
         if (outrownr >= nOutRow) { // Shouldn't happen, but just in case...
@@ -1056,14 +1012,10 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
             break;
         }
 
-        // Will only write a record if some non-flagged data found
-        //    Bool dowrite(True);   // temporarily disable, because FITSGroupWriter chokes
-
-        Float* outptr = optr; // reset for each spectral-window
-
         // Loop over the IFs, whether or not the corresponding spws are present for
         // this (time, baseline, field).
         // rownr should only be used inside this loop; use tbfrownr outside.
+        Int* ifRows = groupRows.storage() + outrownr * nif;
         uInt rawrownr = tbfrownr; // Essentially tbfrownr + m - # of missing spws
         // so far.
         uInt rownr = rawrownr;
@@ -1074,20 +1026,9 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
         }
 
         for (uInt m = 0; m < nif; ++m) {
-            Bool rowFlag; // FLAG_ROW
-
             if (combineSpw && (rownr >= nrow // flag remaining IFs in tbfrownr
-                    || inspwinid(rownr) != expectedDDIDs[m])) {
-                if (padWithFlags) {
-                    // Save this row for the next one, and fill in with flagged junk.
-
-                    indatatmp.set(0.0); // DATA matrix
-                    //indata.get(rownr, indatatmp);   // DATA matrix
-                    rowFlag = true;
-                    inflagtmp.set(true);
-                    inwttmp.set(0.0);
-                    // Don't update lasttime.
-                } else {
+                    || spwids[rownr] != expectedDDIDs[m])) {
+                if (!padWithFlags) {
                     os << LogIO::SEVERE
                             << "A DATA_DESC_ID appeared out of the expected order.\n"
                             << "MSes with multiple tunings (i.e. spw varies with time) cannot"
@@ -1095,6 +1036,7 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
                             << LogIO::POST;
                     return 0;
                 }
+                // Save this row for the next one, and fill in with flagged junk.
             } else { // The spw is present, use it.
                 if (rownr >= nrow) { // Shouldn't happen, but just in case...
                     os << LogIO::WARN
@@ -1102,235 +1044,19 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
                             << LogIO::POST;
                     break;
                 }
-
-                indata.get(rownr, indatatmp); // DATA matrix
-                rowFlag = inrowflag(rownr);
-                indataflag.get(rownr, inflagtmp); // FLAG
-
-                // WEIGHT_SPECTRUM (defaults to WEIGHT)
-                Bool getwt = True;
-                if (hasWeightArray) {
-                    IPosition shp = inweightarray.shape(rownr);
-                    if (shp.isEqual(inwttmp.shape())) {
-                        inweightarray.get(rownr, inwttmp);
-                        getwt = False;
-                    }
-                }
-                if (getwt) {
-                    //weight_spectrum may not exist but flag and data always will.
-                    IPosition shp = indatatmp.shape();
-                    Int nchan = shp(1); // either num of channels of num of lags
-                    //cout << "shp1=" << shp << " shp2=" << inflagtmp.shape() 
-                    //     << " nchan=" << nchan << endl;
-                    if (nchan < 1) nchan = 1;
-                    const Vector<Float> wght = inweightscalar(rownr);
-                    for (Int p = 0; p < numcorr0; p++) {
-                        inwttmp.row(p) = wght(p) / nchan;
-                    }
-                }
-                /*
-                 Double rtime(86400.0*floor(intimec(0)/86400.0));
-                 cout << "rtime = " << rtime << " " << "nrows = " << intimec.nrow()
-                 << endl;
-                 cout << "time = " << intimec(rownr)-rtime;
-                 if (intimec(rownr)!=lasttime)
-                 cout << " ***NEW*** ";
-                 cout << endl;
-                 */
-                // lasttime = intimec(rownr);
-
+                ifRows[m] = rownr;
                 if (!padWithFlags || rawrownr <= tbfend) {
                     ++rawrownr; // register that the spw was present.
                     if (combineSpw && nif > 1)
-                        rownr = sortIndex[rawrownr];
+                        rownr = (rawrownr < nrow ? sortIndex[rawrownr] : nrow);
                     else
                         rownr = rawrownr;
                 }
             }
-
-            // We should optimize this loop more, probably do frequency as
-            // the inner loop?
-            realcorr.set(0);
-            imagcorr.set(0);
-            wgtaver.set(0);
-            realcorrf.set(0);
-            imagcorrf.set(0);
-            wgtaverf.set(0);
-            Int chancounter = 0;
-            Vector<Int> flagcounter(numcorr0);
-            flagcounter.set(0);
-            //cout << "chanstart=" << chanstart << " nchan=" << nchan 
-            //     << " chanstep=" << chanstep << " avgchan=" << avgchan << endl;
-            for (Int k = chanstart; k < (nchan * chanstep + chanstart); k += chanstep) {
-                //cout << "row = " << tbfrownr << " "
-                //   << outptr << " " << optr << " " << outptr-optr << " ";
-                //   << "ddi = " << m << " (" << inspwinid(i) << ") "
-                //   << "chan = " << k << " / "
-                //   << boolalpha
-                //   << "hasWeightArray = " << hasWeightArray << " "
-                //   << "wt(chan) = " << inwttmp.column(k) << "; "
-                //   << "flag(chan) = " << inflagtmp.column(k) << " "
-                //   << "shapes: "
-                //   << indatatmp.shape() << " "
-                //   << inwttmp.shape()  << " "
-                //   << inflagtmp.shape()  << " "
-                //   << endl;
-                /*
-                if (chancounter != avgchan) {
-                    for (Int j = 0; j < numcorr0; j++) {
-                        Int offset = indptr[j] + k * numcorr0;
-                        //cout << "j=" << j << " real=" << iptr[offset].real()
-                        //     << " imag=" << iptr[offset].imag() << endl;
-                        if (!fptr[offset]) {
-                            realcorr[j] += iptr[offset].real() * wptr[offset];
-                            imagcorr[j] += iptr[offset].imag() * wptr[offset];
-                            wgtaver[j] += wptr[offset];
-                            flagcounter++;
-                        }
-                        else {
-                            realcorrf[j] += iptr[offset].real() * wptr[offset];
-                            imagcorrf[j] += iptr[offset].imag() * wptr[offset];
-                            wgtaverf[j] += wptr[offset];
-                        }
-                        //cout << "j=" << j << " k=" << k 
-                        //     << " real=" << realcorr[j] << " image=" << imagcorr[j] 
-                        //     << " offset=" << offset << " chancounter=" << chancounter << endl; 
-                    }
-                    ++chancounter;
-                }
-                if (chancounter == avgchan) {
-                    for (Int j = 0; j < numcorr0; j++) {
-                        if (wgtaver[j] > 0) {
-                            outptr[0] = realcorr[j] / wgtaver[j];
-                            outptr[1] = imagcorr[j] / wgtaver[j];
-                            outptr[2] = wgtaver[j] / flagcounter * numcorr0;
-                        } 
-                        else if (wgtaverf[j] > 0) {
-                            outptr[0] = realcorrf[j] / wgtaverf[j];
-                            outptr[1] = imagcorrf[j] / wgtaverf[j];
-                            outptr[2] = -wgtaverf[j] / avgchan;
-                        }
-                        else {
-                            outptr[0] = realcorrf[j] / avgchan;
-                            outptr[1] = imagcorrf[j] / avgchan;
-                            outptr[2] = 0;
-                        }
-                        if (rowFlag) {
-                            //calculate the average even if row flagged, just in case
-                            //unflag the row and it has some reasonable data there
-                            outptr[2] = -abs(outptr[2]);
-                        }
-                        outptr += 3;
-                    }
-                    realcorr.set(0);
-                    imagcorr.set(0);
-                    wgtaver.set(0);
-                    realcorrf.set(0);
-                    imagcorrf.set(0);
-                    wgtaverf.set(0);
-                    chancounter = 0;
-                    flagcounter = 0;
-                }
-                */
-                if (chancounter != avgchan) {
-                    for (Int j = 0; j < numcorr0; j++) {
-                        Int offset = indptr[j] + k * numcorr0;
-                        //cout << "j=" << j << " real=" << iptr[offset].real()
-                        //     << " imag=" << iptr[offset].imag() << endl;
-                        if (!fptr[offset]) {
-                            realcorr[j] += iptr[offset].real();
-                            imagcorr[j] += iptr[offset].imag();
-                            wgtaver[j] += wptr[offset];
-                            flagcounter[j]++;
-                        }
-                        else {
-                            realcorrf[j] += iptr[offset].real();
-                            imagcorrf[j] += iptr[offset].imag();
-                            wgtaverf[j] += wptr[offset];
-                        }
-                        //cout << "j=" << j << " k=" << k 
-                        //     << " real=" << realcorr[j] << " image=" << imagcorr[j] 
-                        //     << " offset=" << offset << " chancounter=" << chancounter << endl; 
-                    }
-                    ++chancounter;
-                }
-                if (chancounter == avgchan) {
-                    for (Int j = 0; j < numcorr0; j++) {
-                        if (flagcounter[j] > 0) {
-                            outptr[0] = realcorr[j] / flagcounter[j];
-                            outptr[1] = imagcorr[j] / flagcounter[j];
-                            outptr[2] = wgtaver[j] / flagcounter[j];
-                        } 
-                        else if (wgtaverf[j] > 0) {
-                            outptr[0] = realcorrf[j] / avgchan;
-                            outptr[1] = imagcorrf[j] / avgchan;
-                            outptr[2] = -wgtaverf[j] / avgchan;
-                        }
-                        else {
-                            outptr[0] = realcorrf[j] / avgchan;
-                            outptr[1] = imagcorrf[j] / avgchan;
-                            outptr[2] = 0;
-                        }
-                        if (rowFlag) {
-                            //calculate the average even if row flagged, just in case
-                            //unflag the row and it has some reasonable data there
-                            outptr[2] = -abs(outptr[2]);
-                        }
-                        outptr += 3;
-                    }
-                    realcorr.set(0);
-                    imagcorr.set(0);
-                    wgtaver.set(0);
-                    realcorrf.set(0);
-                    imagcorrf.set(0);
-                    wgtaverf.set(0);
-                    chancounter = 0;
-                    flagcounter.set(0);
-                }
-            }
-
-            // if(nOutRow - outtbfrownr < 5)
-            //   os << LogIO::DEBUG1 << "(outtbfrownr, m) = (" << outtbfrownr
-            //      << ", " << m << ")" << LogIO::POST;
-
         } // Ends loop over IFs.
 
-        // If found data at this timestamp, write it out
-        //    if (dowrite) {
-        // Random parameters
-        // UU VV WW
-        inuvw.get(tbfrownr, uvw);
-        *ouu = uvw(0) * oneOverC;
-        *ovv = uvw(1) * oneOverC;
-        *oww = uvw(2) * oneOverC;
-
-        // TIME
-        timeToDay(day, dayFraction, intimec(tbfrownr));
-        *odate1 = day;
-        *odate2 = dayFraction;
-
-        // BASELINE
-        *obaseline = antnumbers(inant1(tbfrownr)) * 256 + antnumbers(inant2(
-                tbfrownr)) + inarray(tbfrownr) * 0.01;
-
-        // FREQSEL (in the future it might be FREQ_GRP+1)
-        //    *ofreqsel = inddid(i) + 1;
-        if (combineSpw) {
-            *ofreqsel = 1;
-        } else {
-            *ofreqsel = 1 + spwidMap[inspwinid(tbfrownr)];
-        }
-
-        // SOURCE
-        // INTTIM
-        if (asMultiSource) {
-            *osource = 1 + fieldidMap[infieldid(tbfrownr)];
-            *ointtim = inexposure(tbfrownr);
-        }
-
-        writer.write();
+        groupStart[outrownr] = tbfrownr;
         ++outrownr;
-        meter.update(outrownr);
 
         // How many spws showed up for this (time_centroid, ant1, ant2, field)?
         if (rawrownr == tbfrownr) {
@@ -1383,8 +1109,263 @@ FitsOutput *MSFitsOutput::writeMain(Int& refPixelFreq, Double& refFreq,
 
             tbfrownr = rawrownr; // Increment it by the # of spws found.
         }
+    }
+    const uInt nGroups = outrownr;
+
+    // Finally, make the writer.  If it breaks past this point, the user gets to
+    // look at the pieces.
+    FITSGroupWriter writer(outFITSFile, desc, nOutRow, ek, False);
+    outfile = writer.writer();
+    const uInt groupSize = writer.groupSize();
+    const uInt nParm = groupSize - dataShape.product();
+    // The index of each random parameter in a group.
+    const Int iU = groupParmIndex(desc, "u");
+    const Int iV = groupParmIndex(desc, "v");
+    const Int iW = groupParmIndex(desc, "w");
+    const Int iDate1 = groupParmIndex(desc, "date1");
+    const Int iDate2 = groupParmIndex(desc, "date2");
+    const Int iBaseline = groupParmIndex(desc, "baseline");
+    const Int iFreqsel = groupParmIndex(desc, "freqsel");
+    const Int iSource = groupParmIndex(desc, "source");
+    const Int iInttim = groupParmIndex(desc, "inttim");
+
+    os << LogIO::DEBUG1 << "output data shape = " << dataShape << LogIO::POST;
+
+    // Check if first cell has a WEIGHT of correct shape.
+    const IPosition wtShape(2, numcorr0, numchan0);
+    if (hasWeightArray) {
+        IPosition shp = inweightarray.shape(0);
+        if (shp.nelements() > 0 && !shp.isEqual(wtShape)) {
+            hasWeightArray = False;
+            os << LogIO::WARN << "WEIGHT_SPECTRUM is ignored (incorrect shape)"
+                    << LogIO::POST;
+        }
+    }
+
+    Vector<Int> antnumbers;
+    handleAntNumbers(rawms, antnumbers);
+    const Int* antPtr = antnumbers.data();
+
+    // The groups are written in chunks. For the groups in a chunk the
+    // input columns are read as row ranges, thereafter the groups are
+    // assembled (in parallel if OpenMP is used) in a buffer, which is
+    // written at once. Determine the number of groups per chunk, such
+    // that the buffers take about 64 MB.
+    const Int64 nValRow = Int64(numcorr0) * numchan0;
+    const Int64 bytesPerGroup = nif * nValRow *
+        (sizeof(Complex) + sizeof(Float) + sizeof(Bool)) +
+        groupSize * sizeof(Float);
+    const uInt chunkGroups = max(1u, min(nGroups,
+                                 uInt(64 * 1024 * 1024 / bytesPerGroup)));
+    Block<Float> groupBuf(Int64(chunkGroups) * groupSize);
+
+    // Loop through all groups.
+    ProgressMeter meter(0.0, nOutRow * 1.0, "UVFITS Writer", "Rows copied", "",
+            "", True, nOutRow / 100);
+
+    Array<Complex> dataBuf;
+    Array<Bool> flagBuf;
+    Array<Float> weightBuf;
+    Array<Float> wtspecBuf;
+    for (uInt firstGroup = 0; firstGroup < nGroups; firstGroup += chunkGroups) {
+        const uInt nGrp = min(chunkGroups, nGroups - firstGroup);
+        // Determine the range of input rows used by the groups in the chunk.
+        uInt firstRow = groupStart[firstGroup];
+        uInt lastRow = groupStart[firstGroup + nGrp - 1];
+        for (uInt i = firstGroup * nif; i < (firstGroup + nGrp) * nif; ++i) {
+            if (groupRows[i] >= 0) {
+                firstRow = min(firstRow, uInt(groupRows[i]));
+                lastRow = max(lastRow, uInt(groupRows[i]));
+            }
+        }
+        const uInt nRow = lastRow + 1 - firstRow;
+        Slicer rowRange(IPosition(1, firstRow), IPosition(1, nRow));
+
+        // Read the columns for all rows in the range.
+        indata.getColumnRange(rowRange, dataBuf, True);
+        indataflag.getColumnRange(rowRange, flagBuf, True);
+        inweightscalar.getColumnRange(rowRange, weightBuf, True);
+        Vector<Bool> rowFlags = inrowflag.getColumnRange(rowRange);
+        Matrix<Double> uvws = inuvw.getColumnRange(rowRange);
+        Vector<Double> times = intimec.getColumnRange(rowRange);
+        Vector<Int> ant1s = inant1.getColumnRange(rowRange);
+        Vector<Int> ant2s = inant2.getColumnRange(rowRange);
+        Vector<Int> arrays = inarray.getColumnRange(rowRange);
+        Vector<Int> fieldids;
+        Vector<Double> exposures;
+        if (asMultiSource) {
+            fieldids = infieldid.getColumnRange(rowRange);
+            exposures = inexposure.getColumnRange(rowRange);
+        }
+        // WEIGHT_SPECTRUM (defaults to WEIGHT) is only used for the rows
+        // where it has the correct shape.
+        Block<Bool> hasWtSpec(nRow, False);
+        if (hasWeightArray) {
+            Bool allWtSpec = True;
+            for (uInt i = 0; i < nRow; ++i) {
+                hasWtSpec[i] = inweightarray.isDefined(firstRow + i)
+                        && inweightarray.shape(firstRow + i).isEqual(wtShape);
+                allWtSpec = allWtSpec && hasWtSpec[i];
+            }
+            if (allWtSpec) {
+                inweightarray.getColumnRange(rowRange, wtspecBuf, True);
+            } else {
+                wtspecBuf.resize(IPosition(3, numcorr0, numchan0, nRow));
+                Cube<Float> wtspecCube(wtspecBuf);
+                for (uInt i = 0; i < nRow; ++i) {
+                    if (hasWtSpec[i]) {
+                        Matrix<Float> wtspecPlane(wtspecCube.xyPlane(i));
+                        inweightarray.get(firstRow + i, wtspecPlane);
+                    }
+                }
+            }
+        }
+
+        // Assemble the groups.
+        const Complex* iptr = dataBuf.data();
+        const Bool* fptr = flagBuf.data();
+        const Float* wtptr = weightBuf.data();
+        const Float* wsptr = wtspecBuf.data();
+        const Bool* rowFlagPtr = rowFlags.data();
+        const Double* uvwPtr = uvws.data();
+        const Double* timePtr = times.data();
+        const Int* ant1Ptr = ant1s.data();
+        const Int* ant2Ptr = ant2s.data();
+        const Int* arrayPtr = arrays.data();
+        const Int* fieldPtr = fieldids.data();
+        const Double* exposurePtr = exposures.data();
+        const Int* spwPtr = spwids.data();
+        const Bool* hasWtSpecPtr = hasWtSpec.storage();
+        const uInt* groupStartPtr = groupStart.storage();
+        const Int* groupRowsPtr = groupRows.storage();
+        Float* bufPtr = groupBuf.storage();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16) if (nGrp >= 64)
+#endif
+        for (Int g = 0; g < Int(nGrp); ++g) {
+            Float* parm = bufPtr + Int64(g) * groupSize;
+            std::fill(parm, parm + groupSize, Float(0));
+            const uInt tbfrow = groupStartPtr[firstGroup + g];
+            const uInt tbf = tbfrow - firstRow;
+
+            // Random parameters
+            // UU VV WW
+            parm[iU] = uvwPtr[3 * tbf] * oneOverC;
+            parm[iV] = uvwPtr[3 * tbf + 1] * oneOverC;
+            parm[iW] = uvwPtr[3 * tbf + 2] * oneOverC;
+            // TIME
+            Int day;
+            Double dayFraction;
+            timeToDay(day, dayFraction, timePtr[tbf]);
+            parm[iDate1] = day;
+            parm[iDate2] = dayFraction;
+            // BASELINE
+            parm[iBaseline] = antPtr[ant1Ptr[tbf]] * 256 + antPtr[ant2Ptr[tbf]]
+                    + arrayPtr[tbf] * 0.01;
+            // FREQSEL (in the future it might be FREQ_GRP+1)
+            if (combineSpw) {
+                parm[iFreqsel] = 1;
+            } else {
+                parm[iFreqsel] = 1 + spwidMap[spwPtr[tbfrow]];
+            }
+            // SOURCE
+            // INTTIM
+            if (asMultiSource) {
+                parm[iSource] = 1 + fieldidMap[fieldPtr[tbf]];
+                parm[iInttim] = exposurePtr[tbf];
+            }
+
+            // Average the channels of each IF.
+            Float* outptr = parm + nParm;
+            Block<Float> sums(6 * numcorr0);
+            Float* realcorr = sums.storage();
+            Float* imagcorr = realcorr + numcorr0;
+            Float* wgtaver = imagcorr + numcorr0;
+            Float* realcorrf = wgtaver + numcorr0;
+            Float* imagcorrf = realcorrf + numcorr0;
+            Float* wgtaverf = imagcorrf + numcorr0;
+            Block<Int> flagcounter(numcorr0);
+            Block<Float> wtPerChan(numcorr0);
+            for (uInt m = 0; m < nif; ++m) {
+                // A missing spw is filled with flagged zeroes.
+                const Int rownr = groupRowsPtr[(firstGroup + g) * nif + m];
+                Bool rowFlag = True; // FLAG_ROW
+                const Complex* rowData = 0;
+                const Bool* rowFlg = 0;
+                const Float* rowWt = 0;
+                if (rownr >= 0) {
+                    const uInt row = rownr - firstRow;
+                    rowFlag = rowFlagPtr[row];
+                    rowData = iptr + row * nValRow;
+                    rowFlg = fptr + row * nValRow;
+                    if (hasWeightArray && hasWtSpecPtr[row]) {
+                        rowWt = wsptr + row * nValRow;
+                    } else {
+                        // Spread the WEIGHT over the channels.
+                        const Int nch = (numchan0 < 1 ? 1 : numchan0);
+                        for (Int p = 0; p < numcorr0; p++) {
+                            wtPerChan[p] = wtptr[row * numcorr0 + p] / nch;
+                        }
+                    }
+                }
+                sums.set(0);
+                flagcounter.set(0);
+                Int chancounter = 0;
+                for (Int k = chanstart; k < (nchan * chanstep + chanstart); k += chanstep) {
+                    if (chancounter != avgchan) {
+                        for (Int j = 0; rowData && j < numcorr0; j++) {
+                            Int offset = indptr[j] + k * numcorr0;
+                            Float wt = (rowWt ? rowWt[offset]
+                                              : wtPerChan[indptr[j]]);
+                            if (!rowFlg[offset]) {
+                                realcorr[j] += rowData[offset].real();
+                                imagcorr[j] += rowData[offset].imag();
+                                wgtaver[j] += wt;
+                                flagcounter[j]++;
+                            }
+                            else {
+                                realcorrf[j] += rowData[offset].real();
+                                imagcorrf[j] += rowData[offset].imag();
+                                wgtaverf[j] += wt;
+                            }
+                        }
+                        ++chancounter;
+                    }
+                    if (chancounter == avgchan) {
+                        for (Int j = 0; j < numcorr0; j++) {
+                            if (flagcounter[j] > 0) {
+                                outptr[0] = realcorr[j] / flagcounter[j];
+                                outptr[1] = imagcorr[j] / flagcounter[j];
+                                outptr[2] = wgtaver[j] / flagcounter[j];
+                            }
+                            else if (wgtaverf[j] > 0) {
+                                outptr[0] = realcorrf[j] / avgchan;
+                                outptr[1] = imagcorrf[j] / avgchan;
+                                outptr[2] = -wgtaverf[j] / avgchan;
+                            }
+                            else {
+                                outptr[0] = realcorrf[j] / avgchan;
+                                outptr[1] = imagcorrf[j] / avgchan;
+                                outptr[2] = 0;
+                            }
+                            if (rowFlag) {
+                                //calculate the average even if row flagged, just in case
+                                //unflag the row and it has some reasonable data there
+                                outptr[2] = -abs(outptr[2]);
+                            }
+                            outptr += 3;
+                        }
+                        sums.set(0);
+                        flagcounter.set(0);
+                        chancounter = 0;
+                    }
+                }
+            } // Ends loop over IFs.
+        }
 
-        //    } // dowrite
+        // Write all groups of the chunk at once.
+        writer.write(groupBuf.storage(), nGrp);
+        meter.update(firstGroup + nGrp);
     }
     os << LogIO::DEBUG1 << "tbfrownr = " << tbfrownr << LogIO::POST;
     os << LogIO::DEBUG1 << "outrownr = " << outrownr << LogIO::POST;
@@ -0,0 +1,167 @@
+//# tMSFitsIDI.cc: Test program for the FITS-IDI to MS conversion
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/msfits/MSFits/MSFitsIDI.h>
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Inputs.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class MSFitsIDI.
+// It converts the given FITS-IDI files one by one and all together
+// (physically and virtually concatenated) and checks the results.
+// </summary>
+
+// Check the main table of an MS converted from a FITS-IDI file.
+// Each row must have a valid DATA_DESC_ID and a positive INTERVAL,
+// also the rows written before the interval could be derived from TIME.
+void checkMain (const String& msName)
+{
+  MeasurementSet ms(msName);
+  AlwaysAssertExit (ms.nrow() > 0);
+  ROMSColumns cols(ms);
+  Vector<Int> ddid = cols.dataDescId().getColumn();
+  AlwaysAssertExit (allGE (ddid, 0));
+  AlwaysAssertExit (allLT (ddid, Int(ms.dataDescription().nrow())));
+  Vector<Double> interval = cols.interval().getColumn();
+  AlwaysAssertExit (allGT (interval, 0.));
+  AlwaysAssertExit (allEQ (interval, cols.exposure().getColumn()));
+  // The first flag category contains the flags.
+  Array<Bool> flags = cols.flag().getColumn();
+  Array<Bool> flagCat = cols.flagCategory().getColumn();
+  IPosition shp = flagCat.shape();
+  AlwaysAssertExit (allEQ (flagCat(IPosition(4,0),
+                                   IPosition(4, shp[0]-1, shp[1]-1,
+                                             0, shp[3]-1)),
+                           flags.reform(IPosition(4,shp[0],shp[1],1,shp[3]))));
+}
+
+// Check that the concatenated MS has the rows of the parts in order.
+void checkConcat (const String& msName, const Block<String>& partNames)
+{
+  MeasurementSet ms(msName);
+  ROMSColumns cols(ms);
+  Vector<Double> time = cols.time().getColumn();
+  Vector<Int> ant1 = cols.antenna1().getColumn();
+  Vector<Int> ant2 = cols.antenna2().getColumn();
+  uInt row = 0;
+  for (uInt i=0; i<partNames.size(); ++i) {
+    MeasurementSet partMS(partNames[i]);
+    ROMSColumns partCols(partMS);
+    uInt nrow = partMS.nrow();
+    AlwaysAssertExit (row + nrow <= ms.nrow());
+    Slice rows(row, nrow);
+    AlwaysAssertExit (allEQ (time(rows), partCols.time().getColumn()));
+    AlwaysAssertExit (allEQ (ant1(rows), partCols.antenna1().getColumn()));
+    AlwaysAssertExit (allEQ (ant2(rows), partCols.antenna2().getColumn()));
+    row += nrow;
+  }
+  AlwaysAssertExit (row == ms.nrow());
+}
+
+// Count the files in the working directory starting with the given prefix.
+uInt countFiles (const String& prefix)
+{
+  uInt n = 0;
+  DirectoryIterator iter(Directory("."));
+  while (! iter.pastEnd()) {
+    if (iter.name().startsWith (prefix)) {
+      n++;
+    }
+    iter++;
+  }
+  return n;
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    Input inputs(1);
+    inputs.create ("fits", "", "Comma separated list of FITS-IDI files");
+    inputs.create ("ms", "tMSFitsIDI_tmp.ms", "Output MS name");
+    inputs.readArguments (argc, argv);
+    Vector<String> fitsNames = stringToVector (inputs.getString("fits"));
+    const String msName = inputs.getString("ms");
+    if (fitsNames.empty()) {
+      cout << "No FITS-IDI files given" << endl;
+      return 3;                           // untested
+    }
+    // Convert the files one by one.
+    Block<String> partNames(fitsNames.size());
+    for (uInt i=0; i<fitsNames.size(); ++i) {
+      partNames[i] = msName + "_single" + String::toString(i);
+      MSFitsIDI msfitsidi(fitsNames[i], partNames[i], True);
+      msfitsidi.fillMS();
+      checkMain (partNames[i]);
+    }
+    if (fitsNames.size() > 1) {
+      // A table with the name formerly used for the first part must not
+      // be touched.
+      const String dummyName = msName + "_part0";
+      Directory(dummyName).create();
+      // Convert the files together; the MSs are concatenated physically
+      // and virtually.
+      const String physName = msName + "_phys";
+      const String virtName = msName + "_virt";
+      {
+        MSFitsIDI msfitsidi(fitsNames, physName, True);
+        msfitsidi.fillMS();
+      }
+      {
+        MSFitsIDI msfitsidi(fitsNames, virtName, True, 0, True);
+        msfitsidi.fillMS();
+      }
+      AlwaysAssertExit (File(dummyName).isDirectory());
+      // No temporary parts must be left.
+      AlwaysAssertExit (countFiles (Path(physName).baseName() + "_parts")
+                        == 0);
+      AlwaysAssertExit (countFiles (Path(virtName).baseName() + "_parts")
+                        == 0);
+      checkMain (physName);
+      checkConcat (physName, partNames);
+      checkMain (virtName);
+      checkConcat (virtName, partNames);
+    }
+  } catch (AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -27,16 +27,110 @@
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/ms/MSOper/MSConcat.h>
 #include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
 #include <casacore/msfits/MSFits/MSFitsInput.h>
+#include <casacore/msfits/MSFits/MSFitsOutput.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Inputs.h>
 
 #include <casacore/casa/namespace.h>
 
+// Check that the main tables of two MSs created from the same FITS file
+// (with different chunk sizes) are equal. Also check that the first
+// flag category contains the flags.
+void compareMS (const String& msName1, const String& msName2)
+{
+  MeasurementSet ms1(msName1);
+  MeasurementSet ms2(msName2);
+  AlwaysAssertExit (ms1.nrow() == ms2.nrow());
+  ROMSColumns c1(ms1);
+  ROMSColumns c2(ms2);
+  AlwaysAssertExit (allEQ (c1.time().getColumn(), c2.time().getColumn()));
+  AlwaysAssertExit (allEQ (c1.interval().getColumn(),
+                           c2.interval().getColumn()));
+  AlwaysAssertExit (allEQ (c1.antenna1().getColumn(),
+                           c2.antenna1().getColumn()));
+  AlwaysAssertExit (allEQ (c1.antenna2().getColumn(),
+                           c2.antenna2().getColumn()));
+  AlwaysAssertExit (allEQ (c1.dataDescId().getColumn(),
+                           c2.dataDescId().getColumn()));
+  AlwaysAssertExit (allEQ (c1.fieldId().getColumn(),
+                           c2.fieldId().getColumn()));
+  AlwaysAssertExit (allEQ (c1.scanNumber().getColumn(),
+                           c2.scanNumber().getColumn()));
+  AlwaysAssertExit (allEQ (c1.flagRow().getColumn(),
+                           c2.flagRow().getColumn()));
+  AlwaysAssertExit (allEQ (c1.uvw().getColumn(), c2.uvw().getColumn()));
+  AlwaysAssertExit (allEQ (c1.data().getColumn(), c2.data().getColumn()));
+  AlwaysAssertExit (allEQ (c1.weight().getColumn(), c2.weight().getColumn()));
+  AlwaysAssertExit (allEQ (c1.sigma().getColumn(), c2.sigma().getColumn()));
+  AlwaysAssertExit (allEQ (c1.weightSpectrum().getColumn(),
+                           c2.weightSpectrum().getColumn()));
+  Array<Bool> flags = c2.flag().getColumn();
+  AlwaysAssertExit (allEQ (c1.flag().getColumn(), flags));
+  Array<Bool> flagCat = c2.flagCategory().getColumn();
+  AlwaysAssertExit (allEQ (c1.flagCategory().getColumn(), flagCat));
+  IPosition shp = flagCat.shape();
+  AlwaysAssertExit (shp.nelements() == 4);
+  AlwaysAssertExit (allEQ (flagCat(IPosition(4,0),
+                                   IPosition(4, shp[0]-1, shp[1]-1,
+                                             0, shp[3]-1)),
+                           flags.reform(IPosition(4,shp[0],shp[1],1,shp[3]))));
+  if (shp[2] > 1) {
+    AlwaysAssertExit (allEQ (flagCat(IPosition(4,0,0,1,0), shp-1), False));
+  }
+}
+
+// Write the MS as UVFITS, read it back into another MS and check that
+// the main table is the same. UVW and TIME are stored as floats in
+// UVFITS, so they are compared with a tolerance.
+void roundTrip (const String& msName)
+{
+  const String fitsName = msName + "_rt.fits";
+  const String msRTName = msName + "_rt";
+  MeasurementSet ms(msName);
+  Int nchan = ROMSColumns(ms).data().shape(0)[1];
+  AlwaysAssertExit (MSFitsOutput::writeFitsFile (fitsName, ms, "DATA",
+                                                 0, nchan));
+  {
+    MSFitsInput msfitsin(msRTName, fitsName);
+    msfitsin.readFitsFile();
+  }
+  // Sort both tables in the same way, because the UVFITS writer can
+  // change the row order.
+  Block<String> sortKeys(4);
+  sortKeys[0] = "TIME";
+  sortKeys[1] = "ANTENNA1";
+  sortKeys[2] = "ANTENNA2";
+  sortKeys[3] = "DATA_DESC_ID";
+  Table t1 = ms.sort (sortKeys);
+  Table t2 = Table(msRTName).sort (sortKeys);
+  AlwaysAssertExit (t1.nrow() == t2.nrow());
+  MeasurementSet ms1(t1);
+  MeasurementSet ms2(t2);
+  ROMSColumns c1(ms1);
+  ROMSColumns c2(ms2);
+  AlwaysAssertExit (allEQ (c1.antenna1().getColumn(),
+                           c2.antenna1().getColumn()));
+  AlwaysAssertExit (allEQ (c1.antenna2().getColumn(),
+                           c2.antenna2().getColumn()));
+  AlwaysAssertExit (allEQ (c1.dataDescId().getColumn(),
+                           c2.dataDescId().getColumn()));
+  AlwaysAssertExit (allNearAbs (c1.time().getColumn(),
+                                c2.time().getColumn(), 0.1));
+  AlwaysAssertExit (allNearAbs (c1.uvw().getColumn(),
+                                c2.uvw().getColumn(), 0.01));
+  AlwaysAssertExit (allEQ (c1.data().getColumn(), c2.data().getColumn()));
+  AlwaysAssertExit (allEQ (c1.flag().getColumn(), c2.flag().getColumn()));
+}
+
 int main(int argc, const char* argv[])
 {
   try {
@@ -55,8 +149,20 @@ int main(int argc, const char* argv[])
       }
       cout << "Converting FITS file called " << fitsName 
 	   << " to and MS called " << msName << endl;
-      MSFitsInput msfitsin(msName, fitsName);
-      msfitsin.readFitsFile();
+      {
+        MSFitsInput msfitsin(msName, fitsName);
+        msfitsin.readFitsFile();
+      }
+      // Convert again using chunks of a single group, so the main table
+      // is filled in many parts. The result must be the same.
+      const String msChunkName = msName + "_chunk";
+      {
+        MSFitsInput msfitsin(msChunkName, fitsName);
+        msfitsin.setChunkSize (1);
+        msfitsin.readFitsFile();
+      }
+      compareMS (msName, msChunkName);
+      roundTrip (msName);
     }
   }
   catch (AipsError x) {
@@ -100,6 +100,12 @@ namespace casacore { namespace python {
     return d;
   }
 
+  template <>
+  object makePyArrayObjectShared (casacore::Array<String> const& arr)
+  {
+    return makePyArrayObject (arr);
+  }
+
 
   // Instantiate the templates.
   template boost::python::object makePyArrayObject
@@ -125,4 +131,27 @@ namespace casacore { namespace python {
   template boost::python::object makePyArrayObject
     (casacore::Array<DComplex> const& arr);
 
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Bool> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uChar> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Short> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uShort> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Int> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uInt> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Int64> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Float> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Double> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Complex> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<DComplex> const& arr);
+
 }}
@@ -90,12 +90,29 @@ namespace casacore { namespace python {
   boost::python::object makePyArrayObject (casacore::Array<String> const& arr);
   // </group>
 
+  // Make a PyArrayObject referencing the Array data instead of copying it,
+  // which is only done if the Array is the sole owner of its data.
+  // It should only be used for an Array that is not changed anymore
+  // (e.g. a temporary one); in practice it is used for the arrays in a
+  // ValueHolder returned by a function like TableProxy::getColumn.
+  // Strings are always copied.
+  // <group>
+  template <typename T>
+  boost::python::object makePyArrayObjectShared
+    (casacore::Array<T> const& arr);
+  template <>
+  boost::python::object makePyArrayObjectShared
+    (casacore::Array<String> const& arr);
+  // </group>
+
   // Convert Array to Python.
   template <typename T>
   struct casa_array_to_python
   {
     static boost::python::object makeobject (Array<T> const& arr)
       { return makePyArrayObject (arr); }
+    static boost::python::object makeobjectShared (Array<T> const& arr)
+      { return makePyArrayObjectShared (arr); }
     static PyObject* convert (Array<T> const& c)
       { return boost::python::incref(makeobject(c).ptr()); }
   };
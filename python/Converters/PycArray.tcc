@@ -40,6 +40,13 @@ namespace casacore { namespace python {
     return numpy::makePyArrayObject (arr);
   }
 
+  template <typename T>
+  boost::python::object makePyArrayObjectShared
+    (casacore::Array<T> const& arr)
+  {
+    return numpy::makePyArrayObjectShared (arr);
+  }
+
 }}
 
 #endif
@@ -85,4 +85,16 @@
   template <typename T>
   boost::python::object makePyArrayObject (casacore::Array<T> const& arr);
 
+  // Convert a Casacore array to a Python array object without copying
+  // the data if possible. That is done if the Array is the sole owner of
+  // its contiguous data (thus no other Array references it) and if the
+  // element sizes are the same. The Python
+  // array then references the data and keeps it alive; it is deleted when
+  // the Python array is deleted. Otherwise the data are copied.
+  // Note that the Array must not be changed after this call, because
+  // the Python array would see that change.
+  template <typename T>
+  boost::python::object makePyArrayObjectShared
+    (casacore::Array<T> const& arr);
+
 
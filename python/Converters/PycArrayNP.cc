@@ -316,6 +316,72 @@ namespace casacore { namespace python { namespace numpy {
     return boost::python::object(boost::python::handle<>((PyObject*)po));
   }
 
+  // Delete the Array kept alive by a Python array using its data.
+  template <typename T>
+  void deleteSharedArray (PyObject* capsule)
+  {
+    delete static_cast<casacore::Array<T>*>(PyCapsule_GetPointer(capsule, 0));
+  }
+
+  template <typename T>
+  boost::python::object makePyArrayObjectShared
+    (casacore::Array<T> const& arr)
+  {
+    if (sizeof(T) != sizeof(typename TypeConvTraits<T>::python_type)
+	||  arr.size() == 0  ||  !arr.contiguousStorage()
+	||  !arr.ownsData()  ||  arr.nrefs() != 1) {
+      return makePyArrayObject (arr);
+    }
+    if (!PyArray_API) loadAPI();
+    // Swap axes, because Casacore has row minor and Python row major order.
+    int nd = arr.ndim();
+    vector<npy_intp> newshp(nd);
+    const IPosition& shp = arr.shape();
+    for (int i=0; i<nd; i++) {
+      newshp[i] = shp[nd-i-1];
+    }
+    // Keep the data alive by referencing it in an Array owned by a capsule
+    // which becomes the base object of the Python array.
+    casacore::Array<T>* keep = new casacore::Array<T>(arr);
+    PyObject* capsule = PyCapsule_New (keep, 0, &deleteSharedArray<T>);
+    if (capsule == 0) {
+      delete keep;
+      boost::python::throw_error_already_set();
+    }
+    PyObject* po = PyArray_SimpleNewFromData
+      (nd, &(newshp[0]), TypeConvTraits<T>::pyType(), keep->data());
+    if (po == 0) {
+      Py_DECREF (capsule);
+      boost::python::throw_error_already_set();
+    }
+    // This steals the reference to the capsule.
+    PyArray_SetBaseObject ((PyArrayObject*)po, capsule);
+    return boost::python::object(boost::python::handle<>(po));
+  }
+
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Bool> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uChar> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Short> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uShort> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Int> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<uInt> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Int64> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Float> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Double> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<Complex> const& arr);
+  template boost::python::object makePyArrayObjectShared
+    (casacore::Array<DComplex> const& arr);
+
 
 }}}
 
@@ -34,6 +34,19 @@
 
 namespace casacore { namespace python {
 
+  // Convert an array in a ValueHolder to Python.
+  // The data are only handed over to Python without copying if nothing
+  // else references them, otherwise changes made in Python would be
+  // visible in C++ objects (such as a Record field).
+  template<typename T>
+  boost::python::object arrayToPython (ValueHolder const& vh)
+  {
+    if (vh.hasUniqueArray<T>()) {
+      return casa_array_to_python<T>::makeobjectShared (vh.asArrayRef<T>());
+    }
+    return casa_array_to_python<T>::makeobject (vh.asArrayRef<T>());
+  }
+
   boost::python::object casa_value_to_python::makeobject
   (ValueHolder const& vh)
   {
@@ -61,25 +74,25 @@ namespace casacore { namespace python {
     case TpString:
       return boost::python::object((std::string const&)(vh.asString()));
     case TpArrayBool:
-      return casa_array_to_python<Bool>::makeobject (vh.asArrayBool());
+      return arrayToPython<Bool> (vh);
     case TpArrayUChar:
       return casa_array_to_python<uChar>::makeobject (vh.asArrayuChar());
     case TpArrayShort:
       return casa_array_to_python<Short>::makeobject (vh.asArrayShort());
     case TpArrayInt:
-      return casa_array_to_python<Int>::makeobject (vh.asArrayInt());
+      return arrayToPython<Int> (vh);
     case TpArrayUInt:
-      return casa_array_to_python<uInt>::makeobject (vh.asArrayuInt());
+      return arrayToPython<uInt> (vh);
     case TpArrayInt64:
-      return casa_array_to_python<Int64>::makeobject (vh.asArrayInt64());
+      return arrayToPython<Int64> (vh);
     case TpArrayFloat:
-      return casa_array_to_python<Float>::makeobject (vh.asArrayFloat());
+      return arrayToPython<Float> (vh);
     case TpArrayDouble:
-      return casa_array_to_python<Double>::makeobject (vh.asArrayDouble());
+      return arrayToPython<Double> (vh);
     case TpArrayComplex:
-      return casa_array_to_python<Complex>::makeobject (vh.asArrayComplex());
+      return arrayToPython<Complex> (vh);
     case TpArrayDComplex:
-      return casa_array_to_python<DComplex>::makeobject (vh.asArrayDComplex());
+      return arrayToPython<DComplex> (vh);
     case TpArrayString:
       return casa_array_to_python<String>::makeobject (vh.asArrayString());
     case TpRecord:
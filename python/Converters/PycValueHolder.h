@@ -50,6 +50,10 @@ namespace casacore { namespace python {
   // <synopsis>
   // </synopsis>
 
+  // Convert a ValueHolder to a Python object.
+  // An array is handed over to Python without copying its data if the
+  // ValueHolder is the sole owner of the data. That is usually the case
+  // for arrays read from a table (e.g. by TableProxy::getColumn).
   struct casa_value_to_python
   {
     static boost::python::object makeobject (ValueHolder const&);
@@ -31,6 +31,7 @@
 #include <casacore/python/Converters/PycRecord.h>
 #include <casacore/python/Converters/PycArray.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/BasicSL/STLIO.h>
 
 #include <boost/python.hpp>
@@ -83,6 +84,10 @@ namespace casacore { namespace python {
       {cout << "vecvh " << in.size() << endl; return in;}
     IPosition testipos (const IPosition& in)
       {cout << "IPos " << in << endl; return in;}
+    // Return an array owned by the ValueHolder only, so its data are
+    // handed over to Python without a copy.
+    ValueHolder testvhshared (Int n)
+      {Array<Int> arr(IPosition(2,3,n)); indgen(arr); return ValueHolder(arr);}
   };
 
 
@@ -109,6 +114,7 @@ namespace casacore { namespace python {
       .def ("teststdvecvecuint", &TConvert::teststdvecvecuint)
       .def ("teststdvecvh"  , &TConvert::teststdvecvh)
       .def ("testipos",       &TConvert::testipos)
+      .def ("testvhshared",   &TConvert::testvhshared)
       ;
   }
 
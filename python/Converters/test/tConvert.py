@@ -100,6 +100,13 @@ def dotest(t):
     print '>>>'
     print a
     print '<<<'
+
+    # Test an array handed over without a copy.
+    print t.testvhshared (4);
+    a = t.testvhshared (2);
+    print a.flags.owndata, a.shape, a.sum();
+    a[1,2] = 20;
+    print a;
     print 'end dotest'
     print ''
 
@@ -250,6 +250,35 @@ protected:
 	);
 	// </group>
 
+	// <group>
+	// Accumulate the statistics of a dataset which is accessed via pointers by
+	// splitting it into contiguous chunks that are accumulated independently, in
+	// parallel if OpenMP is enabled, and merging the per-chunk results afterwards.
+	// Unweighted, unmasked, unit stride data without ranges are accumulated in blocks
+	// by loops the compiler can vectorize. Null <src>weightsBegin</src>,
+	// <src>maskBegin</src> and <src>ranges</src> indicate that no weights, mask, or
+	// ranges apply. Nothing is done and False is returned if the dataset is too small
+	// to benefit or if the iterators are not pointers, in which case the caller should
+	// accumulate the data element by element.
+	// The chunked path is only taken by the <src>_unweightedStats</src> and
+	// <src>_weightedStats</src> functions of this class. Derived classes overriding
+	// them (ConstrainedRangeStatistics and FitToHalfStatistics) accumulate their
+	// data element by element.
+	template <class DataType, class MaskType>
+	Bool _accumulateChunks(
+		uInt64& ngood, AccumType& mymin, AccumType& mymax, Int64& minpos, Int64& maxpos,
+		const DataType* dataBegin, const DataType* weightsBegin, Int64 nr, uInt dataStride,
+		const MaskType* maskBegin, uInt maskStride, const DataRanges* ranges, Bool isInclude
+	);
+
+	template <class DataIterator, class MaskIter>
+	Bool _accumulateChunks(
+		uInt64&, AccumType&, AccumType&, Int64&, Int64&,
+		const DataIterator&, const DataIterator&, Int64, uInt,
+		const MaskIter&, uInt, const DataRanges*, Bool
+	) { return False; }
+	// </group>
+
 	void _addData();
 
 	void _clearData();
@@ -669,6 +698,26 @@ private:
 		const vector<typename StatisticsUtilities<AccumType>::BinDesc>& binDesc
 	);
 
+	// accumulate elements [start, end) of a dataset into <src>stats</src>, which should be
+	// initialized on entry. The extrema and their locations, if requested, are stored in
+	// <src>stats</src> as well.
+	template <class DataType, class MaskType>
+	static void _accumulateChunk(
+		StatsData<AccumType>& stats, uInt64& ngood, const DataType* dataBegin,
+		const DataType* weightsBegin, Int64 start, Int64 end, uInt dataStride,
+		const MaskType* maskBegin, uInt maskStride, const DataRanges* ranges,
+		Bool isInclude, Bool doMaxMin
+	);
+
+	// blocked accumulation of unweighted, unmasked, unit stride data for which all
+	// elements are good. The moments of each block are computed using two passes over
+	// the (cache resident) block, without loop carried divisions, and then merged.
+	template <class DataType>
+	static void _accumulateContiguous(
+		StatsData<AccumType>& stats, const DataType* dataBegin, Int64 start,
+		Int64 end, Bool doMaxMin
+	);
+
 	// convert in place by taking the absolute value of the difference of the vector and the median
 	static void _convertToAbsDevMedArray(vector<AccumType>& myArray, AccumType median);
 
@@ -33,6 +33,9 @@
 #include <casacore/scimath/Mathematics/StatisticsUtilities.h>
 
 #include <iomanip>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
 
 namespace casacore {
 
@@ -753,11 +756,251 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_accumulate(
 	else {
 		StatisticsUtilities<AccumType>::waccumulate (
 			_statsData.npts, _statsData.sumweights, _statsData.sum, _statsData.mean,
-			_statsData.nvariance, _statsData.sumsq, weight, datum
+			_statsData.nvariance, _statsData.sumsq, datum, weight
 		);
 	}
 }
 
+template <class AccumType, class InputIterator, class MaskIterator>
+template <class DataType, class MaskType>
+Bool ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_accumulateChunks(
+	uInt64& ngood, AccumType& mymin, AccumType& mymax, Int64& minpos, Int64& maxpos,
+	const DataType* dataBegin, const DataType* weightsBegin, Int64 nr, uInt dataStride,
+	const MaskType* maskBegin, uInt maskStride, const DataRanges* ranges, Bool isInclude
+) {
+	// below this size the overhead of chunking outweighs the gain
+	const Int64 minChunkSize = 65536;
+	if (nr < minChunkSize) {
+		return False;
+	}
+	Int nchunks = 1;
+#ifdef _OPENMP
+	nchunks = std::max(Int64(1), std::min(Int64(omp_get_max_threads()), nr/minChunkSize));
+#endif
+	vector<StatsData<AccumType> > chunkStats(nchunks, initializeStatsData<AccumType>());
+	vector<uInt64> chunkNGood(nchunks, 0);
+	Int64 step = nr/nchunks;
+	Bool doMaxMin = _doMaxMin;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nchunks)
+#endif
+	for (Int i=0; i<nchunks; ++i) {
+		Int64 start = i*step;
+		Int64 end = i == nchunks - 1 ? nr : start + step;
+		_accumulateChunk(
+			chunkStats[i], chunkNGood[i], dataBegin, weightsBegin, start, end,
+			dataStride, maskBegin, maskStride, ranges, isInclude, doMaxMin
+		);
+	}
+	// merge in chunk order, so that the first occurrence of an extremum is
+	// retained, as in the serial case
+	for (Int i=0; i<nchunks; ++i) {
+		const StatsData<AccumType>& cs = chunkStats[i];
+		if (cs.npts == 0) {
+			continue;
+		}
+		if (doMaxMin) {
+			Bool isFirst = _statsData.npts == 0;
+			StatisticsUtilities<AccumType>::doMax(
+				mymax, maxpos, isFirst, *cs.max, cs.maxpos.second
+			);
+			StatisticsUtilities<AccumType>::doMin(
+				mymin, minpos, isFirst, *cs.min, cs.minpos.second
+			);
+		}
+		StatisticsUtilities<AccumType>::mergeResults(_statsData, cs);
+		ngood += chunkNGood[i];
+	}
+	return True;
+}
+
+template <class AccumType, class InputIterator, class MaskIterator>
+template <class DataType, class MaskType>
+void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_accumulateChunk(
+	StatsData<AccumType>& stats, uInt64& ngood, const DataType* dataBegin,
+	const DataType* weightsBegin, Int64 start, Int64 end, uInt dataStride,
+	const MaskType* maskBegin, uInt maskStride, const DataRanges* ranges,
+	Bool isInclude, Bool doMaxMin
+) {
+	if (! weightsBegin && ! maskBegin && ! ranges && dataStride == 1) {
+		_accumulateContiguous(stats, dataBegin, start, end, doMaxMin);
+		ngood += end - start;
+		return;
+	}
+	stats.weighted = weightsBegin != NULL;
+	stats.masked = maskBegin != NULL;
+	const DataType* datum = dataBegin + start*dataStride;
+	const DataType* weight = weightsBegin ? weightsBegin + start*dataStride : NULL;
+	const MaskType* mask = maskBegin ? maskBegin + start*maskStride : NULL;
+	typename DataRanges::const_iterator beginRange, endRange;
+	if (ranges) {
+		beginRange = ranges->begin();
+		endRange = ranges->end();
+	}
+	AccumType mymin = 0;
+	AccumType mymax = 0;
+	Int64 minpos = -1;
+	Int64 maxpos = -1;
+	for (Int64 count=start; count<end; ++count) {
+		if (
+			(! mask || *mask) && (! weight || *weight > 0)
+			&& (
+				! ranges || StatisticsUtilities<AccumType>::includeDatum(
+					*datum, beginRange, endRange, isInclude
+				)
+			)
+		) {
+			if (weight) {
+				if (doMaxMin) {
+					StatisticsUtilities<AccumType>::waccumulate (
+						stats.npts, stats.sumweights, stats.sum, stats.mean,
+						stats.nvariance, stats.sumsq, mymin, mymax, minpos,
+						maxpos, *datum, *weight, count
+					);
+				}
+				else {
+					StatisticsUtilities<AccumType>::waccumulate (
+						stats.npts, stats.sumweights, stats.sum, stats.mean,
+						stats.nvariance, stats.sumsq, *datum, *weight
+					);
+				}
+			}
+			else {
+				if (doMaxMin) {
+					StatisticsUtilities<AccumType>::accumulate (
+						stats.npts, stats.sum, stats.mean, stats.nvariance,
+						stats.sumsq, mymin, mymax, minpos, maxpos, *datum, count
+					);
+				}
+				else {
+					StatisticsUtilities<AccumType>::accumulate (
+						stats.npts, stats.sum, stats.mean, stats.nvariance,
+						stats.sumsq, *datum
+					);
+				}
+				++ngood;
+			}
+		}
+		datum += dataStride;
+		if (weight) {
+			weight += dataStride;
+		}
+		if (mask) {
+			mask += maskStride;
+		}
+	}
+	if (doMaxMin && stats.npts > 0) {
+		stats.max = new AccumType(mymax);
+		stats.maxpos.second = maxpos;
+		stats.min = new AccumType(mymin);
+		stats.minpos.second = minpos;
+	}
+}
+
+template <class AccumType, class InputIterator, class MaskIterator>
+template <class DataType>
+void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_accumulateContiguous(
+	StatsData<AccumType>& stats, const DataType* dataBegin, Int64 start,
+	Int64 end, Bool doMaxMin
+) {
+	// small enough for a block to remain in L1 cache between passes
+	const Int64 blockSize = 1024;
+	AccumType zero = 0;
+	AccumType mymin = 0;
+	AccumType mymax = 0;
+	Int64 minpos = -1;
+	Int64 maxpos = -1;
+	for (Int64 bstart=start; bstart<end; bstart+=blockSize) {
+		const DataType* block = dataBegin + bstart;
+		Int64 n = std::min(blockSize, end - bstart);
+		// independent partial sums break the loop carried dependency
+		// so that the loops can be unrolled and vectorized
+		AccumType s0 = zero, s1 = zero, s2 = zero, s3 = zero;
+		AccumType q0 = zero, q1 = zero, q2 = zero, q3 = zero;
+		Int64 i = 0;
+		for (; i+4<=n; i+=4) {
+			AccumType x0 = block[i];
+			AccumType x1 = block[i+1];
+			AccumType x2 = block[i+2];
+			AccumType x3 = block[i+3];
+			s0 += x0;
+			s1 += x1;
+			s2 += x2;
+			s3 += x3;
+			q0 += x0*x0;
+			q1 += x1*x1;
+			q2 += x2*x2;
+			q3 += x3*x3;
+		}
+		for (; i<n; ++i) {
+			AccumType x = block[i];
+			s0 += x;
+			q0 += x*x;
+		}
+		StatsData<AccumType> bstats = initializeStatsData<AccumType>();
+		bstats.npts = n;
+		bstats.sum = (s0 + s1) + (s2 + s3);
+		bstats.sumsq = (q0 + q1) + (q2 + q3);
+		bstats.mean = bstats.sum/AccumType(n);
+		AccumType v0 = zero, v1 = zero, v2 = zero, v3 = zero;
+		const AccumType& mean = bstats.mean;
+		for (i=0; i+4<=n; i+=4) {
+			AccumType d0 = AccumType(block[i]) - mean;
+			AccumType d1 = AccumType(block[i+1]) - mean;
+			AccumType d2 = AccumType(block[i+2]) - mean;
+			AccumType d3 = AccumType(block[i+3]) - mean;
+			v0 += d0*d0;
+			v1 += d1*d1;
+			v2 += d2*d2;
+			v3 += d3*d3;
+		}
+		for (; i<n; ++i) {
+			AccumType d = AccumType(block[i]) - mean;
+			v0 += d*d;
+		}
+		bstats.nvariance = (v0 + v1) + (v2 + v3);
+		if (doMaxMin) {
+			AccumType bmin = block[0];
+			AccumType bmax = bmin;
+			for (i=1; i<n; ++i) {
+				AccumType x = block[i];
+				bmin = x < bmin ? x : bmin;
+				bmax = x > bmax ? x : bmax;
+			}
+			// only locate the extrema if they improve on the current ones,
+			// which is rare after the first few blocks
+			Bool isFirst = stats.npts == 0;
+			if (isFirst || bmax > mymax) {
+				mymax = bmax;
+				maxpos = bstart;
+				for (i=0; i<n; ++i) {
+					if (AccumType(block[i]) == bmax) {
+						maxpos = bstart + i;
+						break;
+					}
+				}
+			}
+			if (isFirst || bmin < mymin) {
+				mymin = bmin;
+				minpos = bstart;
+				for (i=0; i<n; ++i) {
+					if (AccumType(block[i]) == bmin) {
+						minpos = bstart + i;
+						break;
+					}
+				}
+			}
+		}
+		StatisticsUtilities<AccumType>::mergeResults(stats, bstats);
+	}
+	if (doMaxMin && stats.npts > 0) {
+		stats.max = new AccumType(mymax);
+		stats.maxpos.second = maxpos;
+		stats.min = new AccumType(mymin);
+		stats.minpos.second = minpos;
+	}
+}
+
 template <class AccumType, class InputIterator, class MaskIterator>
 vector<vector<uInt64> > ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_binCounts(
 	vector<CountedPtr<AccumType> >& sameVal,
@@ -2955,6 +3198,14 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_unweightedSta
 	const InputIterator& dataBegin, Int64 nr, uInt dataStride
 
 ) {
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, InputIterator(),
+			nr, dataStride, MaskIterator(), 1, NULL, True
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	Int64 count = 0;
 	Bool unityStride = dataStride == 1;
@@ -2976,6 +3227,14 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_unweightedSta
 	const InputIterator& dataBegin, Int64 nr, uInt dataStride,
 	const DataRanges& ranges, Bool isInclude
 ) {
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, InputIterator(),
+			nr, dataStride, MaskIterator(), 1, &ranges, isInclude
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	Int64 count = 0;
 	Bool unityStride = dataStride == 1;
@@ -3005,6 +3264,14 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_unweightedSta
 	const InputIterator& dataBegin, Int64 nr, uInt dataStride,
 	const MaskIterator& maskBegin, uInt maskStride
 ) {
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, InputIterator(),
+			nr, dataStride, maskBegin, maskStride, NULL, True
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	MaskIterator mask = maskBegin;
 	Int64 count = 0;
@@ -3031,6 +3298,14 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_unweightedSta
 	Bool isInclude
 
 ) {
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, InputIterator(),
+			nr, dataStride, maskBegin, maskStride, &ranges, isInclude
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	MaskIterator mask = maskBegin;
 	Int64 count = 0;
@@ -3141,6 +3416,15 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_weightedStats
 	const InputIterator& dataBegin, const InputIterator& weightsBegin,
 	Int64 nr, uInt dataStride
 ) {
+	uInt64 ngood = 0;
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, weightsBegin,
+			nr, dataStride, MaskIterator(), 1, NULL, True
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	InputIterator weight = weightsBegin;
 	Int64 count = 0;
@@ -3164,6 +3448,15 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_weightedStats
 	const InputIterator& dataBegin, const InputIterator& weightsBegin,
 	Int64 nr, uInt dataStride, const DataRanges& ranges, Bool isInclude
 ) {
+	uInt64 ngood = 0;
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, weightsBegin,
+			nr, dataStride, MaskIterator(), 1, &ranges, isInclude
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	InputIterator weight = weightsBegin;
 	Int64 count = 0;
@@ -3195,6 +3488,15 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_weightedStats
 	Int64 nr, uInt dataStride, const MaskIterator& maskBegin, uInt maskStride,
 	const DataRanges& ranges, Bool isInclude
 ) {
+	uInt64 ngood = 0;
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, weightsBegin,
+			nr, dataStride, maskBegin, maskStride, &ranges, isInclude
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	InputIterator weight = weightsBegin;
 	MaskIterator mask = maskBegin;
@@ -3226,6 +3528,15 @@ void ClassicalStatistics<AccumType, InputIterator, MaskIterator>::_weightedStats
 	const InputIterator& dataBegin, const InputIterator& weightBegin,
 	Int64 nr, uInt dataStride, const MaskIterator& maskBegin, uInt maskStride
 ) {
+	uInt64 ngood = 0;
+	if (
+		_accumulateChunks(
+			ngood, mymin, mymax, minpos, maxpos, dataBegin, weightBegin,
+			nr, dataStride, maskBegin, maskStride, NULL, True
+		)
+	) {
+		return;
+	}
 	InputIterator datum = dataBegin;
 	InputIterator weight = weightBegin;
 	MaskIterator mask = maskBegin;
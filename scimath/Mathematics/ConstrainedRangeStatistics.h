@@ -506,6 +506,9 @@ protected:
 	virtual void _setRange() = 0;
 
 	// <group>
+	// These functions override the ClassicalStatistics ones to apply the range
+	// constraint. They accumulate element by element, thus do not use the chunked
+	// (parallel) accumulation of ClassicalStatistics.
 	// no weights, no mask, no ranges
 	void _unweightedStats(
 		uInt64& ngood, AccumType& mymin, AccumType& mymax,
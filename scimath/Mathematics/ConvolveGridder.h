@@ -31,7 +31,9 @@
 
 #include <casacore/casa/aips.h>
 #include <casacore/scimath/Mathematics/Gridder.h>
+#include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Containers/Block.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -59,6 +61,32 @@ public:
 		      const Vector<Domain>& position,
 		      Range& value);
 
+  // Grid or degrid many positions at once. The positions are given in a
+  // Matrix with shape <src>(ndim, npos)</src>. The grid locations and the
+  // convolution function offsets of all positions are calculated first,
+  // after which the convolution is done by C++ loops over the support
+  // with the first axis innermost.
+  // <br>If <src>parallel=True</src> and OpenMP is used, gridding is
+  // parallelized by dividing the grid into bands along its last axis.
+  // Each thread adds all positions to its own band, so no locks or
+  // temporary grids are needed and the result is the same as for serial
+  // gridding. Degridding is parallelized over the positions.
+  // <br>Positions off the grid are skipped; the functions return the number
+  // of positions (de)gridded. <src>degridMany</src> sets <src>ok</src>
+  // for each position; the value of an off-grid position is set to 0.
+  // An exception is thrown if the array shape differs from the gridder
+  // shape or if the number of positions and values differ.
+  // <group>
+  uInt gridMany(Array<Range>& gridded,
+		const Matrix<Domain>& positions,
+		const Vector<Range>& values,
+		Bool parallel=True);
+  uInt degridMany(const Array<Range>& gridded,
+		  const Matrix<Domain>& positions,
+		  Vector<Range>& values, Vector<Bool>& ok,
+		  Bool parallel=True);
+  // </group>
+
   Vector<Double>& cFunction();
 
   Vector<Int>& cSupport();
@@ -69,6 +97,21 @@ protected:
   virtual Range correctionFactor1D(Int loc, Int len);
 
 private:
+  // Calculate the grid location and convolution function offset of
+  // each position. The offset vector is subtracted from the locations
+  // if <src>subtractOffset=True</src>. The locations of a position are
+  // only valid if the position is on the grid.
+  // It returns the number of positions on the grid.
+  uInt makeOffsets(Block<Int>& locs, Block<Int>& offs, Block<Bool>& valid,
+		   const Matrix<Domain>& positions, Bool subtractOffset);
+
+  // Fill the convolution weights for the given offset and return their sum.
+  Double fillWeights(Double* weights, Int off) const;
+
+  // Check the arguments of the batch functions.
+  void checkMany(const IPosition& gridShape, const Matrix<Domain>& positions,
+		 uInt nvalues, const String& func) const;
+
   Vector<Double> convFunc;
   Vector<Int> supportVec;
   Vector<Int> loc;
@@ -91,6 +134,7 @@ protected:
   using Gridder<Domain,Range>::offsetVec;
   using Gridder<Domain,Range>::centerVec;
   using Gridder<Domain,Range>::fillCorrectionVectors;
+  using Gridder<Domain,Range>::nint;
 };
 
 } //# NAMESPACE CASACORE - END
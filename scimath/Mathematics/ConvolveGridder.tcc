@@ -30,10 +30,19 @@
 #define SCIMATH_CONVOLVEGRIDDER_TCC
 
 #include <casacore/scimath/Mathematics/ConvolveGridder.h>
+#include <casacore/scimath/Mathematics/NumericTraits.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -381,6 +390,240 @@ Bool ConvolveGridder<Domain, Range>::degrid(const Array<Range> &gridded,
   }
 }
 
+template <class Domain, class Range>
+void ConvolveGridder<Domain, Range>::checkMany(const IPosition& gridShape,
+					      const Matrix<Domain>& positions,
+					      uInt nvalues,
+					      const String& func) const
+{
+  if (ndim < 1  ||  ndim > 3) {
+    throw AipsError("ConvolveGridder::" + func +
+		    ": only 1, 2 or 3 dimensions are supported");
+  }
+  if (! gridShape.isEqual(shape)) {
+    ostringstream ostr;
+    ostr << "ConvolveGridder::" << func << ": array shape " << gridShape
+	 << " differs from gridder shape " << shape;
+    throw AipsError(ostr.str());
+  }
+  if (positions.nrow() != uInt(ndim)  ||  positions.ncolumn() != nvalues) {
+    ostringstream ostr;
+    ostr << "ConvolveGridder::" << func << ": positions shape "
+	 << positions.shape() << " mismatches dimensionality " << ndim
+	 << " or number of values " << nvalues;
+    throw AipsError(ostr.str());
+  }
+}
+
+template <class Domain, class Range>
+uInt ConvolveGridder<Domain, Range>::makeOffsets(Block<Int>& locs,
+						 Block<Int>& offs,
+						 Block<Bool>& valid,
+						 const Matrix<Domain>& positions,
+						 Bool subtractOffset)
+{
+  const uInt npos = positions.ncolumn();
+  locs.resize(npos*ndim, False, False);
+  offs.resize(npos*ndim, False, False);
+  valid.resize(npos, False, False);
+  Bool deletePos;
+  const Domain* pos = positions.getStorage(deletePos);
+  uInt nvalid = 0;
+  for (uInt k=0; k<npos; ++k) {
+    Bool ok = True;
+    for (Int axis=0; axis<ndim; ++axis) {
+      // Same arithmetic as location() and position().
+      Domain gpos = scale(axis)*pos[k*ndim+axis] + offset(axis);
+      Int l = nint(gpos);
+      offs[k*ndim+axis] = nint((Double(nint(gpos)) - gpos) * sampling);
+      if (subtractOffset) {
+	l -= offsetVec(axis);
+      }
+      locs[k*ndim+axis] = l;
+      if (l-support < 0  ||  l+support >= shapeVec(axis)) {
+	ok = False;
+      }
+    }
+    valid[k] = ok;
+    if (ok) {
+      nvalid++;
+    }
+  }
+  positions.freeStorage(pos, deletePos);
+  return nvalid;
+}
+
+template <class Domain, class Range>
+Double ConvolveGridder<Domain, Range>::fillWeights(Double* weights,
+						   Int off) const
+{
+  const Double* cf = convFunc.data();
+  Double sum = 0;
+  for (Int i=-support; i<=support; ++i) {
+    Double w = cf[abs(sampling*i + off)];
+    weights[i+support] = w;
+    sum += w;
+  }
+  return sum;
+}
+
+template <class Domain, class Range>
+uInt ConvolveGridder<Domain, Range>::gridMany(Array<Range>& gridded,
+					      const Matrix<Domain>& positions,
+					      const Vector<Range>& values,
+					      Bool parallel)
+{
+  typedef typename NumericTraits<Range>::BaseType Weight;
+  checkMany(gridded.shape(), positions, values.nelements(), "gridMany");
+  Block<Int> locs, offs;
+  Block<Bool> valid;
+  uInt nvalid = makeOffsets(locs, offs, valid, positions, True);
+  if (nvalid == 0) {
+    return 0;
+  }
+  const Int npos = values.nelements();
+  const Int nw = 2*support + 1;
+  // Treat the grid as 3-dim; the extra axes have length 1.
+  Int nx = shape(0);
+  Int ny = (ndim > 1 ? shape(1) : 1);
+  // The bands are taken along the last axis; 1-dim grids are not split.
+  const Int bandAxis = ndim - 1;
+  const Int bandLength = (ndim > 1 ? shape(bandAxis) : 1);
+  Bool deleteGrid, deleteVal;
+  Range* grid = gridded.getStorage(deleteGrid);
+  const Range* val = values.getStorage(deleteVal);
+#ifdef _OPENMP
+#pragma omp parallel if (parallel && ndim > 1 && nvalid >= 1024)
+#endif
+  {
+    Int nbands = 1;
+    Int band = 0;
+#ifdef _OPENMP
+    nbands = omp_get_num_threads();
+    band = omp_get_thread_num();
+#endif
+    const Int bandStart = Int64(bandLength) * band / nbands;
+    const Int bandEnd = Int64(bandLength) * (band+1) / nbands;
+    // Weights per axis; unused axes have a single weight 1.
+    std::vector<Double> weights(3*nw, 1.);
+    Double* wts[3] = {&weights[0], &weights[nw], &weights[2*nw]};
+    for (Int k=0; k<npos; ++k) {
+      if (! valid[k]) {
+	continue;
+      }
+      const Int* loc = &locs[k*ndim];
+      const Int* off = &offs[k*ndim];
+      Int start[3] = {0, 0, 0};
+      Int end[3] = {1, 1, 1};
+      for (Int axis=0; axis<ndim; ++axis) {
+	start[axis] = loc[axis] - support;
+	end[axis] = loc[axis] + support + 1;
+      }
+      if (ndim > 1) {
+	start[bandAxis] = std::max(start[bandAxis], bandStart);
+	end[bandAxis] = std::min(end[bandAxis], bandEnd);
+	if (start[bandAxis] >= end[bandAxis]) {
+	  continue;
+	}
+      }
+      Double norm = 1;
+      for (Int axis=0; axis<ndim; ++axis) {
+	norm *= fillWeights(wts[axis], off[axis]);
+      }
+      // Index of the weights of the first pixel handled on each axis.
+      const Int wstart1 = (ndim > 1 ? start[1] - (loc[1] - support) : 0);
+      const Int wstart2 = (ndim > 2 ? start[2] - (loc[2] - support) : 0);
+      const Double* wx = wts[0];
+      const Range value = val[k];
+      for (Int iz=start[2]; iz<end[2]; ++iz) {
+	Double wz = wts[2][wstart2 + iz - start[2]] / norm;
+	for (Int iy=start[1]; iy<end[1]; ++iy) {
+	  Range factor = value * Weight(wts[1][wstart1 + iy - start[1]] * wz);
+	  Range* row = grid + start[0] + nx*(iy + ny*iz);
+	  for (Int ix=0; ix<nw; ++ix) {
+	    row[ix] += factor * Weight(wx[ix]);
+	  }
+	}
+      }
+    }
+  }
+  values.freeStorage(val, deleteVal);
+  gridded.putStorage(grid, deleteGrid);
+  return nvalid;
+}
+
+template <class Domain, class Range>
+uInt ConvolveGridder<Domain, Range>::degridMany(const Array<Range>& gridded,
+						const Matrix<Domain>& positions,
+						Vector<Range>& values,
+						Vector<Bool>& ok,
+						Bool parallel)
+{
+  typedef typename NumericTraits<Range>::BaseType Weight;
+  checkMany(gridded.shape(), positions, positions.ncolumn(), "degridMany");
+  const Int npos = positions.ncolumn();
+  values.resize(npos);
+  ok.resize(npos);
+  Block<Int> locs, offs;
+  Block<Bool> valid;
+  uInt nvalid = makeOffsets(locs, offs, valid, positions, False);
+  const Int nw = 2*support + 1;
+  Int nx = shape(0);
+  Int ny = (ndim > 1 ? shape(1) : 1);
+  Int nwy = (ndim > 1 ? nw : 1);
+  Int nwz = (ndim > 2 ? nw : 1);
+  Bool deleteGrid, deleteVal, deleteOK;
+  const Range* grid = gridded.getStorage(deleteGrid);
+  Range* val = values.getStorage(deleteVal);
+  Bool* okp = ok.getStorage(deleteOK);
+#ifdef _OPENMP
+#pragma omp parallel if (parallel && npos >= 1024)
+#endif
+  {
+    std::vector<Double> weights(3*nw, 1.);
+    Double* wts[3] = {&weights[0], &weights[nw], &weights[2*nw]};
+#ifdef _OPENMP
+#pragma omp for
+#endif
+    for (Int k=0; k<npos; ++k) {
+      okp[k] = valid[k];
+      if (! valid[k]) {
+	val[k] = Range(0);
+	continue;
+      }
+      const Int* loc = &locs[k*ndim];
+      const Int* off = &offs[k*ndim];
+      Int start[3] = {0, 0, 0};
+      for (Int axis=0; axis<ndim; ++axis) {
+	start[axis] = loc[axis] - support;
+      }
+      Double norm = 1;
+      for (Int axis=0; axis<ndim; ++axis) {
+	norm *= fillWeights(wts[axis], off[axis]);
+      }
+      const Double* wx = wts[0];
+      Range sum(0);
+      for (Int iz=0; iz<nwz; ++iz) {
+	for (Int iy=0; iy<nwy; ++iy) {
+	  const Double wyz = wts[1][iy] * wts[2][iz];
+	  const Range* row = grid + start[0] +
+	                     nx*(start[1] + iy + ny*(start[2] + iz));
+	  Range rowSum(0);
+	  for (Int ix=0; ix<nw; ++ix) {
+	    rowSum += row[ix] * Weight(wx[ix]);
+	  }
+	  sum += rowSum * Weight(wyz);
+	}
+      }
+      val[k] = sum / Weight(norm);
+    }
+  }
+  ok.putStorage(okp, deleteOK);
+  values.putStorage(val, deleteVal);
+  gridded.freeStorage(grid, deleteGrid);
+  return nvalid;
+}
+
 template <class Domain, class Range>
 Range ConvolveGridder<Domain, Range>::correctionFactor1D(Int loc, Int len)
 {
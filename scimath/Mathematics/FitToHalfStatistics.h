@@ -158,6 +158,10 @@ protected:
 	inline const StatsData<AccumType>& _getStatsData() const { return _statsData; }
 
 	// <group>
+	// These functions override the ClassicalStatistics ones to accumulate the
+	// real and the virtual (reflected) part of the distribution. They accumulate
+	// element by element, thus do not use the chunked (parallel) accumulation
+	// of ClassicalStatistics.
 	// no weights, no mask, no ranges
 	void _unweightedStats(
 		uInt64& ngood, AccumType& mymin, AccumType& mymax,
@@ -35,7 +35,9 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-Interpolate2D::Interpolate2D(Interpolate2D::Method method) {
+Interpolate2D::Interpolate2D(Interpolate2D::Method method)
+: itsMethod (method)
+{
 
 // Set up function pointers to correct method
 
@@ -59,7 +61,8 @@ Interpolate2D::Interpolate2D(Interpolate2D::Method method) {
 }
 
 Interpolate2D::Interpolate2D(const Interpolate2D &other)
-: itsFuncPtrFloat (other.itsFuncPtrFloat),
+: itsMethod       (other.itsMethod),
+  itsFuncPtrFloat (other.itsFuncPtrFloat),
   itsFuncPtrDouble(other.itsFuncPtrDouble),
   itsFuncPtrBool  (other.itsFuncPtrBool)
 {}
@@ -69,6 +72,7 @@ Interpolate2D::~Interpolate2D()
 
 Interpolate2D &Interpolate2D::operator=(const Interpolate2D &other)
 {
+   itsMethod        = other.itsMethod;
    itsFuncPtrFloat  = other.itsFuncPtrFloat;
    itsFuncPtrDouble = other.itsFuncPtrDouble;
    itsFuncPtrBool   = other.itsFuncPtrBool;
@@ -129,6 +133,44 @@ Bool Interpolate2D::interp(Double &resultI, Double &resultJ,
 
 
 
+// Batch versions
+
+uInt Interpolate2D::interpMany(Vector<Float> &result, Vector<Bool> &ok,
+                               const Vector<Double> &x,
+                               const Vector<Double> &y,
+                               const Matrix<Float> &data,
+                               Bool parallel) const {
+  return interpManyData(result, ok, x, y, data, 0, parallel);
+}
+
+uInt Interpolate2D::interpMany(Vector<Float> &result, Vector<Bool> &ok,
+                               const Vector<Double> &x,
+                               const Vector<Double> &y,
+                               const Matrix<Float> &data,
+                               const Matrix<Bool> &mask,
+                               Bool parallel) const {
+  return interpManyData(result, ok, x, y, data, &mask, parallel);
+}
+
+uInt Interpolate2D::interpMany(Vector<Double> &result, Vector<Bool> &ok,
+                               const Vector<Double> &x,
+                               const Vector<Double> &y,
+                               const Matrix<Double> &data,
+                               Bool parallel) const {
+  return interpManyData(result, ok, x, y, data, 0, parallel);
+}
+
+uInt Interpolate2D::interpMany(Vector<Double> &result, Vector<Bool> &ok,
+                               const Vector<Double> &x,
+                               const Vector<Double> &y,
+                               const Matrix<Double> &data,
+                               const Matrix<Bool> &mask,
+                               Bool parallel) const {
+  return interpManyData(result, ok, x, y, data, &mask, parallel);
+}
+
+
+
 // Bool versions
 
 
@@ -245,7 +287,8 @@ void Interpolate2D::bcucof (Double c[4][4], const Double y[4],
     {0,0,0,0,0,0,0,0,2,-2,0,0,1,1,0,0},
     {-6,6,-6,6,-3,-3,3,3,-4,4,2,-2,-2,-2,-1,-1},
     {4,-4,4,-4,2,2,-2,-2,2,-2,-2,2,1,1,1,1} };
-  static Double X[16], CL[16];
+  // Scratch arrays are local, so interpolation can be done in parallel.
+  Double X[16], CL[16];
   
   // Pack temporary
   for (uInt i=0; i<4; ++i) {
@@ -177,6 +177,42 @@ class Interpolate2D {
                 const Matrix<Bool> &data) const;
   // </group>
   
+  // Do many interpolations in one call, supply Matrix, optionally a mask
+  // (True is good), and the pixel coordinates of the points in the vectors
+  // <src>x</src> and <src>y</src> (which must have the same length).
+  // <src>result</src> and <src>ok</src> are resized to that length;
+  // <src>ok[k]</src> is False if point k is out of range or its data are
+  // masked (its result is then undefined). The number of points
+  // interpolated successfully is returned.
+  // <br>The results are the same as those of <src>interp</src>, except
+  // for LANCZOS with a mask near the edges. There <src>interp</src> tests
+  // mask elements outside the matrix, while <src>interpMany</src> only
+  // tests the elements of the kernel support inside the matrix.
+  // <br>The loop over the points is instantiated per interpolation method,
+  // so the method dispatch and the Matrix indexing are taken out of the
+  // inner loop. If <src>parallel</src> is True and casacore is built with
+  // OpenMP, large batches are divided over multiple threads.
+  // <group>
+  uInt interpMany (Vector<Float> &result, Vector<Bool> &ok,
+                   const Vector<Double> &x, const Vector<Double> &y,
+                   const Matrix<Float> &data,
+                   Bool parallel=True) const;
+  uInt interpMany (Vector<Float> &result, Vector<Bool> &ok,
+                   const Vector<Double> &x, const Vector<Double> &y,
+                   const Matrix<Float> &data,
+                   const Matrix<Bool> &mask,
+                   Bool parallel=True) const;
+  uInt interpMany (Vector<Double> &result, Vector<Bool> &ok,
+                   const Vector<Double> &x, const Vector<Double> &y,
+                   const Matrix<Double> &data,
+                   Bool parallel=True) const;
+  uInt interpMany (Vector<Double> &result, Vector<Bool> &ok,
+                   const Vector<Double> &x, const Vector<Double> &y,
+                   const Matrix<Double> &data,
+                   const Matrix<Bool> &mask,
+                   Bool parallel=True) const;
+  // </group>
+
   // Recover interpolation method
   Method interpolationMethod() const {return itsMethod;}
   
@@ -227,6 +263,28 @@ class Interpolate2D {
   template <typename T>
   T L(const T x, const Int a) const;
 
+  // Batch interpolation; the data and mask (if any) are contiguous copies.
+  template <typename T>
+  uInt interpManyData(Vector<T> &result, Vector<Bool> &ok,
+                      const Vector<Double> &x, const Vector<Double> &y,
+                      const Matrix<T> &data, const Matrix<Bool>* maskPtr,
+                      Bool parallel) const;
+
+  // Batch interpolation for the given method.
+  template <typename T, Int METHOD>
+  uInt interpManyMethod(T* result, Bool* ok,
+                        const Double* x, const Double* y, Int npoints,
+                        const T* data, const Bool* mask,
+                        Int nx, Int ny, Bool parallel) const;
+
+  // Interpolate a single point of a batch for the given method.
+  // <src>data</src> and <src>mask</src> (if not null) point to
+  // contiguous matrices of shape [nx,ny].
+  template <typename T, Int METHOD>
+  Bool interpPoint(T &result, Double x, Double y,
+                   const T* data, const Bool* mask,
+                   Int nx, Int ny) const;
+
   // helping routine from numerical recipes
   void bcucof (Double c[4][4], const Double y[4],
 	       const Double y1[4], 
@@ -32,6 +32,14 @@
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -251,6 +259,195 @@ Bool Interpolate2D::interpCubic(T &result,
    return True;
 }
 
+template <typename T>
+uInt Interpolate2D::interpManyData(Vector<T> &result, Vector<Bool> &ok,
+				   const Vector<Double> &x,
+				   const Vector<Double> &y,
+				   const Matrix<T> &data,
+				   const Matrix<Bool>* maskPtr,
+				   Bool parallel) const {
+  AlwaysAssert (x.nelements() == y.nelements(), AipsError);
+  const Int npoints = x.nelements();
+  result.resize (npoints);
+  ok.resize (npoints);
+  if (npoints == 0) {
+    return 0;
+  }
+  // getStorage gives contiguous arrays (copies if needed).
+  Bool deleteData, deleteMask, deleteX, deleteY, deleteRes, deleteOK;
+  const T* dataPtr = data.getStorage (deleteData);
+  const Bool* mask = 0;
+  if (maskPtr) {
+    mask = maskPtr->getStorage (deleteMask);
+  }
+  const Double* xPtr = x.getStorage (deleteX);
+  const Double* yPtr = y.getStorage (deleteY);
+  T* resPtr = result.getStorage (deleteRes);
+  Bool* okPtr = ok.getStorage (deleteOK);
+  const Int nx = data.nrow();
+  const Int ny = data.ncolumn();
+  uInt nOK;
+  switch (itsMethod) {
+  case NEAREST:
+    nOK = interpManyMethod<T,NEAREST> (resPtr, okPtr, xPtr, yPtr, npoints,
+				       dataPtr, mask, nx, ny, parallel);
+    break;
+  case LINEAR:
+    nOK = interpManyMethod<T,LINEAR> (resPtr, okPtr, xPtr, yPtr, npoints,
+				      dataPtr, mask, nx, ny, parallel);
+    break;
+  case CUBIC:
+    nOK = interpManyMethod<T,CUBIC> (resPtr, okPtr, xPtr, yPtr, npoints,
+				     dataPtr, mask, nx, ny, parallel);
+    break;
+  default:
+    nOK = interpManyMethod<T,LANCZOS> (resPtr, okPtr, xPtr, yPtr, npoints,
+				       dataPtr, mask, nx, ny, parallel);
+    break;
+  }
+  data.freeStorage (dataPtr, deleteData);
+  if (maskPtr) {
+    maskPtr->freeStorage (mask, deleteMask);
+  }
+  x.freeStorage (xPtr, deleteX);
+  y.freeStorage (yPtr, deleteY);
+  result.putStorage (resPtr, deleteRes);
+  ok.putStorage (okPtr, deleteOK);
+  return nOK;
+}
+
+template <typename T, Int METHOD>
+uInt Interpolate2D::interpManyMethod(T* result, Bool* ok,
+				     const Double* x, const Double* y,
+				     Int npoints,
+				     const T* data, const Bool* mask,
+				     Int nx, Int ny, Bool parallel) const {
+  uInt nOK = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:nOK) if (parallel && npoints >= 1024)
+#endif
+  for (Int k=0; k<npoints; ++k) {
+    ok[k] = interpPoint<T,METHOD> (result[k], x[k], y[k], data, mask,
+				   nx, ny);
+    if (ok[k]) ++nOK;
+  }
+  return nOK;
+}
+
+template <typename T, Int METHOD>
+Bool Interpolate2D::interpPoint(T &result, Double x, Double y,
+				const T* data, const Bool* mask,
+				Int nx, Int ny) const {
+  // The same algorithms as in interpNearest, etc. are used, but with
+  // the method known at compile time and direct indexing of the data.
+  if (METHOD == NEAREST) {
+    static const Double half= .5001;
+    Double imax = nx - 1.;
+    if (x < 0. - half || x > imax + half || imax < 0) return False;
+    Double jmax = ny - 1.;
+    if (y < 0. - half || y > jmax + half || jmax < 0) return False;
+    Int i = (x <= 0.) ? 0 : (x >= imax) ? Int(imax) : Int(x + .5);
+    Int j = (y <= 0.) ? 0 : (y >= jmax) ? Int(jmax) : Int(y + .5);
+    const Int off = i + j*nx;
+    if (mask && !mask[off]) return False;
+    result = data[off];
+    return True;
+  }
+  if (METHOD == LINEAR  ||  METHOD == CUBIC) {
+    Int i = Int(x);
+    Int j = Int(y);
+    if (METHOD == CUBIC  &&  i > 0  &&  i < nx-2  &&  j > 0  &&  j < ny-2) {
+      // Bi-cubic using the 4x4 grid [i-1,j-1] -> [i+2,j+2].
+      const T* d = data + i + j*nx;
+      if (mask) {
+	const Bool* m = mask + (i-1) + (j-1)*nx;
+	for (Int jj=0; jj<4; ++jj, m+=nx) {
+	  if (!m[0] || !m[1] || !m[2] || !m[3]) return False;
+	}
+      }
+      const Int n = nx;
+      Double yv[4], y1[4], y2[4], y12[4];
+      yv[0] = d[0];
+      yv[1] = d[1];
+      yv[2] = d[1+n];
+      yv[3] = d[n];
+      y1[0] = (d[1]     - d[-1]) / 2.0;
+      y1[1] = (d[2]     - d[0]) / 2.0;
+      y1[2] = (d[2+n]   - d[n]) / 2.0;
+      y1[3] = (d[1+n]   - d[-1+n]) / 2.0;
+      y2[0] = (d[n]     - d[-n]) / 2.0;
+      y2[1] = (d[1+n]   - d[1-n]) / 2.0;
+      y2[2] = (d[1+2*n] - d[1]) / 2.0;
+      y2[3] = (d[2*n]   - d[0]) / 2.0;
+      y12[0] = (d[1+n] + d[-1-n] - d[-1+n] - d[1-n]) / 4.0;
+      y12[1] = (d[2+n] + d[-n] - d[n] - d[2-n]) / 4.0;
+      y12[2] = (d[2+2*n] + d[0] - d[2*n] - d[2]) / 4.0;
+      y12[3] = (d[1+2*n] + d[-1] - d[-1+2*n] - d[1]) / 4.0;
+      Double c[4][4];
+      bcucof(c, yv, y1, y2, y12);
+      const Double TT = x - i;
+      const Double UU = y - j;
+      Double res = 0.0;
+      for (Int k=3; k>=0; --k) {
+	res = TT*res + ((c[k][3]*UU + c[k][2])*UU + c[k][1])*UU + c[k][0];
+      }
+      result = res;
+      return True;
+    }
+    // Bi-linear (also used by cubic at the edges).
+    // Negative and too large indices fail the tests.
+    if (i == nx-1) --i;
+    if (j == ny-1) --j;
+    if (i < 0  ||  j < 0  ||  i >= nx-1  ||  j >= ny-1) return False;
+    const Int off = i + j*nx;
+    if (mask) {
+      if (!mask[off] || !mask[off+1] || !mask[off+nx] || !mask[off+nx+1]) {
+	return False;
+      }
+    }
+    const Double TT = x - i;
+    const Double UU = y - j;
+    result = (1.0-TT)*(1.0-UU)*data[off] +
+      TT*(1.0-UU)*data[off+1] +
+      TT*UU*data[off+nx+1] +
+      (1.0-TT)*UU*data[off+nx];
+    return True;
+  }
+  // Lanczos with a hardcoded kernel size.
+  const Int a = 3;
+  const Double floorx = floor(x);
+  const Double floory = floor(y);
+  // Unlike interpLanczos, only the mask elements inside the matrix
+  // are tested.
+  if (mask) {
+    const Int i1 = max(0, Int(x-a+1));
+    const Int i2 = min(nx-1, Int(x+a));
+    const Int j1 = max(0, Int(y-a+1));
+    const Int j2 = min(ny-1, Int(y+a));
+    for (Int j=j1; j<=j2; ++j) {
+      for (Int i=i1; i<=i2; ++i) {
+	if (!mask[i + j*nx]) return False;
+      }
+    }
+  }
+  // Near the edge the result is set to zero (as in interpLanczos).
+  if (floorx < a || floorx >= nx - a || floory < a || floory >= ny - a) {
+    result = 0;
+    return True;
+  }
+  Double res = 0;
+  const Int i0 = Int(floorx);
+  const Int j0 = Int(floory);
+  for (Int i = i0 - a + 1; i <= i0 + a; ++i) {
+    const Double li = L(x - i, a);
+    for (Int j = j0 - a + 1; j <= j0 + a; ++j) {
+      res += data[i + j*nx] * li * L(y - j, a);
+    }
+  }
+  result = res;
+  return True;
+}
+
 template <typename T>
 Bool Interpolate2D::interpLanczos(T &result, 
         const Vector<Double> &where, 
@@ -178,6 +178,16 @@ public:
 	);
 
 	// </group>
+
+	// Merge the moments (npts, sum, sumsq, mean, nvariance and, if <src>other.weighted</src>
+	// is True, sumweights) of <src>other</src>, which were accumulated independently from a
+	// disjoint subset of the data, into <src>stats</src> using the pairwise update formulae of
+	// Chan, Golub and LeVeque (1979). The extrema and their positions are not merged; callers
+	// must handle those themselves.
+	inline static void mergeResults(
+		StatsData<AccumType>& stats, const StatsData<AccumType>& other
+	);
+
 	// This does the obvious conversions. The Complex and DComplex versions
 	// (implemented after the class definition) are used solely to permit compilation. In general, these versions should
 	// never actually be called
@@ -234,6 +234,35 @@ void StatisticsUtilities<AccumType>::waccumulateSym (
 	_MAXMINSYM
 }
 
+template <class AccumType>
+void StatisticsUtilities<AccumType>::mergeResults(
+	StatsData<AccumType>& stats, const StatsData<AccumType>& other
+) {
+	if (other.npts == 0) {
+		return;
+	}
+	// for unweighted accumulations, sumweights is not updated, so npts
+	// serves as the weight of each subset
+	AccumType wa = other.weighted ? stats.sumweights : AccumType(stats.npts);
+	AccumType wb = other.weighted ? other.sumweights : AccumType(other.npts);
+	if (stats.npts == 0) {
+		stats.mean = other.mean;
+		stats.nvariance = other.nvariance;
+	}
+	else {
+		AccumType wtot = wa + wb;
+		AccumType delta = other.mean - stats.mean;
+		stats.mean += delta*wb/wtot;
+		stats.nvariance += other.nvariance + delta*delta*wa*wb/wtot;
+	}
+	stats.npts += other.npts;
+	stats.sum += other.sum;
+	stats.sumsq += other.sumsq;
+	if (other.weighted) {
+		stats.sumweights += other.sumweights;
+	}
+}
+
 template <class AccumType>
 Bool StatisticsUtilities<AccumType>::includeDatum(
     const AccumType& datum, typename DataRanges::const_iterator beginRange,
@@ -1312,6 +1312,76 @@ int main() {
     		AlwaysAssert(quantileToValue[0.25] == -10, AipsError);
     		AlwaysAssert(quantileToValue[0.75] == 30, AipsError);
     	}
+    	{
+    		// large datasets accessed via pointers use the chunked accumulation,
+    		// compare with the element by element accumulation via iterators
+    		uInt n = 200003;
+    		vector<Float> big(n);
+    		vector<Float> wts(n);
+    		vector<Bool> mask(n);
+    		for (uInt i=0; i<n; ++i) {
+    			big[i] = Float((i*7919) % 10007) - 5000.5;
+    			wts[i] = Float(i % 5);
+    			mask[i] = i % 3 != 0;
+    		}
+    		Bool *bmask = new Bool[n];
+    		std::copy(mask.begin(), mask.end(), bmask);
+    		std::vector<std::pair<Double, Double> > ranges(1);
+    		ranges[0].first = -3000;
+    		ranges[0].second = 4000;
+    		for (uInt j=0; j<8; ++j) {
+    			Bool useWeights = j & 1;
+    			Bool useMask = j & 2;
+    			Bool useRanges = j & 4;
+    			ClassicalStatistics<Double, vector<Float>::const_iterator, vector<Bool>::const_iterator> cs1;
+    			ClassicalStatistics<Double, const Float*, const Bool*> cs2;
+    			if (useWeights && useMask && useRanges) {
+    				cs1.setData(big.begin(), wts.begin(), mask.begin(), n, ranges, True, 2, False, 2);
+    				cs2.setData(&big[0], &wts[0], bmask, n, ranges, True, 2, False, 2);
+    			}
+    			else if (useWeights && useMask) {
+    				cs1.setData(big.begin(), wts.begin(), mask.begin(), n);
+    				cs2.setData(&big[0], &wts[0], bmask, n);
+    			}
+    			else if (useWeights && useRanges) {
+    				cs1.setData(big.begin(), wts.begin(), n, ranges, True);
+    				cs2.setData(&big[0], &wts[0], n, ranges, True);
+    			}
+    			else if (useWeights) {
+    				cs1.setData(big.begin(), wts.begin(), n);
+    				cs2.setData(&big[0], &wts[0], n);
+    			}
+    			else if (useMask && useRanges) {
+    				cs1.setData(big.begin(), mask.begin(), n, ranges, False);
+    				cs2.setData(&big[0], bmask, n, ranges, False);
+    			}
+    			else if (useMask) {
+    				cs1.setData(big.begin(), mask.begin(), n, 2, False, 2);
+    				cs2.setData(&big[0], bmask, n, 2, False, 2);
+    			}
+    			else if (useRanges) {
+    				cs1.setData(big.begin(), n, ranges, True);
+    				cs2.setData(&big[0], n, ranges, True);
+    			}
+    			else {
+    				cs1.setData(big.begin(), n);
+    				cs2.setData(&big[0], n);
+    			}
+    			StatsData<Double> sd1 = cs1.getStatistics();
+    			StatsData<Double> sd2 = cs2.getStatistics();
+    			AlwaysAssert(sd1.npts == sd2.npts, AipsError);
+    			AlwaysAssert(*sd1.max == *sd2.max, AipsError);
+    			AlwaysAssert(*sd1.min == *sd2.min, AipsError);
+    			AlwaysAssert(sd1.maxpos == sd2.maxpos, AipsError);
+    			AlwaysAssert(sd1.minpos == sd2.minpos, AipsError);
+    			AlwaysAssert(near(sd1.sum, sd2.sum, 1e-10), AipsError);
+    			AlwaysAssert(near(sd1.sumsq, sd2.sumsq, 1e-10), AipsError);
+    			AlwaysAssert(near(sd1.sumweights, sd2.sumweights, 1e-10), AipsError);
+    			AlwaysAssert(near(sd1.mean, sd2.mean, 1e-8), AipsError);
+    			AlwaysAssert(near(sd1.variance, sd2.variance, 1e-8), AipsError);
+    		}
+    		delete [] bmask;
+    	}
     }
 
     catch (const AipsError& x) {
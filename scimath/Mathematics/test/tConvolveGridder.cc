@@ -0,0 +1,143 @@
+//# tConvolveGridder.cc: This program tests the ConvolveGridder class
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+
+#include <casacore/casa/aips.h>
+#include <casacore/scimath/Mathematics/ConvolveGridder.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// Check that gridding and degridding of many positions at once gives
+// the same results as doing it position by position.
+template <typename T>
+void checkMany (const IPosition& shape, const String& convType,
+                Bool parallel)
+{
+  const uInt ndim = shape.nelements();
+  Vector<Double> scale(ndim, 1.);
+  Vector<Double> offset(ndim);
+  for (uInt i=0; i<ndim; ++i) {
+    offset[i] = shape[i] / 2;
+  }
+  ConvolveGridder<Double,T> gridder(shape, scale, offset, convType);
+  // Make positions covering the grid, where the last one is off the grid.
+  const uInt n = 3000;
+  Matrix<Double> pos(ndim, n);
+  Vector<T> values(n);
+  for (uInt k=0; k<n; ++k) {
+    for (uInt i=0; i<ndim; ++i) {
+      pos(i,k) = (shape[i]/2 - 4) * sin(0.37*k + 1.3*i + 0.01*k*i);
+    }
+    values[k] = T(1 + 0.001*k);
+  }
+  pos(0,n-1) = shape[0];
+  // Grid one by one and in batch.
+  Array<T> grid1(shape, T(0));
+  Array<T> grid2(shape, T(0));
+  Vector<Double> p(ndim);
+  for (uInt k=0; k<n-1; ++k) {
+    p = pos.column(k);
+    AlwaysAssertExit (gridder.grid (grid1, p, values[k]));
+  }
+  AlwaysAssertExit (gridder.gridMany (grid2, pos, values, parallel) == n-1);
+  AlwaysAssertExit (allNearAbs (grid1, grid2, 1e-4));
+  AlwaysAssertExit (! allEQ (grid2, T(0)));
+  // Degrid one by one and in batch.
+  Vector<T> res;
+  Vector<Bool> ok;
+  AlwaysAssertExit (gridder.degridMany (grid1, pos, res, ok, parallel)
+                    == n-1);
+  AlwaysAssertExit (res.nelements() == n  &&  ok.nelements() == n);
+  for (uInt k=0; k<n; ++k) {
+    p = pos.column(k);
+    T value;
+    Bool resOK = gridder.degrid (grid1, p, value);
+    AlwaysAssertExit (ok[k] == resOK);
+    AlwaysAssertExit (ok[k] == (k < n-1));
+    if (resOK) {
+      AlwaysAssertExit (nearAbs (res[k], value, 1e-4));
+    }
+  }
+}
+
+template <typename T>
+void checkAll()
+{
+  for (uInt i=0; i<2; ++i) {
+    String convType = (i==0 ? "SF" : "BOX");
+    for (uInt j=0; j<2; ++j) {
+      Bool parallel = (j==1);
+      checkMany<T> (IPosition(1,128), convType, parallel);
+      checkMany<T> (IPosition(2,64,48), convType, parallel);
+      checkMany<T> (IPosition(3,24,20,16), convType, parallel);
+    }
+  }
+}
+
+int main()
+{
+  try {
+    checkAll<Float>();
+    checkAll<Double>();
+    checkAll<Complex>();
+    // Check errors.
+    ConvolveGridder<Double,Float> gridder(IPosition(2,16,16),
+                                          Vector<Double>(2,1.),
+                                          Vector<Double>(2,8.));
+    Array<Float> grid(IPosition(2,16,8));
+    Bool failed = False;
+    try {
+      gridder.gridMany (grid, Matrix<Double>(2,1,0.), Vector<Float>(1,1.f));
+    } catch (AipsError&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+    grid.resize (IPosition(2,16,16));
+    failed = False;
+    try {
+      gridder.gridMany (grid, Matrix<Double>(2,2,0.), Vector<Float>(1,1.f));
+    } catch (AipsError&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+  } catch (AipsError& x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,143 @@
+//# tInterpolate2D.cc: This program tests the Interpolate2D class
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/casa/aips.h>
+#include <casacore/scimath/Mathematics/Interpolate2D.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// Check that the batch interpolation gives the same results as the
+// interpolation of the individual points.
+template <typename T>
+void checkMany (Interpolate2D::Method method, Bool useMask, Bool parallel)
+{
+  const uInt nx = 23;
+  const uInt ny = 17;
+  Matrix<T> data(nx, ny);
+  Matrix<Bool> mask(nx, ny);
+  for (uInt j=0; j<ny; ++j) {
+    for (uInt i=0; i<nx; ++i) {
+      data(i,j) = sin(0.3*i) * cos(0.2*j) + 0.01*i*j;
+      mask(i,j) = (i+3*j) % 11 != 0;
+    }
+  }
+  // Take positions on a grid extending beyond the matrix.
+  const uInt n = 5000;
+  Vector<Double> x(n), y(n);
+  for (uInt k=0; k<n; ++k) {
+    x[k] = -1.5 + (nx+2) * Double(k % 97) / 96;
+    y[k] = -1.5 + (ny+2) * Double(k / 97) / (n/97);
+  }
+  Interpolate2D interp(method);
+  Vector<T> result;
+  Vector<Bool> ok;
+  uInt nOK;
+  if (useMask) {
+    nOK = interp.interpMany (result, ok, x, y, data, mask, parallel);
+  } else {
+    nOK = interp.interpMany (result, ok, x, y, data, parallel);
+  }
+  AlwaysAssertExit (result.nelements() == n  &&  ok.nelements() == n);
+  Vector<Double> where(2);
+  uInt nExp = 0;
+  for (uInt k=0; k<n; ++k) {
+    where[0] = x[k];
+    where[1] = y[k];
+    T res;
+    Bool resOK;
+    if (useMask  &&  method == Interpolate2D::LANCZOS  &&
+        (x[k] < 2  ||  x[k] > nx-4  ||  y[k] < 2  ||  y[k] > ny-4)) {
+      // The mask support of Lanczos extends beyond the matrix, which
+      // interp does not check. interpMany only checks the part inside it.
+      resOK = True;
+      for (Int j=max(0, Int(y[k]-2)); j<=min(Int(ny)-1, Int(y[k]+3)); ++j) {
+        for (Int i=max(0, Int(x[k]-2)); i<=min(Int(nx)-1, Int(x[k]+3)); ++i) {
+          if (!mask(i,j)) resOK = False;
+        }
+      }
+      // Near the edge the result is zero.
+      res = 0;
+    } else if (useMask) {
+      resOK = interp.interp (res, where, data, mask);
+    } else {
+      resOK = interp.interp (res, where, data);
+    }
+    AlwaysAssertExit (ok[k] == resOK);
+    if (resOK) {
+      nExp++;
+      AlwaysAssertExit (near (result[k], res, 1e-5));
+    }
+  }
+  AlwaysAssertExit (nOK == nExp);
+}
+
+template <typename T>
+void checkAll()
+{
+  Interpolate2D::Method methods[] = {Interpolate2D::NEAREST,
+                                     Interpolate2D::LINEAR,
+                                     Interpolate2D::CUBIC,
+                                     Interpolate2D::LANCZOS};
+  for (uInt i=0; i<4; ++i) {
+    checkMany<T> (methods[i], False, False);
+    checkMany<T> (methods[i], False, True);
+    checkMany<T> (methods[i], True, True);
+  }
+}
+
+int main()
+{
+  try {
+    // Check the method is kept by copying.
+    Interpolate2D interp(Interpolate2D::CUBIC);
+    AlwaysAssertExit (interp.interpolationMethod() == Interpolate2D::CUBIC);
+    Interpolate2D interp2(interp);
+    AlwaysAssertExit (interp2.interpolationMethod() == Interpolate2D::CUBIC);
+    interp2 = Interpolate2D(Interpolate2D::NEAREST);
+    AlwaysAssertExit (interp2.interpolationMethod() == Interpolate2D::NEAREST);
+    checkAll<Float>();
+    checkAll<Double>();
+    // Empty batch.
+    Vector<Float> result;
+    Vector<Bool> ok;
+    AlwaysAssertExit (interp.interpMany (result, ok, Vector<Double>(),
+                                         Vector<Double>(),
+                                         Matrix<Float>(4,4,0.f)) == 0);
+    AlwaysAssertExit (result.nelements() == 0);
+  } catch (AipsError& x) {
+    cout << "Caught exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -43,7 +43,7 @@
          loci=abs(sampling*i+offi)
          norm=norm+convFunc(loci+1)
       end do
-      nvalue=nvalue/norm
+      nvalue=value/norm
       do i=-support,support
          loci=abs(sampling*i+offi)
          grid(i+li+1)=grid(i+li+1)+nvalue*convFunc(loci+1)
@@ -116,7 +116,7 @@
 	  do i=-support,support
 	    loci=abs(sampling*i+offi)
 	    grid(i+li+1,j+lj+1,k+lk+1)=grid(i+li+1,j+lj+1,k+lk+1)+
-     $           value*convFunc(loci+1)
+     $           nvalue*convFunc(loci+1)
 	  end do
 	end do
       end do
@@ -221,7 +221,7 @@
          loci=abs(sampling*i+offi)
          norm=norm+convFunc(loci+1)
       end do
-      nvalue=nvalue/norm
+      nvalue=value/norm
       do i=-support,support
          loci=abs(sampling*i+offi)
          grid(i+li+1)=grid(i+li+1)+nvalue*convFunc(loci+1)
@@ -294,7 +294,7 @@
 	  do i=-support,support
 	    loci=abs(sampling*i+offi)
 	    grid(i+li+1,j+lj+1,k+lk+1)=grid(i+li+1,j+lj+1,k+lk+1)+
-     $           value*convFunc(loci+1)
+     $           nvalue*convFunc(loci+1)
 	  end do
 	end do
       end do
@@ -399,7 +399,7 @@
          loci=abs(sampling*i+offi)
          norm=norm+convFunc(loci+1)
       end do
-      nvalue=nvalue/norm
+      nvalue=value/norm
       do i=-support,support
          loci=abs(sampling*i+offi)
          grid(i+li+1)=grid(i+li+1)+nvalue*convFunc(loci+1)
@@ -473,7 +473,7 @@
 	  do i=-support,support
 	    loci=abs(sampling*i+offi)
 	    grid(i+li+1,j+lj+1,k+lk+1)=grid(i+li+1,j+lj+1,k+lk+1)+
-     $           value*convFunc(loci+1)
+     $           nvalue*convFunc(loci+1)
 	  end do
 	end do
       end do
@@ -739,6 +739,18 @@ uInt TSMCube::cacheSize() const
     return cache_p->cacheSize();
 }
 
+void TSMCube::getCacheStatistics (uInt& nAccess, uInt& nRead,
+                                  uInt& nWrite) const
+{
+    if (cache_p == 0) {
+        nAccess = nRead = nWrite = 0;
+    } else {
+        nAccess = cache_p->nAccess();
+        nRead   = cache_p->nRead();
+        nWrite  = cache_p->nWrite();
+    }
+}
+
 uInt TSMCube::validateCacheSize (uInt cacheSize) const
 {
   return validateCacheSize (cacheSize, stmanPtr_p->maximumCacheSize(),
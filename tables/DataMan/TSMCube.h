@@ -230,6 +230,11 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Get the cache statistics: the number of tile accesses and the number
+    // of tiles read from and written to the file. All are 0 if no cache
+    // has been created (yet).
+    void getCacheStatistics (uInt& nAccess, uInt& nRead, uInt& nWrite) const;
+
     // Calculate the cache size (in buckets) for the given slice
     // and access path.
     // <group>
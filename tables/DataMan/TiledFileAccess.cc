@@ -35,6 +35,11 @@
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/iostream.h>
+#include <cstring>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -48,14 +53,14 @@ TiledFileAccess::TiledFileAccess (const String& fileName,
 				  Bool writable)
 : itsCube     (0),
   itsTSM      (0),
+  itsMap      (0),
+  itsMapData  (0),
+  itsSwapSize (0),
   itsWritable (writable),
   itsDataType (dataType)
 {
-  itsLocalPixelSize = ValType::getTypeSize (dataType);
-  itsTSM  = new TiledFileHelper (fileName, shape, dataType, tsmOpt,
-				 writable, HostInfo::bigEndian());
-  itsCube = itsTSM->makeTSMCube (itsTSM->file(), shape, tileShape,
-                                 Record(), fileOffset);
+  init (fileName, fileOffset, shape, tileShape, tsmOpt,
+        HostInfo::bigEndian(), False);
 }
 
 TiledFileAccess::TiledFileAccess (const String& fileName,
@@ -65,23 +70,156 @@ TiledFileAccess::TiledFileAccess (const String& fileName,
 				  DataType dataType,
                                   const TSMOption& tsmOpt,
 				  Bool writable,
-				  Bool bigEndian)
+				  Bool bigEndian,
+                                  Bool directMap)
 : itsCube     (0),
   itsTSM      (0),
+  itsMap      (0),
+  itsMapData  (0),
+  itsSwapSize (0),
   itsWritable (writable),
   itsDataType (dataType)
 {
-  itsLocalPixelSize = ValType::getTypeSize (dataType);
-  itsTSM  = new TiledFileHelper (fileName, shape, dataType, tsmOpt,
-				 writable, bigEndian);
-  itsCube = itsTSM->makeTSMCube (itsTSM->file(), shape, tileShape,
-                                 Record(), fileOffset);
+  init (fileName, fileOffset, shape, tileShape, tsmOpt, bigEndian,
+        directMap);
 }
 
 TiledFileAccess::~TiledFileAccess()
 {
   delete itsCube;
   delete itsTSM;
+  delete itsMap;
+}
+
+void TiledFileAccess::init (const String& fileName, Int64 fileOffset,
+                            const IPosition& shape,
+                            const IPosition& tileShape,
+                            const TSMOption& tsmOpt, Bool bigEndian,
+                            Bool directMap)
+{
+  itsLocalPixelSize = ValType::getTypeSize (itsDataType);
+  // Bools are stored as bits, so they cannot be mapped directly.
+  if (directMap  &&  !itsWritable  &&  itsDataType != TpBool) {
+    if (mapFile (fileName, fileOffset, shape, bigEndian)) {
+      itsShape     = shape;
+      itsTileShape = tileShape;
+      return;
+    }
+  }
+  itsTSM  = new TiledFileHelper (fileName, shape, itsDataType, tsmOpt,
+				 itsWritable, bigEndian);
+  itsCube = itsTSM->makeTSMCube (itsTSM->file(), shape, tileShape,
+                                 Record(), fileOffset);
+}
+
+Bool TiledFileAccess::mapFile (const String& fileName, Int64 fileOffset,
+                               const IPosition& shape, Bool bigEndian)
+{
+  try {
+    itsMap = new MMapIO (RegularFile(fileName), ByteIO::Old);
+  } catch (AipsError&) {
+    itsMap = 0;
+    return False;
+  }
+  // A file too short for the array is left to the tiled storage manager.
+  if (itsMap->length() < fileOffset + shape.product() * itsLocalPixelSize) {
+    delete itsMap;
+    itsMap = 0;
+    return False;
+  }
+  itsMapData = static_cast<const char*>(itsMap->getReadPointer (fileOffset));
+  // Determine the size of the values to be swapped (complex values
+  // are swapped as pairs).
+  itsSwapSize = 0;
+  if (bigEndian != HostInfo::bigEndian()) {
+    switch (itsDataType) {
+    case TpShort:
+    case TpUShort:
+      itsSwapSize = 2;
+      break;
+    case TpInt:
+    case TpUInt:
+    case TpFloat:
+    case TpComplex:
+      itsSwapSize = 4;
+      break;
+    case TpDouble:
+    case TpInt64:
+    case TpDComplex:
+      itsSwapSize = 8;
+      break;
+    default:
+      break;
+    }
+  }
+  return True;
+}
+
+void TiledFileAccess::getData (char* to, const IPosition& start,
+                               const IPosition& end, const IPosition& stride)
+{
+  if (itsMap) {
+    mapGet (to, start, end, stride);
+  } else {
+    itsCube->accessStrided (start, end, stride, to, 0,
+                            itsLocalPixelSize, itsLocalPixelSize, False);
+  }
+}
+
+void TiledFileAccess::mapGet (char* to, const IPosition& start,
+                              const IPosition& end, const IPosition& stride)
+{
+  const uInt ndim = start.nelements();
+  const size_t pixelSize = itsLocalPixelSize;
+  const size_t n0 = (end[0] - start[0]) / stride[0] + 1;
+  const size_t lineBytes = n0 * pixelSize;
+  const size_t inc0 = stride[0] * pixelSize;
+  char* data = to;
+  // Copy line by line along the first axis.
+  IPosition pos(start);
+  while (True) {
+    Int64 offset = 0;
+    Int64 step = 1;
+    for (uInt i=0; i<ndim; ++i) {
+      offset += pos[i] * step;
+      step *= itsShape[i];
+    }
+    const char* from = itsMapData + offset * pixelSize;
+    if (stride[0] == 1) {
+      memcpy (to, from, lineBytes);
+    } else {
+      for (size_t j=0; j<n0; ++j) {
+        memcpy (to + j*pixelSize, from + j*inc0, pixelSize);
+      }
+    }
+    to += lineBytes;
+    uInt ax;
+    for (ax=1; ax<ndim; ++ax) {
+      pos[ax] += stride[ax];
+      if (pos[ax] <= end[ax]) {
+        break;
+      }
+      pos[ax] = start[ax];
+    }
+    if (ax >= ndim) {
+      break;
+    }
+  }
+  // Convert all values to local format in one go.
+  const size_t nbytes = to - data;
+  switch (itsSwapSize) {
+  case 2:
+    Conversion::byteSwap2 (data, data, nbytes/2);
+    break;
+  case 4:
+    Conversion::byteSwap4 (data, data, nbytes/4);
+    break;
+  case 8:
+    Conversion::byteSwap8 (data, data, nbytes/8);
+    break;
+  default:
+    break;
+  }
 }
 
 Array<Bool> TiledFileAccess::getBool (const Slicer& section)
@@ -137,13 +275,12 @@ void TiledFileAccess::get (Array<Bool>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpBool, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Bool* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -151,13 +288,12 @@ void TiledFileAccess::get (Array<uChar>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpUChar, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   uChar* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -165,13 +301,12 @@ void TiledFileAccess::get (Array<Short>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpShort, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Short* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -179,13 +314,12 @@ void TiledFileAccess::get (Array<Int>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpInt, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Int* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -193,13 +327,12 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpFloat, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Float* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -207,13 +340,12 @@ void TiledFileAccess::get (Array<Double>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpDouble, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Double* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -221,13 +353,12 @@ void TiledFileAccess::get (Array<Complex>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpComplex, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   Complex* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
@@ -235,17 +366,37 @@ void TiledFileAccess::get (Array<DComplex>& buffer, const Slicer& section)
 {
   AlwaysAssert (itsDataType == TpDComplex, AipsError);
   IPosition start, end, stride;
-  IPosition shp = section.inferShapeFromSource (itsCube->cubeShape(),
+  IPosition shp = section.inferShapeFromSource (shape(),
 						start, end, stride);
   buffer.resize (shp);
   Bool deleteIt;
   DComplex* dataPtr = buffer.getStorage (deleteIt);
-  itsCube->accessStrided (start, end, stride, (char*)dataPtr, 0,
-  			  itsLocalPixelSize, itsLocalPixelSize, False);
+  getData ((char*)dataPtr, start, end, stride);
   buffer.putStorage (dataPtr, deleteIt);
 }
 
 
+// Scale the values and set the deleted ones to NaN.
+// The scaling loop has no branches, so the compiler can vectorize it.
+template<typename T>
+static void scaleValues (Float* to, const T* from, size_t n,
+                  Float scale, Float offset, T deleteValue,
+                  Bool examineForDeleteValues)
+{
+  for (size_t i=0; i<n; i++) {
+    to[i] = from[i] * scale + offset;
+  }
+  if (examineForDeleteValues) {
+    Float nan;
+    setNaN (nan);
+    for (size_t i=0; i<n; i++) {
+      if (from[i] == deleteValue) {
+        to[i] = nan;
+      }
+    }
+  }
+}
+
 Array<Float> TiledFileAccess::getFloat (const Slicer& section,
 					Float scale, Float offset,
 					uChar deleteValue, 
@@ -284,20 +435,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const uChar* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  scaleValues (bufPtr, arrPtr, arr.nelements(), scale, offset,
+               deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -311,20 +450,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const Short* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  scaleValues (bufPtr, arrPtr, arr.nelements(), scale, offset,
+               deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -338,20 +465,8 @@ void TiledFileAccess::get (Array<Float>& buffer, const Slicer& section,
   Bool deleteArr, deleteBuf;
   const Int* arrPtr = arr.getStorage (deleteArr);
   Float* bufPtr = buffer.getStorage (deleteBuf);
-  uInt n = arr.nelements();
-  if (examineForDeleteValues) {
-    for (uInt i=0; i<n; i++) {
-      if (arrPtr[i] == deleteValue) {
-        setNaN (bufPtr[i]);
-      } else {
-        bufPtr[i] = arrPtr[i] * scale + offset;
-      }
-    }
-  } else {
-    for (uInt i=0; i<n; i++) {
-      bufPtr[i] = arrPtr[i] * scale + offset;
-    }
-  }
+  scaleValues (bufPtr, arrPtr, arr.nelements(), scale, offset,
+               deleteValue, examineForDeleteValues);
   arr.freeStorage (arrPtr, deleteArr);
   buffer.putStorage (bufPtr, deleteBuf);
 }
@@ -481,12 +596,23 @@ void TiledFileAccess::put (const Array<DComplex>& buffer,
 
 void TiledFileAccess::setMaximumCacheSize (uInt nbytes)
 {
-  itsTSM->setMaximumCacheSize (nbytes);
+  if (itsTSM) {
+    itsTSM->setMaximumCacheSize (nbytes);
+  }
 }
 
 uInt TiledFileAccess::maximumCacheSize() const
 {
-  return itsTSM->maximumCacheSize();
+  return (itsTSM ? itsTSM->maximumCacheSize() : 0);
+}
+
+void TiledFileAccess::showCacheStatistics (ostream& os) const
+{
+  if (itsCube) {
+    itsCube->showCacheStatistics (os);
+  } else {
+    os << "TiledFileAccess: memory-mapped; no cache used" << endl;
+  }
 }
 
 IPosition TiledFileAccess::makeTileShape (const IPosition& arrayShape,
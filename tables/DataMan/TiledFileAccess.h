@@ -40,6 +40,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Forward Declarations
 class TiledFileHelper;
 class Slicer;
+class MMapIO;
 
 
 // <summary>
@@ -67,6 +68,13 @@ class Slicer;
 // <p>
 // See <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>
 // for a more detailed discussion.
+// <p>
+// A read-only array stored contiguously (like a FITS or MIRIAD image) can
+// also be accessed directly by memory-mapping the file. In that case no
+// tiled storage manager and cache are used; a slice is copied straight from
+// the mapped data and converted to local format. The tile shape is then
+// only advisory. If the file cannot be mapped (e.g. on 32-bit systems),
+// the normal tiled access is used.
 // </synopsis> 
 
 // <motivation>
@@ -104,11 +112,15 @@ public:
 
   // Create a TiledFileAccess object.
   // The endian format of the data is explicitly given.
+  // If <src>directMap=True</src> and the file is not writable, the data
+  // are read directly from a memory-mapped file (see the synopsis).
+  // If the file cannot be mapped (e.g. because it is too short for the
+  // array), the tiled storage manager is used as usual.
   TiledFileAccess (const String& fileName, Int64 fileOffset,
 		   const IPosition& shape, const IPosition& tileShape,
 		   DataType dataType,
                    const TSMOption&,
-		   Bool writable, Bool bigEndian);
+		   Bool writable, Bool bigEndian, Bool directMap=False);
 
   ~TiledFileAccess();
 
@@ -119,6 +131,10 @@ public:
   DataType dataType() const
     { return itsDataType; }
 
+  // Is the data read directly from the memory-mapped file?
+  Bool isDirectMapped() const
+    { return itsMap != 0; }
+
   // Get part of the array.
   // The Array object is resized if needed.
   // <group>
@@ -176,26 +192,25 @@ public:
 
   // Flush the cache.
   void flush()
-    { itsCube->flushCache(); }
+    { if (itsCube) itsCube->flushCache(); }
 
   // Empty the cache.
   // It will flush the cache as needed and remove all buckets from it
   // resulting in a possibly large drop in memory used.
   // It'll also clear the <src>userSetCache_p</src> flag.
   void clearCache()
-    { itsCube->emptyCache(); }
+    { if (itsCube) itsCube->emptyCache(); }
 
   // Show the cache statistics.
-  void showCacheStatistics (ostream& os) const
-    { itsCube->showCacheStatistics (os); }
+  void showCacheStatistics (ostream& os) const;
 
   // Get the shape of the array.
   const IPosition& shape() const
-    { return itsCube->cubeShape(); }
+    { return itsCube ? itsCube->cubeShape() : itsShape; }
 
   // Get the shape of the tiles.
   const IPosition& tileShape() const
-    { return itsCube->tileShape(); }
+    { return itsCube ? itsCube->tileShape() : itsTileShape; }
 
   // Set the maximum cache size (in bytes).
   // 0 means no maximum.
@@ -206,22 +221,24 @@ public:
 
   // Get the current cache size (in buckets).
   uInt cacheSize() const
-    { return itsCube->cacheSize(); }
+    { return itsCube ? itsCube->cacheSize() : 0; }
 
   // Set the cache size using the given access pattern.
   // <group>
   void setCacheSize (const IPosition& sliceShape,
 		     const IPosition& axisPath,
 		     Bool forceSmaller=True)
-    { itsCube->setCacheSize (sliceShape, IPosition(), IPosition(),
-			     axisPath, forceSmaller, True); }
+    { if (itsCube) itsCube->setCacheSize (sliceShape, IPosition(),
+                                          IPosition(), axisPath,
+                                          forceSmaller, True); }
   void setCacheSize (const IPosition& sliceShape,
 		     const IPosition& windowStart,
 		     const IPosition& windowLength,
 		     const IPosition& axisPath,
 		     Bool forceSmaller=True)
-    { itsCube->setCacheSize (sliceShape, windowStart, windowLength,
-			     axisPath, forceSmaller, True); }
+    { if (itsCube) itsCube->setCacheSize (sliceShape, windowStart,
+                                          windowLength, axisPath,
+                                          forceSmaller, True); }
   // </group>
 
   // Set the cache size for accessing the data.
@@ -230,7 +247,7 @@ public:
   // <br>When forceSmaller is False, the cache is not resized when the
   // new size is smaller.
   void setCacheSize (uInt nbuckets, Bool forceSmaller=True)
-    { itsCube->setCacheSize (nbuckets, forceSmaller, True); }
+    { if (itsCube) itsCube->setCacheSize (nbuckets, forceSmaller, True); }
 
   // Make a tile shape from the array shape to fit as closely as possible
   // the number of pixels in the tile.
@@ -245,9 +262,32 @@ private:
   TiledFileAccess& operator= (const TiledFileAccess&);
   // </group>
 
+  // Open the file using the tiled storage manager or memory-mapped.
+  void init (const String& fileName, Int64 fileOffset,
+             const IPosition& shape, const IPosition& tileShape,
+             const TSMOption& tsmOpt, Bool bigEndian, Bool directMap);
+
+  // Try to map the file. It returns False if not possible.
+  Bool mapFile (const String& fileName, Int64 fileOffset,
+                const IPosition& shape, Bool bigEndian);
+
+  // Get the data of a section from the cube or the mapped file.
+  void getData (char* to, const IPosition& start, const IPosition& end,
+                const IPosition& stride);
+
+  // Copy the data of a section from the mapped file and convert it
+  // to local format.
+  void mapGet (char* to, const IPosition& start, const IPosition& end,
+               const IPosition& stride);
+
 
   TSMCube*         itsCube;
   TiledFileHelper* itsTSM;
+  MMapIO*          itsMap;
+  const char*      itsMapData;       //# start of the array in the map
+  IPosition        itsShape;         //# shape if mapped
+  IPosition        itsTileShape;     //# advisory tile shape if mapped
+  uInt             itsSwapSize;      //# size of values to byte swap (0=none)
   uInt             itsLocalPixelSize;
   Bool             itsWritable;
   DataType         itsDataType;
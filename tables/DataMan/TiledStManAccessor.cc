@@ -187,6 +187,14 @@ void ROTiledStManAccessor::setCacheSize (uInt rownr, uInt nbuckets,
     dataManPtr_p->setCacheSize (rownr, nbuckets, forceSmaller);
 }
 
+void ROTiledStManAccessor::getCacheStatistics (uInt rownr, uInt& nAccess,
+                                               uInt& nRead,
+                                               uInt& nWrite) const
+{
+    dataManPtr_p->getHypercube(rownr)->getCacheStatistics (nAccess, nRead,
+                                                           nWrite);
+}
+
 void ROTiledStManAccessor::clearCaches()
 {
     dataManPtr_p->emptyCaches();
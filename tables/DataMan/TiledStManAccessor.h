@@ -272,6 +272,13 @@ public:
     // new size is smaller.
     void setCacheSize (uInt rownr, uInt nbuckets, Bool forceSmaller = True);
 
+    // Get the statistics of the cache of the hypercube containing the given
+    // row: the number of tile accesses and the number of tiles read from
+    // and written to disk since the cache was last cleared.
+    // The cache hit ratio is <src>1 - nRead/nAccess</src>.
+    void getCacheStatistics (uInt rownr, uInt& nAccess, uInt& nRead,
+                             uInt& nWrite) const;
+
     // Clear the caches used by the hypercubes in this storage manager.
     // It will flush the caches as needed and remove all buckets from them
     // resulting in a possibly large drop in memory used.
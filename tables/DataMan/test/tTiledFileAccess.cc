@@ -35,9 +35,11 @@
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Arrays/ArrayIO.h>
 #include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/MaskedArray.h>
 #include <casacore/casa/IO/CanonicalIO.h>
 #include <casacore/casa/IO/RawIO.h>
 #include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
@@ -255,6 +257,71 @@ int main()
     }
   }
 
+  // Test direct access of a memory-mapped file for a Short array in
+  // canonical format and a Float array in local format. Compare the
+  // results (also strided and scaled) with the tiled access.
+  {
+    IPosition shape(3,17,10,4);
+    Array<Short> arrs(shape);
+    Array<Float> arrf(shape);
+    indgen(arrs, Short(-100));
+    indgen(arrf);
+    uInt off2;
+    {
+      Bool deleteIt;
+      const Short* dataPtr = arrs.getStorage (deleteIt);
+      RegularFileIO fios(RegularFile("tTiledFileAccess_tmp.dat"), ByteIO::New);
+      CanonicalIO ios (&fios);
+      off2 = ios.write (shape.product(), dataPtr);
+      arrs.freeStorage (dataPtr, deleteIt);
+      const Float* fPtr = arrf.getStorage (deleteIt);
+      RawIO rios (&fios);
+      rios.write (shape.product(), fPtr);
+      arrf.freeStorage (fPtr, deleteIt);
+    }
+    try {
+      TiledFileAccess tfas ("tTiledFileAccess_tmp.dat", 0, shape,
+                            IPosition(3,17,10,1), TpShort,
+                            TSMOption::Cache, False, True, True);
+      TiledFileAccess tfac ("tTiledFileAccess_tmp.dat", 0, shape,
+                            IPosition(3,17,10,1), TpShort,
+                            TSMOption::Cache, False, True);
+      TiledFileAccess tfaf ("tTiledFileAccess_tmp.dat", off2, shape,
+                            IPosition(3,17,10,1), TpFloat,
+                            TSMOption::Cache, False,
+                            HostInfo::bigEndian(), True);
+      AlwaysAssertExit (tfas.isDirectMapped());
+      AlwaysAssertExit (tfaf.isDirectMapped());
+      AlwaysAssertExit (! tfac.isDirectMapped());
+      AlwaysAssertExit (tfas.shape() == shape);
+      AlwaysAssertExit (tfas.tileShape() == IPosition(3,17,10,1));
+      AlwaysAssertExit (tfas.cacheSize() == 0);
+      Slicer all (IPosition(3,0,0,0), shape);
+      Slicer sect (IPosition(3,1,2,1), IPosition(3,16,9,3),
+                   IPosition(3,3,2,2), Slicer::endIsLast);
+      AlwaysAssertExit (allEQ (arrs, tfas.getShort (all)));
+      AlwaysAssertExit (allEQ (arrf, tfaf.getFloat (all)));
+      AlwaysAssertExit (allEQ (tfac.getShort (sect), tfas.getShort (sect)));
+      AlwaysAssertExit (allEQ (arrf(sect), tfaf.getFloat (sect)));
+      Array<Float> arr1 = tfac.getFloat (sect, 2., -1., Short(105));
+      Array<Float> arr2 = tfas.getFloat (sect, 2., -1., Short(105));
+      AlwaysAssertExit (allEQ (isNaN(arr1), isNaN(arr2)));
+      AlwaysAssertExit (anyEQ (isNaN(arr2), True));
+      AlwaysAssertExit (allEQ (arr1(arr1==arr1).getCompressedArray(),
+                               arr2(arr2==arr2).getCompressedArray()));
+      // A file too short for the array is not mapped, but still usable.
+      TiledFileAccess tfal ("tTiledFileAccess_tmp.dat", off2,
+                            IPosition(3,17,10,5), IPosition(3,17,10,1),
+                            TpFloat, TSMOption::Cache, False,
+                            HostInfo::bigEndian(), True);
+      AlwaysAssertExit (! tfal.isDirectMapped());
+      AlwaysAssertExit (allEQ (arrf, tfal.getFloat (all)));
+    } catch (AipsError x) {
+      cout << "Exception: " << x.getMesg() << endl;
+      return 1;
+    }
+  }
+
   // Test the tileShape function in various ways.
   {
     try {
@@ -33,6 +33,7 @@
 #include <casacore/tables/TaQL/ExprUDFNode.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/string.h>
 #include <limits>
 
 
@@ -91,6 +92,33 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  void TableExprGroupKey::pack (std::string& buf) const
+  {
+    switch (itsDT) {
+    case TableExprNodeRep::NTBool:
+      buf.push_back (itsBool ? 1 : 0);
+      break;
+    case TableExprNodeRep::NTInt:
+      buf.append ((const char*)(&itsInt64), sizeof(Int64));
+      break;
+    case TableExprNodeRep::NTDouble:
+    case TableExprNodeRep::NTDate:
+      {
+        // Make sure -0 and +0 are the same key.
+        Double v = (itsDouble == 0  ?  0. : itsDouble);
+        buf.append ((const char*)(&v), sizeof(Double));
+      }
+      break;
+    default:
+      {
+        uInt n = itsString.size();
+        buf.append ((const char*)(&n), sizeof(uInt));
+        buf.append (itsString.data(), n);
+      }
+    }
+  }
+
+
   TableExprGroupKeySet::TableExprGroupKeySet (const vector<TableExprNode>& nodes)
   {
     itsKeys.reserve (nodes.size());
@@ -146,6 +174,105 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return false;
   }
 
+  const std::string& TableExprGroupKeySet::pack()
+  {
+    itsPacked.clear();
+    for (size_t i=0; i<itsKeys.size(); ++i) {
+      itsKeys[i].pack (itsPacked);
+    }
+    return itsPacked;
+  }
+
+
+  TableExprGroupHashMap::TableExprGroupHashMap()
+    : itsSlots   (64, -1),
+      itsOffsets (1, 0),
+      itsMask    (63)
+  {}
+
+  uInt64 TableExprGroupHashMap::hash (const void* key, uInt size)
+  {
+    // Process the key in 8-byte words using a multiply/xorshift mixer;
+    // the tail bytes are processed one by one.
+    const uInt64 mult = 0x9e3779b97f4a7c15ULL;
+    const char* ptr = static_cast<const char*>(key);
+    uInt64 h = size * mult;
+    uInt i = 0;
+    for (; i+8<=size; i+=8) {
+      uInt64 w;
+      memcpy (&w, ptr+i, 8);
+      h = (h ^ w) * mult;
+      h ^= h >> 29;
+    }
+    for (; i<size; ++i) {
+      h = (h ^ uChar(ptr[i])) * mult;
+    }
+    h ^= h >> 32;
+    return h;
+  }
+
+  uInt TableExprGroupHashMap::findSlot (const char* key, uInt size,
+                                        uInt64 hashValue) const
+  {
+    uInt64 slot = hashValue & itsMask;
+    while (True) {
+      Int entry = itsSlots[slot];
+      if (entry < 0) {
+        return slot;
+      }
+      if (itsHashes[entry] == hashValue  &&
+          itsOffsets[entry+1] - itsOffsets[entry] == size  &&
+          memcmp (itsKeys.data() + itsOffsets[entry], key, size) == 0) {
+        return slot;
+      }
+      slot = (slot+1) & itsMask;
+    }
+  }
+
+  Int TableExprGroupHashMap::find (const void* key, uInt size) const
+  {
+    uInt64 hashValue = hash (key, size);
+    Int entry = itsSlots[findSlot (static_cast<const char*>(key), size,
+                                   hashValue)];
+    return (entry < 0  ?  -1 : itsGroups[entry]);
+  }
+
+  Int TableExprGroupHashMap::findOrAdd (const void* key, uInt size,
+                                        Int groupnr)
+  {
+    const char* ckey = static_cast<const char*>(key);
+    uInt64 hashValue = hash (key, size);
+    uInt slot = findSlot (ckey, size, hashValue);
+    Int entry = itsSlots[slot];
+    if (entry >= 0) {
+      return itsGroups[entry];
+    }
+    // Add the key; keep the load factor below 0.5.
+    itsSlots[slot] = itsGroups.size();
+    itsHashes.push_back (hashValue);
+    itsGroups.push_back (groupnr);
+    itsKeys.append (ckey, size);
+    itsOffsets.push_back (itsKeys.size());
+    if (2*itsGroups.size() > itsSlots.size()) {
+      resize();
+    }
+    return groupnr;
+  }
+
+  void TableExprGroupHashMap::resize()
+  {
+    uInt nslot = 2*itsSlots.size();
+    itsSlots.assign (nslot, -1);
+    itsMask = nslot - 1;
+    for (uInt i=0; i<itsHashes.size(); ++i) {
+      uInt64 slot = itsHashes[i] & itsMask;
+      while (itsSlots[slot] >= 0) {
+        slot = (slot+1) & itsMask;
+      }
+      itsSlots[slot] = i;
+    }
+  }
+
 
   TableExprGroupResult::TableExprGroupResult
   (const vector<CountedPtr<TableExprGroupFuncSet> >& funcSets)
@@ -79,6 +79,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator<  (const TableExprGroupKey&) const;
     // </group>
 
+    // Append the key's value in binary form to the buffer.
+    // A string is preceded by its length, so the packed form of a keyset
+    // is unambiguous. A double -0 is packed as +0.
+    void pack (std::string& buf) const;
+
   private:
     TableExprNodeRep::NodeDataType itsDT;
     Bool   itsBool;
@@ -121,8 +126,69 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator== (const TableExprGroupKeySet&) const;
     bool operator<  (const TableExprGroupKeySet&) const;
 
+    // Pack the values of all keys (as set by the last <src>fill</src>)
+    // into a byte string. Equal keysets result in equal byte strings,
+    // so the result can be used in a TableExprGroupHashMap.
+    const std::string& pack();
+
   private:
     vector<TableExprGroupKey> itsKeys;
+    std::string               itsPacked;
+  };
+
+
+  // <summary>
+  // Hash map of packed keys to group numbers.
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tTableGram">
+  // </reviewed>
+  // <synopsis>
+  // This class maps a key, given as a byte string, to a group number.
+  // It is used to find the group of a table row in the GROUPBY clause
+  // and the matching row in a JOIN. Keys are usually packed by
+  // TableExprGroupKeySet::pack, but a single scalar value can also be
+  // used directly.
+  // <br>It uses open addressing with linear probing, so finding a key
+  // takes constant time on average. The packed keys are stored contiguously
+  // which avoids an allocation per key.
+  // </synopsis>
+  class TableExprGroupHashMap
+  {
+  public:
+    // Create an empty map.
+    TableExprGroupHashMap();
+
+    // Get the number of keys in the map.
+    uInt size() const
+      { return itsGroups.size(); }
+
+    // Find the group number of the given key.
+    // If not found, the key is added with the given group number.
+    // The (found or given) group number is returned.
+    Int findOrAdd (const void* key, uInt size, Int groupnr);
+
+    // Find the group number of the given key.
+    // -1 is returned if not found.
+    Int find (const void* key, uInt size) const;
+
+    // Calculate the hash value of a byte string.
+    static uInt64 hash (const void* key, uInt size);
+
+  private:
+    // Find the slot of the given key, which is the empty slot where
+    // the key should be added if not found.
+    uInt findSlot (const char* key, uInt size, uInt64 hashValue) const;
+
+    // Double the number of slots.
+    void resize();
+
+    vector<Int>    itsSlots;      //# entry number per slot (-1 is empty)
+    vector<uInt64> itsHashes;     //# hash value per entry
+    vector<uInt64> itsOffsets;    //# offset of key per entry (plus end)
+    vector<Int>    itsGroups;     //# group number per entry
+    std::string    itsKeys;       //# all keys
+    uInt64         itsMask;
   };
 
 
@@ -0,0 +1,177 @@
+//# ExprJoinNode.cc: Classes handling a JOIN in a table select expression
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+//# Includes
+#include <casacore/tables/TaQL/ExprJoinNode.h>
+#include <casacore/tables/TaQL/TableExprId.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Quanta/MVTime.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+TableExprJoin::TableExprJoin
+                   (const vector<TableExprNode>& joinKeys,
+                    const vector<TableExprNode>& mainKeys,
+                    const vector<TableExprNodeRep::NodeDataType>& keyTypes,
+                    uInt joinNrow, const String& tableName)
+  : itsMainKeys   (mainKeys),
+    itsMainKeySet (vector<TableExprNode>())
+{
+  AlwaysAssert (joinKeys.size() == keyTypes.size()  &&
+                mainKeys.size() == keyTypes.size(), AipsError);
+  TableExprGroupKeySet joinKeySet ((vector<TableExprNode>()));
+  for (uInt i=0; i<keyTypes.size(); ++i) {
+    joinKeySet.addKey (keyTypes[i]);
+    itsMainKeySet.addKey (keyTypes[i]);
+  }
+  // Put the keys of all rows of the joined table into the hash map.
+  for (uInt i=0; i<joinNrow; ++i) {
+    joinKeySet.fill (joinKeys, TableExprId(i));
+    const std::string& key = joinKeySet.pack();
+    if (itsIndex.findOrAdd (key.data(), key.size(), i) != Int(i)) {
+      throw TableInvExpr ("JOIN key in table " + tableName +
+                          " is not unique (rows " +
+                          String::toString(itsIndex.find(key.data(),
+                                                         key.size())) +
+                          " and " + String::toString(i) + ')');
+    }
+  }
+}
+
+void TableExprJoin::fill (Vector<Bool>& valid)
+{
+  itsRowMap.resize (valid.size());
+  for (uInt i=0; i<valid.size(); ++i) {
+    Int row = -1;
+    if (valid[i]) {
+      itsMainKeySet.fill (itsMainKeys, TableExprId(i));
+      const std::string& key = itsMainKeySet.pack();
+      row = itsIndex.find (key.data(), key.size());
+      if (row < 0) {
+        valid[i] = False;
+      }
+    }
+    itsRowMap[i] = row;
+  }
+}
+
+
+
+TableExprJoinNode::TableExprJoinNode (const CountedPtr<TableExprJoin>& join,
+                                      TableExprNodeRep& child,
+                                      const Table& mainTable)
+  : TableExprNodeBinary (child.dataType(), child, OtFunc),
+    itsJoin             (join),
+    itsApplySelection   (True)
+{
+  table_p    = mainTable;
+  exprtype_p = Variable;
+  lnode_p    = child.link();
+}
+
+TableExprJoinNode::~TableExprJoinNode()
+{}
+
+void TableExprJoinNode::getColumnNodes (vector<TableExprNodeRep*>& cols)
+{
+  cols.push_back (this);
+}
+
+void TableExprJoinNode::disableApplySelection()
+{
+  itsApplySelection = False;
+}
+
+void TableExprJoinNode::applySelection (const Vector<uInt>& rownrs)
+{
+  if (itsApplySelection) {
+    // Keep the main table row numbers of the selected rows.
+    if (itsRownrs.empty()) {
+      itsRownrs.resize (rownrs.size());
+      itsRownrs = rownrs;
+    } else {
+      Vector<uInt> newRows(rownrs.size());
+      for (uInt i=0; i<rownrs.size(); ++i) {
+        newRows[i] = itsRownrs[rownrs[i]];
+      }
+      itsRownrs.reference (newRows);
+    }
+    // Reset switch, because the node can be used multiple times.
+    itsApplySelection = False;
+  }
+}
+
+TableExprId TableExprJoinNode::joinId (const TableExprId& id) const
+{
+  AlwaysAssert (id.byRow(), AipsError);
+  // Without a join the node is used in the ON condition, thus evaluated
+  // for the rows in the joined table.
+  if (itsJoin.null()) {
+    return id;
+  }
+  uInt mainRow = (itsRownrs.empty()  ?  id.rownr() : itsRownrs[id.rownr()]);
+  Int row = itsJoin->joinRow (mainRow);
+  if (row < 0) {
+    throw TableInvExpr ("JOIN has no matching row for row " +
+                        String::toString(mainRow));
+  }
+  return TableExprId (row);
+}
+
+Bool TableExprJoinNode::getBool (const TableExprId& id)
+  { return lnode_p->getBool (joinId(id)); }
+Int64 TableExprJoinNode::getInt (const TableExprId& id)
+  { return lnode_p->getInt (joinId(id)); }
+Double TableExprJoinNode::getDouble (const TableExprId& id)
+  { return lnode_p->getDouble (joinId(id)); }
+DComplex TableExprJoinNode::getDComplex (const TableExprId& id)
+  { return lnode_p->getDComplex (joinId(id)); }
+String TableExprJoinNode::getString (const TableExprId& id)
+  { return lnode_p->getString (joinId(id)); }
+TaqlRegex TableExprJoinNode::getRegex (const TableExprId& id)
+  { return lnode_p->getRegex (joinId(id)); }
+MVTime TableExprJoinNode::getDate (const TableExprId& id)
+  { return lnode_p->getDate (joinId(id)); }
+Array<Bool> TableExprJoinNode::getArrayBool (const TableExprId& id)
+  { return lnode_p->getArrayBool (joinId(id)); }
+Array<Int64> TableExprJoinNode::getArrayInt (const TableExprId& id)
+  { return lnode_p->getArrayInt (joinId(id)); }
+Array<Double> TableExprJoinNode::getArrayDouble (const TableExprId& id)
+  { return lnode_p->getArrayDouble (joinId(id)); }
+Array<DComplex> TableExprJoinNode::getArrayDComplex (const TableExprId& id)
+  { return lnode_p->getArrayDComplex (joinId(id)); }
+Array<String> TableExprJoinNode::getArrayString (const TableExprId& id)
+  { return lnode_p->getArrayString (joinId(id)); }
+Array<MVTime> TableExprJoinNode::getArrayDate (const TableExprId& id)
+  { return lnode_p->getArrayDate (joinId(id)); }
+Bool TableExprJoinNode::isDefined (const TableExprId& id)
+  { return lnode_p->isDefined (joinId(id)); }
+const IPosition& TableExprJoinNode::getShape (const TableExprId& id)
+  { return lnode_p->shape (joinId(id)); }
+
+} //# NAMESPACE CASACORE - END
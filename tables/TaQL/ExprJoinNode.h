@@ -0,0 +1,194 @@
+//# ExprJoinNode.h: Classes handling a JOIN in a table select expression
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#ifndef TABLES_EXPRJOINNODE_H
+#define TABLES_EXPRJOINNODE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/CountedPtr.h>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Hash index of a JOIN in a table select expression
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTableGram">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> TableExprGroupHashMap
+// </prerequisite>
+
+// <synopsis>
+// This class executes the JOIN clause of a TaQL command as a hash join.
+// The JOIN condition consists of one or more equality comparisons,
+// each having a key expression of the joined table and a key expression
+// of the main (i.e. first) table.
+// At construction the keys of all rows in the joined table are put
+// in a hash map. Thereafter <src>fill</src> finds the matching row
+// in the joined table for each row in the main table, which takes linear
+// time in the size of both tables.
+// <br>Each row in the main table can match at most one row in the joined
+// table, thus the keys in the joined table have to be unique. It is,
+// for instance, used to join the main table of a MeasurementSet with
+// a subtable like <src>JOIN ::ANTENNA a1 ON ANTENNA1 = a1.rowid()</src>.
+// </synopsis>
+
+class TableExprJoin
+{
+public:
+  // Build the hash map for the keys of the joined table.
+  // The data type of each key is given, so the corresponding key
+  // expressions of both tables are compared using the same type.
+  // An exception is thrown if the keys in the joined table are not unique.
+  TableExprJoin (const vector<TableExprNode>& joinKeys,
+                 const vector<TableExprNode>& mainKeys,
+                 const vector<TableExprNodeRep::NodeDataType>& keyTypes,
+                 uInt joinNrow, const String& tableName);
+
+  // Find the matching joined row for the first <src>valid.size()</src>
+  // rows of the main table.
+  // No match is done for the rows having a False value in <src>valid</src>.
+  // The value is set to False for rows not matching.
+  void fill (Vector<Bool>& valid);
+
+  // Get the row in the joined table matching the given row in the main table.
+  // -1 is returned if there is no matching row.
+  Int joinRow (uInt rownr) const
+    { return itsRowMap[rownr]; }
+
+private:
+  // Forbid copy constructor and assignment.
+  // <group>
+  TableExprJoin (const TableExprJoin&);
+  TableExprJoin& operator= (const TableExprJoin&);
+  // </group>
+
+  vector<TableExprNode> itsMainKeys;
+  TableExprGroupKeySet  itsMainKeySet;
+  TableExprGroupHashMap itsIndex;
+  Vector<Int>           itsRowMap;
+};
+
+
+
+// <summary>
+// Value of an expression in the joined table
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTableGram">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> TableExprJoin
+// </prerequisite>
+
+// <synopsis>
+// This class represents a column (or other expression) of a table in a
+// JOIN clause. It is evaluated for a row in the main table by evaluating
+// its child for the matching row in the joined table.
+// <br>Like a column node, it adheres to the selection of rows in the main
+// table (see <src>applySelection</src>), so it can be used in all clauses
+// of a select command.
+// <br>In the ON condition of its JOIN the node has no TableExprJoin yet.
+// Then it is evaluated for the rows of the joined table to get the keys.
+// It still makes it possible to combine the node with expressions of the
+// main table, which could not be done if they were of different size.
+// </synopsis>
+
+class TableExprJoinNode : public TableExprNodeBinary
+{
+public:
+  // Construct for the given join and expression in the joined table.
+  // The main table is the table the node belongs to.
+  // An empty join is used for nodes in the ON condition.
+  TableExprJoinNode (const CountedPtr<TableExprJoin>& join,
+                     TableExprNodeRep& child, const Table& mainTable);
+
+  ~TableExprJoinNode();
+
+  // The node acts as a column, so it can be excluded from applySelection.
+  virtual void getColumnNodes (vector<TableExprNodeRep*>& cols);
+
+  // Do not apply the selection.
+  virtual void disableApplySelection();
+
+  // Use the row numbers in the main table for a selection of rows.
+  virtual void applySelection (const Vector<uInt>& rownrs);
+
+  // Get the value in the matching row of the joined table.
+  // <group>
+  virtual Bool     getBool     (const TableExprId& id);
+  virtual Int64    getInt      (const TableExprId& id);
+  virtual Double   getDouble   (const TableExprId& id);
+  virtual DComplex getDComplex (const TableExprId& id);
+  virtual String   getString   (const TableExprId& id);
+  virtual TaqlRegex getRegex   (const TableExprId& id);
+  virtual MVTime   getDate     (const TableExprId& id);
+  virtual Array<Bool>     getArrayBool     (const TableExprId& id);
+  virtual Array<Int64>    getArrayInt      (const TableExprId& id);
+  virtual Array<Double>   getArrayDouble   (const TableExprId& id);
+  virtual Array<DComplex> getArrayDComplex (const TableExprId& id);
+  virtual Array<String>   getArrayString   (const TableExprId& id);
+  virtual Array<MVTime>   getArrayDate     (const TableExprId& id);
+  virtual Bool isDefined (const TableExprId& id);
+  // </group>
+
+protected:
+  // Get the shape in the matching row of the joined table.
+  virtual const IPosition& getShape (const TableExprId& id);
+
+private:
+  // Get the id of the matching row in the joined table.
+  TableExprId joinId (const TableExprId& id) const;
+
+  CountedPtr<TableExprJoin> itsJoin;
+  Vector<uInt> itsRownrs;          //# selected rows in main table
+  Bool         itsApplySelection;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -550,12 +550,9 @@ TaQLNodeResult TaQLJoinNodeRep::visit (TaQLNodeVisitor& visitor) const
 }
 void TaQLJoinNodeRep::show (std::ostream& os) const
 {
-  os << "JOIN ";
-  if (itsTables.isValid()) {
-    itsTables.show (os);
-    os << ' ';
-  }
-  os << "ON CONDITION ";
+  os << " JOIN ";
+  itsTables.show (os);
+  os << " ON ";
   itsCondition.show (os);
 }
 void TaQLJoinNodeRep::save (AipsIO& aio) const
@@ -970,7 +967,16 @@ void TaQLSelectNodeRep::showDerived (std::ostream& os) const
   itsColumns.show (os);
   os << " FROM ";
   itsTables.show (os);
-  itsJoin.show (os);
+  if (itsJoin.isValid()) {
+    // The JOIN clauses are held in a multi node, but must not be shown
+    // as a comma separated list.
+    const TaQLMultiNodeRep* joins =
+      dynamic_cast<const TaQLMultiNodeRep*>(itsJoin.getRep());
+    AlwaysAssert (joins, AipsError);
+    for (uInt i=0; i<joins->itsNodes.size(); ++i) {
+      joins->itsNodes[i].show (os);
+    }
+  }
   if (itsWhere.isValid()) {
     os << " WHERE ";
     itsWhere.show (os);
@@ -426,8 +426,10 @@ public:
 //   <li> <linkto class=TaQLNodeRep>TaQLNodeRep</linkto>
 // </prerequisite>
 // <synopsis> 
-// This class is a TaQLNodeRep holding the expressions of a join operation.
-// This is, however, a placeholder and not implemented yet.
+// This class is a TaQLNodeRep holding the table and the condition of a
+// JOIN clause. The condition must consist of one or more equality
+// comparisons combined with AND. The select node holds the JOIN clauses
+// as a multi node.
 // </synopsis> 
 
 class TaQLJoinNodeRep: public TaQLNodeRep
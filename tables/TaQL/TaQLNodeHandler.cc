@@ -368,9 +368,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return TaQLNodeResult();
   }
 
-  TaQLNodeResult TaQLNodeHandler::visitJoinNode (const TaQLJoinNodeRep&)
+  TaQLNodeResult TaQLNodeHandler::visitJoinNode (const TaQLJoinNodeRep& node)
   {
-    throw TableInvExpr ("join is not supported yet");
+    // Add the joined tables, thereafter handle the join condition.
+    topStack()->startJoin();
+    handleTables (node.itsTables);
+    TaQLNodeResult result = visitNode (node.itsCondition);
+    topStack()->handleJoin (getHR(result).getExpr());
     return TaQLNodeResult();
   }
 
@@ -485,7 +489,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TableParseSelect* curSel = pushStack (TableParseSelect::PSELECT);
     handleTables  (node.itsTables);
     visitNode     (node.itsGiving);
-    visitNode     (node.itsJoin);
+    handleJoins   (node.itsJoin);
     handleWhere   (node.itsWhere);
     visitNode     (node.itsGroupby);
     visitNode     (node.itsColumns);
@@ -846,6 +850,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     //# Possibly let handleColumns also add a table (for selected columns)
   }
 
+  void TaQLNodeHandler::handleJoins (const TaQLNode& node)
+  {
+    if (! node.isValid()) {
+      return;
+    }
+    // The joins have to be done in order of appearance.
+    const TaQLMultiNodeRep* joins =
+      dynamic_cast<const TaQLMultiNodeRep*>(node.getRep());
+    AlwaysAssert (joins, AipsError);
+    const std::vector<TaQLNode>& nodes = joins->itsNodes;
+    for (uInt i=0; i<nodes.size(); ++i) {
+      AlwaysAssert (nodes[i].nodeType() == TaQLNode_Join, AipsError);
+      visitNode (nodes[i]);
+    }
+  }
+
   void TaQLNodeHandler::handleWhere (const TaQLNode& node)
   {
     if (node.isValid()) {
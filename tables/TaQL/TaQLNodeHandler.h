@@ -157,6 +157,9 @@ private:
   // Handle a MultiNode containing table info.
   void handleTables (const TaQLMultiNode&);
 
+  // Handle a MultiNode containing the JOIN clauses.
+  void handleJoins (const TaQLNode&);
+
   // Handle the WHERE clause.
   void handleWhere (const TaQLNode&);
 
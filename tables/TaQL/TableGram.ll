@@ -324,13 +324,15 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
 	    BEGIN(EXPRstate);
 	    return HAVING;
           }
-{JOIN} {
+{JOIN}    {
             tableGramPosition() += yyleng;
-            throw (TableInvExpr ("JOIN ON is not supported yet"));
+	    BEGIN(FROMstate);
+	    return JOIN;
           }
-{ON}  {
+{ON}      {
             tableGramPosition() += yyleng;
-            throw (TableInvExpr ("JOIN ON is not supported yet"));
+	    BEGIN(EXPRstate);
+	    return ON;
           }
 
 {AS}      {
@@ -57,6 +57,8 @@ using namespace casacore;
 %token GROUPBY
 %token GROUPROLL
 %token HAVING
+%token JOIN
+%token ON
 %token ORDERBY
 %token NODUPL
 %token GIVING
@@ -117,6 +119,9 @@ using namespace casacore;
 %type <node> selcol
 %type <node> normcol
 %type <nodelist> tables
+%type <node> joins
+%type <nodelist> joinlist
+%type <node> joinone
 %type <node> whexpr
 %type <node> groupby
 %type <nodelist> exprlist
@@ -279,16 +284,16 @@ selcomm:   SELECT selrow {
            }
          ;
 
-selrow:    selcol FROM tables whexpr groupby having order limitoff given {
+selrow:    selcol FROM tables joins whexpr groupby having order limitoff given {
                $$ = new TaQLQueryNode(
-                    new TaQLSelectNodeRep (*$1, *$3, 0, *$4, *$5, *$6,
-					   *$7, *$8, *$9));
+                    new TaQLSelectNodeRep (*$1, *$3, *$4, *$5, *$6, *$7,
+					   *$8, *$9, *$10));
 	       TaQLNode::theirNodesCreated.push_back ($$);
            }
-         | selcol into FROM tables whexpr groupby having order limitoff {
+         | selcol into FROM tables joins whexpr groupby having order limitoff {
                $$ = new TaQLQueryNode(
-		    new TaQLSelectNodeRep (*$1, *$4, 0, *$5, *$6, *$7,
-					   *$8, *$9, *$2));
+		    new TaQLSelectNodeRep (*$1, *$4, *$5, *$6, *$7, *$8,
+					   *$9, *$10, *$2));
 	       TaQLNode::theirNodesCreated.push_back ($$);
            }
          ;
@@ -727,6 +732,33 @@ tables:    tabalias {
 	   }
          ;
 
+joins:     {          /* no join */
+	       $$ = new TaQLNode();
+	       TaQLNode::theirNodesCreated.push_back ($$);
+	   }
+         | joinlist {
+	       $$ = $1;
+	   }
+         ;
+
+joinlist:  joinone {
+               $$ = new TaQLMultiNode(False);
+	       TaQLNode::theirNodesCreated.push_back ($$);
+               $$->add (*$1);
+	   }
+         | joinlist joinone {
+	       $$ = $1;
+               $$->add (*$2);
+	   }
+         ;
+
+joinone:   JOIN tables ON orexpr {
+	       $$ = new TaQLNode(
+                    new TaQLJoinNodeRep (*$2, *$4));
+	       TaQLNode::theirNodesCreated.push_back ($$);
+	   }
+         ;
+
 /* If NAME is given, it is purely alphanumeric, so it can be used as alias.
    This is not the case if another type of name is given, so in that case
    there is no alias.
@@ -37,6 +37,7 @@
 #include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
+#include <casacore/tables/TaQL/ExprJoinNode.h>
 #include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/Tables/TableColumn.h>
@@ -73,17 +74,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Default constructor.
 TableParse::TableParse()
+  : joinIndex_p (-1)
 {}
 
 //# Constructor with given table name and possible shorthand.
-TableParse::TableParse (const Table& table, const String& shorthand)
+TableParse::TableParse (const Table& table, const String& shorthand,
+                        Int joinIndex)
   : shorthand_p (shorthand),
-    table_p     (table)
+    table_p     (table),
+    joinIndex_p (joinIndex)
 {}
 
 TableParse::TableParse (const TableParse& that)
   : shorthand_p (that.shorthand_p),
-    table_p     (that.table_p)
+    table_p     (that.table_p),
+    joinIndex_p (that.joinIndex_p)
 {}
 
 TableParse& TableParse::operator= (const TableParse& that)
@@ -91,6 +96,7 @@ TableParse& TableParse::operator= (const TableParse& that)
   if (this != &that) {
     shorthand_p = that.shorthand_p;
     table_p     = that.table_p;
+    joinIndex_p = that.joinIndex_p;
   }
   return *this;
 }
@@ -163,6 +169,7 @@ TableParseSelect::TableParseSelect (CommandType commandType)
     distinct_p      (False),
     resultType_p    (0),
     resultSet_p     (0),
+    joinBusy_p      (-1),
     groupbyRollup_p (False),
     limit_p         (0),
     endrow_p        (0),
@@ -233,7 +240,7 @@ void TableParseSelect::addTable (Int tabnr, const String& name,
       }
     }
   }
-  fromTables_p.push_back (TableParse(table, shorthand));
+  fromTables_p.push_back (TableParse(table, shorthand, joinBusy_p));
 }
 
 void TableParseSelect::replaceTable (const Table& table)
@@ -418,6 +425,43 @@ Table TableParseSelect::findTable (const String& shorthand) const
   return Table();
 }
 
+Int TableParseSelect::findJoinIndex (const String& shorthand) const
+{
+  if (! shorthand.empty()) {
+    for (uInt i=0; i<fromTables_p.size(); i++) {
+      if (fromTables_p[i].test (shorthand)) {
+	return fromTables_p[i].joinIndex();
+      }
+    }
+  }
+  return -1;
+}
+
+TableExprNode TableParseSelect::makeJoinNode (const TableExprNode& node,
+                                              Int joinIndex)
+{
+  TableExprNodeRep* rep = const_cast<TableExprNodeRep*>(node.getNodeRep());
+  if (rep->isConstant()) {
+    return node;
+  }
+  if (joinIndex == joinBusy_p) {
+    // Used in the ON clause, so it is evaluated for rows in the joined
+    // table. Wrap it without a join, so it can be combined with
+    // expressions of the main table.
+    TableExprNode jnode (new TableExprJoinNode (CountedPtr<TableExprJoin>(),
+                                                *rep,
+                                                fromTables_p[0].table()));
+    joinRawNodes_p.push_back
+      (const_cast<TableExprNodeRep*>(jnode.getNodeRep()));
+    return jnode;
+  }
+  AlwaysAssert (joinIndex < Int(joins_p.size()), AipsError);
+  TableExprNode jnode (new TableExprJoinNode (joins_p[joinIndex], *rep,
+                                              fromTables_p[0].table()));
+  applySelNodes_p.push_back (jnode);
+  return jnode;
+}
+
 //# Lookup a field name in the table for which the shorthand is given.
 //# If no shorthand is given, use the first table.
 //# The shorthand and name are separated by a period.
@@ -456,6 +500,16 @@ TableExprNode TableParseSelect::handleKeyCol (const String& name, Bool tryProj)
         }
       }
     }
+    // A column in a joined table is used via the join.
+    Int joinIndex = findJoinIndex (shand);
+    if (joinIndex >= 0) {
+      try {
+        return makeJoinNode (tab.keyCol (columnName, fieldNames), joinIndex);
+      } catch (const TableError&) {
+        throw TableInvExpr (name + " is an unknown column (or keyword)"
+                            " in table " + tab.tableName());
+      }
+    }
     // If it is a column, check if all tables used have the same size.
     // Note: the projected table (used above) should not be checked.
     if (tab.tableDesc().isColumn (columnName)) {
@@ -879,6 +933,20 @@ TableExprNode TableParseSelect::handleFunc (const String& name,
     }
     return makeFuncNode (this, name, arguments, ignoreFuncs, Table(), style);
   }
+  // A function like rowid can be applied to a joined table
+  // by preceeding its name with the table's shorthand (e.g. t2.rowid()).
+  Vector<String> parts = stringToVector (name, '.');
+  if (parts.size() == 2) {
+    Int joinIndex = findJoinIndex (parts[0]);
+    if (joinIndex >= 0  &&
+        findFunc (parts[1], arguments.nelements(), ignoreFuncs) !=
+        TableExprFuncNode::NRFUNC) {
+      return makeJoinNode (makeFuncNode (this, parts[1], arguments,
+                                         ignoreFuncs, findTable(parts[0]),
+                                         style),
+                           joinIndex);
+    }
+  }
   TableExprNode node = makeFuncNode (this, name, arguments, ignoreFuncs,
                                      fromTables_p[0].table(), style);
   // A rowid function node needs to be added to applySelNodes_p.
@@ -1420,6 +1488,132 @@ void TableParseSelect::handleCreTab (const String& tableName,
   table_p = Table(newtab);
 }
 
+void TableParseSelect::startJoin()
+{
+  joinBusy_p = joins_p.size();
+  joinRawNodes_p.clear();
+}
+
+//# Count the row dependent nodes in an expression which are and which are
+//# not evaluated for the joined table.
+static void countJoinNodes (const TableExprNodeRep* node,
+                            const vector<TableExprNodeRep*>& joinNodes,
+                            uInt& njoin, uInt& nmain)
+{
+  if (node == 0) {
+    return;
+  }
+  if (std::find (joinNodes.begin(), joinNodes.end(), node) !=
+      joinNodes.end()) {
+    njoin++;
+  } else if (dynamic_cast<const TableExprNodeColumn*>(node)  ||
+             dynamic_cast<const TableExprNodeArrayColumn*>(node)  ||
+             dynamic_cast<const TableExprNodeRowid*>(node)  ||
+             dynamic_cast<const TableExprJoinNode*>(node)) {
+    nmain++;
+  } else if (const TableExprNodeBinary* bnode =
+             dynamic_cast<const TableExprNodeBinary*>(node)) {
+    countJoinNodes (bnode->getLeftChild(), joinNodes, njoin, nmain);
+    countJoinNodes (bnode->getRightChild(), joinNodes, njoin, nmain);
+  } else if (const TableExprNodeMulti* mnode =
+             dynamic_cast<const TableExprNodeMulti*>(node)) {
+    const PtrBlock<TableExprNodeRep*>& children = mnode->getChildren();
+    for (uInt i=0; i<children.size(); ++i) {
+      countJoinNodes (children[i], joinNodes, njoin, nmain);
+    }
+  }
+}
+
+//# Split a JOIN condition into the keys of the joined and main table.
+static void splitJoinCond (const TableExprNodeRep* node,
+                           const vector<TableExprNodeRep*>& joinNodes,
+                           vector<TableExprNode>& joinKeys,
+                           vector<TableExprNode>& mainKeys,
+                           vector<TableExprNodeRep::NodeDataType>& keyTypes)
+{
+  const TableExprNodeBinary* bnode =
+    dynamic_cast<const TableExprNodeBinary*>(node);
+  if (bnode  &&  node->operType() == TableExprNodeRep::OtAND) {
+    splitJoinCond (bnode->getLeftChild(), joinNodes,
+                   joinKeys, mainKeys, keyTypes);
+    splitJoinCond (bnode->getRightChild(), joinNodes,
+                   joinKeys, mainKeys, keyTypes);
+    return;
+  }
+  if (!bnode  ||  node->operType() != TableExprNodeRep::OtEQ) {
+    throw TableInvExpr ("JOIN condition must consist of comparisons "
+                        "for equality combined with AND");
+  }
+  TableExprNodeRep* keys[2];
+  keys[0] = const_cast<TableExprNodeRep*>(bnode->getLeftChild());
+  keys[1] = const_cast<TableExprNodeRep*>(bnode->getRightChild());
+  uInt njoin[2], nmain[2];
+  for (uInt i=0; i<2; ++i) {
+    njoin[i] = nmain[i] = 0;
+    countJoinNodes (keys[i], joinNodes, njoin[i], nmain[i]);
+    if (keys[i]->valueType() != TableExprNodeRep::VTScalar) {
+      throw TableInvExpr ("JOIN key must be a scalar");
+    }
+  }
+  // Determine which side uses the joined table.
+  uInt jinx = 0;
+  if (njoin[0] == 0) {
+    jinx = 1;
+  }
+  if (njoin[jinx] == 0  ||  nmain[jinx] > 0  ||  njoin[1-jinx] > 0) {
+    throw TableInvExpr ("Each JOIN comparison must have one side using "
+                        "the joined table only and one side not using it");
+  }
+  // Determine the data type to use for comparison.
+  TableExprNodeRep::NodeDataType dtj = keys[jinx]->dataType();
+  TableExprNodeRep::NodeDataType dtm = keys[1-jinx]->dataType();
+  TableExprNodeRep::NodeDataType dt = dtj;
+  if (dtj != dtm) {
+    if ((dtj == TableExprNodeRep::NTInt  ||
+         dtj == TableExprNodeRep::NTDouble)  &&
+        (dtm == TableExprNodeRep::NTInt  ||
+         dtm == TableExprNodeRep::NTDouble)) {
+      dt = TableExprNodeRep::NTDouble;
+    } else {
+      throw TableInvExpr ("JOIN keys have mismatching data types");
+    }
+  }
+  if (dt == TableExprNodeRep::NTComplex) {
+    throw TableInvExpr ("A JOIN key cannot have data type dcomplex");
+  }
+  joinKeys.push_back (keys[jinx]);
+  mainKeys.push_back (keys[1-jinx]);
+  keyTypes.push_back (dt);
+}
+
+void TableParseSelect::handleJoin (const TableExprNode& condition)
+{
+  AlwaysAssert (joinBusy_p >= 0, AipsError);
+  // Find the joined table.
+  Table joinTab;
+  for (uInt i=0; i<fromTables_p.size(); ++i) {
+    if (fromTables_p[i].joinIndex() == joinBusy_p) {
+      if (! joinTab.isNull()) {
+        throw TableInvExpr ("Only one table can be given in a JOIN");
+      }
+      if (fromTables_p[i].shorthand().empty()) {
+        throw TableInvExpr ("A table in a JOIN must have a shorthand");
+      }
+      joinTab = fromTables_p[i].table();
+    }
+  }
+  AlwaysAssert (!joinTab.isNull(), AipsError);
+  checkAggrFuncs (condition);
+  vector<TableExprNode> joinKeys, mainKeys;
+  vector<TableExprNodeRep::NodeDataType> keyTypes;
+  splitJoinCond (condition.getNodeRep(), joinRawNodes_p,
+                 joinKeys, mainKeys, keyTypes);
+  joins_p.push_back (new TableExprJoin (joinKeys, mainKeys, keyTypes,
+                                        joinTab.nrow(), joinTab.tableName()));
+  joinBusy_p = -1;
+  joinRawNodes_p.clear();
+}
+
 void TableParseSelect::handleWhere (const TableExprNode& node)
 {
   checkAggrFuncs (node);
@@ -2302,10 +2496,10 @@ TableParseSelect::doGroupByAggrMultipleKeys
   // We have to group the data according to the (maybe empty) groupby.
   // We step through the table in the normal order which may not be the
   // groupby order.
-  // A map<key,int> is used to keep track of the results where the int
-  // is the index in a vector of a set of aggregate function objects.
+  // A hash map of the packed keys is used to keep track of the results,
+  // mapping to the index in a vector of a set of aggregate function objects.
   vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-  std::map<TableExprGroupKeySet, int> keyFuncMap;
+  TableExprGroupHashMap keyFuncMap;
   // Create the set of groupby key objects.
   TableExprGroupKeySet keySet(groupbyNodes_p);
   // Loop through all rows.
@@ -2314,13 +2508,11 @@ TableParseSelect::doGroupByAggrMultipleKeys
   for (uInt i=0; i<rownrs_p.size(); ++i) {
     rowid.setRownr (rownrs_p[i]);
     keySet.fill (groupbyNodes_p, rowid);
-    int groupnr = funcSets.size();
-    std::map<TableExprGroupKeySet, int>::iterator iter=keyFuncMap.find (keySet);
-    if (iter == keyFuncMap.end()) {
-      keyFuncMap[keySet] = groupnr;
+    const std::string& key = keySet.pack();
+    Int groupnr = keyFuncMap.findOrAdd (key.data(), key.size(),
+                                        funcSets.size());
+    if (groupnr == Int(funcSets.size())) {
       funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-    } else {
-      groupnr = iter->second;
     }
     funcSets[groupnr]->apply (rowid);
   }
@@ -2656,6 +2848,41 @@ void TableParseSelect::doLimOff (Bool showTimings)
   }
 }
 
+Table TableParseSelect::doJoinWhere (Bool showTimings, uInt nrmax)
+{
+  Timer timer;
+  Table table = fromTables_p[0].table();
+  uInt nrow = table.nrow();
+  if (!node_p.isNull()  &&  (node_p.dataType() != TpBool  ||
+                             !node_p.isScalar())) {
+    throw TableInvExpr ("WHERE expression must result in a bool scalar value");
+  }
+  // Find the matching rows of all joined tables.
+  // A row is only selected if all joins have a match.
+  Vector<Bool> valid(nrow, True);
+  for (uInt i=0; i<joins_p.size(); ++i) {
+    joins_p[i]->fill (valid);
+  }
+  // Apply the WHERE to the remaining rows.
+  Vector<uInt> rownrs(nrow);
+  uInt nr = 0;
+  for (uInt i=0; i<nrow; ++i) {
+    if (valid[i]) {
+      if (node_p.isNull()  ||  node_p.getBool (TableExprId(i))) {
+        rownrs[nr++] = i;
+        if (nrmax > 0  &&  nr >= nrmax) {
+          break;
+        }
+      }
+    }
+  }
+  rownrs.resize (nr, True);
+  if (showTimings) {
+    timer.show ("  Join+Where  ");
+  }
+  return table(rownrs);
+}
+
 Table TableParseSelect::doLimOff (Bool showTimings, const Table& table)
 {
   Timer timer;
@@ -3097,9 +3324,15 @@ void TableParseSelect::execute (Bool showTimings, Bool setInGiving,
       cerr << "pre-empt WHERE at " << nrmax << " rows" << endl;
     }
   }
-  //# First do the where selection.
+  //# First do the joins and where selection.
   Table resultTable(table);
-  if (! node_p.isNull()) {
+  if (! joins_p.empty()) {
+    resultTable = doJoinWhere (showTimings, nrmax);
+    if (doTracing) {
+      cerr << "JOIN+WHERE resulted in " << resultTable.nrow()
+           << " rows" << endl;
+    }
+  } else if (! node_p.isNull()) {
 //#//	cout << "Showing TableExprRange values ..." << endl;
 //#//	Block<TableExprRange> rang;
 //#//	node_p->ranges(rang);
@@ -47,6 +47,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Forward Declarations
 class TableExprNodeSet;
 class TableExprNodeSetElem;
+class TableExprJoin;
 class TableExprNodeIndex;
 class TableColumn;
 class AipsIO;
@@ -118,7 +119,10 @@ public:
   TableParse& operator= (const TableParse&);
 
   // Associate the table and the shorthand.
-  TableParse (const Table& table, const String& shorthand);
+  // The join index tells if the table is used in the n-th JOIN clause
+  // (-1 means it is a table in the FROM clause).
+  TableParse (const Table& table, const String& shorthand,
+              Int joinIndex=-1);
 
   // Test if shorthand matches.
   Bool test (const String& shortHand) const;
@@ -129,9 +133,14 @@ public:
   // Get table object.
   const Table& table() const;
 
+  // Get the index of the JOIN the table is used in (-1 if not in a JOIN).
+  Int joinIndex() const
+    { return joinIndex_p; }
+
 private:
   String  shorthand_p;
   Table   table_p;
+  Int     joinIndex_p;
 };
 
 
@@ -400,6 +409,17 @@ public:
   // Show the expression tree.
   void show (ostream& os) const;
 
+  // Start a JOIN clause; the tables added thereafter are joined tables.
+  void startJoin();
+
+  // Handle the ON condition of the JOIN clause started last.
+  // The condition must consist of one or more comparisons for equality
+  // combined with AND. Each comparison must have one side using columns
+  // of the joined table only, and the other side using no columns of it.
+  // The keys in the joined table have to be unique, so each row in the
+  // main table matches at most one row in the joined table.
+  void handleJoin (const TableExprNode& condition);
+
   // Keep the selection expression.
   void handleWhere (const TableExprNode&);
 
@@ -653,6 +673,21 @@ private:
   // If not found, a null Table object is returned.
   Table findTable (const String& shorthand) const;
 
+  // Get the index of the JOIN in which the table with the given shorthand
+  // is used. -1 is returned if not used in a JOIN.
+  Int findJoinIndex (const String& shorthand) const;
+
+  // Make the node for an expression using a joined table.
+  // It is wrapped in a TableExprJoinNode, so it gets evaluated for the
+  // row in the joined table matching a row in the main table.
+  // Inside the ON clause of its JOIN, it is evaluated for all rows of
+  // the joined table.
+  TableExprNode makeJoinNode (const TableExprNode& node, Int joinIndex);
+
+  // Do the joins for the rows in the main table and evaluate the WHERE
+  // expression (if given) for the matching rows.
+  Table doJoinWhere (Bool showTimings, uInt nrmax);
+
   // Handle the selection of a wildcarded column name.
   void handleWildColumn (Int stringType, const String& name);
 
@@ -692,12 +727,12 @@ private:
     // We have to group the data according to the (possibly empty) groupby.
     // We step through the table in the normal order which may not be the
     // groupby order.
-    // A map<key,int> is used to keep track of the results where the int
-    // is the index in a vector of a set of aggregate function objects.
+    // A hash map is used to keep track of the results, mapping the key
+    // to the index in a vector of a set of aggregate function objects.
     vector<CountedPtr<TableExprGroupFuncSet> > funcSets;
-    std::map<T, int> keyFuncMap;
+    TableExprGroupHashMap keyFuncMap;
     T lastKey = std::numeric_limits<Double>::max();
-    int groupnr = -1;
+    Int groupnr = -1;
     // Loop through all rows.
     // For each row generate the key to get the right entry.
     TableExprId rowid(0);
@@ -706,13 +741,14 @@ private:
       rowid.setRownr (rownrs_p[i]);
       groupbyNodes_p[0].get (rowid, key);
       if (key != lastKey) {
-        typename std::map<T, int>::iterator iter = keyFuncMap.find (key);
-        if (iter == keyFuncMap.end()) {
-          groupnr = funcSets.size();
-          keyFuncMap[key] = groupnr;
+        lastKey = key;
+        // Make sure -0 and +0 are the same key.
+        if (key == 0) {
+          key = 0;
+        }
+        groupnr = keyFuncMap.findOrAdd (&key, sizeof(T), funcSets.size());
+        if (groupnr == Int(funcSets.size())) {
           funcSets.push_back (new TableExprGroupFuncSet (aggrNodes));
-        } else {
-          groupnr = iter->second;
         }
       }
       rowid.setRownr (rownrs_p[i]);
@@ -751,6 +787,12 @@ private:
   Int    resultType_p;
   //# Resulting set (from GIVING part).
   TableExprNodeSet* resultSet_p;
+  //# The JOIN clauses (in order of appearance).
+  vector<CountedPtr<TableExprJoin> > joins_p;
+  //# The index of the JOIN whose ON condition is being handled (-1 is none).
+  Int joinBusy_p;
+  //# The nodes of the joined table used in that ON condition.
+  vector<TableExprNodeRep*> joinRawNodes_p;
   //# The WHERE expression tree.
   TableExprNode node_p;
   //# The GROUPBY expressions.
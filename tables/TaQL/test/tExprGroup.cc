@@ -28,7 +28,13 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
+#include <casacore/tables/TaQL/ExprJoinNode.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -444,6 +450,87 @@ void doDComplexArr()
          recs, mean(vecd), "meanDComplex");
 }
 
+void doHashMap()
+{
+  // Use many keys, so the map has to be resized a few times.
+  TableExprGroupHashMap map;
+  for (Int i=0; i<1000; ++i) {
+    Int64 key = 7*i;
+    AlwaysAssertExit (map.findOrAdd (&key, sizeof(key), i) == i);
+  }
+  AlwaysAssertExit (map.size() == 1000);
+  for (Int i=0; i<1000; ++i) {
+    Int64 key = 7*i;
+    AlwaysAssertExit (map.findOrAdd (&key, sizeof(key), 2000) == i);
+    AlwaysAssertExit (map.find (&key, sizeof(key)) == i);
+    key++;
+    AlwaysAssertExit (map.find (&key, sizeof(key)) == -1);
+  }
+  AlwaysAssertExit (map.size() == 1000);
+  // Use packed keys of different length.
+  TableExprGroupKeySet keySet((vector<TableExprNode>()));
+  keySet.addKey (TableExprNodeRep::NTString);
+  TableExprGroupHashMap smap;
+  String keys[] = {"", "a", "ab", "abcdefghij", "abcdefghi"};
+  for (Int i=0; i<5; ++i) {
+    vector<TableExprNode> nodes(1, TableExprNode(keys[i]));
+    keySet.fill (nodes, TableExprId(0));
+    const std::string& packed = keySet.pack();
+    AlwaysAssertExit (smap.findOrAdd (packed.data(), packed.size(), i) == i);
+  }
+  for (Int i=0; i<5; ++i) {
+    vector<TableExprNode> nodes(1, TableExprNode(keys[i]));
+    keySet.fill (nodes, TableExprId(0));
+    const std::string& packed = keySet.pack();
+    AlwaysAssertExit (smap.find (packed.data(), packed.size()) == i);
+  }
+}
+
+void doJoin()
+{
+  // Create a main table and a table to join with.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("KEY"));
+  SetupNewTable newtab("tExprGroup_tmp_main", td, Table::New);
+  Table mainTab(newtab, Table::Memory, 10);
+  ScalarColumn<Int> mainCol(mainTab, "KEY");
+  TableDesc td2;
+  td2.addColumn (ScalarColumnDesc<Double>("KEY"));
+  SetupNewTable newtab2("tExprGroup_tmp_join", td2, Table::New);
+  Table joinTab(newtab2, Table::Memory, 4);
+  ScalarColumn<Double> joinCol(joinTab, "KEY");
+  for (uInt i=0; i<10; ++i) {
+    mainCol.put (i, i%6);
+  }
+  for (uInt i=0; i<4; ++i) {
+    joinCol.put (i, 3.-i);
+  }
+  vector<TableExprNode> joinKeys(1, joinTab.col("KEY"));
+  vector<TableExprNode> mainKeys(1, mainTab.col("KEY"));
+  vector<TableExprNodeRep::NodeDataType> keyTypes(1, TableExprNodeRep::NTDouble);
+  TableExprJoin join(joinKeys, mainKeys, keyTypes, 4, "join");
+  Vector<Bool> valid(10, True);
+  valid[2] = False;
+  join.fill (valid);
+  for (uInt i=0; i<10; ++i) {
+    Int key = i%6;
+    if (key < 4  &&  i != 2) {
+      AlwaysAssertExit (valid[i]  &&  join.joinRow(i) == 3-key);
+    } else {
+      AlwaysAssertExit (!valid[i]  &&  join.joinRow(i) == -1);
+    }
+  }
+  // Keys in the joined table must be unique.
+  joinCol.put (0, 2.);
+  Bool failed = False;
+  try {
+    TableExprJoin join2(joinKeys, mainKeys, keyTypes, 4, "join");
+  } catch (std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
 
 int main()
 {
@@ -458,6 +545,9 @@ int main()
     doIntArr();
     doDoubleArr();
     doDComplexArr();
+    cout << "test hash map and join ..." << endl;
+    doHashMap();
+    doJoin();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
@@ -1417,6 +1417,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <dt> TableLock::UserNoReadLocking
 //  <dd> is similar to UserLocking. However, similarly to AutoNoReadLocking
 //       no lock is needed to read the table.
+//  <dt> TableLock::AutoShmLocking and TableLock::UserShmLocking
+//  <dd> are similar to AutoLocking and UserLocking. However, the locks
+//       and synchronization data are kept in shared memory instead of in
+//       the lock file, which makes locking much cheaper (no file IO).
+//       It can only be used if all processes accessing the table run on
+//       the same host and use one of these modes.
+//       On systems not supporting it, the normal file locking is used.
 //  <dt> TableLock::NoLocking
 //  <dd> does not use table locking. It is the responsibility of the
 //       user to ensure that no concurrent access is done on the same
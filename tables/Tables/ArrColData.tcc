@@ -136,16 +136,19 @@ void ArrayColumnData<T>::setShapeColumn (const IPosition& shp)
 template<class T>
 Bool ArrayColumnData<T>::isDefined (uInt rownr) const
 {
+    ReadLock lock (readMutex_p);
     return dataColPtr_p->isShapeDefined(rownr);
 }
 template<class T>
 uInt ArrayColumnData<T>::ndim (uInt rownr) const
 {
+    ReadLock lock (readMutex_p);
     return dataColPtr_p->ndim(rownr);
 }
 template<class T>
 IPosition ArrayColumnData<T>::shape (uInt rownr) const
 {
+    ReadLock lock (readMutex_p);
     return dataColPtr_p->shape(rownr);
 }
 
@@ -204,6 +207,7 @@ void ArrayColumnData<T>::get (uInt rownr, void* arrayPtr) const
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getArrayV (rownr, (Array<T>*)arrayPtr);
     autoReleaseLock();
 }
@@ -218,6 +222,7 @@ void ArrayColumnData<T>::getSlice (uInt rownr, const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getSliceV (rownr, ns, (Array<T>*)arrayPtr);
     autoReleaseLock();
 }
@@ -264,6 +269,7 @@ void ArrayColumnData<T>::getArrayColumn (void* arrayPtr) const
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getArrayColumnV ((Array<T>*)arrayPtr);
     autoReleaseLock();
 }
@@ -278,6 +284,7 @@ void ArrayColumnData<T>::getArrayColumnCells (const RefRows& rownrs,
                          static_cast<const Array<T>*>(arrayPtr)->shape());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getArrayColumnCellsV (rownrs, arrayPtr);
     autoReleaseLock();
 }
@@ -292,6 +299,7 @@ void ArrayColumnData<T>::getColumnSlice (const Slicer& ns,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getColumnSliceV (ns, (Array<T>*)arrayPtr);
     autoReleaseLock();
 }
@@ -307,6 +315,7 @@ void ArrayColumnData<T>::getColumnSliceCells (const RefRows& rownrs,
                          ns.start(), ns.end(), ns.stride());
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getColumnSliceCellsV (rownrs, ns, arrayPtr);
     autoReleaseLock();
 }
@@ -287,6 +287,19 @@ void BaseTable::writeEnd (AipsIO& ios)
 void BaseTable::setTableChanged()
 {}
 
+void BaseTable::setConcurrentRead (Bool enable)
+{
+    if (enable) {
+	throw (TableInvOper ("Table " + name_p + " does not support "
+			     "concurrent read mode"));
+    }
+}
+
+Bool BaseTable::isConcurrentRead() const
+{
+    return False;
+}
+
 
 void BaseTable::markForDelete (Bool callback, const String& oldName)
 {
@@ -147,6 +147,15 @@ public:
     // thus force the data to be written to disk.
     virtual void unlock() = 0;
 
+    // Enable or disable the concurrent read mode (see class Table).
+    // The default implementation throws an exception when enabling,
+    // because the table type does not support it.
+    virtual void setConcurrentRead (Bool enable);
+
+    // Is the table in concurrent read mode?
+    // The default implementation returns False.
+    virtual Bool isConcurrentRead() const;
+
     // Flush the table, i.e. write it to disk.
     virtual void flush (Bool fsync, Bool recursive) = 0;
 
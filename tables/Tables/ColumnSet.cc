@@ -56,7 +56,9 @@ ColumnSet::ColumnSet (TableDesc* tdesc, const StorageOption& opt)
   lockPtr_p       (0),
   colMap_p        (static_cast<void *>(0), tdesc->ncolumn()),
   seqCount_p      (0),
-  blockDataMan_p  (0)
+  blockDataMan_p  (0),
+  concurrentRead_p   (False),
+  concurrentLocked_p (False)
 {
     //# Loop through all columns in the description and create
     //# a column out of them.
@@ -76,6 +78,9 @@ ColumnSet::~ColumnSet()
     for (i=0; i<blockDataMan_p.nelements(); i++) {
 	delete BLOCKDATAMANVAL(i);
     }
+    for (i=0; i<readMutex_p.nelements(); i++) {
+	delete readMutex_p[i];
+    }
     delete multiFile_p;
 }
 
@@ -941,6 +946,70 @@ Bool ColumnSet::userLock (FileLocker::LockType type, Bool wait)
     return False;
 }
 
+void ColumnSet::setConcurrentRead (Bool enable)
+{
+    if (enable == concurrentRead_p) {
+        return;
+    }
+    uInt ncol = colMap_p.ndefined();
+    if (enable) {
+#ifndef USE_THREADS
+        // Without thread support the mutexes do nothing, so concurrent
+        // access would not be serialized.
+        throw TableError ("Table " + baseTablePtr_p->tableName() +
+                          " cannot be put in concurrent read mode; "
+                          "casacore is built without USE_THREADS");
+#endif
+        // Acquire the read lock now. It is kept while in concurrent mode,
+        // so the columns never need to lock or resync the table.
+        concurrentLocked_p = False;
+	if (lockPtr_p->readLocking()
+        &&  ! baseTablePtr_p->hasLock (FileLocker::Read)) {
+	    baseTablePtr_p->lock (FileLocker::Read, 0);
+	    concurrentLocked_p = True;
+	}
+        // Data managers sharing a MultiFile have to use the same mutex.
+        uInt ndm = blockDataMan_p.nelements();
+        uInt nmutex = (multiFile_p == 0  ?  ndm : 1);
+        readMutex_p.resize (nmutex);
+        for (uInt i=0; i<nmutex; i++) {
+	    readMutex_p[i] = new Mutex (Mutex::Recursive);
+	}
+        for (uInt i=0; i<ncol; i++) {
+	    PlainColumn* colPtr = COLMAPVAL(i);
+	    uInt inx = 0;
+	    if (multiFile_p == 0) {
+	        while (inx < ndm  &&
+                       BLOCKDATAMANVAL(inx) != colPtr->dataManager()) {
+		    inx++;
+		}
+                AlwaysAssert (inx < ndm, AipsError);
+	    }
+	    colPtr->setReadMutex (readMutex_p[inx]);
+	}
+        concurrentRead_p = True;
+    } else {
+        concurrentRead_p = False;
+        for (uInt i=0; i<ncol; i++) {
+	    COLMAPVAL(i)->setReadMutex (0);
+	}
+        for (uInt i=0; i<readMutex_p.nelements(); i++) {
+	    delete readMutex_p[i];
+	}
+        readMutex_p.resize (0, True);
+	if (concurrentLocked_p) {
+	    concurrentLocked_p = False;
+	    baseTablePtr_p->unlock();
+	}
+    }
+}
+
+void ColumnSet::throwConcurrentWrite() const
+{
+    throw (TableError ("Table " + baseTablePtr_p->tableName() +
+                       " cannot be written while in concurrent read mode"));
+}
+
 void ColumnSet::doLock (FileLocker::LockType type, Bool wait)
 {
     if (lockPtr_p->option() != TableLock::AutoLocking) {
@@ -35,7 +35,9 @@
 #include <casacore/tables/Tables/BaseTable.h>
 #include <casacore/tables/Tables/StorageOption.h>
 #include <casacore/casa/Containers/SimOrdMap.h>
+#include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -83,6 +85,15 @@ template<class T> class Vector;
 // The main purpose of the class is to deal with constructing, writing
 // and reading the column objects. It is used by classes SetupNewTable
 // and Table.
+//
+// The ColumnSet also manages the concurrent read mode of a table.
+// In that mode each data manager gets its own mutex which is used by the
+// columns to serialize the access to the data manager (and thus its
+// bucket or tile cache). Data managers sharing a MultiFile share a single
+// mutex, because the MultiFile buffers are shared as well.
+// A read lock is acquired when entering the mode and is kept until it is
+// left, so the columns do not need to lock or synchronize the table.
+// Writing is not possible in concurrent read mode.
 // </synopsis> 
 
 // <todo asof="$DATE:$">
@@ -158,6 +169,18 @@ public:
     // Release a temporary user lock if the given release flag is True.
     void userUnlock (Bool releaseFlag);
 
+    // Enable or disable the concurrent read mode.
+    // When enabling, a read lock is acquired (if not held yet) and
+    // the data manager mutexes are created and given to the columns.
+    // When disabling, the mutexes are removed and a read lock acquired
+    // by enabling is released.
+    // Enabling throws a TableError if built without USE_THREADS.
+    void setConcurrentRead (Bool enable);
+
+    // Is the table in concurrent read mode?
+    Bool isConcurrentRead() const
+      { return concurrentRead_p; }
+
     // Do all data managers and engines allow to add rows?
     Bool canAddRow() const;
 
@@ -312,6 +335,10 @@ private:
     // If autolocking is in effect, it locks the table when needed.
     void doLock (FileLocker::LockType, Bool wait);
 
+    // Throw an exception that the table cannot be written, because it is
+    // in concurrent read mode.
+    void throwConcurrentWrite() const;
+
 
     //# Declare the variables.
     TableDesc*                      tdescPtr_p;
@@ -325,6 +352,10 @@ private:
     //#                                                 (used for unique seqnr)
     Block<void*>                    blockDataMan_p; //# list of data managers
     Block<Bool>                     dataManChanged_p; //# data has changed
+    Bool                            concurrentRead_p;
+    Bool                            concurrentLocked_p; //# lock acquired
+    //#                                                 by setConcurrentRead
+    PtrBlock<Mutex*>                readMutex_p;    //# mutex per data manager
 };
 
 
@@ -347,13 +378,16 @@ inline void ColumnSet::linkToLockObject (TableLockData* lockObject)
 }
 inline void ColumnSet::checkReadLock (Bool wait)
 {
-    if (lockPtr_p->readLocking()
+    if (! concurrentRead_p  &&  lockPtr_p->readLocking()
     &&  ! lockPtr_p->hasLock (FileLocker::Read)) {
 	doLock (FileLocker::Read, wait);
     }
 }
 inline void ColumnSet::checkWriteLock (Bool wait)
 {
+    if (concurrentRead_p) {
+        throwConcurrentWrite();
+    }
     if (! lockPtr_p->hasLock (FileLocker::Write)) {
 	doLock (FileLocker::Write, wait);
     }
@@ -366,7 +400,9 @@ inline void ColumnSet::userUnlock (Bool releaseFlag)
 }
 inline void ColumnSet::autoReleaseLock()
 {
-    lockPtr_p->autoRelease();
+    if (! concurrentRead_p) {
+        lockPtr_p->autoRelease();
+    }
 }
 inline Block<Bool>& ColumnSet::dataManChanged()
 {
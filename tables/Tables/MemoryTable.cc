@@ -136,6 +136,16 @@ Bool MemoryTable::lock (FileLocker::LockType, uInt)
 void MemoryTable::unlock()
 {}
 
+void MemoryTable::setConcurrentRead (Bool enable)
+{
+  colSetPtr_p->setConcurrentRead (enable);
+}
+
+Bool MemoryTable::isConcurrentRead() const
+{
+  return colSetPtr_p->isConcurrentRead();
+}
+
 void MemoryTable::flush (Bool, Bool)
 {}
 
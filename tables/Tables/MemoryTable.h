@@ -124,6 +124,12 @@ public:
   // Unlocking the table is a no-op.
   virtual void unlock();
 
+  // Enable or disable the concurrent read mode.
+  virtual void setConcurrentRead (Bool enable);
+
+  // Is the table in concurrent read mode?
+  virtual Bool isConcurrentRead() const;
+
   // Flushing the table is a no-op.
   virtual void flush (Bool fsync, Bool recursive);
 
@@ -39,12 +39,16 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# The cache given in concurrent read mode; it is always invalid.
+static ColumnCache theirNoCache;
+
 PlainColumn::PlainColumn (const BaseColumnDesc* cdp, ColumnSet* csp)
 : BaseColumn    (cdp),
   dataManPtr_p  (0),
   dataColPtr_p  (0),
   colSetPtr_p   (csp),
-  originalName_p(cdp->name())
+  originalName_p(cdp->name()),
+  readMutex_p   (0)
 {
   int trace = TableTrace::traceColumn (colDesc_p);
   rtraceColumn_p = (trace&TableTrace::READ)  != 0;
@@ -96,7 +100,12 @@ Bool PlainColumn::isStored() const
     { return dataManPtr_p->isStorageManager(); }
 
 ColumnCache& PlainColumn::columnCache()
-    { return dataColPtr_p->columnCache(); }
+{
+    if (readMutex_p) {
+        return theirNoCache;
+    }
+    return dataColPtr_p->columnCache();
+}
 
 void PlainColumn::setMaximumCacheSize (uInt nbytes)
     { dataManPtr_p->setMaximumCacheSize (nbytes); }
@@ -74,6 +74,11 @@ class IPosition;
 // table. Furthermore it defines some virtual functions (on top of
 // the virtual functions defined in BaseColumn) which are specific for
 // plain columns.
+// <p>
+// If the table is in concurrent read mode, the column has a mutex
+// (set by ColumnSet) which is locked while the data manager is accessed
+// to get data. In that mode the column cache of the data manager is not
+// given to the caller, because the data manager changes it while reading.
 // </synopsis> 
 
 // <todo asof="$DATE:$">
@@ -126,8 +131,13 @@ public:
     DataManagerColumn*& dataManagerColumn();
 
     // Get a pointer to the underlying column cache.
+    // In concurrent read mode an always invalid cache is returned.
     virtual ColumnCache& columnCache();
 
+    // Set the mutex to use for concurrent reading (0 means no concurrency).
+    void setReadMutex (Mutex* mutex)
+      { readMutex_p = mutex; }
+
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
@@ -144,6 +154,24 @@ protected:
     String              originalName_p;  //# Column name before any rename
     Bool                rtraceColumn_p;  //# trace reads of the column?
     Bool                wtraceColumn_p;  //# trace writes of the column?
+    Mutex*              readMutex_p;     //# mutex for concurrent read
+
+    // Helper class locking the mutex (if any) for the lifetime of the
+    // object, thus serializing the access to the data manager in
+    // concurrent read mode.
+    class ReadLock
+    {
+    public:
+      explicit ReadLock (Mutex* mutex)
+        : itsMutex (mutex)
+        { if (itsMutex) itsMutex->lock(); }
+      ~ReadLock()
+        { if (itsMutex) itsMutex->unlock(); }
+    private:
+      ReadLock (const ReadLock&);
+      ReadLock& operator= (const ReadLock&);
+      Mutex* itsMutex;
+    };
 
     // Get the trace-id of the table.
     int traceId() const
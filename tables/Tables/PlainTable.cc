@@ -452,6 +452,16 @@ void PlainTable::unlock()
     lockPtr_p->release();
 }
 
+void PlainTable::setConcurrentRead (Bool enable)
+{
+    colSetPtr_p->setConcurrentRead (enable);
+}
+
+Bool PlainTable::isConcurrentRead() const
+{
+    return colSetPtr_p->isConcurrentRead();
+}
+
 void PlainTable::autoReleaseLock (Bool always)
 {
     lockPtr_p->autoRelease (always);
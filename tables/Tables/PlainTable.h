@@ -146,6 +146,12 @@ public:
     // thus force the data to be written to disk.
     virtual void unlock();
 
+    // Enable or disable the concurrent read mode.
+    virtual void setConcurrentRead (Bool enable);
+
+    // Is the table in concurrent read mode?
+    virtual Bool isConcurrentRead() const;
+
     // Do a release of an AutoLock when the inspection interval has expired.
     // <src>always=True</src> means that the inspection is always done,
     // thus not every 25th call or so.
@@ -33,9 +33,11 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/String.h>
@@ -51,12 +53,107 @@
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/fstream.h>             // needed for file IO
 #include <casacore/casa/sstream.h>           // needed for internal IO
+#include <stdlib.h>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 const Int lineSize = 32768;
 
+//# The maximum number of lines and characters in a batch of data lines.
+const uInt batchLines = 8192;
+const uInt batchChars = 8*1024*1024;
+
+
+//# Buffer holding the values of a column for a batch of data lines.
+//# The values of array columns are kept per row as a Block with a shape
+//# as filled by ReadAsciiTable::getArray.
+class ReadAsciiColumnBuffer
+{
+public:
+  virtual ~ReadAsciiColumnBuffer()
+    {}
+  // Make sure the buffer can hold the given number of rows.
+  virtual void resize (uInt nrow) = 0;
+  // Get a pointer to the scalar value of a row after setting it to
+  // its default value.
+  virtual void* scalar (uInt row) = 0;
+  // Get a pointer to the Block holding the array values of a row.
+  virtual void* arrayBlock (uInt row) = 0;
+  // Set the shape of the array in a row.
+  void setShape (uInt row, const IPosition& shape)
+    { itsShapes[row] = shape; }
+  // Put the values of the first nrow rows into the column,
+  // starting at the given table row.
+  virtual void put (TableColumn& tabcol, uInt startRow, uInt nrow) = 0;
+protected:
+  Block<IPosition> itsShapes;
+};
+
+template<typename T>
+class ReadAsciiColumnBufferT : public ReadAsciiColumnBuffer
+{
+public:
+  explicit ReadAsciiColumnBufferT (Bool isArray)
+    : itsIsArray (isArray)
+    {}
+  virtual void resize (uInt nrow)
+  {
+    if (itsIsArray) {
+      itsArrays.resize (nrow);
+      itsShapes.resize (nrow);
+    } else {
+      itsValues.resize (nrow);
+    }
+  }
+  virtual void* scalar (uInt row)
+  {
+    itsValues[row] = T();
+    return &(itsValues[row]);
+  }
+  virtual void* arrayBlock (uInt row)
+    { return &(itsArrays[row]); }
+  virtual void put (TableColumn& tabcol, uInt startRow, uInt nrow)
+  {
+    if (itsIsArray) {
+      ArrayColumn<T> col(tabcol);
+      for (uInt i=0; i<nrow; ++i) {
+	Array<T> array(itsShapes[i], itsArrays[i].storage(), SHARE);
+	col.put (startRow+i, array);
+      }
+    } else {
+      ScalarColumn<T> col(tabcol);
+      Vector<T> vec(IPosition(1,nrow), itsValues.storage(), SHARE);
+      col.putColumnRange (Slicer(IPosition(1,startRow), IPosition(1,nrow)),
+			  vec);
+    }
+  }
+private:
+  Bool            itsIsArray;
+  Block<T>        itsValues;
+  Block<Block<T> > itsArrays;
+};
+
+
+//# Convert a string to an integer value. Out of range values are clipped.
+template<typename T>
+inline T stringToInt (const char* str)
+{
+  long val = strtol (str, 0, 10);
+  if (val < long(std::numeric_limits<T>::min())) {
+    return std::numeric_limits<T>::min();
+  }
+  if (val > long(std::numeric_limits<T>::max())) {
+    return std::numeric_limits<T>::max();
+  }
+  return T(val);
+}
+
 
 
 //# Helper function.
@@ -557,38 +654,21 @@ Bool ReadAsciiTable::getValue (char* string1, Int lineSize, char* first,
     first[0] = '\0';
   }
   if(more){
-  String dum(first, done1);
   switch (type) {
   case RATBool:
     *(Bool*)value = makeBool(String(first, done1));
     break;
   case RATShort:
-    if (done1 > 0) {
-      istringstream(dum) >> *(Short*)value;
-    } else {
-      *(Short*)value = 0;
-    }
+    *(Short*)value = (done1 > 0  ?  stringToInt<Short>(first) : 0);
     break;
   case RATInt:
-    if (done1 > 0) {
-      istringstream(dum) >> *(Int*)value;
-    } else {
-      *(Int*)value = 0;
-    }
+    *(Int*)value = (done1 > 0  ?  stringToInt<Int>(first) : 0);
     break;
   case RATFloat:
-    if (done1 > 0) {
-      istringstream(dum) >> *(Float*)value;
-    } else {
-      *(Float*)value = 0;
-    }
+    *(Float*)value = (done1 > 0  ?  strtof(first, 0) : 0);
     break;
   case RATDouble:
-    if (done1 > 0) {
-      istringstream(dum) >> *(Double*)value;
-    } else {
-      *(Double*)value = 0;
-    }
+    *(Double*)value = (done1 > 0  ?  strtod(first, 0) : 0);
     break;
   case RATString:
     *(String*)value = String(first, done1);
@@ -601,46 +681,42 @@ Bool ReadAsciiTable::getValue (char* string1, Int lineSize, char* first,
     break;
   case RATComX:
     if (done1 > 0) {
-      istringstream(dum) >> f1;
+      f1 = strtof (first, 0);
     }
     done1 = getNext (string1, lineSize, first, at1, separator);
     if (done1 > 0) {
-      String dum2(first, done1);
-      istringstream(dum2) >> f2;
+      f2 = strtof (first, 0);
     }
     *(Complex*)value = Complex(f1, f2);
     break;
   case RATDComX:
     if (done1 > 0) {
-      istringstream(dum) >> d1;
+      d1 = strtod (first, 0);
     }
     done1 = getNext (string1, lineSize, first, at1, separator);
     if (done1 > 0) {
-      String dum2(first, done1);
-      istringstream(dum2) >> d2;
+      d2 = strtod (first, 0);
     }
     *(DComplex*)value = DComplex(d1, d2);
     break;
   case RATComZ:
     if (done1 > 0) {
-      istringstream(dum) >> f1;
+      f1 = strtof (first, 0);
     }
     done1 = getNext (string1, lineSize, first, at1, separator);
     if (done1 > 0) {
-      String dum2(first, done1);
-      istringstream(dum2) >> f2;
+      f2 = strtof (first, 0);
     }
     f2 *= 3.14159265/180.0; 
     *(Complex*)value = Complex(f1*cos(f2), f1*sin(f2));
     break;
   case RATDComZ:
     if (done1 > 0) {
-      istringstream(dum) >> d1;
+      d1 = strtod (first, 0);
     }
     done1 = getNext (string1, lineSize, first, at1, separator);
     if (done1 > 0) {
-      String dum2(first, done1);
-      istringstream(dum2) >> d2;
+      d2 = strtod (first, 0);
     }
     d2 *= 3.14159265/180.0; 
     *(DComplex*)value = DComplex(d1*cos(d2), d1*sin(d2));
@@ -651,76 +727,6 @@ Bool ReadAsciiTable::getValue (char* string1, Int lineSize, char* first,
 }
 
 
-void ReadAsciiTable::handleScalar (char* string1, Int lineSize, char* first,
-				   Int& at1, Char separator,
-				   Int type,
-				   TableColumn& tabcol, uInt rownr)
-{
-  switch (type) {
-  case RATBool:
-    {
-      Bool value = False;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATShort:
-    {
-      Short value = 0;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATInt:
-    {
-      Int value = 0;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATFloat:
-    {
-      Float value = 0;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATDouble:
-  case RATDMS:
-  case RATHMS:
-    {
-      Double value = 0;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATString:
-    {
-      String value;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATComX:
-  case RATComZ:
-    {
-      Complex value;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  case RATDComX:
-  case RATDComZ:
-    {
-      DComplex value;
-      getValue (string1, lineSize, first, at1, separator, type, &value);
-      tabcol.putScalar (rownr, value);
-    }
-    break;
-  }
-}
-
-
 IPosition ReadAsciiTable::getArray (char* string1, Int lineSize, char* first,
 				    Int& at1, Char separator,
 				    const IPosition& shape, Int varAxis,
@@ -963,89 +969,75 @@ IPosition ReadAsciiTable::getArray (char* string1, Int lineSize, char* first,
 }
 
 
-void ReadAsciiTable::handleArray (char* string1, Int lineSize, char* first,
-				  Int& at1, Char separator,
-				  const IPosition& shape, Int varAxis,
-				  Int type,
-				  TableColumn& tabcol, uInt rownr)
+ReadAsciiColumnBuffer* ReadAsciiTable::makeBuffer (Int type, Bool isArray)
 {
   switch (type) {
   case RATBool:
-    {
-      Block<Bool> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Bool> array(shp, data.storage(), SHARE);
-      ArrayColumn<Bool>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Bool> (isArray);
   case RATShort:
-    {
-      Block<Short> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Short> array(shp, data.storage(), SHARE);
-      ArrayColumn<Short>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Short> (isArray);
   case RATInt:
-    {
-      Block<Int> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Int> array(shp, data.storage(), SHARE);
-      ArrayColumn<Int>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Int> (isArray);
   case RATFloat:
-    {
-      Block<Float> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Float> array(shp, data.storage(), SHARE);
-      ArrayColumn<Float>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Float> (isArray);
   case RATDouble:
   case RATDMS:
   case RATHMS:
-    {
-      Block<Double> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Double> array(shp, data.storage(), SHARE);
-      ArrayColumn<Double>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Double> (isArray);
   case RATString:
-    {
-      Block<String> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<String> array(shp, data.storage(), SHARE);
-      ArrayColumn<String>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<String> (isArray);
   case RATComX:
   case RATComZ:
-    {
-      Block<Complex> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<Complex> array(shp, data.storage(), SHARE);
-      ArrayColumn<Complex>(tabcol).put (rownr, array);
-    }
-    break;
+    return new ReadAsciiColumnBufferT<Complex> (isArray);
   case RATDComX:
   case RATDComZ:
-    {
-      Block<DComplex> data;
-      IPosition shp = getArray (string1, lineSize, first, at1, separator,
-				shape, varAxis, type, &data);
-      Array<DComplex> array(shp, data.storage(), SHARE);
-      ArrayColumn<DComplex>(tabcol).put (rownr, array);
+    return new ReadAsciiColumnBufferT<DComplex> (isArray);
+  }
+  throw AipsError ("ReadAsciiTable: unknown column type");
+}
+
+
+void ReadAsciiTable::parseLines (const Block<char>& text,
+				 const Block<uInt>& offsets, uInt nlines,
+				 Char separator,
+				 const Block<IPosition>& shapes,
+				 const Block<Int>& types, Int varAxis,
+				 PtrBlock<ReadAsciiColumnBuffer*>& buffers,
+				 Bool parallel)
+{
+  const Int nrcol = types.nelements();
+  for (Int i=0; i<nrcol; ++i) {
+    buffers[i]->resize (nlines);
+  }
+  // Each thread needs its own buffer for the values.
+  // The lines are not changed, so they can be used in place.
+  // Without OpenMP the lines are always parsed sequentially.
+  (void)parallel;
+#ifdef _OPENMP
+#pragma omp parallel if (parallel  &&  nlines >= 256)
+#endif
+  {
+    Block<char> first(lineSize);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for (Int row=0; row<Int(nlines); ++row) {
+      char* line = const_cast<char*>(text.storage()) + offsets[row];
+      Int leng = offsets[row+1] - offsets[row];
+      Int at1 = 0;
+      for (Int i=0; i<nrcol; ++i) {
+	if (shapes[i].nelements() > 0) {
+	  Int varAx = (i == nrcol-1  ?  varAxis : -1);
+	  IPosition shp = getArray (line, leng, first.storage(),
+				    at1, separator, shapes[i], varAx,
+				    types[i], buffers[i]->arrayBlock(row));
+	  buffers[i]->setShape (row, shp);
+	} else {
+	  getValue (line, leng, first.storage(), at1, separator,
+		    types[i], buffers[i]->scalar(row));
+	}
+      }
     }
-    break;
   }
 }
 
@@ -1362,8 +1354,22 @@ Table ReadAsciiTable::makeTab (String& formatString,
 
 // OK, Now we have real data
 // stringsav may contain the first data line.
+// The data lines are read in batches which are parsed into a buffer per
+// column (in parallel if possible). Thereafter each column is written
+// for the entire batch.
+// Converting DMS and HMS positions uses MVAngle, which is not thread-safe.
 
-    int at1=0;
+    PtrBlock<ReadAsciiColumnBuffer*> buffers(nrcol, 0);
+    Bool parallel = True;
+    for (Int i=0; i<nrcol; i++) {
+        buffers[i] = makeBuffer (typeOfColumn[i],
+				 shapeOfColumn[i].nelements() > 0);
+	if (typeOfColumn[i] == RATDMS  ||  typeOfColumn[i] == RATHMS) {
+	    parallel = False;
+	}
+    }
+    Block<char> text(lineSize);
+    Block<uInt> offsets(batchLines+1);
     Bool cont = True;
     if (stringsav[0] == '\0') {
         cont = getLine (jFile, lineNumber, string1, lineSize,
@@ -1372,30 +1378,43 @@ Table ReadAsciiTable::makeTab (String& formatString,
     } else {
         strcpy (string1, stringsav);
     }
-    while (cont) {
-	at1 = 0; 
-	tab.addRow();
-	for (Int i6=0; i6<nrcol; i6++) {
-	    if (shapeOfColumn[i6].nelements() > 0) {
-	        Int varAx = (i6 == nrcol-1  ?  varAxis : -1);
-		handleArray (string1, lineSize, first,
-			     at1, separator,
-			     shapeOfColumn[i6], varAx,
-			     typeOfColumn[i6],
-			     tabcol[i6], rownr);
-	    } else {
-		handleScalar (string1, lineSize, first,
-			      at1, separator,
-			      typeOfColumn[i6],
-			      tabcol[i6], rownr);
+    try {
+        while (cont) {
+	    uInt nlines = 0;
+	    uInt nchar  = 0;
+	    while (cont  &&  nlines < batchLines  &&  nchar < batchChars) {
+	        uInt leng = strlen(string1) + 1;
+		if (nchar + leng > text.nelements()) {
+		    text.resize (2*(nchar + leng), False, True);
+		}
+		memcpy (text.storage() + nchar, string1, leng);
+		offsets[nlines++] = nchar;
+		nchar += leng;
+		cont = getLine (jFile, lineNumber, string1, lineSize,
+				testComment, commentMarker,
+				firstLine, lastLine);
 	    }
+	    offsets[nlines] = nchar;
+	    parseLines (text, offsets, nlines, separator,
+			shapeOfColumn, typeOfColumn, varAxis,
+			buffers, parallel);
+	    tab.addRow (nlines);
+	    for (Int i=0; i<nrcol; i++) {
+	        buffers[i]->put (tabcol[i], rownr, nlines);
+	    }
+	    rownr += nlines;
 	}
-	rownr++;
-        cont = getLine (jFile, lineNumber, string1, lineSize,
-			testComment, commentMarker,
-			firstLine, lastLine);
+    } catch (...) {
+        for (Int i=0; i<nrcol; i++) {
+	    delete buffers[i];
+	}
+	delete [] tabcol;
+	throw;
     }
 
+    for (Int i=0; i<nrcol; i++) {
+        delete buffers[i];
+    }
     delete [] tabcol;
     jFile.close();
     formatString = formStr;
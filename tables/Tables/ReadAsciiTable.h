@@ -44,6 +44,9 @@ class IPosition;
 class LogIO;
 class TableRecord;
 class TableColumn;
+class ReadAsciiColumnBuffer;
+template<typename T> class Block;
+template<typename T> class PtrBlock;
 
 
 // <summary>
@@ -179,6 +182,14 @@ class TableColumn;
 // resulting in a table with 6 columns and 2 rows.
 // </example>
 
+// <note role=tip>
+// The data lines are read in batches. The lines in a batch are tokenized
+// and converted in parallel if casacore is built with OpenMP (unless a
+// column has type DMS or HMS), after which the values are written column
+// by column for the entire batch. The number of threads can be set with
+// the environment variable OMP_NUM_THREADS.
+// </note>
+
 // <group name=readAsciiTable>
 
 
@@ -415,13 +426,6 @@ private:
 			Int& at1, Char separator,
 			Int type, void* value);
 
-  // Handle the next scalar with the given type from the data line and
-  // put it into the table column.
-  static void handleScalar (char* string1, Int lineSize, char* first,
-			    Int& at1, Char separator,
-			    Int type,
-			    TableColumn& tabcol, uInt rownr);
-
   // Get the next array with the given type from string1.
   // It returns the shape (for variable shaped arrays).
   static IPosition getArray (char* string1, Int lineSize, char* first,
@@ -429,13 +433,20 @@ private:
 			     const IPosition& shape, Int varAxis,
 			     Int type, void* valueBlock);
 
-  // Get the next array with the given type from the data line and
-  // put it into the table column.
-  static void handleArray (char* string1, Int lineSize, char* first,
-			   Int& at1, Char separator,
-			   const IPosition& shape, Int varAxis,
-			   Int type,
-			   TableColumn& tabcol, uInt rownr);
+  // Make a buffer for a batch of values of a column with the given type.
+  static ReadAsciiColumnBuffer* makeBuffer (Int type, Bool isArray);
+
+  // Parse a batch of data lines into the column buffers.
+  // The lines are stored consecutively (with a trailing 0) in
+  // <src>text</src>; <src>offsets</src> gives the start of each line.
+  // The lines are parsed in parallel if <src>parallel</src> is True.
+  static void parseLines (const Block<char>& text,
+			  const Block<uInt>& offsets, uInt nlines,
+			  Char separator,
+			  const Block<IPosition>& shapes,
+			  const Block<Int>& types, Int varAxis,
+			  PtrBlock<ReadAsciiColumnBuffer*>& buffers,
+			  Bool parallel);
 };
 
 
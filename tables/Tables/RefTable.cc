@@ -27,6 +27,7 @@
 
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/RefColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
@@ -48,6 +49,7 @@ RefTable::RefTable (AipsIO& ios, const String& name, uInt nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
+  rowRanges_p  (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (False)
@@ -59,6 +61,7 @@ RefTable::RefTable (AipsIO& ios, const String& name, uInt nrrow, int opt,
     noWrite_p = True;
     getRef (ios, opt, lockOptions, tsmOption);
     noWrite_p = False;
+    makeRowRangesIfConcurrent();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'o');
 }
 
@@ -68,6 +71,7 @@ RefTable::RefTable (BaseTable* btp, Bool order, uInt nrall)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (order),
   rowStorage_p (nrall),       // allocate vector of rownrs
+  rowRanges_p  (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -87,6 +91,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<uInt>& rownrs)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (True),
   rowStorage_p (0),
+  rowRanges_p  (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -107,6 +112,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<uInt>& rownrs)
     //# Link to the root table.
     rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
     baseTabPtr_p->link();
+    makeRowRangesIfConcurrent();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -115,6 +121,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),              // initially empty vector of rownrs
+  rowRanges_p  (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -133,6 +140,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
     //# Link to the root table.
     rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
     baseTabPtr_p->link();
+    makeRowRangesIfConcurrent();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -141,6 +149,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
   baseTabPtr_p (btp->root()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),
+  rowRanges_p  (0),
   nameMap_p    (""),
   colMap_p     (static_cast<RefColumn*>(0)),
   changed_p    (True)
@@ -160,6 +169,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
     rows_p = getStorage (rowStorage_p);
     //# Link to the root table.
     baseTabPtr_p->link();
+    makeRowRangesIfConcurrent();
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'p');
 }
 
@@ -177,6 +187,7 @@ RefTable::~RefTable()
     for (uInt i=0; i<colMap_p.ndefined(); i++) {
 	delete colMap_p.getVal(i);
     }
+    delete rowRanges_p;
     //# Unlink from root.
     BaseTable::unlink (baseTabPtr_p);
 }
@@ -243,6 +254,17 @@ void RefTable::unlock()
     baseTabPtr_p->unlock();
 }
 
+void RefTable::setConcurrentRead (Bool enable)
+{
+    baseTabPtr_p->setConcurrentRead (enable);
+    makeRowRangesIfConcurrent();
+}
+
+Bool RefTable::isConcurrentRead() const
+{
+    return baseTabPtr_p->isConcurrentRead();
+}
+
 void RefTable::flush (Bool fsync, Bool recursive)
 {
     if (!isMarkedForDelete()) {
@@ -514,6 +536,7 @@ void RefTable::addRownr (uInt rnr)
     }
     rows_p[nrrow_p++] = rnr;
     changed_p = True;
+    clearRowRanges();
 }
 
 //# Set exact number of rows.
@@ -525,6 +548,7 @@ void RefTable::setNrrow (uInt nrrow)
     rows_p = getStorage (rowStorage_p);
     nrrow_p = nrrow;
     changed_p = True;
+    clearRowRanges();
 }
 
 
@@ -674,7 +698,10 @@ BaseColumn* RefTable::getColumn (uInt columnIndex) const
     
 
 Vector<uInt>* RefTable::rowStorage()
-    { return &rowStorage_p; }
+{
+    clearRowRanges();
+    return &rowStorage_p;
+}
 
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<uInt> RefTable::rootRownr (const Vector<uInt>& rownrs) const
@@ -688,6 +715,62 @@ Vector<uInt> RefTable::rootRownr (const Vector<uInt>& rownrs) const
 }
 	
 
+const RefRows& RefTable::rowRanges() const
+{
+    //# Serialize making the object, because a table can be in concurrent
+    //# read mode before its row numbers are final (e.g. sort or select).
+    ScopedMutexLock lock(rowRangesMutex_p);
+    if (rowRanges_p == 0) {
+        RefRows* ranges = new RefRows (makeRowRanges (rowNumbers()));
+        //# Calculate the number of rows before the object is used,
+        //# because RefRows does that lazily.
+        ranges->nrows();
+        rowRanges_p = ranges;
+    }
+    return *rowRanges_p;
+}
+
+RefRows RefTable::rootRows (const RefRows& rownrs) const
+{
+    return makeRowRanges (rownrs.convert (rowNumbers()));
+}
+
+RefRows RefTable::makeRowRanges (const Vector<uInt>& rownrs)
+{
+    //# Only use slices if on average a slice (of 3 values) contains
+    //# at least 8 rows. Otherwise the per-slice overhead in the data
+    //# managers can exceed the gain of range access.
+    //# Also only use them if all slices are ascending; RefRows collapses
+    //# any pair of row numbers into a slice, even if the second is lower.
+    RefRows ranges (rownrs, False, True);
+    if (ranges.isSliced()  &&
+        8 * (ranges.rowVector().nelements() / 3) <= rownrs.nelements()) {
+        const Vector<uInt>& rows = ranges.rowVector();
+        Bool ascending = True;
+        for (uInt i=0; ascending && i<rows.nelements(); i+=3) {
+            ascending = (rows[i+1] >= rows[i]  &&  rows[i+2] > 0);
+        }
+        if (ascending) {
+            return ranges;
+        }
+    }
+    return RefRows (rownrs);
+}
+
+void RefTable::makeRowRangesIfConcurrent()
+{
+    //# Make the row ranges now, so the threads only read them.
+    if (baseTabPtr_p->isConcurrentRead()) {
+        rowRanges();
+    }
+}
+
+void RefTable::clearRowRanges()
+{
+    delete rowRanges_p;
+    rowRanges_p = 0;
+}
+
 BaseTable* RefTable::root()
     { return baseTabPtr_p; }
 Bool RefTable::rowOrder() const
@@ -786,6 +869,7 @@ void RefTable::removeRow (uInt rownr)
     }
     nrrow_p--;
     changed_p = True;
+    clearRowRanges();
 }
 
 
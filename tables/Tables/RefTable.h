@@ -35,12 +35,14 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Containers/SimOrdMap.h>
+#include <casacore/casa/OS/Mutex.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class TSMOption;
 class RefColumn;
+class RefRows;
 class AipsIO;
 
 
@@ -75,6 +77,13 @@ class AipsIO;
 // while (if needed) converting the given row number to the row number
 // in the referenced table. For that purpose RefTable maintains a
 // Vector of the row numbers in the referenced table.
+// <br>Often a selection consists of a few runs of contiguous rows
+// (e.g. a selection on TIME or SCAN). When getting or putting an entire
+// column, RefColumn passes the row numbers as a
+// <linkto class=RefRows>RefRows</linkto> object in which such runs are
+// collapsed into slices, so the data managers can access them as ranges.
+// The Vector of row numbers is still kept, thus it does not reduce memory
+// usage; neither are the row numbers stored as slices in the table file.
 //
 // The RefTable constructor acts in a way that it will always reference
 // the original table. This means that if a select is done on a RefTable,
@@ -183,6 +192,13 @@ public:
     // thus force the data to be written to disk.
     virtual void unlock();
 
+    // Enable or disable the concurrent read mode of the underlying table.
+    // When enabling, the row ranges (see <src>rowRanges</src>) are made.
+    virtual void setConcurrentRead (Bool enable);
+
+    // Is the underlying table in concurrent read mode?
+    virtual Bool isConcurrentRead() const;
+
     // Flush the table, i.e. write it to disk.
     // Nothing will be done if the table is not writable.
     // A flush can be executed at any time.
@@ -296,11 +312,30 @@ public:
     // This converts the given row numbers to row numbers in the root table.
     Vector<uInt> rootRownr (const Vector<uInt>& rownrs) const;
 
+    // Get the row numbers in the root table as a RefRows object.
+    // Runs of row numbers with a constant stride (e.g. contiguous ranges
+    // resulting from a selection on TIME or SCAN) are collapsed into slices,
+    // so accessing an entire column can be forwarded as range access to the
+    // data managers. The object is calculated when needed (or when
+    // switching on concurrent read mode) and kept until the row numbers
+    // change.
+    // <br>Note that in concurrent read mode the object is shared by the
+    // threads. It is made when the table is constructed if the root table
+    // is already in concurrent read mode; otherwise making it is guarded
+    // by a mutex.
+    const RefRows& rowRanges() const;
+
+    // Convert the given row numbers to the row numbers in the root table.
+    // As in <src>rowRanges</src>, runs are collapsed into slices.
+    RefRows rootRows (const RefRows& rownrs) const;
+
     // Tell if the table is in row order.
     virtual Bool rowOrder() const;
 
     // Get row number vector.
     // This is used by the BaseTable logic and sort routines.
+    // Because the caller can change the row numbers, the row ranges
+    // are cleared.
     virtual Vector<uInt>* rowStorage();
 
     // Add a rownr to reference table.
@@ -332,6 +367,8 @@ private:
     Bool         rowOrd_p;                     //# True = table is in row order
     Vector<uInt> rowStorage_p;                 //# row numbers in parent table
     uInt*        rows_p;                       //# Pointer to rowStorage_p
+    mutable RefRows* rowRanges_p;              //# rows as slices (if made)
+    mutable Mutex rowRangesMutex_p;            //# guards making rowRanges_p
     SimpleOrderedMap<String,String> nameMap_p; //# map to column name in parent
     SimpleOrderedMap<String,RefColumn*> colMap_p; //# map name to column
     Bool         changed_p;                 //# True = changed since last write
@@ -352,6 +389,17 @@ private:
     // Show the extra table structure info (name of root table).
     void showStructureExtra (std::ostream&) const;
 
+    // Make a RefRows object from the row numbers, where runs of row numbers
+    // are collapsed into slices. It is only sliced if the runs are long
+    // enough to make range access worthwhile and if all runs are ascending.
+    static RefRows makeRowRanges (const Vector<uInt>& rownrs);
+
+    // Make the row ranges if the root table is in concurrent read mode.
+    void makeRowRangesIfConcurrent();
+
+    // Clear the row ranges, because the row numbers have changed.
+    void clearRowRanges();
+
     // Make a table description for the given columns.
     static void makeDesc (TableDesc& desc, const TableDesc& rootDesc,
 			  SimpleOrderedMap<String,String>& nameMap,
@@ -103,6 +103,7 @@ Bool ScalarColumnData<T>::isDefined (uInt rownr) const
 	return True;
     }
     T val;
+    ReadLock lock (readMutex_p);
     dataColPtr_p->get (rownr, &val);
     return ( (!(val == undefVal_p)));
 }
@@ -115,6 +116,7 @@ void ScalarColumnData<T>::get (uInt rownr, void* val) const
       TableTrace::trace (traceId(), columnDesc().name(), 'r', rownr);
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->get (rownr, (T*)val);
     autoReleaseLock();
 }
@@ -131,6 +133,7 @@ void ScalarColumnData<T>::getScalarColumn (void* val) const
 	throw (TableArrayConformanceError("ScalarColumnData::getScalarColumn"));
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getScalarColumnV (vecPtr);
     autoReleaseLock();
 }
@@ -148,6 +151,7 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
 	throw (TableArrayConformanceError("ScalarColumnData::getColumnCells"));
     }
     checkReadLock (True);
+    ReadLock lock (readMutex_p);
     dataColPtr_p->getScalarColumnCellsV (rownrs, &vec);
     autoReleaseLock();
 }
@@ -217,6 +221,7 @@ void ScalarColumnData<T>::makeSortKey (Sort& sortobj,
 	getScalarColumn (vecPtr);
     }else{
 	checkReadLock (True);
+	ReadLock lock (readMutex_p);
 	for (uInt i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (i,  &(*vecPtr)(i));
 	}
@@ -244,6 +249,7 @@ void ScalarColumnData<T>::makeRefSortKey (Sort& sortobj,
 	getScalarColumnCells (rownrs, vecPtr);
     }else{
 	checkReadLock (True);
+	ReadLock lock (readMutex_p);
 	for (uInt i=0; i<nrrow; i++) {
 	    dataColPtr_p->get (rownrs(i),  &(*vecPtr)(i));
 	}
@@ -180,13 +180,21 @@ void ScalarRecordColumnData::putScalarColumnCells (const RefRows& rownrs,
 
 void ScalarRecordColumnData::getRecord (uInt rownr, TableRecord& rec) const
 {
-    if (! dataColPtr_p->isShapeDefined (rownr)) {
+    Array<uChar> data;
+    Bool defined;
+    {
+	ReadLock lock (readMutex_p);
+	defined = dataColPtr_p->isShapeDefined (rownr);
+	if (defined) {
+	    data.resize (dataColPtr_p->shape (rownr));
+	    dataColPtr_p->getArrayV (rownr, &data);
+	}
+    }
+    if (! defined) {
 	rec = TableRecord();
     } else {
-	IPosition shape = dataColPtr_p->shape (rownr);
+	IPosition shape = data.shape();
 	AlwaysAssert (shape.nelements() == 1, AipsError);
-	Array<uChar> data(shape);
-	dataColPtr_p->getArrayV (rownr, &data);
 	Bool deleteIt;
 	const uChar* buf = data.getStorage (deleteIt);
 	MemoryIO memio (buf, shape(0));
@@ -117,6 +117,29 @@ template<class T> class CountedPtr;
 // reference tables. In this way a subset of a table can be created and
 // can be read/written in the same way as a normal Table. Writing has the
 // effect that the underlying table gets written.
+//
+// In general a Table object cannot be used in multiple threads.
+// However, a plain table (or a reference table or memory table) can be put
+// in concurrent read mode using <src>setConcurrentRead</src>. In that
+// mode multiple threads can get data from the same Table object, where
+// the threads share the bucket and tile caches of the storage managers.
+// The access to each data manager is serialized by a mutex, so threads
+// reading columns in different data managers do not block each other.
+// Thereafter the following rules apply until the mode is switched off:
+// <ul>
+//  <li> The Table object has to be shared by reference, thus not copied.
+//  <li> Each thread has to create its own column objects (ScalarColumn,
+//       ArrayColumn, etc.). They must be created after the mode has
+//       been switched on.
+//  <li> Only data can be read; writing data or keywords results in an
+//       exception. Other operations (like select, sort, or reading
+//       keywords) must not be done in the threads.
+//  <li> The table is read locked, so other processes cannot write it.
+//       The lock must not be released explicitly.
+// </ul>
+// Concurrent read mode can only be used if casacore is built with thread
+// support (USE_THREADS or USE_OPENMP); otherwise switching it on results
+// in a TableError exception.
 // </synopsis>
 
 // <example>
@@ -455,6 +478,18 @@ public:
     // If <src>PermanentLocking</src> is in effect, nothing will be done.
     void unlock();
 
+    // Switch the concurrent read mode on or off (see the synopsis above).
+    // When switching it on, the table is read locked (waiting until the
+    // lock can be acquired) if no read lock is held yet. That lock is
+    // released again when switching it off.
+    // An exception is thrown for a table type not supporting it
+    // (e.g. a concatenated table) and when switching it on if casacore
+    // is built without thread support (USE_THREADS).
+    void setConcurrentRead (Bool enable);
+
+    // Is the table in concurrent read mode?
+    Bool isConcurrentRead() const;
+
     // Determine the number of locked tables opened with the AutoLock option
     // (Locked table means locked for read and/or write).
     static uInt nAutoLocks();
@@ -1105,6 +1140,10 @@ inline Bool Table::lock (Bool write, uInt nattempts)
 }
 inline void Table::unlock()
     { baseTabPtr_p->unlock(); }
+inline void Table::setConcurrentRead (Bool enable)
+    { baseTabPtr_p->setConcurrentRead (enable); }
+inline Bool Table::isConcurrentRead() const
+    { return baseTabPtr_p->isConcurrentRead(); }
 inline Bool Table::hasLock (FileLocker::LockType type) const
     { return baseTabPtr_p->hasLock (type); }
 inline Bool Table::hasLock (Bool write) const
@@ -32,6 +32,8 @@
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableLocker.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/tables/DataMan/DataManager.h>
@@ -40,12 +42,171 @@
 #include <casacore/casa/Containers/SimOrdMap.h>
 #include <casacore/casa/Utilities/LinearSearch.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// The number of bytes to transfer per column at a time in copyRows.
+static const uInt theirCopyChunkBytes = 4*1024*1024;
+
+// Copy the rows of a scalar column in chunks.
+template<typename T>
+static void copyScalarRows (TableColumn& outCol, const TableColumn& inCol,
+                            uInt startout, uInt startin, uInt nrrow)
+{
+  ScalarColumn<T> out(outCol);
+  ScalarColumn<T> in(inCol);
+  uInt chunk = std::max (theirCopyChunkBytes / uInt(sizeof(T)), 1u);
+  Vector<T> vec;
+  for (uInt done=0; done<nrrow; done+=chunk) {
+    uInt n = std::min (chunk, nrrow-done);
+    in.getColumnRange (Slicer(IPosition(1,startin+done), IPosition(1,n)),
+                       vec, True);
+    out.putColumnRange (Slicer(IPosition(1,startout+done), IPosition(1,n)),
+                        vec);
+  }
+}
+
+// Copy the rows of an array column in chunks.
+// A chunk consists of consecutive defined cells with the same shape as its
+// first cell and is limited to about theirCopyChunkBytes bytes.
+// Undefined cells are skipped; a chunk of a single cell is copied as such.
+template<typename T>
+static void copyArrayRows (TableColumn& outCol, const TableColumn& inCol,
+                           uInt startout, uInt startin, uInt nrrow)
+{
+  ArrayColumn<T> out(outCol);
+  ArrayColumn<T> in(inCol);
+  Bool fixedShape = in.columnDesc().isFixedShape();
+  Array<T> arr;
+  uInt done = 0;
+  while (done < nrrow) {
+    uInt rownr = startin + done;
+    if (! in.isDefined (rownr)) {
+      done++;
+      continue;
+    }
+    // Size the chunk from the shape of its first cell.
+    IPosition shape = in.shape (rownr);
+    Int64 cellSize = std::max (shape.product() * Int64(sizeof(T)), Int64(1));
+    uInt maxn = std::max (uInt(std::min (Int64(theirCopyChunkBytes) / cellSize,
+                                         Int64(nrrow - done))), 1u);
+    uInt n = 1;
+    while (n < maxn  &&
+           (fixedShape  ||  (in.isDefined (rownr+n)  &&
+                             shape.isEqual (in.shape(rownr+n))))) {
+      n++;
+    }
+    if (n == 1) {
+      out.put (startout+done, in, rownr);
+    } else {
+      in.getColumnRange (Slicer(IPosition(1,rownr), IPosition(1,n)),
+                         arr, True);
+      out.putColumnRange (Slicer(IPosition(1,startout+done),
+                                 IPosition(1,n)), arr);
+    }
+    done += n;
+  }
+}
+
+// Copy the rows of a column if its data type can be copied in bulk.
+// It returns False if that is not possible.
+static Bool copyColumnRows (Table& out, const Table& in, const String& name,
+                            uInt startout, uInt startin, uInt nrrow)
+{
+  TableColumn outCol(out, name);
+  TableColumn inCol(in, name);
+  const ColumnDesc& outDesc = outCol.columnDesc();
+  const ColumnDesc& inDesc = inCol.columnDesc();
+  if (outDesc.dataType() != inDesc.dataType()  ||
+      outDesc.isScalar() != inDesc.isScalar()  ||
+      !(inDesc.isScalar()  ||  inDesc.isArray())) {
+    return False;
+  }
+  if (inDesc.isScalar()) {
+    switch (inDesc.dataType()) {
+    case TpBool:
+      copyScalarRows<Bool> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUChar:
+      copyScalarRows<uChar> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpShort:
+      copyScalarRows<Short> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUShort:
+      copyScalarRows<uShort> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpInt:
+      copyScalarRows<Int> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUInt:
+      copyScalarRows<uInt> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpFloat:
+      copyScalarRows<Float> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpDouble:
+      copyScalarRows<Double> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpComplex:
+      copyScalarRows<Complex> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpDComplex:
+      copyScalarRows<DComplex> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpString:
+      copyScalarRows<String> (outCol, inCol, startout, startin, nrrow);
+      break;
+    default:
+      return False;
+    }
+  } else {
+    switch (inDesc.dataType()) {
+    case TpBool:
+      copyArrayRows<Bool> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUChar:
+      copyArrayRows<uChar> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpShort:
+      copyArrayRows<Short> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUShort:
+      copyArrayRows<uShort> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpInt:
+      copyArrayRows<Int> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpUInt:
+      copyArrayRows<uInt> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpFloat:
+      copyArrayRows<Float> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpDouble:
+      copyArrayRows<Double> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpComplex:
+      copyArrayRows<Complex> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpDComplex:
+      copyArrayRows<DComplex> (outCol, inCol, startout, startin, nrrow);
+      break;
+    case TpString:
+      copyArrayRows<String> (outCol, inCol, startout, startin, nrrow);
+      break;
+    default:
+      return False;
+    }
+  }
+  return True;
+}
+
 Table TableCopy::makeEmptyTable (const String& newName,
 				 const Record& dataManagerInfo,
 				 const Table& tab,
@@ -113,11 +274,22 @@ void TableCopy::copyRows (Table& out, const Table& in, uInt startout,
     if (startout + nrrow > out.nrow()) {
       out.addRow (startout + nrrow - out.nrow());
     }
-    ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
-    for (uInt i=0; i<nrrow; i++) {
-      inrow.get (startin + i);
-      outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+    // Copy the columns in bulk as far as possible.
+    // The other columns are copied row by row.
+    uInt nrother = 0;
+    for (uInt i=0; i<nrcol; i++) {
+      if (! copyColumnRows (out, in, cols(i), startout, startin, nrrow)) {
+        cols(nrother++) = cols(i);
+      }
+    }
+    if (nrother > 0) {
+      cols.resize (nrother, True);
+      ROTableRow inrow(in, cols);
+      outrow = TableRow(out, cols);
+      for (uInt i=0; i<nrrow; i++) {
+        inrow.get (startin + i);
+        outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
+      }
     }
     if (flush) {
       out.flush();
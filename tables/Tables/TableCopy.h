@@ -113,6 +113,12 @@ public:
   // column with the same name in table <src>in</src>. In principle only
   // stored columns will be filled; however if the output table has only
   // one column, it can also be a virtual one.
+  // <br>Columns with a standard data type are copied per column in
+  // chunks of rows using <src>getColumnRange</src> and
+  // <src>putColumnRange</src>, which avoids the per-cell overhead and makes
+  // the data managers access their data sequentially. Other columns
+  // (e.g. with a different data type in input and output) are copied row
+  // by row.
   // <group>
   static void copyRows (Table& out, const Table& in, Bool flush=True)
     { copyRows (out, in, 0, 0, in.nrow(), flush); }
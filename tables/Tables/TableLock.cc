@@ -35,6 +35,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 TableLock::TableLock (LockOption option)
 : itsOption            (option),
   itsReadLocking       (True),
+  itsSharedMemory      (False),
   itsMaxWait           (0),
   itsInterval          (5),
   itsIsDefaultLocking  (False),
@@ -47,6 +48,7 @@ TableLock::TableLock (LockOption option, double inspectionInterval,
 		      uInt maxWait)
 : itsOption            (option),
   itsReadLocking       (True),
+  itsSharedMemory      (False),
   itsMaxWait           (maxWait),
   itsInterval          (inspectionInterval),
   itsIsDefaultLocking  (False),
@@ -58,6 +60,7 @@ TableLock::TableLock (LockOption option, double inspectionInterval,
 TableLock::TableLock (const TableLock& that)
 : itsOption            (that.itsOption),
   itsReadLocking       (that.itsReadLocking),
+  itsSharedMemory      (that.itsSharedMemory),
   itsMaxWait           (that.itsMaxWait),
   itsInterval          (that.itsInterval),
   itsIsDefaultLocking  (that.itsIsDefaultLocking),
@@ -69,6 +72,7 @@ TableLock& TableLock::operator= (const TableLock& that)
   if (this != &that) {
     itsOption            = that.itsOption;
     itsReadLocking       = that.itsReadLocking;
+    itsSharedMemory      = that.itsSharedMemory;
     itsMaxWait           = that.itsMaxWait;
     itsInterval          = that.itsInterval;
     itsIsDefaultLocking  = that.itsIsDefaultLocking;
@@ -92,6 +96,12 @@ void TableLock::init()
   } else if (itsOption == UserNoReadLocking) {
     itsOption      = UserLocking;
     itsReadLocking = False;
+  } else if (itsOption == AutoShmLocking) {
+    itsOption       = AutoLocking;
+    itsSharedMemory = True;
+  } else if (itsOption == UserShmLocking) {
+    itsOption       = UserLocking;
+    itsSharedMemory = True;
   }
 #endif
   if (itsOption == NoLocking) {
@@ -111,7 +111,16 @@ public:
 	// It means that AutoLocking will be used if the table is not
 	// opened yet. Otherwise the locking options of the PlainTable
 	// object already in use will be used.
-	DefaultLocking
+	DefaultLocking,
+	// The same as AutoLocking, but the locks and synchronization
+	// info are kept in shared memory instead of in the lock file.
+	// This avoids file IO when locking, but it can only be used if
+	// all processes using the table are on the same host and use
+	// shared memory locking. It falls back to AutoLocking if shared
+	// memory locking is not supported on the system.
+	AutoShmLocking,
+	// The same as UserLocking, but using shared memory.
+	UserShmLocking
     };
 
     // Construct with given option and interval.
@@ -139,6 +148,8 @@ public:
     // PermanentLocking.
     // When an interval was defaulted, it is not taken into account.
     // An option DefaultLocking is not taken into account.
+    // The use of shared memory is not merged, because it cannot be changed
+    // once the table is opened.
     void merge (const TableLock& that);
 
     // Get the locking option.
@@ -150,6 +161,9 @@ public:
     // Is permanent locking used?
     Bool isPermanent() const;
 
+    // Are the locks kept in shared memory?
+    Bool sharedMemory() const;
+
     // Get the inspection interval.
     double interval() const;
 
@@ -163,13 +177,14 @@ public:
 private:
     LockOption  itsOption;
     Bool        itsReadLocking;
+    Bool        itsSharedMemory;
     uInt        itsMaxWait;
     double      itsInterval;
     Bool        itsIsDefaultLocking;
     Bool        itsIsDefaultInterval;
 
 
-    // Set itsOption and itsReadLocking when needed.
+    // Set itsOption, itsReadLocking and itsSharedMemory when needed.
     void init();
 };
 
@@ -191,6 +206,11 @@ inline Bool TableLock::isPermanent() const
 	       ||  itsOption == PermanentLockingWait);
 }
 
+inline Bool TableLock::sharedMemory() const
+{
+    return itsSharedMemory;
+}
+
 inline double TableLock::interval() const
 {
     return itsInterval;
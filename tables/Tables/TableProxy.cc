@@ -256,14 +256,18 @@ Record TableProxy::lockOptions()
     option = "permanentwait";
     break;
   case TableLock::UserLocking:
-    if (lock.readLocking()) {
+    if (lock.sharedMemory()) {
+      option = "usershm";
+    } else if (lock.readLocking()) {
       option = "user";
     } else {
       option = "usernoread";
     }
     break;
   case TableLock::AutoLocking:
-    if (lock.readLocking()) {
+    if (lock.sharedMemory()) {
+      option = "autoshm";
+    } else if (lock.readLocking()) {
       option = "auto";
     } else {
       option = "autonoread";
@@ -3387,14 +3391,18 @@ TableLock TableProxy::makeLockOptions (const Record& options)
     opt = TableLock::UserLocking;
   } else if (str == "usernoread") {
     opt = TableLock::UserNoReadLocking;
+  } else if (str == "autoshm") {
+    opt = TableLock::AutoShmLocking;
+  } else if (str == "usershm") {
+    opt = TableLock::UserShmLocking;
   } else if (str == "permanent") {
     opt = TableLock::PermanentLocking;
   } else if (str == "permanentwait") {
     opt = TableLock::PermanentLockingWait;
   } else {
     throw TableError ("'" + str + "' is an unknown lock option; valid are "
-		      "default,auto,autonoread,user,usernoread,permanent,"
-		      "permanentwait");
+		      "default,auto,autonoread,user,usernoread,autoshm,"
+		      "usershm,permanent,permanentwait");
   }
   if (options.nfields() == 1) {
     return TableLock(opt);
@@ -60,6 +60,7 @@ void b (const String& dir, const String& suffix, Char separator,
 void b1 (const String& dir);
 void b2 (const String& dir);
 void b3 (const String& dir, const IPosition& autoShape);
+void c (uInt nrow);
 void erronous();
 
 int main (int argc, const char* argv[])
@@ -94,6 +95,7 @@ int main (int argc, const char* argv[])
 	b3 (dir, IPosition(2,2,5));
 	b3 (dir, IPosition(2,3,5));
 	b3 (dir, IPosition(2,0,5));
+	c (20000);
 	erronous();
     } catch (AipsError x) {
 	cout << "Caught an exception: " << x.getMesg() << endl;
@@ -482,6 +484,61 @@ void tryerror()
   AlwaysAssertExit (ok==False);
 }
 
+// Read a file spanning several batches of lines (with a comment line and
+// a variable shaped last column) and check the values in each row.
+void c (uInt nrow)
+{
+  {
+    ofstream ofile("tReadAsciiTable_tmp.large");
+    ofile << "COLS COLI COLD COLA COLF COLV" << endl;
+    ofile << "S I D A R3 I0" << endl;
+    for (uInt i=0; i<nrow; ++i) {
+      if (i%1000 == 500) {
+        ofile << "# comment line" << endl;
+      }
+      ofile << Int(i%200) - 100 << ' ' << i << ' ' << i+0.5 << " s" << i
+            << ' ' << i << ' ' << i+1 << ' ' << i+2;
+      for (uInt j=0; j<i%4; ++j) {
+        ofile << ' ' << j;
+      }
+      ofile << endl;
+    }
+  }
+  String formStr;
+  Table tab = readAsciiTable (formStr, Table::Plain,
+                              "tReadAsciiTable_tmp.large", "",
+                              "tReadAsciiTable_tmp.data_tablarge",
+                              False, ' ', "#");
+  AlwaysAssertExit (tab.nrow() == nrow);
+  ScalarColumn<Short>  cols (tab,"COLS");
+  ScalarColumn<Int>    coli (tab,"COLI");
+  ScalarColumn<Double> cold (tab,"COLD");
+  ScalarColumn<String> cola (tab,"COLA");
+  ArrayColumn<Float>   colf (tab,"COLF");
+  ArrayColumn<Int>     colv (tab,"COLV");
+  for (uInt i=0; i<nrow; ++i) {
+    AlwaysAssertExit (cols(i) == Int(i%200) - 100);
+    AlwaysAssertExit (coli(i) == Int(i));
+    AlwaysAssertExit (cold(i) == i+0.5);
+    AlwaysAssertExit (cola(i) == "s" + String::toString(i));
+    Vector<Float> vecf = colf(i);
+    AlwaysAssertExit (vecf.nelements() == 3);
+    for (uInt j=0; j<3; ++j) {
+      AlwaysAssertExit (vecf[j] == Float(i+j));
+    }
+    if (colv.isDefined(i)) {
+      Vector<Int> vecv = colv(i);
+      AlwaysAssertExit (vecv.nelements() == i%4);
+      for (uInt j=0; j<i%4; ++j) {
+        AlwaysAssertExit (vecv[j] == Int(j));
+      }
+    } else {
+      AlwaysAssertExit (i%4 == 0);
+    }
+  }
+  cout << "Read and checked " << nrow << " rows" << endl;
+}
+
 void erronous()
 {
   {
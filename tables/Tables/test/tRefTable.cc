@@ -30,6 +30,15 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
@@ -38,7 +47,8 @@
 #include <casacore/casa/namespace.h>
 
 // <summary>
-// Test program for RefTable::addColumn
+// Test program for RefTable::addColumn and for selections consisting
+// of runs of rows (which are accessed as slices).
 // </summary>
 
 void readTab (const String& tabName, uInt nrow, uInt ncol)
@@ -108,6 +118,164 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+void makeRangeTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ci"));
+  td.addColumn (ScalarColumnDesc<Double>("cd"));
+  td.addColumn (ArrayColumnDesc<Float>("ca", IPosition(2,2,3),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  StandardStMan ssm("ssm", 512);
+  newtab.bindColumn ("ci", ssm);
+  IncrementalStMan ism("ism", 512);
+  newtab.bindColumn ("cd", ism);
+  TiledColumnStMan tsm("tsm", IPosition(3,2,3,32));
+  newtab.bindColumn ("ca", tsm);
+  Table tab(newtab, 1000);
+  ScalarColumn<Int> ci(tab, "ci");
+  ScalarColumn<Double> cd(tab, "cd");
+  ArrayColumn<Float> ca(tab, "ca");
+  Matrix<Float> arr(2,3);
+  indgen (arr);
+  for (uInt i=0; i<1000; ++i) {
+    ci.put (i, i);
+    cd.put (i, i/10);
+    ca.put (i, arr + Float(i));
+  }
+}
+
+// Check if the columns in the selection contain the expected values.
+void checkColumns (const Table& sel)
+{
+  Vector<uInt> rows = sel.rowNumbers();
+  Vector<Int> ci = ScalarColumn<Int>(sel, "ci").getColumn();
+  Vector<Double> cd = ScalarColumn<Double>(sel, "cd").getColumn();
+  Array<Float> ca = ArrayColumn<Float>(sel, "ca").getColumn();
+  Array<Float> cs = ArrayColumn<Float>(sel, "ca").getColumn
+    (Slicer(IPosition(2,1,0), IPosition(2,1,2)));
+  AlwaysAssertExit (ci.nelements() == rows.nelements());
+  AlwaysAssertExit (ca.shape() == IPosition(3,2,3,rows.nelements()));
+  AlwaysAssertExit (cs.shape() == IPosition(3,1,2,rows.nelements()));
+  Matrix<Float> arr(2,3);
+  indgen (arr);
+  for (uInt i=0; i<rows.nelements(); ++i) {
+    AlwaysAssertExit (ci[i] == Int(rows[i]));
+    AlwaysAssertExit (cd[i] == rows[i]/10);
+    Array<Float> cell = ca[i];
+    AlwaysAssertExit (allEQ (cell, arr + Float(rows[i])));
+    Array<Float> scell = cs[i];
+    AlwaysAssertExit (allEQ (scell, arr(IPosition(2,1,0), IPosition(2,1,1))
+                                    + Float(rows[i])));
+  }
+  // Get some cells.
+  if (rows.nelements() > 10) {
+    Vector<Int> cic = ScalarColumn<Int>(sel, "ci").getColumnRange
+      (Slicer(IPosition(1,2), IPosition(1,8)));
+    for (uInt i=0; i<8; ++i) {
+      AlwaysAssertExit (cic[i] == Int(rows[i+2]));
+    }
+  }
+}
+
+void testRanges()
+{
+  Table tab("tRefTable_tmp.rng", Table::Update);
+  // Select 2 contiguous ranges.
+  Table sel = tab((tab.col("ci") >= 100  &&  tab.col("ci") < 300)  ||
+                  (tab.col("ci") >= 500  &&  tab.col("ci") < 800));
+  AlwaysAssertExit (sel.nrow() == 500);
+  checkColumns (sel);
+  // Put through the selection and check in the original table.
+  ScalarColumn<Int> sci(sel, "ci");
+  sci.putColumn (sci.getColumn() * 2);
+  ScalarColumn<Int> ci(tab, "ci");
+  AlwaysAssertExit (ci(99) == 99);
+  AlwaysAssertExit (ci(100) == 200);
+  AlwaysAssertExit (ci(299) == 598);
+  AlwaysAssertExit (ci(300) == 300);
+  AlwaysAssertExit (ci(799) == 1598);
+  sci.putColumn (sci.getColumn() / 2);
+  // Removing a row changes the row ranges.
+  sel.removeRow (0);
+  AlwaysAssertExit (sel.nrow() == 499);
+  AlwaysAssertExit (ScalarColumn<Int>(sel, "ci").getColumn()(0) == 101);
+  checkColumns (sel);
+  // Write the selection and check it.
+  sel.rename ("tRefTable_tmp.rngsel1", Table::New);
+}
+
+void testScattered()
+{
+  Table tab("tRefTable_tmp.rng");
+  // Every third row gives a single slice with stride 3.
+  Table sel = tab(tab.col("ci") % 3 == 0);
+  AlwaysAssertExit (sel.nrow() == 334);
+  checkColumns (sel);
+  // Short runs are not collapsed.
+  Table sel2 = tab(tab.col("ci") % 7 < 2);
+  checkColumns (sel2);
+  sel2.rename ("tRefTable_tmp.rngsel2", Table::New);
+  // A sorted table.
+  Table sel3 = sel.sort ("ci", Sort::Descending);
+  AlwaysAssertExit (sel3.nrow() == 334);
+  AlwaysAssertExit (ScalarColumn<Int>(sel3, "ci")(0) == 999);
+  checkColumns (sel3);
+}
+
+void testUnordered()
+{
+  Table tab("tRefTable_tmp.rng", Table::Update);
+  // Rows not in ascending order followed by a long run; the descending
+  // steps must not be collapsed into slices.
+  Vector<uInt> rownrs(504);
+  rownrs[0] = 10;
+  rownrs[1] = 20;
+  rownrs[2] = 15;
+  rownrs[3] = 10;
+  Vector<uInt> run = rownrs(Slice(4,500));
+  indgen (run, 100u);
+  Table sel = tab(rownrs);
+  AlwaysAssertExit (sel.nrow() == 504);
+  checkColumns (sel);
+  Table sel2 = tab(rownrs(Slice(0,4)));
+  checkColumns (sel2);
+  // Put through the selection and check in the original table.
+  ScalarColumn<Int> sci(sel, "ci");
+  Vector<Int> vals = sci.getColumn();
+  sci.putColumn (vals * 2);
+  ScalarColumn<Int> ci(tab, "ci");
+  AlwaysAssertExit (ci(10) == 20);
+  AlwaysAssertExit (ci(15) == 30);
+  AlwaysAssertExit (ci(20) == 40);
+  AlwaysAssertExit (ci(99) == 99);
+  AlwaysAssertExit (ci(100) == 200);
+  AlwaysAssertExit (ci(599) == 1198);
+  AlwaysAssertExit (ci(600) == 600);
+  AlwaysAssertExit (allEQ (sci.getColumn(), vals * 2));
+  sci.putColumn (vals);
+  checkColumns (sel);
+}
+
+void testPersistent()
+{
+  Table sel1("tRefTable_tmp.rngsel1");
+  AlwaysAssertExit (sel1.nrow() == 499);
+  AlwaysAssertExit (sel1.rowNumbers()(0) == 101);
+  AlwaysAssertExit (sel1.rowNumbers()(198) == 299);
+  AlwaysAssertExit (sel1.rowNumbers()(199) == 500);
+  checkColumns (sel1);
+  Table sel2("tRefTable_tmp.rngsel2");
+  AlwaysAssertExit (sel2.nrow() == 286);
+  checkColumns (sel2);
+  // The row numbers are stored one by one (RefTable version 2), so older
+  // software can read the selections.
+  Int64 size1 = RegularFile("tRefTable_tmp.rngsel1/table.dat").size();
+  Int64 size2 = RegularFile("tRefTable_tmp.rngsel2/table.dat").size();
+  AlwaysAssertExit (size1 > 4*499);
+  AlwaysAssertExit (size2 > 4*286);
+}
+
 int main()
 {
   try {
@@ -115,6 +283,11 @@ int main()
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
     readTab ("tRefTable_tmp.dataref", 10, 4);
+    makeRangeTable ("tRefTable_tmp.rng");
+    testRanges();
+    testScattered();
+    testUnordered();
+    testPersistent();
   } catch (AipsError x) {
     cout << "Caught an exception: " << x.getMesg() << endl;
     return 1;
@@ -0,0 +1,222 @@
+//# tTableConcurrentRead.cc: Test program for concurrent reading of a table
+//# Copyright (C) 2015
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+//#
+//# $Id$
+
+#include <casacore/tables/Tables.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <iostream>
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+using namespace casacore;
+using namespace std;
+
+// <summary>
+// Test program for the concurrent read mode of a table.
+// </summary>
+
+const Int nrow = 1000;
+
+// Create a table with columns in different storage managers.
+void createTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ci"));
+  td.addColumn (ScalarColumnDesc<Double>("cd"));
+  td.addColumn (ArrayColumnDesc<Float>("ca", IPosition(2,4,8),
+                                       ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Int>("cv"));
+  SetupNewTable newtab(name, td, Table::New);
+  StandardStMan ssm("ssm", 512);
+  newtab.bindColumn ("ci", ssm);
+  newtab.bindColumn ("cv", ssm);
+  IncrementalStMan ism("ism", 512);
+  newtab.bindColumn ("cd", ism);
+  TiledColumnStMan tsm("tsm", IPosition(3,4,8,16));
+  newtab.bindColumn ("ca", tsm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ci(tab, "ci");
+  ScalarColumn<Double> cd(tab, "cd");
+  ArrayColumn<Float> ca(tab, "ca");
+  ArrayColumn<Int> cv(tab, "cv");
+  Matrix<Float> arr(4,8);
+  indgen (arr);
+  for (Int i=0; i<nrow; ++i) {
+    ci.put (i, i);
+    cd.put (i, i/10);
+    ca.put (i, arr + Float(i));
+    // Leave some cells of the variable shaped column undefined.
+    if (i%3 != 0) {
+      cv.put (i, Vector<Int>(1 + i%5, i));
+    }
+  }
+}
+
+// Read all rows in parallel and check the values.
+// Each thread uses its own column objects.
+Int readTable (const Table& tab)
+{
+  Int nerr = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nerr)
+#endif
+  {
+    ScalarColumn<Int> ci(tab, "ci");
+    ScalarColumn<Double> cd(tab, "cd");
+    ArrayColumn<Float> ca(tab, "ca");
+    ArrayColumn<Int> cv(tab, "cv");
+    Matrix<Float> arr(4,8);
+    indgen (arr);
+    Int nr = tab.nrow();
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,7)
+#endif
+    for (Int j=0; j<nr; ++j) {
+      // Read the rows in a different order to have cache misses.
+      Int i = (j*37) % nr;
+      if (ci(i) != i) nerr++;
+      if (cd(i) != i/10) nerr++;
+      if (! allEQ (ca(i), arr + Float(i))) nerr++;
+      if (! allEQ (ca.getSlice (i, Slicer(IPosition(2,1,2),
+                                          IPosition(2,2,3))),
+                   arr(IPosition(2,1,2), IPosition(2,2,4)) + Float(i))) {
+        nerr++;
+      }
+      if (cv.isDefined(i) != (i%3 != 0)) {
+        nerr++;
+      } else if (cv.isDefined(i)) {
+        if (cv.shape(i) != IPosition(1, 1 + i%5)  ||  ! allEQ (cv(i), i)) {
+          nerr++;
+        }
+      }
+    }
+  }
+  return nerr;
+}
+
+void testPlain()
+{
+  Table tab("tTableConcurrentRead_tmp.tab");
+  AlwaysAssertExit (! tab.isConcurrentRead());
+  tab.setConcurrentRead (True);
+  AlwaysAssertExit (tab.isConcurrentRead());
+  AlwaysAssertExit (tab.hasLock (FileLocker::Read));
+  AlwaysAssertExit (readTable (tab) == 0);
+  tab.setConcurrentRead (False);
+  AlwaysAssertExit (! tab.isConcurrentRead());
+  // Reading in a normal way should still work.
+  ScalarColumn<Int> ci(tab, "ci");
+  AlwaysAssertExit (ci(10) == 10);
+}
+
+void testWrite()
+{
+  Table tab("tTableConcurrentRead_tmp.tab", Table::Update);
+  tab.setConcurrentRead (True);
+  ScalarColumn<Int> ci(tab, "ci");
+  Bool failed = False;
+  try {
+    ci.put (0, 1);
+  } catch (AipsError& x) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  tab.setConcurrentRead (False);
+  // Now writing is possible again.
+  ci.put (0, 1);
+  AlwaysAssertExit (ci(0) == 1);
+  ci.put (0, 0);
+}
+
+void testRef()
+{
+  Table tab("tTableConcurrentRead_tmp.tab");
+  Table sel = tab(tab.col("ci") >= 500);
+  AlwaysAssertExit (sel.nrow() == 500);
+  sel.setConcurrentRead (True);
+  AlwaysAssertExit (tab.isConcurrentRead());
+  Int nerr = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nerr)
+#endif
+  {
+    ScalarColumn<Int> ci(sel, "ci");
+    Int nr = sel.nrow();
+#ifdef _OPENMP
+#pragma omp for
+#endif
+    for (Int i=0; i<nr; ++i) {
+      if (ci(i) != i+500) nerr++;
+    }
+  }
+  AlwaysAssertExit (nerr == 0);
+  sel.setConcurrentRead (False);
+  AlwaysAssertExit (! tab.isConcurrentRead());
+}
+
+void testMemory()
+{
+  Table tab("tTableConcurrentRead_tmp.tab");
+  Table mtab = tab.copyToMemoryTable ("tTableConcurrentRead_tmp.mem");
+  mtab.setConcurrentRead (True);
+  AlwaysAssertExit (readTable (mtab) == 0);
+  mtab.setConcurrentRead (False);
+}
+
+int main()
+{
+  try {
+    createTable ("tTableConcurrentRead_tmp.tab");
+#ifndef USE_THREADS
+    // Without thread support the mode cannot be switched on.
+    Table tab("tTableConcurrentRead_tmp.tab");
+    Bool failed = False;
+    try {
+      tab.setConcurrentRead (True);
+    } catch (TableError&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed  &&  ! tab.isConcurrentRead());
+    cout << "Concurrent read mode needs USE_THREADS" << endl;
+    return 3;                           // untested
+#endif
+    testPlain();
+    testWrite();
+    testRef();
+    testMemory();
+  } catch (AipsError& x) {
+    cout << "Caught an exception: " << x.getMesg() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -26,6 +26,9 @@
 //# $Id$
 
 #include <casacore/tables/Tables.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <stdexcept>
 #include <iostream>
 using namespace casacore;
@@ -63,6 +66,73 @@ void testDM()
     cout << dminfo << endl;
 }
 
+// Test copyRows for columns with cells of different shapes, undefined
+// cells, a column with another data type in the output and row offsets.
+void testCopyRows()
+{
+  TableDesc tdin;
+  tdin.addColumn (ScalarColumnDesc<Int>("sc"));
+  tdin.addColumn (ArrayColumnDesc<Float>("ar"));
+  tdin.addColumn (ArrayColumnDesc<Float>("fx", IPosition(2,3,2),
+                                         ColumnDesc::FixedShape));
+  tdin.addColumn (ScalarColumnDesc<Int>("mm"));
+  SetupNewTable newin("tTableCopy_tmp.in", tdin, Table::New);
+  Table in(newin, 30);
+  ScalarColumn<Int> sc(in, "sc");
+  ArrayColumn<Float> ar(in, "ar");
+  ArrayColumn<Float> fx(in, "fx");
+  ScalarColumn<Int> mm(in, "mm");
+  for (uInt i=0; i<30; ++i) {
+    sc.put (i, i);
+    mm.put (i, 2*i);
+    Matrix<Float> fxarr(3,2);
+    indgen (fxarr, Float(i));
+    fx.put (i, fxarr);
+    // Rows 10-14 and 25 are undefined; rows 15-19 have another shape.
+    if (i < 10  ||  i >= 20) {
+      if (i != 25) {
+        Matrix<Float> arr(2,3);
+        indgen (arr, Float(i));
+        ar.put (i, arr);
+      }
+    } else if (i >= 15) {
+      Vector<Float> arr(i-10);
+      indgen (arr, Float(i));
+      ar.put (i, arr);
+    }
+  }
+  TableDesc tdout;
+  tdout.addColumn (ScalarColumnDesc<Int>("sc"));
+  tdout.addColumn (ArrayColumnDesc<Float>("ar"));
+  tdout.addColumn (ArrayColumnDesc<Float>("fx", IPosition(2,3,2),
+                                          ColumnDesc::FixedShape));
+  tdout.addColumn (ScalarColumnDesc<Double>("mm"));
+  SetupNewTable newout("tTableCopy_tmp.out", tdout, Table::New);
+  Table out(newout, 5);
+  ScalarColumn<Int> osc(out, "sc");
+  ArrayColumn<Float> oar(out, "ar");
+  ArrayColumn<Float> ofx(out, "fx");
+  ScalarColumn<Double> omm(out, "mm");
+  osc.fillColumn (-1);
+  // Copy input rows 2-27 to output rows 3-28.
+  TableCopy::copyRows (out, in, 3, 2, 26);
+  AlwaysAssertExit (out.nrow() == 29);
+  for (uInt i=0; i<3; ++i) {
+    AlwaysAssertExit (osc(i) == -1);
+  }
+  for (uInt i=3; i<29; ++i) {
+    uInt j = i-1;
+    AlwaysAssertExit (osc(i) == Int(j));
+    AlwaysAssertExit (omm(i) == 2.*j);
+    AlwaysAssertExit (allEQ (ofx(i), fx(j)));
+    AlwaysAssertExit (oar.isDefined(i) == ar.isDefined(j));
+    if (ar.isDefined(j)) {
+      AlwaysAssertExit (oar.shape(i).isEqual (ar.shape(j)));
+      AlwaysAssertExit (allEQ (oar(i), ar(j)));
+    }
+  }
+}
+
 int main (int argc, const char* argv[])
 {
   Table::TableType ttyp = Table::Plain;
@@ -104,6 +174,7 @@ int main (int argc, const char* argv[])
 
     if (argc <= 1) {
       testDM();
+      testCopyRows();
     }
   } catch (exception& x) {
     cout << x.what() << endl;
@@ -79,6 +79,20 @@ int main()
     TableLock lock(TableLock::UserNoReadLocking);
     checkLockOption (lock, TableLock::UserLocking, False, False);
   }
+  {
+    TableLock lock(TableLock::AutoShmLocking);
+    checkLockOption (lock, TableLock::AutoLocking, True, False);
+    AlwaysAssertExit (lock.sharedMemory() != TableLock::lockingDisabled());
+    TableLock lock2(lock);
+    AlwaysAssertExit (lock2.sharedMemory() == lock.sharedMemory());
+    lock2 = TableLock();
+    AlwaysAssertExit (! lock2.sharedMemory());
+  }
+  {
+    TableLock lock(TableLock::UserShmLocking);
+    checkLockOption (lock, TableLock::UserLocking, True, False);
+    AlwaysAssertExit (lock.sharedMemory() != TableLock::lockingDisabled());
+  }
   {
     TableLock lock(TableLock::PermanentLocking);
     checkLockOption (lock, TableLock::PermanentLocking, True, True);